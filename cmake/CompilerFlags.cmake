@@ -5,7 +5,7 @@ set(GNU_CLANG_FLAGS
     -finput-charset=UTF-8
     -fexec-charset=UTF-8
     -std=c++23
-    -mavx2
+    -msse4.2
     -fexceptions
 )
 
@@ -33,10 +33,44 @@ set(MSVC_FLAGS
     /utf-8
     #/std:c++latest
     /permissive-
-    /arch:AVX2
     /EHsc
 )
 
+# SIMD kernel translation units (src/algorithms/simd_kernels_*.cpp). Each is built with the flags
+# of its width while the rest of the library stays at the baseline above; SIMDType::Auto picks
+# one at run time. -O2 inlines everything a kernel calls, so no inline function is left compiled
+# with wider flags for the linker to pick in place of the baseline copy.
+set(GNU_CLANG_AVX2_KERNEL_FLAGS
+    -mavx2
+    -mfma
+    -mf16c
+)
+set(GNU_CLANG_AVX512_KERNEL_FLAGS
+    ${GNU_CLANG_AVX2_KERNEL_FLAGS}
+    -mavx512f
+    -mavx512bw
+    -mavx512vl
+)
+# VNNI and BF16 are not part of the AVX-512 width (select_simd_type would then refuse AVX-512 on
+# CPUs without them); the kernels that use them get files of their own, picked at run time.
+set(GNU_CLANG_AVX512_VNNI_KERNEL_FLAGS
+    ${GNU_CLANG_AVX512_KERNEL_FLAGS}
+    -mavx512vnni
+)
+set(GNU_CLANG_AVX512_BF16_KERNEL_FLAGS
+    ${GNU_CLANG_AVX512_KERNEL_FLAGS}
+    -mavx512bf16
+)
+set(GNU_CLANG_KERNEL_FLAGS
+    -O2
+    -Wno-ignored-attributes
+)
+
+# For MSVC callers that build their own kernels wider (and the wider test executables); the
+# library's own kernels stay at the baseline under MSVC, see apply_simd_kernel_flags.
+set(MSVC_AVX2_KERNEL_FLAGS /arch:AVX2)
+set(MSVC_AVX512_KERNEL_FLAGS /arch:AVX512)
+
 set(MSVC_WARNING_FLAGS
     /W4
     /WX
@@ -54,6 +88,27 @@ function(apply_compiler_flags)
     endif()
 endfunction()
 
+# Function to apply the per-width flags to the SIMD kernel sources
+function(apply_simd_kernel_flags sse_source avx2_source avx512_source avx512_vnni_source avx512_bf16_source)
+    if((CMAKE_CXX_COMPILER_ID MATCHES "GNU") OR (CMAKE_CXX_COMPILER_ID MATCHES "Clang"))
+        set(common ${GNU_CLANG_KERNEL_FLAGS})
+        if(CMAKE_CXX_COMPILER_ID MATCHES "GNU")
+            # GCC reports the _mm*_undefined_*() idiom inside its own gather intrinsics.
+            list(APPEND common -Wno-maybe-uninitialized)
+        endif()
+        set_source_files_properties(${sse_source} PROPERTIES COMPILE_OPTIONS "${common}")
+        set_source_files_properties(${avx2_source} PROPERTIES COMPILE_OPTIONS "${common};${GNU_CLANG_AVX2_KERNEL_FLAGS}")
+        set_source_files_properties(${avx512_source} PROPERTIES COMPILE_OPTIONS "${common};${GNU_CLANG_AVX512_KERNEL_FLAGS}")
+        set_source_files_properties(${avx512_vnni_source} PROPERTIES COMPILE_OPTIONS "${common};${GNU_CLANG_AVX512_VNNI_KERNEL_FLAGS}")
+        set_source_files_properties(${avx512_bf16_source} PROPERTIES COMPILE_OPTIONS "${common};${GNU_CLANG_AVX512_BF16_KERNEL_FLAGS}")
+    elseif(CMAKE_CXX_COMPILER_ID MATCHES "MSVC")
+        # MSVC has no flatten attribute: the inline helpers a kernel calls would be left as COMDAT
+        # copies built with /arch:AVX2 or /arch:AVX512, and the linker may keep one of those for
+        # baseline callers. So MSVC builds every kernel file at the baseline. The wider widths then
+        # report no AVX2 / AVX-512 in width_features() and SIMDType::Auto stays at SSE.
+    endif()
+endfunction()
+
 # Function to apply warning flags to specified targets
 function(apply_warning_flags_to_targets)
     if(NOT POT_CHECK_WARNINGS)
@@ -1,14 +1,87 @@
 #pragma once
 
 #include "pot/algorithms/reduce.h"
+#include "pot/algorithms/dot_blocks.h"
 
 namespace pot::algorithms
 {
 /**
  * @brief Asynchronously computes the dot product of two arrays using SIMD.
  *
+ * Every block accumulates with fused multiply-adds (`simd_forced::fma`) into
+ * `details::simd_accumulators` independent registers and finishes with an in-register horizontal sum.
+ *
  * @tparam T  Element type (must be arithmetic).
- * @tparam ST SIMD type (pot::simd::SIMDType).
+ * @tparam ST SIMD type (pot::simd::SIMDType); `Auto` picks the width at run time. float, double and
+ *           int32_t use the kernels the library builds per width; other types are compiled in
+ *           the calling file and stay within the widths its flags enable.
+ * @param exec Executor for task scheduling.
+ * @param a    Pointer to the first array.
+ * @param b    Pointer to the second array.
+ * @param n    Number of elements.
+ * @return lazy_task<T> The computed dot product.
+ */
+template <typename T, pot::simd::SIMDType ST>
+[[nodiscard]] pot::coroutines::lazy_task<T> dot_simd(pot::executor &exec, const T *a, const T *b, std::size_t n)
+    requires(std::is_arithmetic_v<T>)
+{
+    if constexpr (ST == pot::simd::SIMDType::Auto && details::has_dot_kernels_v<T>)
+    {
+        const auto kernels = details::active_dot_kernels<T>();
+        return details::simd_blocks_reduce(exec, n, kernels.lanes,
+            [=, run = kernels.contiguous](std::size_t begin, std::size_t end) { return run(a, b, begin, end); },
+            std::plus<T>{}, T{0});
+    }
+    else
+        return details::accumulate_reduce_simd<T, T, ST>(exec, details::contiguous_access<T>{a}, details::contiguous_access<T>{b},
+                                                         n, details::fma_accumulate{}, std::plus<T>{}, T{0});
+}
+
+/**
+ * @brief Reproducible SIMD dot product: bit-identical for any executor and SIMD width.
+ *
+ * Uses fixed-size blocks and fixed combine trees (see `pot::algorithms::reproducible`);
+ * `summation::kahan` or `summation::pairwise` additionally reduce the rounding error.
+ *
+ * @copydetails dot_simd(pot::executor&, const T*, const T*, std::size_t)
+ * @param mode Block size and lane summation method.
+ */
+template <typename T, pot::simd::SIMDType ST>
+[[nodiscard]] pot::coroutines::lazy_task<T> dot_simd(pot::executor &exec, const T *a, const T *b, std::size_t n,
+                                                     reproducible mode)
+    requires(std::is_arithmetic_v<T>)
+{
+    if constexpr (ST == pot::simd::SIMDType::Auto && details::has_dot_kernels_v<T>)
+    {
+        return details::reproducible_blocks_reduce(exec, n, mode,
+            [=, run = details::active_dot_kernels<T>().reproducible](std::size_t begin, std::size_t end, summation method)
+            { return run(a, b, begin, end, method); },
+            std::plus<T>{}, T{0});
+    }
+    else
+        return elementwise_reduce_simd<T, T, ST>(exec, a, b, n, details::multiply_lanes{}, std::plus<T>{}, T{0}, mode);
+}
+
+/**
+ * @brief Reproducible SIMD dot product of two spans.
+ * @copydetails dot_simd(pot::executor&, const T*, const T*, std::size_t, reproducible)
+ * @throws std::invalid_argument if the spans have different sizes.
+ */
+template <typename T, pot::simd::SIMDType ST>
+[[nodiscard]] pot::coroutines::lazy_task<T> dot_simd(pot::executor &exec, std::span<const T> a,
+                                                     std::span<const T> b, reproducible mode)
+    requires(std::is_arithmetic_v<T>)
+{
+    if (a.size() != b.size())
+        throw std::invalid_argument("dot_simd: spans must have equal sizes");
+    return dot_simd<T, ST>(exec, a.data(), b.data(), a.size(), mode);
+}
+
+/**
+ * @brief Asynchronously computes the dot product of two arrays using SIMD.
+ *
+ * @tparam T  Element type (must be arithmetic).
+ * @tparam ST SIMD type (pot::simd::SIMDType); `Auto` as in the pointer overload.
  * @param exec Executor for task scheduling.
  * @param a    First input span.
  * @param b    Second input span.
@@ -40,6 +113,23 @@ template <typename T, pot::simd::SIMDType ST>
     return dot_simd<T, ST>(exec, std::span<const T>(a), std::span<const T>(b));
 }
 
+/**
+ * @brief Asynchronously computes the dot product of two arrays without SIMD.
+ *
+ * @tparam T  Element type (must be arithmetic).
+ * @param exec Executor for task scheduling.
+ * @param a    Pointer to the first array.
+ * @param b    Pointer to the second array.
+ * @param n    Number of elements.
+ * @return lazy_task<T> The computed dot product.
+ */
+template <typename T>
+[[nodiscard]] pot::coroutines::lazy_task<T> dot(pot::executor &exec, const T *a, const T *b, std::size_t n)
+    requires(std::is_arithmetic_v<T>)
+{
+    return elementwise_reduce<T, T>(exec, a, b, n, std::multiplies<T>{}, std::plus<T>{}, T{0});
+}
+
 /**
  * @brief Asynchronously computes the dot product of two arrays without SIMD.
  *
@@ -75,4 +165,194 @@ template <typename T>
     return dot<T>(exec, std::span<const T>(a), std::span<const T>(b));
 }
 
+
+/**
+ * @brief Dot product of two strided arrays: sum of a[i * stride_a] * b[i * stride_b].
+ *
+ * Works on matrix columns in place, e.g. `dot_strided(exec, m + c, cols, m + c, cols, rows)` is
+ * the squared norm of column c of a row-major rows x cols matrix.
+ *
+ * @tparam T  Element type (must be arithmetic).
+ * @param exec     Executor for task scheduling.
+ * @param a        Pointer to the first element of the first array.
+ * @param stride_a Distance between consecutive elements of @p a, in elements.
+ * @param b        Pointer to the first element of the second array.
+ * @param stride_b Distance between consecutive elements of @p b, in elements.
+ * @param n        Number of elements.
+ * @return lazy_task<T> The computed dot product.
+ */
+template <typename T>
+[[nodiscard]] pot::coroutines::lazy_task<T> dot_strided(pot::executor &exec, const T *a, std::size_t stride_a,
+                                                        const T *b, std::size_t stride_b, std::size_t n)
+    requires(std::is_arithmetic_v<T>)
+{
+    return elementwise_reduce_strided<T, T>(exec, a, stride_a, b, stride_b, n, std::multiplies<T>{}, std::plus<T>{}, T{0});
+}
+
+/**
+ * @brief SIMD dot product of two strided arrays; lanes are loaded with gather instructions.
+ * @copydetails dot_strided(pot::executor&, const T*, std::size_t, const T*, std::size_t, std::size_t)
+ * @tparam ST SIMD type (pot::simd::SIMDType); `Auto` picks the width at run time for float, double
+ *           and int32_t, and within the calling file's compile flags for other types.
+ */
+template <typename T, pot::simd::SIMDType ST>
+[[nodiscard]] pot::coroutines::lazy_task<T> dot_strided_simd(pot::executor &exec, const T *a, std::size_t stride_a,
+                                                             const T *b, std::size_t stride_b, std::size_t n)
+    requires(std::is_arithmetic_v<T>)
+{
+    if constexpr (ST == pot::simd::SIMDType::Auto && details::has_dot_kernels_v<T>)
+    {
+        const auto kernels = details::active_dot_kernels<T>();
+        return details::simd_blocks_reduce(exec, n, kernels.lanes,
+            [=, run = kernels.strided](std::size_t begin, std::size_t end) { return run(a, stride_a, b, stride_b, begin, end); },
+            std::plus<T>{}, T{0});
+    }
+    else
+        return details::accumulate_reduce_simd<T, T, ST>(exec, details::strided_access<T>{a, stride_a},
+                                                         details::strided_access<T>{b, stride_b}, n, details::fma_accumulate{},
+                                                         std::plus<T>{}, T{0});
+}
+
+/**
+ * @brief Sparse-dense dot product: sum of values[i] * x[idx[i]].
+ *
+ * @tparam T  Element type (must be arithmetic).
+ * @param exec   Executor for task scheduling.
+ * @param values Non-zero values of the sparse vector.
+ * @param x      Dense vector.
+ * @param idx    Positions of the non-zeros in @p x, one per value.
+ * @param n      Number of non-zeros.
+ * @return lazy_task<T> The computed dot product.
+ */
+template <typename T>
+[[nodiscard]] pot::coroutines::lazy_task<T> dot_indexed(pot::executor &exec, const T *values, const T *x,
+                                                        const uint32_t *idx, std::size_t n)
+    requires(std::is_arithmetic_v<T>)
+{
+    return elementwise_reduce_indexed<T, T>(exec, values, x, idx, n, std::multiplies<T>{}, std::plus<T>{}, T{0});
+}
+
+/**
+ * @brief SIMD sparse-dense dot product; @p x is read with gather instructions.
+ * @copydetails dot_indexed(pot::executor&, const T*, const T*, const uint32_t*, std::size_t)
+ * @tparam ST SIMD type (pot::simd::SIMDType); `Auto` as for dot_strided_simd. Every index must be
+ *           below 2^31.
+ */
+template <typename T, pot::simd::SIMDType ST>
+[[nodiscard]] pot::coroutines::lazy_task<T> dot_indexed_simd(pot::executor &exec, const T *values, const T *x,
+                                                             const uint32_t *idx, std::size_t n)
+    requires(std::is_arithmetic_v<T>)
+{
+    if constexpr (ST == pot::simd::SIMDType::Auto && details::has_dot_kernels_v<T>)
+    {
+        const auto kernels = details::active_dot_kernels<T>();
+        return details::simd_blocks_reduce(exec, n, kernels.lanes,
+            [=, run = kernels.indexed](std::size_t begin, std::size_t end) { return run(values, x, idx, begin, end); },
+            std::plus<T>{}, T{0});
+    }
+    else
+        return details::accumulate_reduce_simd<T, T, ST>(exec, details::contiguous_access<T>{values},
+                                                         details::indexed_access<T>{x, idx}, n, details::fma_accumulate{},
+                                                         std::plus<T>{}, T{0});
+}
+
+/**
+ * @brief Mixed-precision dot product: elements are widened to @p Acc before multiplying.
+ *
+ * `dot<float, double>` accumulates float inputs in double, `dot<int8_t, int32_t>` multiplies
+ * bytes exactly in int32, `dot<bfloat16, float>` converts 16-bit floats to float first.
+ *
+ * @tparam In  Input element type (arithmetic, pot::simd::float16 or pot::simd::bfloat16).
+ * @tparam Acc Accumulator and result type.
+ * @param exec Executor for task scheduling.
+ * @param a    Pointer to the first array.
+ * @param b    Pointer to the second array.
+ * @param n    Number of elements.
+ * @return lazy_task<Acc> The computed dot product.
+ */
+template <typename In, typename Acc>
+[[nodiscard]] pot::coroutines::lazy_task<Acc> dot(pot::executor &exec, const In *a, const In *b, std::size_t n)
+    requires(std::is_arithmetic_v<Acc>)
+{
+    return details::transform_reduce_views(
+        exec, n, Acc{0}, std::plus<Acc>{},
+        [](const In &x, const In &y) { return pot::simd::details::widen<Acc>(x) * pot::simd::details::widen<Acc>(y); },
+        std::span<const In>(a, n), std::span<const In>(b, n));
+}
+
+/**
+ * @brief Mixed-precision dot product of two spans.
+ * @copydetails dot(pot::executor&, const In*, const In*, std::size_t)
+ * @throws std::invalid_argument if the spans have different sizes.
+ */
+template <typename In, typename Acc>
+[[nodiscard]] pot::coroutines::lazy_task<Acc> dot(pot::executor &exec, std::span<const In> a,
+                                                  std::span<const In> b)
+    requires(std::is_arithmetic_v<Acc>)
+{
+    if (a.size() != b.size())
+        throw std::invalid_argument("dot: spans must have equal sizes");
+    return dot<In, Acc>(exec, a.data(), b.data(), a.size());
+}
+
+namespace details
+{
+template <typename In, typename Acc, pot::simd::SIMDType ST,
+          pot::simd::details::widen_extension Ext = compiled_widen_extension<In, Acc, ST>()>
+pot::coroutines::lazy_task<Acc> widening_dot_simd(pot::executor &exec, const In *a, const In *b, std::size_t n)
+{
+    return simd_blocks_reduce(exec, n, pot::simd::details::widening_dot_traits<In, Acc, ST, Ext>::step,
+        [=](std::size_t begin, std::size_t end) { return widening_dot_block<In, Acc, ST, Ext>(a, b, begin, end); },
+        std::plus<Acc>{}, Acc{0});
+}
+} // namespace details
+
+/**
+ * @brief Mixed-precision SIMD dot product.
+ *
+ * Supported combinations (see pot::simd::details::widening_dot_traits):
+ * float -> double, int8_t / uint8_t / int16_t -> int32_t (`vpdpbusd` with AVX-512 VNNI,
+ * `pmaddwd` otherwise), bfloat16 / float16 -> float (`vdpbf16ps` with AVX-512 BF16). Other
+ * combinations do not compile. `Auto` uses VNNI and BF16 when the CPU has them; an explicit
+ * width uses them when the caller is built with them.
+ *
+ * @tparam In  Input element type.
+ * @tparam Acc Accumulator and result type.
+ * @tparam ST  SIMD type (pot::simd::SIMDType); `Auto` picks the width at run time.
+ * @param exec Executor for task scheduling.
+ * @param a    Pointer to the first array.
+ * @param b    Pointer to the second array.
+ * @param n    Number of elements.
+ * @return lazy_task<Acc> The computed dot product.
+ */
+template <typename In, typename Acc, pot::simd::SIMDType ST>
+[[nodiscard]] pot::coroutines::lazy_task<Acc> dot_simd(pot::executor &exec, const In *a, const In *b, std::size_t n)
+    requires(!std::is_same_v<In, Acc>)
+{
+    if constexpr (ST == pot::simd::SIMDType::Auto && details::has_widening_dot_kernel_v<In, Acc>)
+    {
+        const auto kernel = details::active_widening_dot_kernel<In, Acc>();
+        return details::simd_blocks_reduce(exec, n, kernel.step,
+            [=, run = kernel.run](std::size_t begin, std::size_t end) { return run(a, b, begin, end); },
+            std::plus<Acc>{}, Acc{0});
+    }
+    else
+        return pot::simd::dispatch<ST>([&]<pot::simd::SIMDType W>() { return details::widening_dot_simd<In, Acc, W>(exec, a, b, n); });
+}
+
+/**
+ * @brief Mixed-precision SIMD dot product of two spans.
+ * @copydetails dot_simd(pot::executor&, const In*, const In*, std::size_t)
+ * @throws std::invalid_argument if the spans have different sizes.
+ */
+template <typename In, typename Acc, pot::simd::SIMDType ST>
+[[nodiscard]] pot::coroutines::lazy_task<Acc> dot_simd(pot::executor &exec, std::span<const In> a,
+                                                       std::span<const In> b)
+    requires(!std::is_same_v<In, Acc>)
+{
+    if (a.size() != b.size())
+        throw std::invalid_argument("dot_simd: spans must have equal sizes");
+    return dot_simd<In, Acc, ST>(exec, a.data(), b.data(), a.size());
+}
+
 } // namespace pot::algorithms
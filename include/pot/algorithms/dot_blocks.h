@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "pot/algorithms/reduce_blocks.h"
+#include "pot/simd/dispatch.h"
+#include "pot/simd/simd_widen.h"
+
+namespace pot::algorithms::details
+{
+// x * y lane by lane, the element op of the reproducible dot product.
+struct multiply_lanes
+{
+    template <typename V>
+    V operator()(const V &x, const V &y) const { return x * y; }
+};
+
+template <typename In, typename Acc, pot::simd::SIMDType ST,
+          pot::simd::details::widen_extension Ext = pot::simd::details::widen_extension::none>
+Acc widening_dot_block(const In *a, const In *b, std::size_t begin, std::size_t end)
+{
+    using kernel = pot::simd::details::widening_dot_traits<In, Acc, ST, Ext>;
+    constexpr std::size_t step = kernel::step;
+
+    // Two independent accumulators hide the latency of the multiply-add chain.
+    auto acc0 = kernel::zero();
+    auto acc1 = kernel::zero();
+
+    std::size_t i = begin;
+    for (; i + 2 * step <= end; i += 2 * step)
+    {
+        acc0 = kernel::madd(acc0, a + i, b + i);
+        acc1 = kernel::madd(acc1, a + i + step, b + i + step);
+    }
+    for (; i + step <= end; i += step)
+        acc0 = kernel::madd(acc0, a + i, b + i);
+
+    if (i < end)
+    {
+        // The kernels read whole steps of raw input, so the tail is padded with zeros, which add
+        // nothing to the products, and runs through the same madd.
+        In tail_a[step] = {};
+        In tail_b[step] = {};
+        std::copy(a + i, a + end, tail_a);
+        std::copy(b + i, b + end, tail_b);
+        acc1 = kernel::madd(acc1, tail_a, tail_b);
+    }
+
+    // Either half of an integer dot may pass the range the whole one fits in; add them wrapping.
+    if constexpr (std::is_integral_v<Acc>)
+        return static_cast<Acc>(static_cast<std::make_unsigned_t<Acc>>(kernel::reduce(acc0)) +
+                                static_cast<std::make_unsigned_t<Acc>>(kernel::reduce(acc1)));
+    else
+        return kernel::reduce(acc0) + kernel::reduce(acc1);
+}
+
+/**
+ * Block kernels of the dot products for one element type, built into the library once per SIMD
+ * width (src/algorithms/simd_kernels_*.cpp). `SIMDType::Auto` runs them at `active_simd_type()`
+ * whatever flags the caller is built with. Each reduces elements [begin, end) of one block;
+ * `lanes` is the register width the blocks are cut to.
+ */
+template <typename T>
+struct dot_kernels
+{
+    std::size_t lanes;
+    T (*contiguous)(const T *a, const T *b, std::size_t begin, std::size_t end);
+    T (*strided)(const T *a, std::size_t stride_a, const T *b, std::size_t stride_b, std::size_t begin, std::size_t end);
+    T (*indexed)(const T *values, const T *x, const uint32_t *idx, std::size_t begin, std::size_t end);
+    T (*reproducible)(const T *a, const T *b, std::size_t begin, std::size_t end, summation method);
+};
+
+template <typename T>
+inline constexpr bool has_dot_kernels_v = std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>;
+
+template <typename T, pot::simd::SIMDType W>
+dot_kernels<T> dot_kernels_at();
+
+template <typename T>
+dot_kernels<T> active_dot_kernels()
+{
+    switch (pot::simd::active_simd_type())
+    {
+    case pot::simd::SIMDType::AVX512: return dot_kernels_at<T, pot::simd::SIMDType::AVX512>();
+    case pot::simd::SIMDType::AVX: return dot_kernels_at<T, pot::simd::SIMDType::AVX>();
+    default: return dot_kernels_at<T, pot::simd::SIMDType::SSE>();
+    }
+}
+
+/// Block kernel of a mixed-precision dot product, built into the library like `dot_kernels`.
+template <typename In, typename Acc>
+struct widening_dot_kernel
+{
+    std::size_t step;
+    Acc (*run)(const In *a, const In *b, std::size_t begin, std::size_t end);
+};
+
+template <typename In, typename Acc>
+inline constexpr bool has_widening_dot_kernel_v =
+    (std::is_same_v<In, float> && std::is_same_v<Acc, double>) ||
+    ((std::is_same_v<In, int8_t> || std::is_same_v<In, uint8_t> || std::is_same_v<In, int16_t>) && std::is_same_v<Acc, int32_t>) ||
+    ((std::is_same_v<In, pot::simd::bfloat16> || std::is_same_v<In, pot::simd::float16>) && std::is_same_v<Acc, float>);
+
+template <typename In, typename Acc, pot::simd::SIMDType W>
+widening_dot_kernel<In, Acc> widening_dot_kernel_at();
+
+// AVX-512 kernels that also use VNNI (8-bit inputs) or BF16 (bfloat16 inputs). select_simd_type
+// does not ask for either extension, so these are built in translation units of their own and
+// picked only when this CPU has the one they use.
+template <typename In, typename Acc>
+inline constexpr bool has_avx512_vnni_kernel_v = (std::is_same_v<In, int8_t> || std::is_same_v<In, uint8_t>) && std::is_same_v<Acc, int32_t>;
+
+template <typename In, typename Acc>
+inline constexpr bool has_avx512_bf16_kernel_v = std::is_same_v<In, pot::simd::bfloat16> && std::is_same_v<Acc, float>;
+
+/// Extension a widening kernel of width `W` can use with the flags of this translation unit.
+template <typename In, typename Acc, pot::simd::SIMDType W>
+consteval pot::simd::details::widen_extension compiled_widen_extension()
+{
+    using pot::simd::details::widen_extension;
+    constexpr pot::simd::cpu_features compiled = pot::simd::details::compiled_features();
+    if (W == pot::simd::SIMDType::AVX512 && has_avx512_vnni_kernel_v<In, Acc> && compiled.avx512vnni)
+        return widen_extension::avx512_vnni;
+    if (W == pot::simd::SIMDType::AVX512 && has_avx512_bf16_kernel_v<In, Acc> && compiled.avx512bf16)
+        return widen_extension::avx512_bf16;
+    if (W != pot::simd::SIMDType::AVX512 && std::is_same_v<In, pot::simd::float16> && compiled.f16c)
+        return widen_extension::f16c;
+    return widen_extension::none;
+}
+
+template <typename In, typename Acc>
+widening_dot_kernel<In, Acc> widening_dot_kernel_avx512_vnni();
+
+template <typename In, typename Acc>
+widening_dot_kernel<In, Acc> widening_dot_kernel_avx512_bf16();
+
+template <typename In, typename Acc>
+widening_dot_kernel<In, Acc> active_widening_dot_kernel()
+{
+    switch (pot::simd::active_simd_type())
+    {
+    case pot::simd::SIMDType::AVX512:
+        if constexpr (has_avx512_vnni_kernel_v<In, Acc>)
+        {
+            if (pot::simd::cpu_features::system().avx512vnni)
+                return widening_dot_kernel_avx512_vnni<In, Acc>();
+        }
+        if constexpr (has_avx512_bf16_kernel_v<In, Acc>)
+        {
+            if (pot::simd::cpu_features::system().avx512bf16)
+                return widening_dot_kernel_avx512_bf16<In, Acc>();
+        }
+        return widening_dot_kernel_at<In, Acc, pot::simd::SIMDType::AVX512>();
+    case pot::simd::SIMDType::AVX: return widening_dot_kernel_at<In, Acc, pot::simd::SIMDType::AVX>();
+    default: return widening_dot_kernel_at<In, Acc, pot::simd::SIMDType::SSE>();
+    }
+}
+} // namespace pot::algorithms::details
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "pot/algorithms/scan.h"
+#include "pot/simd/dispatch.h"
+#include "pot/simd/simd_forced.h"
+
+namespace pot::algorithms::details
+{
+    template <typename T, typename Pred>
+    std::size_t count_block(const T *in, std::size_t begin, std::size_t end, Pred &pred)
+    {
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; ++i)
+            if (std::invoke(pred, in[i]))
+                ++count;
+        return count;
+    }
+
+    template <typename T, typename Pred>
+    std::size_t filter_block(const T *in, T *out, std::size_t begin, std::size_t end, Pred &pred, std::size_t offset)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            if (std::invoke(pred, in[i]))
+                out[offset++] = in[i];
+        return offset;
+    }
+
+    template <typename T, pot::simd::SIMDType ST, typename SimdPred>
+    std::size_t count_block_simd(const T *in, std::size_t begin, std::size_t end, SimdPred &simd_pred)
+    {
+        using simd_t = pot::simd::simd_forced<T, ST>;
+        using mask_t = typename simd_t::mask;
+
+        std::size_t count = 0;
+        std::size_t i = begin;
+        for (; i + simd_t::lanes <= end; i += simd_t::lanes)
+        {
+            simd_t v; v.loadu(in + i);
+            count += simd_pred(v).popcount();
+        }
+        if (i < end)
+        {
+            // The zero-filled lanes past `end` may match, so the mask is cut to the loaded ones.
+            simd_t v; v.loadu(in + i, end - i);
+            count += (simd_pred(v) & mask_t::first(end - i)).popcount();
+        }
+        return count;
+    }
+
+    template <typename T, pot::simd::SIMDType ST, typename SimdPred>
+    std::size_t filter_block_simd(const T *in, T *out, std::size_t begin, std::size_t end, SimdPred &simd_pred,
+                                  std::size_t offset)
+    {
+        using simd_t = pot::simd::simd_forced<T, ST>;
+        using mask_t = typename simd_t::mask;
+
+        std::size_t i = begin;
+        for (; i + simd_t::lanes <= end; i += simd_t::lanes)
+        {
+            simd_t v; v.loadu(in + i);
+            offset += v.compress_store(out + offset, simd_pred(v));
+        }
+        if (i < end)
+        {
+            simd_t v; v.loadu(in + i, end - i);
+            offset += v.compress_store(out + offset, simd_pred(v) & mask_t::first(end - i));
+        }
+        return offset;
+    }
+
+    /**
+     * Stream compaction is an exclusive scan of the match counts: the first pass counts the matches
+     * of every block, the serial scan turns the counts into output offsets, and the second pass
+     * writes every block's matches from its offset on.
+     */
+    template <typename CountBlock, typename FilterBlock>
+    pot::coroutines::lazy_task<std::size_t> filter_two_pass(pot::executor &exec, std::size_t n, CountBlock count_block,
+                                                            FilterBlock filter_block, std::size_t granule = 1)
+    {
+        return scan_two_pass<std::size_t>(exec, n, std::plus<std::size_t>{}, std::size_t(0), count_block, filter_block,
+                                          granule);
+    }
+} // namespace pot::algorithms::details
+
+namespace pot::algorithms
+{
+    /**
+     * @brief Asynchronously copies the elements that satisfy @p pred to @p out, keeping their order.
+     *
+     * Two passes over the input, like inclusive_scan: the blocks count their matches in parallel,
+     * the counts are scanned into output offsets, and the blocks write their matches in parallel.
+     * @p pred is therefore called twice per element and must not have side effects.
+     *
+     * @tparam T     Element type.
+     * @tparam Pred  Callable: (T) -> bool.
+     *
+     * @param exec Executor for task scheduling.
+     * @param in   Pointer to the input array.
+     * @param out  Pointer to the output array, with room for @p n elements; must not overlap @p in.
+     * @param n    Number of input elements.
+     * @param pred Predicate selecting the elements to keep.
+     *
+     * @return lazy_task<std::size_t> The number of elements written to @p out.
+     */
+    template <typename T, typename Pred>
+    [[nodiscard]] pot::coroutines::lazy_task<std::size_t>
+    filter(pot::executor &exec, const T *in, T *out, std::size_t n, Pred pred)
+    {
+        return details::filter_two_pass(exec, n,
+            [=](std::size_t begin, std::size_t end) mutable { return details::count_block(in, begin, end, pred); },
+            [=](std::size_t begin, std::size_t end, std::size_t offset) mutable
+            {
+                return details::filter_block(in, out, begin, end, pred, offset);
+            });
+    }
+
+    /**
+     * @brief Convenience overload of filter for std::span.
+     * @copydetails filter(pot::executor&, const T*, T*, std::size_t, Pred)
+     * @throws std::invalid_argument if @p out is shorter than @p in.
+     */
+    template <typename T, typename Pred>
+    [[nodiscard]] pot::coroutines::lazy_task<std::size_t>
+    filter(pot::executor &exec, std::span<const T> in, std::span<T> out, Pred pred)
+    {
+        if (out.size() < in.size())
+            throw std::invalid_argument("filter: output span is shorter than the input");
+        return filter<T>(exec, in.data(), out.data(), in.size(), pred);
+    }
+
+    /**
+     * @brief Asynchronously copies the elements that satisfy @p simd_pred to @p out, a register at a time.
+     *
+     * Same algorithm as filter. @p simd_pred compares a whole register and returns its lane mask
+     * (`simd_forced::mask`, e.g. `v > simd_t(0)`); the first pass sums the mask popcounts, the second
+     * packs the matching lanes with `simd_forced::compress_store` (vpcompress on AVX-512, a shuffle
+     * table on AVX2 and SSE). The last partial register is loaded masked and its mask cut to the
+     * loaded lanes, so there is no scalar tail.
+     *
+     * @tparam T         Element type (any simdable type).
+     * @tparam ST        SIMD type (pot::simd::SIMDType). `Auto` runs at the widest width both the CPU
+     *                   and the calling file's compile flags support, so a file built at the SSE 4.2
+     *                   baseline filters at SSE; give it the AVX2 or AVX-512 flags of
+     *                   cmake/CompilerFlags.cmake to go wider. With `Auto`, @p simd_pred must be
+     *                   generic (an `auto` parameter).
+     * @tparam SimdPred  Callable: (simd_forced<T, ST>) -> simd_forced<T, ST>::mask.
+     *
+     * @param exec      Executor for task scheduling.
+     * @param in        Pointer to the input array.
+     * @param out       Pointer to the output array, with room for @p n elements; must not overlap @p in.
+     * @param n         Number of input elements.
+     * @param simd_pred Predicate applied to SIMD registers.
+     *
+     * @return lazy_task<std::size_t> The number of elements written to @p out.
+     */
+    template <typename T, pot::simd::SIMDType ST, typename SimdPred>
+    [[nodiscard]] pot::coroutines::lazy_task<std::size_t>
+    filter_simd(pot::executor &exec, const T *in, T *out, std::size_t n, SimdPred simd_pred)
+        requires(std::is_arithmetic_v<T>)
+    {
+        return pot::simd::dispatch<ST>([&]<pot::simd::SIMDType W>()
+        {
+            return details::filter_two_pass(exec, n,
+                [=](std::size_t begin, std::size_t end) mutable
+                {
+                    return details::count_block_simd<T, W>(in, begin, end, simd_pred);
+                },
+                [=](std::size_t begin, std::size_t end, std::size_t offset) mutable
+                {
+                    return details::filter_block_simd<T, W>(in, out, begin, end, simd_pred, offset);
+                },
+                pot::simd::details::simd_traits<T, W>::scalar_count);
+        });
+    }
+
+    /**
+     * @brief Convenience overload of filter_simd for std::span.
+     * @copydetails filter_simd(pot::executor&, const T*, T*, std::size_t, SimdPred)
+     * @throws std::invalid_argument if @p out is shorter than @p in.
+     */
+    template <typename T, pot::simd::SIMDType ST, typename SimdPred>
+    [[nodiscard]] pot::coroutines::lazy_task<std::size_t>
+    filter_simd(pot::executor &exec, std::span<const T> in, std::span<T> out, SimdPred simd_pred)
+        requires(std::is_arithmetic_v<T>)
+    {
+        if (out.size() < in.size())
+            throw std::invalid_argument("filter_simd: output span is shorter than the input");
+        return filter_simd<T, ST>(exec, in.data(), out.data(), in.size(), simd_pred);
+    }
+} // namespace pot::algorithms
@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <optional>
+#include <utility>
 
 namespace pot::algorithms
 {
@@ -22,6 +23,7 @@ public:
     ~lfdequeue();
 
     void push(const T &item);
+    void push(T &&item);
     [[nodiscard]] std::optional<T> pop();
 
     [[nodiscard]] stealer_token *register_stealer();
@@ -40,6 +42,7 @@ private:
 
         long size() const;
         T get(long i) const;
+        T take(long i);
         void put(long i, T item);
         ring_buffer *resize(long b, long t, int delta);
     };
@@ -82,10 +85,16 @@ T pot::algorithms::lfdequeue<T>::ring_buffer::get(long i) const
     return segment[i % size()];
 }
 
+template <typename T>
+T pot::algorithms::lfdequeue<T>::ring_buffer::take(long i)
+{
+    return std::move(segment[i % size()]);
+}
+
 template <typename T>
 void pot::algorithms::lfdequeue<T>::ring_buffer::put(long i, T item)
 {
-    segment[i % size()] = item;
+    segment[i % size()] = std::move(item);
 }
 
 template <typename T>
@@ -131,6 +140,12 @@ pot::algorithms::lfdequeue<T>::~lfdequeue()
 
 template <typename T>
 void pot::algorithms::lfdequeue<T>::push(const T &item)
+{
+    push(T(item));
+}
+
+template <typename T>
+void pot::algorithms::lfdequeue<T>::push(T &&item)
 {
     auto b = bottom.load(std::memory_order_relaxed);
     auto t = top.load(std::memory_order_acquire);
@@ -149,7 +164,7 @@ void pot::algorithms::lfdequeue<T>::push(const T &item)
         reclaim_buffers(a);
     }
 
-    a->put(b, item);
+    a->put(b, std::move(item));
     std::atomic_thread_fence(std::memory_order_release);
     bottom.store(b + 1, std::memory_order_relaxed);
 }
@@ -175,13 +190,13 @@ std::optional<T> pot::algorithms::lfdequeue<T>::pop()
     {
         if (top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
         {
-            popped = a->get(t);
+            popped = a->take(t);
         }
         bottom.store(b, std::memory_order_relaxed);
     }
     else
     {
-        popped = a->get(b - 1);
+        popped = a->take(b - 1);
 
         if (current_size <= a->size() / 3 && current_size > (1 << log_initial_size))
         {
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <utility>
 
 namespace pot::algorithms
 {
@@ -16,8 +19,12 @@ template <typename T> class lfqueue
 
     [[nodiscard]] std::optional<T> pop() noexcept;
     [[nodiscard]] bool push(const T &msg) noexcept;
+    [[nodiscard]] bool push(T &&msg) noexcept;
+    [[nodiscard]] size_t push_bulk(T *items, size_t count) noexcept;
 
   private:
+    template <typename U> bool push_impl(U &&msg) noexcept;
+
     struct cell_t
     {
         std::atomic<size_t> sequence;
@@ -49,6 +56,17 @@ template <typename T> lfqueue<T>::lfqueue()
 template <typename T> lfqueue<T>::~lfqueue() { delete[] buffer; }
 
 template <typename T> bool lfqueue<T>::push(const T &msg) noexcept
+{
+    return push_impl(msg);
+}
+
+// The item is only moved from when the push succeeds, so callers may retry with the same object.
+template <typename T> bool lfqueue<T>::push(T &&msg) noexcept
+{
+    return push_impl(std::move(msg));
+}
+
+template <typename T> template <typename U> bool lfqueue<T>::push_impl(U &&msg) noexcept
 {
     cell_t *cell;
     size_t pos = enqueuePos.load(std::memory_order_relaxed);
@@ -63,7 +81,7 @@ template <typename T> bool lfqueue<T>::push(const T &msg) noexcept
         {
             if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
             {
-                cell->data = msg;
+                cell->data = std::forward<U>(msg);
 
                 cell->sequence.store(pos + 1, std::memory_order_release);
                 return true;
@@ -80,6 +98,45 @@ template <typename T> bool lfqueue<T>::push(const T &msg) noexcept
     }
 }
 
+// Claims a run of consecutive free cells with a single CAS and moves up to `count` items into them.
+// Returns how many were pushed: a prefix of `items`, possibly fewer than `count` if the queue is
+// nearly full, and 0 only when it is full.
+template <typename T> size_t lfqueue<T>::push_bulk(T *items, size_t count) noexcept
+{
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+
+    while (count > 0)
+    {
+        size_t free = 0;
+        while (free < count && free < capacity &&
+               buffer[(pos + free) & mask].sequence.load(std::memory_order_acquire) == pos + free)
+            ++free;
+
+        if (free == 0)
+        {
+            size_t seq = buffer[pos & mask].sequence.load(std::memory_order_acquire);
+            if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos) < 0)
+                return 0;
+            pos = enqueuePos.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // A free cell can only be taken by a producer that moves enqueuePos past it, so if the CAS
+        // succeeds, all cells counted above are still ours.
+        if (enqueuePos.compare_exchange_weak(pos, pos + free, std::memory_order_relaxed))
+        {
+            for (size_t i = 0; i < free; ++i)
+            {
+                cell_t *cell = &buffer[(pos + i) & mask];
+                cell->data = std::move(items[i]);
+                cell->sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            return free;
+        }
+    }
+    return 0;
+}
+
 template <typename T> std::optional<T> lfqueue<T>::pop() noexcept
 {
     cell_t *cell;
@@ -1,12 +1,375 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <memory>
+#include <numeric>
+#include <ranges>
+#include <span>
 #include <vector>
 
 #include "pot/coroutines/when_all.h"
 #include "pot/executors/executor.h"
+#include "pot/utils/cache_line.h"
+#include "pot/utils/this_thread.h"
+
+namespace pot::algorithms
+{
+/**
+ * @brief How `parfor` hands iterations to workers, after OpenMP's `schedule` clause.
+ *
+ * - `static_chunks`: the range is cut into equal chunks up front, one task per chunk. Cheapest
+ *   when every iteration costs the same.
+ * - `dynamic`: one task per worker; workers grab the next `chunk_size` iterations from a shared
+ *   atomic counter until the range is exhausted, so a slow iteration only delays its own worker.
+ * - `guided`: like `dynamic`, but each grab takes `remaining / workers` iterations (at least
+ *   `chunk_size`), so chunks start large and shrink towards the end of the loop.
+ * - `automatic`: runs the first part of the range dynamically, measures how uneven the chunks were
+ *   and finishes the loop with `static_chunks`, `guided` or `dynamic` accordingly.
+ * - `lazy_split`: divide and conquer. Each task works through its range `chunk_size` iterations at
+ *   a time and splits off the upper half of what is left only while some worker of the executor
+ *   is idle, so tasks are created on demand. A `parfor` nested in a worker of the same executor
+ *   starts on the calling worker and stays inline while the pool is busy.
+ *
+ * A `chunk_size` of 0 lets `parfor` pick one from the iteration and thread counts.
+ */
+struct schedule
+{
+    enum class kind
+    {
+        static_chunks,
+        dynamic,
+        guided,
+        automatic,
+        lazy_split
+    };
+
+    kind type = kind::static_chunks;
+    int64_t chunk_size = 0;
+
+    static constexpr schedule static_chunks(int64_t chunk = 0) noexcept { return {kind::static_chunks, chunk}; }
+    static constexpr schedule dynamic(int64_t chunk = 0) noexcept { return {kind::dynamic, chunk}; }
+    static constexpr schedule guided(int64_t min_chunk = 0) noexcept { return {kind::guided, min_chunk}; }
+    static constexpr schedule automatic() noexcept { return {kind::automatic, 0}; }
+    static constexpr schedule lazy_split(int64_t grain = 0) noexcept { return {kind::lazy_split, grain}; }
+};
+} // namespace pot::algorithms
+
+namespace pot::algorithms::details
+{
+template <typename FuncType, typename IndexType>
+inline constexpr bool parfor_body_is_async_v =
+    pot::traits::is_task_v<std::invoke_result_t<FuncType &, IndexType>> ||
+    pot::traits::is_lazy_task_v<std::invoke_result_t<FuncType &, IndexType>>;
+
+/// One parfor chunk: runs `func` over [begin, end) on whichever worker resumes it.
+template <typename IndexType, typename FuncType>
+pot::coroutines::lazy_task<void> parfor_chunk(FuncType func, IndexType begin, IndexType end)
+{
+    for (IndexType i = begin; i < end; ++i)
+    {
+        if constexpr (parfor_body_is_async_v<FuncType, IndexType>)
+        {
+            co_await std::invoke(func, i);
+        }
+        else
+        {
+            std::invoke(func, i);
+        }
+    }
+    co_return;
+}
+
+template <typename IndexType, typename FuncType>
+pot::coroutines::lazy_task<void> parfor_static(pot::executor &executor, IndexType from, IndexType to,
+                                               int64_t chunk_size, FuncType func)
+{
+    const int64_t numIterations = static_cast<int64_t>(to - from);
+
+    if (chunk_size <= 0)
+        chunk_size =
+            std::max<int64_t>(1ull, numIterations / static_cast<int64_t>(executor.thread_count()));
+
+    const int64_t numChunks = (numIterations + chunk_size - 1) / chunk_size;
+
+    std::vector<pot::coroutines::lazy_task<void>> chunks;
+    chunks.reserve(static_cast<size_t>(numChunks));
+
+    for (int64_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+    {
+        const IndexType chunkStart = from + static_cast<IndexType>(chunkIndex * chunk_size);
+        const IndexType chunkEnd =
+            std::min<IndexType>(chunkStart + static_cast<IndexType>(chunk_size), to);
+
+        chunks.push_back(details::parfor_chunk<IndexType>(func, chunkStart, chunkEnd));
+    }
+
+    co_await pot::coroutines::when_all_on(executor, chunks);
+    co_return;
+}
+
+/// Iteration counter shared by the workers of a dynamic or guided loop; offsets are relative to `from`.
+struct parfor_shared_range
+{
+    alignas(pot::cache_line_alignment) std::atomic<int64_t> next{0};
+    int64_t end = 0;
+    int64_t chunk_size = 1;
+    int64_t workers = 1;
+    bool guided = false;
+
+    /// Claim the next block of iterations; returns false once the range is exhausted.
+    bool claim(int64_t &begin, int64_t &stop) noexcept
+    {
+        if (!guided)
+        {
+            begin = next.fetch_add(chunk_size, std::memory_order_relaxed);
+            if (begin >= end)
+                return false;
+            stop = std::min(begin + chunk_size, end);
+            return true;
+        }
+
+        begin = next.load(std::memory_order_relaxed);
+        while (begin < end)
+        {
+            const int64_t remaining = end - begin;
+            const int64_t size = std::max(chunk_size, (remaining + workers - 1) / workers);
+            if (next.compare_exchange_weak(begin, begin + size, std::memory_order_relaxed))
+            {
+                stop = std::min(begin + size, end);
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/// Pulls blocks from `range` until it runs dry. With `timings`, stores the nanoseconds per
+/// iteration of block `k` (dynamic blocks only) in `timings[k]`.
+template <typename IndexType, typename FuncType>
+pot::coroutines::lazy_task<void> parfor_worker(parfor_shared_range &range, IndexType from, FuncType func,
+                                               std::vector<int64_t> *timings)
+{
+    int64_t begin = 0;
+    int64_t stop = 0;
+    while (range.claim(begin, stop))
+    {
+        const auto started = timings ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+        for (int64_t offset = begin; offset < stop; ++offset)
+        {
+            const IndexType i = from + static_cast<IndexType>(offset);
+            if constexpr (parfor_body_is_async_v<FuncType, IndexType>)
+            {
+                co_await std::invoke(func, i);
+            }
+            else
+            {
+                std::invoke(func, i);
+            }
+        }
+
+        if (timings)
+        {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - started);
+            (*timings)[static_cast<size_t>(begin / range.chunk_size)] = elapsed.count() / (stop - begin);
+        }
+    }
+    co_return;
+}
+
+/// Runs offsets [begin, end) of the loop with one self-scheduling worker task per thread.
+template <typename IndexType, typename FuncType>
+pot::coroutines::lazy_task<void> parfor_self_scheduled(pot::executor &executor, IndexType from, int64_t begin,
+                                                       int64_t end, int64_t chunk_size, bool guided,
+                                                       FuncType func, std::vector<int64_t> *timings = nullptr)
+{
+    const int64_t numIterations = end - begin;
+    const int64_t threads = static_cast<int64_t>(std::max<size_t>(1, executor.thread_count()));
+
+    if (chunk_size <= 0)
+        chunk_size = guided ? 1 : std::max<int64_t>(1, numIterations / (threads * 16));
+
+    parfor_shared_range range;
+    range.next.store(begin, std::memory_order_relaxed);
+    range.end = end;
+    range.chunk_size = chunk_size;
+    range.workers = threads;
+    range.guided = guided;
+
+    const int64_t workers = std::min(threads, (numIterations + chunk_size - 1) / chunk_size);
+
+    std::vector<pot::coroutines::lazy_task<void>> tasks;
+    tasks.reserve(static_cast<size_t>(workers));
+    for (int64_t w = 0; w < workers; ++w)
+        tasks.push_back(details::parfor_worker<IndexType>(range, from, func, timings));
+
+    co_await pot::coroutines::when_all_on(executor, tasks);
+    co_return;
+}
+
+/**
+ * Pick the schedule for the rest of a loop from per-iteration timings of its first chunks:
+ * even timings keep the cheap static split, a moderate spread switches to guided and a
+ * large one to fine-grained dynamic.
+ */
+inline schedule::kind choose_schedule(const std::vector<int64_t> &timings) noexcept
+{
+    int64_t max = 0;
+    int64_t sum = 0;
+    int64_t count = 0;
+    for (int64_t t : timings)
+    {
+        if (t < 0)
+            continue;
+        max = std::max(max, t);
+        sum += t;
+        ++count;
+    }
+    if (count < 2 || sum == 0)
+        return schedule::kind::static_chunks;
+
+    const double imbalance = static_cast<double>(max) * static_cast<double>(count) / static_cast<double>(sum);
+    if (imbalance < 1.5)
+        return schedule::kind::static_chunks;
+    if (imbalance < 4.0)
+        return schedule::kind::guided;
+    return schedule::kind::dynamic;
+}
+
+template <typename IndexType, typename FuncType>
+pot::coroutines::lazy_task<void> parfor_auto(pot::executor &executor, IndexType from, IndexType to,
+                                             FuncType func)
+{
+    const int64_t numIterations = static_cast<int64_t>(to - from);
+    const int64_t threads = static_cast<int64_t>(std::max<size_t>(1, executor.thread_count()));
+
+    // Probe roughly the first 1/16 of the range in small dynamic chunks, four per thread.
+    const int64_t probe_chunk = std::max<int64_t>(1, numIterations / (threads * 64));
+    const int64_t probe_chunks = std::min((numIterations + probe_chunk - 1) / probe_chunk, threads * 4);
+    const int64_t probe_end = std::min(numIterations, probe_chunks * probe_chunk);
+
+    std::vector<int64_t> timings(static_cast<size_t>(probe_chunks), -1);
+    co_await details::parfor_self_scheduled<IndexType>(executor, from, 0, probe_end, probe_chunk, false, func,
+                                                       &timings);
+
+    if (probe_end == numIterations)
+        co_return;
+
+    const IndexType rest = from + static_cast<IndexType>(probe_end);
+    switch (choose_schedule(timings))
+    {
+    case schedule::kind::static_chunks:
+        co_await details::parfor_static<IndexType>(executor, rest, to, 0, std::move(func));
+        break;
+    case schedule::kind::guided:
+        co_await details::parfor_self_scheduled<IndexType>(executor, from, probe_end, numIterations, probe_chunk,
+                                                           true, std::move(func));
+        break;
+    default:
+        co_await details::parfor_self_scheduled<IndexType>(executor, from, probe_end, numIterations, probe_chunk,
+                                                           false, std::move(func));
+        break;
+    }
+    co_return;
+}
+
+/// Lazy binary splitting over [begin, end): see `schedule::lazy_split`.
+template <typename IndexType, typename FuncType>
+pot::coroutines::lazy_task<void> parfor_split_range(pot::executor &executor, IndexType begin, IndexType end,
+                                                    int64_t grain, FuncType func)
+{
+    std::vector<pot::coroutines::task<void>> spawned;
+    std::exception_ptr error;
+
+    try
+    {
+        while (begin < end)
+        {
+            const int64_t remaining = static_cast<int64_t>(end - begin);
+            if (remaining > grain && executor.idle_thread_count() > 0)
+            {
+                const IndexType mid = begin + static_cast<IndexType>(remaining / 2);
+                spawned.push_back(executor.run(
+                    [&executor, mid, end, grain, func]
+                    { return details::parfor_split_range<IndexType>(executor, mid, end, grain, func); }));
+                end = mid;
+                continue;
+            }
+
+            const IndexType stop = begin + static_cast<IndexType>(std::min(remaining, grain));
+            for (IndexType i = begin; i < stop; ++i)
+            {
+                if constexpr (parfor_body_is_async_v<FuncType, IndexType>)
+                {
+                    co_await std::invoke(func, i);
+                }
+                else
+                {
+                    std::invoke(func, i);
+                }
+            }
+            begin = stop;
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    // Wait for the halves handed out even if our own part failed, so none outlives the loop.
+    if (!spawned.empty())
+        co_await pot::coroutines::when_all(spawned);
+    if (error)
+        std::rethrow_exception(error);
+    co_return;
+}
+
+template <typename IndexType, typename FuncType>
+pot::coroutines::lazy_task<void> parfor_lazy_split(pot::executor &executor, IndexType from, IndexType to,
+                                                   int64_t grain, FuncType func)
+{
+    const int64_t numIterations = static_cast<int64_t>(to - from);
+    const int64_t threads = static_cast<int64_t>(std::max<size_t>(1, executor.thread_count()));
+
+    if (grain <= 0)
+        grain = std::max<int64_t>(1, numIterations / (threads * 64));
+
+    // Nested loop: start on this worker and only split when somebody is idle.
+    if (pot::details::this_thread::tl_owner_executor == &executor)
+    {
+        co_await details::parfor_split_range<IndexType>(executor, from, to, grain, std::move(func));
+        co_return;
+    }
+
+    // Outside caller: one piece per worker so every thread starts at once; pieces split further
+    // whenever a worker runs dry.
+    const int64_t pieces = std::min(threads, (numIterations + grain - 1) / grain);
+    const int64_t piece_size = (numIterations + pieces - 1) / pieces;
+
+    std::vector<pot::coroutines::lazy_task<void>> ranges;
+    ranges.reserve(static_cast<size_t>(pieces));
+    for (int64_t p = 0; p < pieces; ++p)
+    {
+        const IndexType begin = from + static_cast<IndexType>(p * piece_size);
+        const IndexType end = std::min<IndexType>(begin + static_cast<IndexType>(piece_size), to);
+        if (begin < end)
+            ranges.push_back(details::parfor_split_range<IndexType>(executor, begin, end, grain, func));
+    }
+
+    co_await pot::coroutines::when_all_on(executor, ranges);
+    co_return;
+}
+
+inline pot::coroutines::lazy_task<void> parfor_nothing() { co_return; }
+} // namespace pot::algorithms::details
 
 namespace pot::algorithms
 {
@@ -14,7 +377,9 @@ namespace pot::algorithms
  * @brief Asynchronously executes a parallel for-loop using the given executor.
  *
  * The iteration space [from, to) is divided into chunks, which are then
- * scheduled across the executor's threads. Each iteration calls the provided
+ * scheduled across the executor's threads in one bulk submission
+ * (`when_all_on`), so the pool is signalled once per loop instead of once
+ * per chunk. Each iteration calls the provided
  * function object @p func, which may return either:
  *   - `void` (synchronous execution), or
  *   - a coroutine (`task<void>` or `lazy_task<void>`) to be awaited.
@@ -41,45 +406,124 @@ pot::coroutines::lazy_task<void> parfor(pot::executor &executor, IndexType from,
 {
     assert(from < to);
 
+    return details::parfor_static<IndexType>(executor, from, to, static_chunk_size, std::move(func));
+}
+
+/**
+ * @brief Parallel for-loop with an explicit scheduling policy.
+ *
+ * Same contract as the overload above; @p sched selects how iterations are distributed (see
+ * `pot::algorithms::schedule`). Use `schedule::dynamic()` or `schedule::guided()` when iteration
+ * costs vary widely, e.g. rows of a fractal or triangular loops.
+ *
+ * @param sched Scheduling policy; `schedule::static_chunks()` behaves like the overload above.
+ */
+template <typename IndexType, typename FuncType>
+    requires std::invocable<FuncType &, IndexType>
+pot::coroutines::lazy_task<void> parfor(pot::executor &executor, IndexType from, IndexType to, schedule sched,
+                                        FuncType func)
+{
+    assert(from < to);
+
     const int64_t numIterations = static_cast<int64_t>(to - from);
 
-    int64_t chunk_size = static_chunk_size;
-    if (chunk_size < 0)
-        chunk_size =
-            std::max<int64_t>(1ull, numIterations / static_cast<int64_t>(executor.thread_count()));
+    switch (sched.type)
+    {
+    case schedule::kind::dynamic:
+        return details::parfor_self_scheduled<IndexType>(executor, from, 0, numIterations, sched.chunk_size, false,
+                                                         std::move(func));
+    case schedule::kind::guided:
+        return details::parfor_self_scheduled<IndexType>(executor, from, 0, numIterations, sched.chunk_size, true,
+                                                         std::move(func));
+    case schedule::kind::automatic:
+        return details::parfor_auto<IndexType>(executor, from, to, std::move(func));
+    case schedule::kind::lazy_split:
+        return details::parfor_lazy_split<IndexType>(executor, from, to, sched.chunk_size, std::move(func));
+    case schedule::kind::static_chunks:
+        break;
+    }
+    return details::parfor_static<IndexType>(executor, from, to, sched.chunk_size, std::move(func));
+}
 
-    const int64_t numChunks = (numIterations + chunk_size - 1) / chunk_size;
+/**
+ * @brief Parallel loop whose body receives a whole block `[b, e)` instead of single indices.
+ *
+ * The body owns the inner loop, so a tight loop over plain indices can be auto-vectorized or
+ * written with `simd_forced`, and no per-index call goes through the coroutine machinery. Blocks
+ * are distributed according to @p sched: with `chunk_size > 0` every block has that many
+ * iterations (the last one may be shorter); otherwise there is one block per thread for
+ * `static_chunks` and eight per thread for the self-balancing schedules.
+ *
+ * @param func Callable `func(IndexType b, IndexType e)`; may return `task<void>` / `lazy_task<void>`.
+ *
+ * @return lazy_task<void> that completes once all blocks have run. An empty range completes at once.
+ */
+template <typename IndexType, typename FuncType>
+    requires std::integral<IndexType> && std::invocable<FuncType &, IndexType, IndexType>
+pot::coroutines::lazy_task<void> parfor_range(pot::executor &executor, IndexType from, IndexType to, schedule sched,
+                                              FuncType func)
+{
+    if (!(from < to))
+        return details::parfor_nothing();
 
-    std::vector<pot::coroutines::task<void>> tasks;
-    tasks.reserve(static_cast<size_t>(numChunks));
+    const int64_t numIterations = static_cast<int64_t>(to - from);
+    const int64_t threads = static_cast<int64_t>(std::max<size_t>(1, executor.thread_count()));
+    const int64_t blocks_per_thread = sched.type == schedule::kind::static_chunks ? 1 : 8;
 
-    for (int64_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
-    {
-        const IndexType chunkStart = from + static_cast<IndexType>(chunkIndex * chunk_size);
-        const IndexType chunkEnd =
-            std::min<IndexType>(chunkStart + static_cast<IndexType>(chunk_size), to);
+    const int64_t block = sched.chunk_size > 0 ? sched.chunk_size
+                                               : std::max<int64_t>(1, numIterations / (threads * blocks_per_thread));
+    const int64_t numBlocks = (numIterations + block - 1) / block;
 
-        tasks.emplace_back(executor.run(
-            [=]() mutable -> pot::coroutines::task<void>
-            {
-                for (IndexType i = chunkStart; i < chunkEnd; ++i)
-                {
-                    using Ret = std::invoke_result_t<decltype(func) &, IndexType>;
-                    if constexpr (pot::traits::is_task_v<Ret> || pot::traits::is_lazy_task_v<Ret>)
-                    {
-                        co_await std::invoke(func, i);
-                    }
-                    else
-                    {
-                        std::invoke(func, i);
-                    }
-                }
-                co_return;
-            }));
-    }
+    // Blocks are the iterations of the underlying loop; each task then takes whole blocks.
+    const schedule block_schedule{sched.type, sched.type == schedule::kind::static_chunks ? 0 : 1};
 
-    co_await pot::coroutines::when_all(tasks);
-    // for (auto && t : tasks) std::move(t).get(); // temp
-    co_return;
+    return pot::algorithms::parfor(executor, int64_t{0}, numBlocks, block_schedule,
+                                   [from, to, block, func](int64_t b) mutable
+                                   {
+                                       const IndexType begin = from + static_cast<IndexType>(b * block);
+                                       const IndexType end = std::min<IndexType>(begin + static_cast<IndexType>(block), to);
+                                       return std::invoke(func, begin, end);
+                                   });
+}
+
+/**
+ * @brief Block-body parallel loop with one contiguous block per thread.
+ * @copydetails parfor_range(pot::executor&, IndexType, IndexType, schedule, FuncType)
+ */
+template <typename IndexType, typename FuncType>
+    requires std::integral<IndexType> && std::invocable<FuncType &, IndexType, IndexType>
+pot::coroutines::lazy_task<void> parfor_range(pot::executor &executor, IndexType from, IndexType to, FuncType func)
+{
+    return parfor_range(executor, from, to, schedule::static_chunks(), std::move(func));
+}
+
+/**
+ * @brief Block-body parallel loop over the elements of a contiguous range.
+ *
+ * Like the index overload, but the body receives `std::span` views of @p data, e.g.
+ * `parfor_range(exec, std::span(v), sched, [](std::span<float> block) { ... })`. The task is lazy and
+ * only keeps a view of @p data, so the range must be an lvalue or a borrowed view such as `std::span`.
+ */
+template <std::ranges::contiguous_range Range, typename FuncType,
+          typename T = std::remove_reference_t<std::ranges::range_reference_t<Range>>>
+    requires std::ranges::borrowed_range<Range> && std::ranges::sized_range<Range> &&
+             std::invocable<FuncType &, std::span<T>>
+pot::coroutines::lazy_task<void> parfor_range(pot::executor &executor, Range &&data, schedule sched, FuncType func)
+{
+    const std::span<T> view(std::ranges::data(data), std::ranges::size(data));
+    return parfor_range(executor, size_t{0}, view.size(), sched,
+                        [view, func](size_t b, size_t e) mutable { return std::invoke(func, view.subspan(b, e - b)); });
+}
+
+/**
+ * @brief Block-body parallel loop over a contiguous range with one block per thread.
+ */
+template <std::ranges::contiguous_range Range, typename FuncType,
+          typename T = std::remove_reference_t<std::ranges::range_reference_t<Range>>>
+    requires std::ranges::borrowed_range<Range> && std::ranges::sized_range<Range> &&
+             std::invocable<FuncType &, std::span<T>>
+pot::coroutines::lazy_task<void> parfor_range(pot::executor &executor, Range &&data, FuncType func)
+{
+    return parfor_range(executor, std::forward<Range>(data), schedule::static_chunks(), std::move(func));
 }
 } // namespace pot::algorithms
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "pot/algorithms/parfor.h"
+
+namespace pot::algorithms
+{
+/**
+ * @brief Order in which `parfor_2d` / `parfor_3d` walk the grid of tiles.
+ *
+ * Tiles are handed to workers in contiguous runs of this order. `row_major` keeps runs along the
+ * last dimension; `morton` (Z-order) and `hilbert` keep each run compact in every dimension, so
+ * neighbouring tiles a worker touches share more cache lines, e.g. the halo of a stencil.
+ */
+enum class tile_order
+{
+    row_major,
+    morton,
+    hilbert
+};
+
+/// Tile shape of `parfor_2d`: `size_i` rows by `size_j` columns; `j` is the contiguous dimension.
+struct tile_2d
+{
+    int64_t size_i = 64;
+    int64_t size_j = 64;
+    tile_order order = tile_order::row_major;
+};
+
+/// Tile shape of `parfor_3d`; `k` is the contiguous dimension.
+struct tile_3d
+{
+    int64_t size_i = 16;
+    int64_t size_j = 16;
+    int64_t size_k = 16;
+    tile_order order = tile_order::row_major;
+};
+
+/// Half-open index box of one 2-D tile, passed to tile bodies.
+template <typename IndexType> struct tile_range_2d
+{
+    IndexType i_begin, i_end;
+    IndexType j_begin, j_end;
+};
+
+/// Half-open index box of one 3-D tile, passed to tile bodies.
+template <typename IndexType> struct tile_range_3d
+{
+    IndexType i_begin, i_end;
+    IndexType j_begin, j_end;
+    IndexType k_begin, k_end;
+};
+} // namespace pot::algorithms
+
+namespace pot::algorithms::details
+{
+/// Z-order key: the bits of the coordinates interleaved, first coordinate most significant.
+template <size_t N> uint64_t morton_key(const std::array<uint32_t, N> &coords, unsigned bits) noexcept
+{
+    uint64_t key = 0;
+    for (int bit = static_cast<int>(bits) - 1; bit >= 0; --bit)
+    {
+        for (size_t d = 0; d < N; ++d)
+            key = (key << 1) | ((coords[d] >> bit) & 1u);
+    }
+    return key;
+}
+
+/// Position of a point on the N-dimensional Hilbert curve over a 2^bits grid (Skilling, 2004).
+template <size_t N> uint64_t hilbert_key(std::array<uint32_t, N> x, unsigned bits) noexcept
+{
+    if (bits == 0)
+        return 0;
+
+    const uint32_t m = 1u << (bits - 1);
+
+    // Inverse undo excess work.
+    for (uint32_t q = m; q > 1; q >>= 1)
+    {
+        const uint32_t p = q - 1;
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (x[i] & q)
+            {
+                x[0] ^= p;
+            }
+            else
+            {
+                const uint32_t t = (x[0] ^ x[i]) & p;
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode.
+    for (size_t i = 1; i < N; ++i)
+        x[i] ^= x[i - 1];
+    uint32_t t = 0;
+    for (uint32_t q = m; q > 1; q >>= 1)
+    {
+        if (x[N - 1] & q)
+            t ^= q - 1;
+    }
+    for (size_t i = 0; i < N; ++i)
+        x[i] ^= t;
+
+    return morton_key<N>(x, bits);
+}
+
+/// Coordinates of all tiles of a grid with `counts` tiles per dimension, in the requested order.
+template <size_t N>
+std::vector<std::array<uint32_t, N>> tile_sequence(const std::array<int64_t, N> &counts, tile_order order)
+{
+    const int64_t total = std::accumulate(counts.begin(), counts.end(), int64_t{1}, std::multiplies<>{});
+
+    std::vector<std::array<uint32_t, N>> tiles;
+    tiles.reserve(static_cast<size_t>(total));
+    for (int64_t linear = 0; linear < total; ++linear)
+    {
+        std::array<uint32_t, N> coords{};
+        int64_t rest = linear;
+        for (size_t d = N; d-- > 0;)
+        {
+            coords[d] = static_cast<uint32_t>(rest % counts[d]);
+            rest /= counts[d];
+        }
+        tiles.push_back(coords);
+    }
+
+    if (order == tile_order::row_major)
+        return tiles;
+
+    const int64_t largest = *std::max_element(counts.begin(), counts.end());
+    const auto bits = static_cast<unsigned>(std::bit_width(static_cast<uint64_t>(std::max<int64_t>(largest - 1, 1))));
+
+    std::vector<std::pair<uint64_t, size_t>> keys(tiles.size());
+    for (size_t t = 0; t < tiles.size(); ++t)
+    {
+        const uint64_t key = order == tile_order::morton ? morton_key<N>(tiles[t], bits) : hilbert_key<N>(tiles[t], bits);
+        keys[t] = {key, t};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::array<uint32_t, N>> ordered;
+    ordered.reserve(tiles.size());
+    for (const auto &[key, t] : keys)
+        ordered.push_back(tiles[t]);
+    return ordered;
+}
+
+template <typename IndexType, size_t N> struct tile_range_of;
+template <typename IndexType> struct tile_range_of<IndexType, 2>
+{
+    using type = tile_range_2d<IndexType>;
+};
+template <typename IndexType> struct tile_range_of<IndexType, 3>
+{
+    using type = tile_range_3d<IndexType>;
+};
+template <typename IndexType, size_t N> using tile_range_t = typename tile_range_of<IndexType, N>::type;
+
+template <typename IndexType, size_t N>
+tile_range_t<IndexType, N> make_tile_range(const std::array<IndexType, N> &begin, const std::array<IndexType, N> &end)
+{
+    if constexpr (N == 2)
+        return {begin[0], end[0], begin[1], end[1]};
+    else
+        return {begin[0], end[0], begin[1], end[1], begin[2], end[2]};
+}
+
+template <typename FuncType, typename IndexType, size_t N>
+inline constexpr bool is_tile_body_v = std::is_invocable_v<FuncType &, const tile_range_t<IndexType, N> &>;
+
+template <typename FuncType, typename IndexType, size_t N, bool = is_tile_body_v<FuncType, IndexType, N>>
+struct tile_body_result
+{
+    using type = std::invoke_result_t<FuncType &, const tile_range_t<IndexType, N> &>;
+};
+template <typename FuncType, typename IndexType> struct tile_body_result<FuncType, IndexType, 2, false>
+{
+    using type = std::invoke_result_t<FuncType &, IndexType, IndexType>;
+};
+template <typename FuncType, typename IndexType> struct tile_body_result<FuncType, IndexType, 3, false>
+{
+    using type = std::invoke_result_t<FuncType &, IndexType, IndexType, IndexType>;
+};
+
+template <typename FuncType, typename IndexType, size_t N>
+inline constexpr bool tile_body_is_async_v =
+    pot::traits::is_task_v<typename tile_body_result<FuncType, IndexType, N>::type> ||
+    pot::traits::is_lazy_task_v<typename tile_body_result<FuncType, IndexType, N>::type>;
+
+/// Runs `func` over one tile, either once with the whole box or once per index, last index innermost.
+template <typename IndexType, size_t N, typename FuncType>
+pot::coroutines::lazy_task<void> run_tile_async(FuncType &func, std::array<IndexType, N> begin,
+                                                std::array<IndexType, N> end)
+{
+    if constexpr (is_tile_body_v<FuncType, IndexType, N>)
+    {
+        co_await std::invoke(func, make_tile_range<IndexType, N>(begin, end));
+    }
+    else if constexpr (N == 2)
+    {
+        for (IndexType i = begin[0]; i < end[0]; ++i)
+            for (IndexType j = begin[1]; j < end[1]; ++j)
+                co_await std::invoke(func, i, j);
+    }
+    else
+    {
+        for (IndexType i = begin[0]; i < end[0]; ++i)
+            for (IndexType j = begin[1]; j < end[1]; ++j)
+                for (IndexType k = begin[2]; k < end[2]; ++k)
+                    co_await std::invoke(func, i, j, k);
+    }
+    co_return;
+}
+
+template <typename IndexType, size_t N, typename FuncType>
+void run_tile(FuncType &func, const std::array<IndexType, N> &begin, const std::array<IndexType, N> &end)
+{
+    if constexpr (is_tile_body_v<FuncType, IndexType, N>)
+    {
+        std::invoke(func, make_tile_range<IndexType, N>(begin, end));
+    }
+    else if constexpr (N == 2)
+    {
+        for (IndexType i = begin[0]; i < end[0]; ++i)
+            for (IndexType j = begin[1]; j < end[1]; ++j)
+                std::invoke(func, i, j);
+    }
+    else
+    {
+        for (IndexType i = begin[0]; i < end[0]; ++i)
+            for (IndexType j = begin[1]; j < end[1]; ++j)
+                for (IndexType k = begin[2]; k < end[2]; ++k)
+                    std::invoke(func, i, j, k);
+    }
+}
+
+template <typename IndexType, size_t N, typename FuncType>
+pot::coroutines::lazy_task<void> parfor_tiled(pot::executor &executor, std::array<IndexType, N> extents,
+                                              std::array<int64_t, N> tile, tile_order order, FuncType func)
+{
+    std::array<int64_t, N> counts{};
+    for (size_t d = 0; d < N; ++d)
+    {
+        if (extents[d] <= 0)
+            co_return;
+        counts[d] = (static_cast<int64_t>(extents[d]) + tile[d] - 1) / tile[d];
+    }
+
+    const auto tiles = details::tile_sequence<N>(counts, order);
+
+    auto bounds = [&](size_t t, std::array<IndexType, N> &begin, std::array<IndexType, N> &end)
+    {
+        for (size_t d = 0; d < N; ++d)
+        {
+            begin[d] = static_cast<IndexType>(static_cast<int64_t>(tiles[t][d]) * tile[d]);
+            end[d] = static_cast<IndexType>(
+                std::min<int64_t>(static_cast<int64_t>(begin[d]) + tile[d], static_cast<int64_t>(extents[d])));
+        }
+    };
+
+    // Contiguous runs of the tile order go to the same task, which is what makes the order matter.
+    const auto num_tiles = static_cast<int64_t>(tiles.size());
+    if constexpr (tile_body_is_async_v<FuncType, IndexType, N>)
+    {
+        co_await pot::algorithms::parfor(executor, int64_t{0}, num_tiles,
+                                         [&](int64_t t) -> pot::coroutines::lazy_task<void>
+                                         {
+                                             std::array<IndexType, N> begin{}, end{};
+                                             bounds(static_cast<size_t>(t), begin, end);
+                                             co_await details::run_tile_async<IndexType, N>(func, begin, end);
+                                         });
+    }
+    else
+    {
+        co_await pot::algorithms::parfor(executor, int64_t{0}, num_tiles,
+                                         [&](int64_t t)
+                                         {
+                                             std::array<IndexType, N> begin{}, end{};
+                                             bounds(static_cast<size_t>(t), begin, end);
+                                             details::run_tile<IndexType, N>(func, begin, end);
+                                         });
+    }
+    co_return;
+}
+
+inline void validate_tile(std::initializer_list<int64_t> sizes)
+{
+    for (int64_t size : sizes)
+    {
+        if (size <= 0)
+            throw std::invalid_argument("parfor_nd: tile sizes must be positive");
+    }
+}
+} // namespace pot::algorithms::details
+
+namespace pot::algorithms
+{
+/**
+ * @brief Parallel loop over the 2-D index space [0, rows) x [0, cols), cut into tiles.
+ *
+ * The grid is split into `tile.size_i` x `tile.size_j` tiles (edge tiles are smaller), the tiles
+ * are ordered according to `tile.order` and contiguous runs of that order are run as `parfor`
+ * chunks. @p func is either
+ *   - an index body `func(i, j)`, called for every index of a tile with `j` innermost, or
+ *   - a tile body `func(const tile_range_2d<IndexType>&)`, called once per tile so the inner loop
+ *     can be written (and vectorized, e.g. with `simd_forced`) by hand.
+ * Either form may return `task<void>` / `lazy_task<void>`; it is awaited. The body may be invoked
+ * concurrently from several threads.
+ *
+ * @throws std::invalid_argument if a tile size is not positive.
+ */
+template <typename IndexType, typename FuncType>
+    requires std::integral<IndexType> &&
+             (std::invocable<FuncType &, IndexType, IndexType> ||
+              std::invocable<FuncType &, const tile_range_2d<IndexType> &>)
+pot::coroutines::lazy_task<void> parfor_2d(pot::executor &executor, IndexType rows, IndexType cols, tile_2d tile,
+                                           FuncType func)
+{
+    details::validate_tile({tile.size_i, tile.size_j});
+    return details::parfor_tiled<IndexType, 2>(executor, {rows, cols}, {tile.size_i, tile.size_j}, tile.order,
+                                               std::move(func));
+}
+
+/**
+ * @brief Parallel loop over the 3-D index space [0, ni) x [0, nj) x [0, nk), cut into tiles.
+ *
+ * Same contract as `parfor_2d`; index bodies are called as `func(i, j, k)` with `k` innermost and
+ * tile bodies receive a `tile_range_3d<IndexType>`.
+ *
+ * @throws std::invalid_argument if a tile size is not positive.
+ */
+template <typename IndexType, typename FuncType>
+    requires std::integral<IndexType> &&
+             (std::invocable<FuncType &, IndexType, IndexType, IndexType> ||
+              std::invocable<FuncType &, const tile_range_3d<IndexType> &>)
+pot::coroutines::lazy_task<void> parfor_3d(pot::executor &executor, IndexType ni, IndexType nj, IndexType nk,
+                                           tile_3d tile, FuncType func)
+{
+    details::validate_tile({tile.size_i, tile.size_j, tile.size_k});
+    return details::parfor_tiled<IndexType, 3>(executor, {ni, nj, nk}, {tile.size_i, tile.size_j, tile.size_k},
+                                               tile.order, std::move(func));
+}
+} // namespace pot::algorithms
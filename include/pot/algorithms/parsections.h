@@ -7,14 +7,36 @@
 #include <type_traits>
 #include <utility>
 
+#include "pot/coroutines/when_all.h"
 #include "pot/executors/executor.h"
 
+namespace pot::algorithms::details
+{
+    template<typename Func>
+    pot::coroutines::lazy_task<void> parsections_section(Func f)
+    {
+        using Ret = std::invoke_result_t<Func&>;
+
+        if constexpr (pot::traits::is_task_v<Ret> || pot::traits::is_lazy_task_v<Ret>)
+        {
+            co_await std::invoke(f);
+        }
+        else
+        {
+            std::invoke(f);
+        }
+
+        co_return;
+    }
+}
+
 namespace pot::algorithms
 {
     /**
      * @brief Asynchronously executes multiple independent sections in parallel.
      *
-     * Each function in @p funcs is scheduled as a separate task on the given executor.
+     * Each function in @p funcs becomes a separate task; all of them are handed to the executor
+     * in a single bulk submission.
      *
      * @tparam Funcs Variadic list of callables with signature `void()` or coroutine returning `task<void>` / `lazy_task<void>`.
      *
@@ -30,27 +52,12 @@ namespace pot::algorithms
     {
         static_assert(sizeof...(Funcs) > 0, "At least one function must be provided");
 
-        std::vector<pot::coroutines::task<void>> tasks;
-
-        (tasks.emplace_back(
-            executor.run([f = std::forward<Funcs>(funcs)]() mutable -> pot::coroutines::task<void>
-            {
-                using Ret = std::invoke_result_t<decltype(f)&>;
-
-                if constexpr (pot::traits::is_task_v<Ret> || pot::traits::is_lazy_task_v<Ret>)
-                {
-                    co_await std::invoke(f);
-                }
-                else
-                {
-                    std::invoke(f);
-                }
-             
-                co_return;
-            })
-        ), ...);
-
-        co_await pot::coroutines::when_all(tasks);
+        std::vector<pot::coroutines::lazy_task<void>> sections;
+        sections.reserve(sizeof...(Funcs));
+
+        (sections.push_back(details::parsections_section(std::decay_t<Funcs>(std::forward<Funcs>(funcs)))), ...);
+
+        co_await pot::coroutines::when_all_on(executor, sections);
 
         co_return;
     }
@@ -1,15 +1,194 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <span>
 #include <algorithm>
 #include <type_traits>
 #include <stdexcept>
 #include <functional>
+#include <ranges>
+#include <tuple>
+#include <utility>
 
-#include "pot/simd/simd_forced.h"
+#include "pot/simd/dispatch.h"
+#include "pot/algorithms/reduce_blocks.h"
 #include "pot/algorithms/parfor.h"
+#include "pot/utils/cache_line.h"
+
+namespace pot::algorithms::details
+{
+    /**
+     * Combines per-block partials pairwise in log2(count) rounds: (p0 op p1) op (p2 op p3) ...
+     * Neighbours are always combined left to right, so a non-commutative op stays correct, and
+     * floating-point sums lose less precision than with a left fold.
+     */
+    template <typename R, typename ReduceOp>
+    R tree_combine(std::vector<pot::cache_padded<R>> &partial, ReduceOp &reduce_op)
+    {
+        for (std::size_t stride = 1; stride < partial.size(); stride *= 2)
+            for (std::size_t i = 0; i + stride < partial.size(); i += 2 * stride)
+                partial[i].value = reduce_op(std::move(partial[i].value), std::move(partial[i + stride].value));
+        return std::move(partial.front().value);
+    }
+
+    template <typename R, typename ReduceOp, typename TransformOp, typename... Views>
+    pot::coroutines::lazy_task<R> transform_reduce_views(pot::executor &exec, std::size_t n, R identity,
+                                                         ReduceOp reduce_op, TransformOp transform_op, Views... views)
+    {
+        if (n == 0)
+            co_return identity;
+
+        const std::size_t block_count = std::min(n, std::max<std::size_t>(1, exec.thread_count()));
+        const std::size_t block_size = (n + block_count - 1) / block_count;
+
+        std::vector<pot::cache_padded<R>> partial(block_count, pot::cache_padded<R>{identity});
+
+        co_await pot::algorithms::parfor(exec, std::size_t(0), block_count,
+        [&](std::size_t block_idx)
+        {
+            const std::size_t begin = block_idx * block_size;
+            const std::size_t end = std::min(n, begin + block_size);
+
+            R acc = identity;
+            for (std::size_t i = begin; i < end; ++i)
+                acc = reduce_op(std::move(acc), std::invoke(transform_op, std::ranges::begin(views)[i]...));
+            partial[block_idx].value = std::move(acc);
+        });
+
+        co_return tree_combine(partial, reduce_op);
+    }
+
+    template <typename R, typename A, typename B, typename ElemOp, typename ReduceOp>
+    pot::coroutines::lazy_task<R> elementwise_reduce_access(pot::executor &exec, A a, B b, std::size_t n,
+                                                            ElemOp elem_op, ReduceOp reduce_op, R identity)
+    {
+        if (n == 0) co_return identity;
+
+        const std::size_t block_count = std::max<std::size_t>(1, exec.thread_count());
+        const std::size_t block_size = (n + block_count - 1) / block_count;
+
+        std::vector<pot::cache_padded<R>> partial(block_count, pot::cache_padded<R>{identity});
+
+        co_await pot::algorithms::parfor(exec, static_cast<size_t>(0), block_count,
+        [=, &partial](std::size_t block_idx)
+        {
+            const std::size_t begin = block_idx * block_size;
+            const std::size_t end = std::min(n, begin + block_size);
+
+            R sum = identity;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                sum = reduce_op(sum, elem_op(a[i], b[i]));
+            }
+            partial[block_idx].value = sum;
+        });
+
+        co_return tree_combine(partial, reduce_op);
+    }
+
+    /**
+     * Shared driver of the SIMD reductions: cuts [0, n) into one block per thread, each a whole
+     * number of `lanes`-element registers so that only the last block has a partial register, runs
+     * `block_op(begin, end)` on every block and combines the results with @p reduce_op. The lane
+     * count is a run-time value so the same geometry serves kernels picked at run time.
+     */
+    template <typename R, typename BlockOp, typename ReduceOp>
+    pot::coroutines::lazy_task<R> simd_blocks_reduce(pot::executor &exec, std::size_t n, std::size_t lanes,
+                                                     BlockOp block_op, ReduceOp reduce_op, R identity)
+    {
+        if (n == 0)
+            co_return identity;
+
+        const std::size_t block_count = std::min<std::size_t>(
+            std::max<std::size_t>(1, exec.thread_count()),
+            std::max<std::size_t>(std::size_t(1), n / lanes));
+        const std::size_t elems_per_block = ((n + block_count - 1) / block_count + lanes - 1) / lanes * lanes;
+
+        std::vector<pot::cache_padded<R>> partial(block_count, pot::cache_padded<R>{identity});
+
+        co_await pot::algorithms::parfor(exec, static_cast<size_t>(0), block_count,
+        [=, &partial](std::size_t block_idx)
+        {
+            const std::size_t begin = std::min(n, block_idx * elems_per_block);
+            const std::size_t end = std::min(n, begin + elems_per_block);
+            partial[block_idx].value = block_op(begin, end);
+        });
+
+        co_return tree_combine(partial, reduce_op);
+    }
+
+    template <typename T, typename R, pot::simd::SIMDType ST,
+        typename A, typename B, typename AccumulateOp, typename ReduceOp>
+    pot::coroutines::lazy_task<R> elementwise_reduce_simd_kernel(pot::executor &exec, A a, B b, std::size_t n,
+                                                                 AccumulateOp accumulate_op, ReduceOp reduce_op, R identity)
+    {
+        return simd_blocks_reduce(exec, n, pot::simd::details::simd_traits<T, ST>::scalar_count,
+            [=](std::size_t begin, std::size_t end)
+            { return simd_reduce_block<T, R, ST>(a, b, begin, end, accumulate_op, reduce_op, identity); },
+            reduce_op, identity);
+    }
+
+    template <typename T, typename R, pot::simd::SIMDType ST,
+        typename A, typename B, typename AccumulateOp, typename ReduceOp>
+    pot::coroutines::lazy_task<R> accumulate_reduce_simd(pot::executor &exec, A a, B b, std::size_t n,
+                                                         AccumulateOp accumulate_op, ReduceOp reduce_op, R identity)
+    {
+        return pot::simd::dispatch<ST>([&]<pot::simd::SIMDType W>()
+        {
+            return elementwise_reduce_simd_kernel<T, R, W>(exec, a, b, n, accumulate_op, reduce_op, identity);
+        });
+    }
+
+    template <typename T, typename R, pot::simd::SIMDType ST,
+        typename A, typename B, typename SimdElemOp, typename ReduceOp>
+    pot::coroutines::lazy_task<R> elementwise_reduce_simd_access(pot::executor &exec, A a, B b, std::size_t n,
+                                                                 SimdElemOp simd_elem_op, ReduceOp reduce_op, R identity)
+    {
+        auto accumulate_op = [simd_elem_op](const auto &sum, const auto &x, const auto &y) { return sum + simd_elem_op(x, y); };
+        return accumulate_reduce_simd<T, R, ST>(exec, a, b, n, accumulate_op, reduce_op, identity);
+    }
+
+    // Runs `block_op(begin, end)` on the fixed-size blocks of `mode` and combines them as a fixed tree.
+    template <typename R, typename BlockOp, typename ReduceOp>
+    pot::coroutines::lazy_task<R> reproducible_blocks_reduce(pot::executor &exec, std::size_t n, reproducible mode,
+                                                             BlockOp block_op, ReduceOp reduce_op, R identity)
+    {
+        if (mode.block_size == 0)
+            throw std::invalid_argument("elementwise_reduce_simd: reproducible block size must be positive");
+
+        constexpr std::size_t lanes = reproducible_lanes;
+        const std::size_t block_size = (mode.block_size + lanes - 1) / lanes * lanes;
+        const std::size_t block_count = (n + block_size - 1) / block_size;
+
+        if (n == 0)
+            co_return identity;
+
+        std::vector<pot::cache_padded<R>> partial(block_count, pot::cache_padded<R>{identity});
+
+        co_await pot::algorithms::parfor(exec, static_cast<size_t>(0), block_count,
+        [=, &partial](std::size_t block_idx) mutable
+        {
+            const std::size_t begin = block_idx * block_size;
+            const std::size_t end = std::min(n, begin + block_size);
+            partial[block_idx].value = block_op(begin, end, mode.method);
+        });
+
+        co_return tree_combine(partial, reduce_op);
+    }
+
+    template <typename T, typename R, pot::simd::SIMDType ST, typename SimdElemOp, typename ReduceOp>
+    pot::coroutines::lazy_task<R> reproducible_reduce_simd(pot::executor &exec, const T *a, const T *b, std::size_t n,
+                                                           SimdElemOp simd_elem_op, ReduceOp reduce_op, R identity,
+                                                           reproducible mode)
+    {
+        return reproducible_blocks_reduce(exec, n, mode,
+            [=](std::size_t begin, std::size_t end, summation method) mutable
+            { return reproducible_reduce_block<T, R, ST>(a, b, begin, end, simd_elem_op, reduce_op, method); },
+            reduce_op, identity);
+    }
+} // namespace pot::algorithms::details
 
 namespace pot::algorithms
 {
@@ -39,31 +218,8 @@ namespace pot::algorithms
     elementwise_reduce(pot::executor &exec, const T *a, const T *b, std::size_t n, ElemOp elem_op, ReduceOp reduce_op, R identity)
         requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
     {
-        if (n == 0) co_return identity;
-
-        const std::size_t block_count = std::max<std::size_t>(1, exec.thread_count());
-        const std::size_t block_size = (n + block_count - 1) / block_count;
-
-        std::vector<R> partial(block_count, identity);
-
-        co_await pot::algorithms::parfor(exec, static_cast<size_t>(0), block_count,
-        [=, &partial](std::size_t block_idx)
-        {
-            const std::size_t begin = block_idx * block_size;
-            const std::size_t end = std::min(n, begin + block_size);
-
-            R sum = identity;
-            for (std::size_t i = begin; i < end; ++i)
-            {
-                sum = reduce_op(sum, elem_op(a[i], b[i]));
-            }
-            partial[block_idx] = sum;
-        });
-
-        R total = identity;
-        for (const R &v : partial)
-            total = reduce_op(total, v);
-        co_return total;
+        return details::elementwise_reduce_access<R>(exec, details::contiguous_access<T>{a}, details::contiguous_access<T>{b},
+                                                     n, elem_op, reduce_op, identity);
     }
 
     /**
@@ -97,14 +253,18 @@ namespace pot::algorithms
     /**
      * @brief Asynchronously computes an element-wise reduction using SIMD acceleration.
      *
-     * Loads and processes multiple elements per iteration using SIMD instructions.
-     * Falls back to scalar processing for remaining elements.
+     * Loads and processes multiple elements per iteration using SIMD instructions. The last
+     * partial register is loaded with a lane mask, so every element goes through @p simd_elem_op.
      *
      * @tparam T             Input element type (must be arithmetic).
      * @tparam R             Result type (must be arithmetic).
-     * @tparam ST            SIMD type (pot::simd::SIMDType).
+     * @tparam ST            SIMD type (pot::simd::SIMDType). `Auto` picks the width at run time, but only
+     *                       among the widths the calling translation unit is compiled for, since the
+     *                       kernel is instantiated there (see pot::simd::dispatch). At the default SSE 4.2
+     *                       flags that is SSE even on AVX-512 hardware; build the calling file with
+     *                       `GNU_CLANG_AVX2_KERNEL_FLAGS` or `GNU_CLANG_AVX512_KERNEL_FLAGS` from
+     *                       cmake/CompilerFlags.cmake (MSVC: `/arch:AVX2`, `/arch:AVX512`) to go wider.
      * @tparam SimdElemOp    Callable: (simd_forced<T>, simd_forced<T>) -> simd_forced<R>.
-     * @tparam ScalarElemOp  Callable: (T, T) -> R.
      * @tparam ReduceOp      Callable: (R, R) -> R.
      *
      * @param exec          Executor for task scheduling.
@@ -112,95 +272,284 @@ namespace pot::algorithms
      * @param b             Pointer to second array.
      * @param n             Number of elements.
      * @param simd_elem_op  Operation applied to SIMD registers.
-     * @param scalar_elem_op Operation applied to leftover scalar elements.
      * @param reduce_op     Reduction operator.
      * @param identity      Identity element for reduction.
      *
      * @return lazy_task<R> The reduced result.
      */
-    template < typename T, typename R = T,
-        pot::simd::SIMDType ST, 
-        typename SimdElemOp, typename ScalarElemOp, typename ReduceOp>
+    template <typename T, typename R = T, pot::simd::SIMDType ST, typename SimdElemOp, typename ReduceOp>
     [[nodiscard]] pot::coroutines::lazy_task<R>
     elementwise_reduce_simd(pot::executor &exec, const T *a, const T *b, std::size_t n,
-                            SimdElemOp simd_elem_op, ScalarElemOp scalar_elem_op, ReduceOp reduce_op, R identity)
+                            SimdElemOp simd_elem_op, ReduceOp reduce_op, R identity)
     requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
     {
-        using simd_t_i = pot::simd::simd_forced<T, ST>;
-        using simd_t_res = pot::simd::simd_forced<R, ST>;
-        constexpr std::size_t scalar_count = pot::simd::details::simd_traits<T, ST>::scalar_count;
-
-        if (n == 0)
-            co_return identity;
-
-        const std::size_t block_count = std::min<std::size_t>(
-            std::max<std::size_t>(1, exec.thread_count()),
-            std::max<std::size_t>(std::size_t(1), n / scalar_count));
-        const std::size_t elems_per_block = std::max<std::size_t>(scalar_count, (n + block_count - 1) / block_count);
-
-        std::vector<R> partial(block_count, identity);
+        return details::elementwise_reduce_simd_access<T, R, ST>(
+            exec, details::contiguous_access<T>{a}, details::contiguous_access<T>{b}, n,
+            simd_elem_op, reduce_op, identity);
+    }
 
-        co_await pot::algorithms::parfor(exec, static_cast<size_t>(0), block_count,
-        [=, &partial](std::size_t block_idx)
+    /**
+     * @brief Reproducible variant of elementwise_reduce_simd.
+     *
+     * Same contract as the overload above, but the result is bit-identical for any executor and
+     * any SIMD width (see `pot::algorithms::reproducible`). Lanes are accumulated with `+`, like the
+     * fast path, using @p mode.method; @p reduce_op folds the lanes and the blocks.
+     *
+     * @param mode Block size and lane summation method.
+     * @throws std::invalid_argument if @p mode.block_size is 0.
+     */
+    template <typename T, typename R = T, pot::simd::SIMDType ST, typename SimdElemOp, typename ReduceOp>
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_simd(pot::executor &exec, const T *a, const T *b, std::size_t n,
+                            SimdElemOp simd_elem_op, ReduceOp reduce_op, R identity, reproducible mode)
+    requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
+    {
+        return pot::simd::dispatch<ST>([&]<pot::simd::SIMDType W>()
         {
-            const std::size_t begin = block_idx * elems_per_block;
-            const std::size_t end = std::min(n, begin + elems_per_block);
-
-            simd_t_res sum = simd_t_res::zeros();
-
-            std::size_t i = begin;
-            for (; i + scalar_count <= end; i += scalar_count)
-            {
-                simd_t_i va; va.loadu(a + i);
-                simd_t_i vb; vb.loadu(b + i);
-                sum += simd_elem_op(va, vb);
-            }
-
-            alignas((alignof(R) > alignof(std::max_align_t) ? alignof(R) : alignof(std::max_align_t))) R lane[scalar_count];
-
-            sum.storeu(lane);
-
-            R block_sum = identity;
-            for (std::size_t k = 0; k < scalar_count; ++k) block_sum = reduce_op(block_sum, lane[k]);
-            for (; i < end; ++i) block_sum = reduce_op(block_sum, scalar_elem_op(a[i], b[i]));
-
-            partial[block_idx] = block_sum;
+            return details::reproducible_reduce_simd<T, R, W>(exec, a, b, n, simd_elem_op, reduce_op, identity, mode);
         });
-
-        R total = identity;
-        for (const R &v : partial) total = reduce_op(total, v);
-        co_return total;
     }
 
     /**
      * @brief Convenience overload of elementwise_reduce_simd for std::span.
-     * @copydetails elementwise_reduce_simd(pot::executor&, const T*, const T*, std::size_t, SimdElemOp, ScalarElemOp, ReduceOp, R)
+     * @copydetails elementwise_reduce_simd(pot::executor&, const T*, const T*, std::size_t, SimdElemOp, ReduceOp, R)
      * @throws std::invalid_argument if the spans differ in size.
      */
-    template <typename T, typename R, pot::simd::SIMDType ST, typename SimdElemOp, typename ScalarElemOp, typename ReduceOp>
+    template <typename T, typename R, pot::simd::SIMDType ST, typename SimdElemOp, typename ReduceOp>
     [[nodiscard]] pot::coroutines::lazy_task<R>
     elementwise_reduce_simd(pot::executor &exec, std::span<const T> a, std::span<const T> b,
-                            SimdElemOp simd_elem_op, ScalarElemOp scalar_elem_op, ReduceOp reduce_op, R identity)
+                            SimdElemOp simd_elem_op, ReduceOp reduce_op, R identity)
     {
         if (a.size() != b.size())
             throw std::invalid_argument("elementwise_reduce_simd: spans must have equal sizes");
-        return elementwise_reduce_simd<T, R, ST>(exec, a.data(), b.data(), a.size(),
-                                                 simd_elem_op, scalar_elem_op, reduce_op, identity);
+        return elementwise_reduce_simd<T, R, ST>(exec, a.data(), b.data(), a.size(), simd_elem_op, reduce_op, identity);
     }
 
     /**
      * @brief Convenience overload of elementwise_reduce_simd for std::vector.
-     * @copydetails elementwise_reduce_simd(pot::executor&, const T*, const T*, std::size_t, SimdElemOp, ScalarElemOp, ReduceOp, R)
+     * @copydetails elementwise_reduce_simd(pot::executor&, const T*, const T*, std::size_t, SimdElemOp, ReduceOp, R)
      * @throws std::invalid_argument if the vectors differ in size.
      */
-    template <typename T, typename R, pot::simd::SIMDType ST, typename SimdElemOp, typename ScalarElemOp, typename ReduceOp>
+    template <typename T, typename R, pot::simd::SIMDType ST, typename SimdElemOp, typename ReduceOp>
     [[nodiscard]] pot::coroutines::lazy_task<R>
     elementwise_reduce_simd(pot::executor &exec, const std::vector<T> &a, const std::vector<T> &b,
-                            SimdElemOp simd_elem_op, ScalarElemOp scalar_elem_op, ReduceOp reduce_op, R identity)
+                            SimdElemOp simd_elem_op, ReduceOp reduce_op, R identity)
     {
         if (a.size() != b.size())
             throw std::invalid_argument("elementwise_reduce_simd: vectors must have equal sizes");
         return elementwise_reduce_simd<T, R, ST>(exec, std::span<const T>(a), std::span<const T>(b),
-                                                 simd_elem_op, scalar_elem_op, reduce_op, identity);
+                                                 simd_elem_op, reduce_op, identity);
+    }
+
+    /**
+     * @deprecated Takes a scalar form of @p simd_elem_op that is never called: tails go through
+     *             @p simd_elem_op with masked loads. Use the overload without @p scalar_elem_op.
+     */
+    template <typename T, typename R = T, pot::simd::SIMDType ST,
+        typename SimdElemOp, typename ScalarElemOp, typename ReduceOp>
+    [[deprecated("scalar_elem_op is not called; drop the argument")]]
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_simd(pot::executor &exec, const T *a, const T *b, std::size_t n,
+                            SimdElemOp simd_elem_op, ScalarElemOp /*scalar_elem_op*/, ReduceOp reduce_op, R identity)
+    requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
+    {
+        return elementwise_reduce_simd<T, R, ST>(exec, a, b, n, simd_elem_op, reduce_op, identity);
+    }
+
+    /// @deprecated Use the reproducible overload without @p scalar_elem_op.
+    template <typename T, typename R = T, pot::simd::SIMDType ST,
+        typename SimdElemOp, typename ScalarElemOp, typename ReduceOp>
+    [[deprecated("scalar_elem_op is not called; drop the argument")]]
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_simd(pot::executor &exec, const T *a, const T *b, std::size_t n,
+                            SimdElemOp simd_elem_op, ScalarElemOp /*scalar_elem_op*/, ReduceOp reduce_op, R identity,
+                            reproducible mode)
+    requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
+    {
+        return elementwise_reduce_simd<T, R, ST>(exec, a, b, n, simd_elem_op, reduce_op, identity, mode);
+    }
+
+    /// @deprecated Use the std::span overload without @p scalar_elem_op.
+    template <typename T, typename R, pot::simd::SIMDType ST, typename SimdElemOp, typename ScalarElemOp, typename ReduceOp>
+    [[deprecated("scalar_elem_op is not called; drop the argument")]]
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_simd(pot::executor &exec, std::span<const T> a, std::span<const T> b,
+                            SimdElemOp simd_elem_op, ScalarElemOp /*scalar_elem_op*/, ReduceOp reduce_op, R identity)
+    {
+        return elementwise_reduce_simd<T, R, ST>(exec, a, b, simd_elem_op, reduce_op, identity);
+    }
+
+    /// @deprecated Use the std::vector overload without @p scalar_elem_op.
+    template <typename T, typename R, pot::simd::SIMDType ST, typename SimdElemOp, typename ScalarElemOp, typename ReduceOp>
+    [[deprecated("scalar_elem_op is not called; drop the argument")]]
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_simd(pot::executor &exec, const std::vector<T> &a, const std::vector<T> &b,
+                            SimdElemOp simd_elem_op, ScalarElemOp /*scalar_elem_op*/, ReduceOp reduce_op, R identity)
+    {
+        return elementwise_reduce_simd<T, R, ST>(exec, a, b, simd_elem_op, reduce_op, identity);
+    }
+
+    /**
+     * @brief Element-wise reduction of two strided arrays, e.g. two columns of row-major matrices.
+     *
+     * Reduces `elem_op(a[i * stride_a], b[i * stride_b])` for i in [0, n) without copying the
+     * elements into a contiguous buffer.
+     * @copydetails elementwise_reduce(pot::executor&, const T*, const T*, std::size_t, ElemOp, ReduceOp, R)
+     * @param stride_a Distance between consecutive elements of @p a, in elements.
+     * @param stride_b Distance between consecutive elements of @p b, in elements.
+     */
+    template <typename T, typename R = T, typename ElemOp, typename ReduceOp>
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_strided(pot::executor &exec, const T *a, std::size_t stride_a, const T *b, std::size_t stride_b,
+                               std::size_t n, ElemOp elem_op, ReduceOp reduce_op, R identity)
+        requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
+    {
+        return details::elementwise_reduce_access<R>(exec, details::strided_access<T>{a, stride_a},
+                                                     details::strided_access<T>{b, stride_b}, n, elem_op, reduce_op, identity);
+    }
+
+    /**
+     * @brief SIMD element-wise reduction of two strided arrays.
+     *
+     * Registers are filled with `simd_traits::gather` (AVX2 / AVX-512 gather instructions; SSE
+     * builds without AVX2 load the lanes one by one).
+     * @copydetails elementwise_reduce_simd(pot::executor&, const T*, const T*, std::size_t, SimdElemOp, ReduceOp, R)
+     * @param stride_a Distance between consecutive elements of @p a, in elements.
+     * @param stride_b Distance between consecutive elements of @p b, in elements.
+     */
+    template <typename T, typename R = T, pot::simd::SIMDType ST, typename SimdElemOp, typename ReduceOp>
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_strided_simd(pot::executor &exec, const T *a, std::size_t stride_a, const T *b, std::size_t stride_b,
+                                    std::size_t n, SimdElemOp simd_elem_op, ReduceOp reduce_op, R identity)
+        requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
+    {
+        return details::elementwise_reduce_simd_access<T, R, ST>(
+            exec, details::strided_access<T>{a, stride_a}, details::strided_access<T>{b, stride_b}, n,
+            simd_elem_op, reduce_op, identity);
+    }
+
+    /// @deprecated Use the overload without @p scalar_elem_op, which is never called.
+    template <typename T, typename R = T, pot::simd::SIMDType ST,
+        typename SimdElemOp, typename ScalarElemOp, typename ReduceOp>
+    [[deprecated("scalar_elem_op is not called; drop the argument")]]
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_strided_simd(pot::executor &exec, const T *a, std::size_t stride_a, const T *b, std::size_t stride_b,
+                                    std::size_t n, SimdElemOp simd_elem_op, ScalarElemOp /*scalar_elem_op*/,
+                                    ReduceOp reduce_op, R identity)
+        requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
+    {
+        return elementwise_reduce_strided_simd<T, R, ST>(exec, a, stride_a, b, stride_b, n, simd_elem_op, reduce_op, identity);
+    }
+
+    /**
+     * @brief Element-wise reduction of an array against elements picked by an index list.
+     *
+     * Reduces `elem_op(a[i], b[b_idx[i]])` for i in [0, n): with @p a and @p b_idx holding the
+     * values and indices of a sparse vector and @p b a dense one, this is a sparse-dense product.
+     * @copydetails elementwise_reduce(pot::executor&, const T*, const T*, std::size_t, ElemOp, ReduceOp, R)
+     * @param b_idx Indices into @p b, one per element of @p a.
+     */
+    template <typename T, typename R = T, typename ElemOp, typename ReduceOp>
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_indexed(pot::executor &exec, const T *a, const T *b, const uint32_t *b_idx, std::size_t n,
+                               ElemOp elem_op, ReduceOp reduce_op, R identity)
+        requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
+    {
+        return details::elementwise_reduce_access<R>(exec, details::contiguous_access<T>{a},
+                                                     details::indexed_access<T>{b, b_idx}, n, elem_op, reduce_op, identity);
+    }
+
+    /**
+     * @brief SIMD element-wise reduction of an array against elements picked by an index list.
+     *
+     * Elements of @p b are loaded with `simd_traits::gather`, which takes signed 32-bit indices:
+     * every index must be below 2^31.
+     * @copydetails elementwise_reduce_simd(pot::executor&, const T*, const T*, std::size_t, SimdElemOp, ReduceOp, R)
+     * @param b_idx Indices into @p b, one per element of @p a.
+     */
+    template <typename T, typename R = T, pot::simd::SIMDType ST, typename SimdElemOp, typename ReduceOp>
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_indexed_simd(pot::executor &exec, const T *a, const T *b, const uint32_t *b_idx, std::size_t n,
+                                    SimdElemOp simd_elem_op, ReduceOp reduce_op, R identity)
+        requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
+    {
+        return details::elementwise_reduce_simd_access<T, R, ST>(
+            exec, details::contiguous_access<T>{a}, details::indexed_access<T>{b, b_idx}, n,
+            simd_elem_op, reduce_op, identity);
+    }
+
+    /// @deprecated Use the overload without @p scalar_elem_op, which is never called.
+    template <typename T, typename R = T, pot::simd::SIMDType ST,
+        typename SimdElemOp, typename ScalarElemOp, typename ReduceOp>
+    [[deprecated("scalar_elem_op is not called; drop the argument")]]
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    elementwise_reduce_indexed_simd(pot::executor &exec, const T *a, const T *b, const uint32_t *b_idx, std::size_t n,
+                                    SimdElemOp simd_elem_op, ScalarElemOp /*scalar_elem_op*/, ReduceOp reduce_op, R identity)
+        requires(std::is_arithmetic_v<T> && std::is_arithmetic_v<R>)
+    {
+        return elementwise_reduce_indexed_simd<T, R, ST>(exec, a, b, b_idx, n, simd_elem_op, reduce_op, identity);
+    }
+
+    /**
+     * @brief Asynchronously maps every element of @p range with @p transform_op and reduces the results.
+     *
+     * The range is split into one block per thread. Each block folds
+     * `acc = reduce_op(acc, transform_op(x))` starting from @p identity into its own cache line,
+     * and the block results are combined pairwise as a tree. The accumulator does not have to be
+     * arithmetic: min/max/argmax structs, histograms and similar work as long as @p reduce_op accepts
+     * both (R, transform result) and (R, R).
+     *
+     * @tparam Range        Sized random-access range; a `std::views::iota` gives index-based loops.
+     * @tparam R            Accumulator type.
+     * @tparam ReduceOp     Associative callable: (R, R) -> R and (R, transform result) -> R.
+     * @tparam TransformOp  Callable applied to each element.
+     *
+     * @param exec          Executor for task scheduling.
+     * @param range         Input range. It must outlive the returned task.
+     * @param identity      Identity element of @p reduce_op, copied into every block.
+     * @param reduce_op     Reduction operation.
+     * @param transform_op  Operation applied to each element.
+     *
+     * @return lazy_task<R> The reduced result (identity for an empty range).
+     */
+    template <std::ranges::random_access_range Range, typename R, typename ReduceOp, typename TransformOp>
+        requires std::ranges::sized_range<Range> && std::invocable<TransformOp &, std::ranges::range_reference_t<Range>>
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    transform_reduce(pot::executor &exec, Range &&range, R identity, ReduceOp reduce_op, TransformOp transform_op)
+    {
+        const auto n = static_cast<std::size_t>(std::ranges::size(range));
+        return details::transform_reduce_views<R>(exec, n, std::move(identity), std::move(reduce_op),
+                                                  std::move(transform_op), std::views::all(std::forward<Range>(range)));
+    }
+
+    /**
+     * @brief transform_reduce over N ranges walked in lockstep.
+     *
+     * @p inputs is a tuple of ranges, typically `std::tie(a, b, c)`; @p transform_op receives one
+     * element of each range per index.
+     * @copydetails transform_reduce(pot::executor&, Range&&, R, ReduceOp, TransformOp)
+     * @throws std::invalid_argument if the ranges differ in size.
+     */
+    template <typename... Ranges, typename R, typename ReduceOp, typename TransformOp>
+        requires(sizeof...(Ranges) > 0 && ((std::ranges::random_access_range<Ranges> && std::ranges::sized_range<Ranges>) && ...) &&
+                 std::invocable<TransformOp &, std::ranges::range_reference_t<Ranges>...>)
+    [[nodiscard]] pot::coroutines::lazy_task<R>
+    transform_reduce(pot::executor &exec, std::tuple<Ranges...> inputs, R identity, ReduceOp reduce_op, TransformOp transform_op)
+    {
+        const auto n = static_cast<std::size_t>(std::ranges::size(std::get<0>(inputs)));
+        const bool same_size = std::apply([n](const auto &...ranges)
+                                          { return ((static_cast<std::size_t>(std::ranges::size(ranges)) == n) && ...); },
+                                          inputs);
+        if (!same_size)
+            throw std::invalid_argument("transform_reduce: ranges must have equal sizes");
+
+        return std::apply(
+            [&](auto &&...ranges)
+            {
+                return details::transform_reduce_views<R>(exec, n, std::move(identity), std::move(reduce_op),
+                                                          std::move(transform_op),
+                                                          std::views::all(std::forward<decltype(ranges)>(ranges))...);
+            },
+            std::move(inputs));
     }
 } // namespace pot::algorithms
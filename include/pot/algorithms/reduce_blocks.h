@@ -0,0 +1,358 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "pot/simd/simd_forced.h"
+
+// Per-block bodies of the SIMD reductions. They use nothing but the SIMD headers, so the library
+// can build them once per width (src/algorithms/simd_kernels_*.cpp) without compiling any
+// executor or coroutine code with the flags of a wider width.
+
+namespace pot::algorithms
+{
+    /// How the SIMD lanes accumulate in a reproducible reduction.
+    enum class summation
+    {
+        naive,    ///< Plain running sum per lane.
+        pairwise, ///< Each block is halved recursively and the halves are summed, O(log n) error growth.
+        kahan     ///< Kahan-compensated running sum per lane.
+    };
+
+    /**
+     * @brief Requests a reduction whose result does not depend on the executor.
+     *
+     * The input is cut into blocks of `block_size` elements (rounded up to a multiple of 16), so
+     * block boundaries depend only on the length of the input, not on `exec.thread_count()`. Inside
+     * a block every element goes to one of 16 virtual lanes by its offset, whatever the SIMD width,
+     * the lanes are folded as a fixed tree and the block results are combined as a fixed tree too.
+     * The same input therefore gives bit-identical results on any pool and with SSE, AVX or AVX-512.
+     */
+    struct reproducible
+    {
+        std::size_t block_size = std::size_t(1) << 14;
+        summation method = summation::naive;
+    };
+} // namespace pot::algorithms
+
+namespace pot::algorithms::details
+{
+    inline constexpr std::size_t reproducible_lanes = 16;
+
+    template <std::size_t Count, typename R, typename ReduceOp>
+    R fixed_tree_combine(R (&values)[Count], ReduceOp &reduce_op)
+    {
+        for (std::size_t stride = 1; stride < Count; stride *= 2)
+            for (std::size_t i = 0; i + stride < Count; i += 2 * stride)
+                values[i] = reduce_op(values[i], values[i + stride]);
+        return values[0];
+    }
+
+    /**
+     * Makes @p x opaque to the optimizer. GCC contracts `a * b + c` into an FMA by default in C++
+     * and ignores `#pragma STDC FP_CONTRACT`, so a product added right after this call is rounded
+     * on its own whatever the width and the -m flags of the translation unit. MSVC does not
+     * contract unless /fp:contract is given.
+     */
+    template <typename V>
+    void unfused(V &x)
+    {
+#if defined(__GNUC__)
+        asm("" : "+v"(x));
+#else
+        (void)x;
+#endif
+    }
+
+    /**
+     * The 16 virtual lanes of a reproducible reduction, held in as many registers as the SIMD width
+     * needs. Element `offset` of a block always lands in lane `offset % 16`.
+     */
+    template <typename R, pot::simd::SIMDType ST>
+    struct reproducible_lanes_acc
+    {
+        using simd_t = pot::simd::simd_forced<R, ST>;
+        static constexpr std::size_t lanes = pot::simd::details::simd_traits<R, ST>::scalar_count;
+        static constexpr std::size_t regs = reproducible_lanes / lanes;
+        static_assert(lanes <= reproducible_lanes && reproducible_lanes % lanes == 0,
+                      "reproducible reductions need at most 16 lanes per register");
+
+        simd_t sum[regs];
+        simd_t comp[regs];
+
+        reproducible_lanes_acc()
+        {
+            for (std::size_t r = 0; r < regs; ++r)
+                sum[r] = comp[r] = simd_t::zeros();
+        }
+
+        void add(std::size_t r, simd_t x, summation method)
+        {
+            unfused(x);
+            if (method == summation::kahan)
+            {
+                const simd_t y = x - comp[r];
+                const simd_t t = sum[r] + y;
+                comp[r] = (t - sum[r]) - y;
+                sum[r] = t;
+            }
+            else
+            {
+                sum[r] += x;
+            }
+        }
+
+        void merge(const reproducible_lanes_acc &other)
+        {
+            for (std::size_t r = 0; r < regs; ++r)
+            {
+                sum[r] += other.sum[r];
+                comp[r] += other.comp[r];
+            }
+        }
+
+        template <typename ReduceOp>
+        R fold(ReduceOp &reduce_op)
+        {
+            R values[reproducible_lanes];
+            R errors[reproducible_lanes];
+            for (std::size_t r = 0; r < regs; ++r)
+            {
+                sum[r].storeu(values + r * lanes);
+                comp[r].storeu(errors + r * lanes);
+            }
+            for (std::size_t k = 0; k < reproducible_lanes; ++k)
+                values[k] -= errors[k];
+            return fixed_tree_combine(values, reduce_op);
+        }
+    };
+
+    // Accumulates [begin, end) into 16 virtual lanes. A last group shorter than 16 elements is
+    // loaded masked and adds zeros to the remaining lanes, whatever the register width.
+    template <typename T, typename R, pot::simd::SIMDType ST, typename SimdElemOp>
+    reproducible_lanes_acc<R, ST> reproducible_lanes_sum(const T *a, const T *b, std::size_t begin, std::size_t end,
+                                                         SimdElemOp &simd_elem_op, summation method)
+    {
+        using acc_t = reproducible_lanes_acc<R, ST>;
+        using simd_t_i = pot::simd::simd_forced<T, ST>;
+
+        // Pairwise splits stop at 8 groups of 16 elements, which are summed linearly.
+        constexpr std::size_t pairwise_leaf = 8 * reproducible_lanes;
+        if (method == summation::pairwise && end - begin > pairwise_leaf)
+        {
+            const std::size_t mid = begin + (end - begin) / (2 * reproducible_lanes) * reproducible_lanes;
+            acc_t left = reproducible_lanes_sum<T, R, ST>(a, b, begin, mid, simd_elem_op, method);
+            left.merge(reproducible_lanes_sum<T, R, ST>(a, b, mid, end, simd_elem_op, method));
+            return left;
+        }
+
+        acc_t acc;
+        std::size_t i = begin;
+        for (; i + reproducible_lanes <= end; i += reproducible_lanes)
+        {
+            for (std::size_t r = 0; r < acc_t::regs; ++r)
+            {
+                simd_t_i va; va.loadu(a + i + r * acc_t::lanes);
+                simd_t_i vb; vb.loadu(b + i + r * acc_t::lanes);
+                acc.add(r, simd_elem_op(va, vb), method);
+            }
+        }
+        if (i < end)
+        {
+            using simd_t_r = pot::simd::simd_forced<R, ST>;
+            for (std::size_t r = 0; r < acc_t::regs; ++r)
+            {
+                const std::size_t offset = std::min(end - i, r * acc_t::lanes);
+                const std::size_t count = std::min(end - i - offset, acc_t::lanes);
+                simd_t_i va; va.loadu(a + i + offset, count);
+                simd_t_i vb; vb.loadu(b + i + offset, count);
+                acc.add(r, simd_elem_op(va, vb).first(count, simd_t_r::zeros()), method);
+            }
+        }
+        return acc;
+    }
+
+    /**
+     * Element accessors for the elementwise reductions. `a[i]` reads one element and
+     * `a.load<ST>(i)` reads elements i .. i + lanes - 1 into a register: contiguous arrays use
+     * `loadu`, strided arrays and index lists use `simd_traits::gather`. `a.load<ST>(i, count)`
+     * reads only the first `count` of them and zeroes the other lanes.
+     */
+    template <typename T>
+    struct contiguous_access
+    {
+        const T *data;
+
+        const T &operator[](std::size_t i) const { return data[i]; }
+
+        template <pot::simd::SIMDType ST>
+        pot::simd::simd_forced<T, ST> load(std::size_t i) const
+        {
+            pot::simd::simd_forced<T, ST> v;
+            v.loadu(data + i);
+            return v;
+        }
+
+        template <pot::simd::SIMDType ST>
+        pot::simd::simd_forced<T, ST> load(std::size_t i, std::size_t count) const
+        {
+            pot::simd::simd_forced<T, ST> v;
+            v.loadu(data + i, count);
+            return v;
+        }
+    };
+
+    template <typename T>
+    struct strided_access
+    {
+        const T *data;
+        std::size_t stride;
+
+        const T &operator[](std::size_t i) const { return data[i * stride]; }
+
+        template <pot::simd::SIMDType ST>
+        pot::simd::simd_forced<T, ST> load(std::size_t i) const
+        {
+            constexpr std::size_t lanes = pot::simd::details::simd_traits<T, ST>::scalar_count;
+            pot::simd::simd_forced<T, ST> v;
+            if (stride <= std::size_t(INT32_MAX) / lanes)
+            {
+                // Gather offsets are relative to the first element, so they fit in 32 bits.
+                uint32_t offsets[lanes];
+                for (std::size_t k = 0; k < lanes; ++k)
+                    offsets[k] = static_cast<uint32_t>(k * stride);
+                v.gather(data + i * stride, offsets);
+            }
+            else
+            {
+                T values[lanes];
+                for (std::size_t k = 0; k < lanes; ++k)
+                    values[k] = data[(i + k) * stride];
+                v.loadu(values);
+            }
+            return v;
+        }
+
+        template <pot::simd::SIMDType ST>
+        pot::simd::simd_forced<T, ST> load(std::size_t i, std::size_t count) const
+        {
+            constexpr std::size_t lanes = pot::simd::details::simd_traits<T, ST>::scalar_count;
+            T values[lanes] = {};
+            for (std::size_t k = 0; k < count; ++k)
+                values[k] = data[(i + k) * stride];
+            pot::simd::simd_forced<T, ST> v;
+            v.loadu(values);
+            return v;
+        }
+    };
+
+    template <typename T>
+    struct indexed_access
+    {
+        const T *data;
+        const uint32_t *idx;
+
+        const T &operator[](std::size_t i) const { return data[idx[i]]; }
+
+        template <pot::simd::SIMDType ST>
+        pot::simd::simd_forced<T, ST> load(std::size_t i) const
+        {
+            pot::simd::simd_forced<T, ST> v;
+            v.gather(data, idx + i);
+            return v;
+        }
+
+        template <pot::simd::SIMDType ST>
+        pot::simd::simd_forced<T, ST> load(std::size_t i, std::size_t count) const
+        {
+            constexpr std::size_t lanes = pot::simd::details::simd_traits<T, ST>::scalar_count;
+            T values[lanes] = {};
+            for (std::size_t k = 0; k < count; ++k)
+                values[k] = data[idx[i + k]];
+            pot::simd::simd_forced<T, ST> v;
+            v.loadu(values);
+            return v;
+        }
+    };
+
+    // Independent accumulator registers per block: enough to cover the add / FMA latency of a
+    // loop that also loads its operands (see pot::simd::accumulators).
+    inline constexpr std::size_t simd_accumulators = 4;
+
+    // sum + x * y, rounded once where the build has FMA.
+    struct fma_accumulate
+    {
+        template <typename V>
+        V operator()(const V &sum, const V &x, const V &y) const { return x.fma(y, sum); }
+    };
+
+    /**
+     * Shared block body of the SIMD reductions: `sum = accumulate_op(sum, a.load(i), b.load(i))`
+     * over [begin, end) in whole registers, spread across `simd_accumulators` independent sums,
+     * then a masked tail whose lanes past the end are zeroed after `accumulate_op`. The lanes are
+     * folded with @p reduce_op; for std::plus that is the in-register horizontal sum.
+     */
+    template <typename T, typename R, pot::simd::SIMDType ST,
+        typename A, typename B, typename AccumulateOp, typename ReduceOp>
+    R simd_reduce_block(const A &a, const B &b, std::size_t begin, std::size_t end,
+                        const AccumulateOp &accumulate_op, const ReduceOp &reduce_op, R identity)
+    {
+        using simd_t_res = pot::simd::simd_forced<R, ST>;
+        constexpr std::size_t scalar_count = pot::simd::details::simd_traits<T, ST>::scalar_count;
+
+        pot::simd::accumulators<simd_t_res, simd_accumulators> acc;
+        constexpr std::size_t stride = simd_accumulators * scalar_count;
+
+        std::size_t i = begin;
+        for (; i + stride <= end; i += stride)
+        {
+            acc.each([&](simd_t_res &sum, std::size_t k)
+            {
+                const std::size_t j = i + k * scalar_count;
+                sum = accumulate_op(sum, a.template load<ST>(j), b.template load<ST>(j));
+            });
+        }
+        for (; i + scalar_count <= end; i += scalar_count)
+        {
+            acc[0] = accumulate_op(acc[0], a.template load<ST>(i), b.template load<ST>(i));
+        }
+        if (i < end)
+        {
+            // Masked tail: the lanes past `end` are zero-filled on load and zeroed again after
+            // the op, which may map (0, 0) to something else.
+            const std::size_t count = end - i;
+            acc[1] += accumulate_op(simd_t_res::zeros(), a.template load<ST>(i, count), b.template load<ST>(i, count))
+                          .first(count, simd_t_res::zeros());
+        }
+
+        const simd_t_res sum = acc.total();
+        if constexpr (std::is_same_v<ReduceOp, std::plus<R>> || std::is_same_v<ReduceOp, std::plus<>>)
+        {
+            return reduce_op(identity, sum.sum());
+        }
+        else
+        {
+            R lane[scalar_count];
+            sum.storeu(lane);
+
+            R block_sum = identity;
+            for (std::size_t k = 0; k < scalar_count; ++k) block_sum = reduce_op(block_sum, lane[k]);
+            return block_sum;
+        }
+    }
+
+    // One block of a reproducible reduction: its 16 virtual lanes folded as a fixed tree.
+    template <typename T, typename R, pot::simd::SIMDType ST, typename SimdElemOp, typename ReduceOp>
+    R reproducible_reduce_block(const T *a, const T *b, std::size_t begin, std::size_t end,
+                                SimdElemOp &simd_elem_op, ReduceOp &reduce_op, summation method)
+    {
+        static_assert(pot::simd::details::simd_traits<T, ST>::scalar_count == pot::simd::details::simd_traits<R, ST>::scalar_count,
+                      "input and result registers must have the same number of lanes");
+
+        auto acc = reproducible_lanes_sum<T, R, ST>(a, b, begin, end, simd_elem_op, method);
+        return acc.fold(reduce_op);
+    }
+} // namespace pot::algorithms::details
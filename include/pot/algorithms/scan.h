@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pot/algorithms/parfor.h"
+#include "pot/simd/dispatch.h"
+#include "pot/simd/simd_forced.h"
+#include "pot/utils/cache_line.h"
+
+namespace pot::algorithms::details
+{
+    // Below this many elements per block the second pass over the data costs more than it saves.
+    inline constexpr std::size_t scan_min_block = 4096;
+
+    inline std::size_t scan_block_count(pot::executor &exec, std::size_t n)
+    {
+        const std::size_t threads = std::max<std::size_t>(1, exec.thread_count());
+        return std::clamp<std::size_t>(n / scan_min_block, 1, threads * 4);
+    }
+
+    template <bool Inclusive, typename T, typename Op>
+    T scan_block(const T *in, T *out, std::size_t begin, std::size_t end, Op &op, T carry)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const T value = in[i];
+            if constexpr (Inclusive)
+            {
+                carry = op(carry, value);
+                out[i] = carry;
+            }
+            else
+            {
+                out[i] = carry;
+                carry = op(carry, value);
+            }
+        }
+        return carry;
+    }
+
+    template <typename T, typename Op>
+    T reduce_block(const T *in, std::size_t begin, std::size_t end, Op &op, T identity)
+    {
+        T sum = identity;
+        for (std::size_t i = begin; i < end; ++i)
+            sum = op(sum, in[i]);
+        return sum;
+    }
+
+    // In-register Hillis-Steele scan: log2(lanes) steps of "shift up by 1, 2, 4, ... and combine".
+    template <typename T, pot::simd::SIMDType ST, typename SimdOp>
+    pot::simd::simd_forced<T, ST> scan_lanes(pot::simd::simd_forced<T, ST> v, const pot::simd::simd_forced<T, ST> &fill, SimdOp &op)
+    {
+        constexpr std::size_t lanes = pot::simd::details::simd_traits<T, ST>::scalar_count;
+        [&]<std::size_t... Step>(std::index_sequence<Step...>)
+        {
+            ((v = op(v.template shift_lanes_up<(std::size_t(1) << Step)>(fill), v)), ...);
+        }(std::make_index_sequence<std::bit_width(lanes) - 1>{});
+        return v;
+    }
+
+    template <bool Inclusive, typename T, pot::simd::SIMDType ST, typename SimdOp>
+    T scan_block_simd(const T *in, T *out, std::size_t begin, std::size_t end, SimdOp &simd_op, T identity, T carry)
+    {
+        using simd_t = pot::simd::simd_forced<T, ST>;
+        constexpr std::size_t lanes = pot::simd::details::simd_traits<T, ST>::scalar_count;
+
+        const simd_t fill(identity);
+        std::size_t i = begin;
+        for (; i + lanes <= end; i += lanes)
+        {
+            simd_t v; v.loadu(in + i);
+            const simd_t carry_in(carry);
+            simd_t prefix = simd_op(carry_in, scan_lanes(v, fill, simd_op));
+            carry = prefix.data()[lanes - 1];
+
+            if constexpr (Inclusive)
+                prefix.storeu(out + i);
+            else
+                prefix.template shift_lanes_up<1>(carry_in).storeu(out + i);
+        }
+        if (i < end)
+        {
+            // Masked tail: the lanes past `end` hold the identity and are never stored.
+            const std::size_t count = end - i;
+            simd_t v; v.loadu(in + i, count);
+            const simd_t carry_in(carry);
+            simd_t prefix = simd_op(carry_in, scan_lanes(v.first(count, fill), fill, simd_op));
+            T lane[lanes];
+            prefix.storeu(lane);
+            carry = lane[count - 1];
+
+            if constexpr (Inclusive)
+                prefix.storeu(out + i, count);
+            else
+                prefix.template shift_lanes_up<1>(carry_in).storeu(out + i, count);
+        }
+        return carry;
+    }
+
+    template <typename T, pot::simd::SIMDType ST, typename SimdOp, typename ScalarOp>
+    T reduce_block_simd(const T *in, std::size_t begin, std::size_t end, SimdOp &simd_op, ScalarOp &op, T identity)
+    {
+        using simd_t = pot::simd::simd_forced<T, ST>;
+        constexpr std::size_t lanes = pot::simd::details::simd_traits<T, ST>::scalar_count;
+
+        simd_t acc(identity);
+        std::size_t i = begin;
+        for (; i + lanes <= end; i += lanes)
+        {
+            simd_t v; v.loadu(in + i);
+            acc = simd_op(acc, v);
+        }
+        if (i < end)
+        {
+            simd_t v; v.loadu(in + i, end - i);
+            acc = simd_op(acc, v.first(end - i, simd_t(identity)));
+        }
+
+        T sum = identity;
+        for (std::size_t k = 0; k < lanes; ++k) sum = op(sum, acc.data()[k]);
+        return sum;
+    }
+
+    /**
+     * Two-pass blocked scan. The input is cut into a few blocks per thread; the first pass reduces
+     * every block but the last, the block sums are scanned serially into carry-ins, and the second
+     * pass rescans every block starting from its carry-in. Both passes stream the blocks in parallel,
+     * so the whole scan reads the input twice and writes the output once.
+     */
+    template <typename T, typename Op, typename ReduceBlock, typename ScanBlock>
+    pot::coroutines::lazy_task<T> scan_two_pass(pot::executor &exec, std::size_t n, Op op, T identity,
+                                                ReduceBlock reduce_block, ScanBlock scan_block, std::size_t granule = 1)
+    {
+        const std::size_t block_count = scan_block_count(exec, n);
+        if (block_count == 1)
+            co_return scan_block(std::size_t(0), n, identity);
+
+        // Blocks are whole multiples of `granule` (the SIMD width), so only the last one has a tail.
+        const std::size_t block_size = ((n + block_count - 1) / block_count + granule - 1) / granule * granule;
+        std::vector<pot::cache_padded<T>> partial(block_count);
+
+        co_await pot::algorithms::parfor(exec, std::size_t(0), block_count - 1,
+        [&](std::size_t block_idx)
+        {
+            const std::size_t begin = std::min(n, block_idx * block_size);
+            partial[block_idx].value = reduce_block(begin, std::min(n, begin + block_size));
+        });
+
+        T carry = identity;
+        for (std::size_t b = 0; b + 1 < block_count; ++b)
+        {
+            const T block_sum = partial[b].value;
+            partial[b].value = carry;
+            carry = op(carry, block_sum);
+        }
+        partial[block_count - 1].value = carry;
+
+        co_await pot::algorithms::parfor(exec, std::size_t(0), block_count,
+        [&](std::size_t block_idx)
+        {
+            const std::size_t begin = std::min(n, block_idx * block_size);
+            const T block_total = scan_block(begin, std::min(n, begin + block_size), partial[block_idx].value);
+            if (block_idx + 1 == block_count)
+                carry = block_total;
+        });
+
+        co_return carry;
+    }
+
+    template <bool Inclusive, typename T, typename Op>
+    pot::coroutines::lazy_task<T> scan(pot::executor &exec, const T *in, T *out, std::size_t n, Op op, T identity)
+    {
+        return scan_two_pass<T>(exec, n, op, identity,
+            [=](std::size_t begin, std::size_t end) mutable { return reduce_block(in, begin, end, op, identity); },
+            [=](std::size_t begin, std::size_t end, T carry) mutable { return scan_block<Inclusive>(in, out, begin, end, op, carry); });
+    }
+
+    template <bool Inclusive, typename T, pot::simd::SIMDType ST, typename SimdOp, typename ScalarOp>
+    pot::coroutines::lazy_task<T> scan_simd(pot::executor &exec, const T *in, T *out, std::size_t n,
+                                            SimdOp simd_op, ScalarOp scalar_op, T identity)
+    {
+        static_assert(std::is_floating_point_v<T> || sizeof(T) == 4,
+                      "simd_traits implements integer lanes as 32-bit; use the scalar scan for other integers");
+
+        return pot::simd::dispatch<ST>([&]<pot::simd::SIMDType W>()
+        {
+            return scan_two_pass<T>(exec, n, scalar_op, identity,
+                [=](std::size_t begin, std::size_t end) mutable
+                {
+                    return reduce_block_simd<T, W>(in, begin, end, simd_op, scalar_op, identity);
+                },
+                [=](std::size_t begin, std::size_t end, T carry) mutable
+                {
+                    return scan_block_simd<Inclusive, T, W>(in, out, begin, end, simd_op, identity, carry);
+                },
+                pot::simd::details::simd_traits<T, W>::scalar_count);
+        });
+    }
+} // namespace pot::algorithms::details
+
+namespace pot::algorithms
+{
+    /**
+     * @brief Asynchronously computes an inclusive prefix scan: out[i] = in[0] op ... op in[i].
+     *
+     * Uses the two-pass blocked algorithm (per-block reduce, serial scan of the block sums,
+     * per-block rescan). @p in and @p out may be the same array.
+     *
+     * @tparam T   Element type.
+     * @tparam Op  Associative callable: (T, T) -> T.
+     *
+     * @param exec     Executor for task scheduling.
+     * @param in       Pointer to the input array.
+     * @param out      Pointer to the output array.
+     * @param n        Number of elements.
+     * @param op       Combining operation.
+     * @param identity Identity element of @p op.
+     *
+     * @return lazy_task<T> The reduction of the whole input (identity if @p n is 0).
+     */
+    template <typename T, typename Op = std::plus<T>>
+    [[nodiscard]] pot::coroutines::lazy_task<T>
+    inclusive_scan(pot::executor &exec, const T *in, T *out, std::size_t n, Op op, T identity)
+    {
+        return details::scan<true, T>(exec, in, out, n, op, identity);
+    }
+
+    /**
+     * @brief Asynchronously computes an exclusive prefix scan: out[0] = identity, out[i] = in[0] op ... op in[i-1].
+     * @copydetails inclusive_scan(pot::executor&, const T*, T*, std::size_t, Op, T)
+     */
+    template <typename T, typename Op = std::plus<T>>
+    [[nodiscard]] pot::coroutines::lazy_task<T>
+    exclusive_scan(pot::executor &exec, const T *in, T *out, std::size_t n, Op op, T identity)
+    {
+        return details::scan<false, T>(exec, in, out, n, op, identity);
+    }
+
+    /**
+     * @brief Convenience overload of inclusive_scan for std::span.
+     * @copydetails inclusive_scan(pot::executor&, const T*, T*, std::size_t, Op, T)
+     * @throws std::invalid_argument if the spans differ in size.
+     */
+    template <typename T, typename Op = std::plus<T>>
+    [[nodiscard]] pot::coroutines::lazy_task<T>
+    inclusive_scan(pot::executor &exec, std::span<const T> in, std::span<T> out, Op op, T identity)
+    {
+        if (in.size() != out.size())
+            throw std::invalid_argument("inclusive_scan: spans must have equal sizes");
+        return inclusive_scan<T>(exec, in.data(), out.data(), in.size(), op, identity);
+    }
+
+    /**
+     * @brief Convenience overload of exclusive_scan for std::span.
+     * @copydetails exclusive_scan(pot::executor&, const T*, T*, std::size_t, Op, T)
+     * @throws std::invalid_argument if the spans differ in size.
+     */
+    template <typename T, typename Op = std::plus<T>>
+    [[nodiscard]] pot::coroutines::lazy_task<T>
+    exclusive_scan(pot::executor &exec, std::span<const T> in, std::span<T> out, Op op, T identity)
+    {
+        if (in.size() != out.size())
+            throw std::invalid_argument("exclusive_scan: spans must have equal sizes");
+        return exclusive_scan<T>(exec, in.data(), out.data(), in.size(), op, identity);
+    }
+
+    /**
+     * @brief Asynchronously computes an inclusive prefix scan with SIMD-vectorized blocks.
+     *
+     * Same algorithm as inclusive_scan; inside a block every register is scanned with
+     * log2(lanes) lane shifts and then offset by the running carry. The block reduce accumulates
+     * lane-wise, so @p simd_op and @p scalar_op must be commutative as well as associative.
+     *
+     * @tparam T         Element type: float, double or a 32-bit integer.
+     * @tparam ST        SIMD type (pot::simd::SIMDType). `Auto` picks the width at run time, capped at
+     *                   the widths this file is compiled for: @p simd_op is instantiated here, so a
+     *                   caller built at the SSE 4.2 baseline scans at SSE. Compile it with the AVX2 or
+     *                   AVX-512 flags of cmake/CompilerFlags.cmake for the wider widths.
+     * @tparam SimdOp    Callable: (simd_forced<T>, simd_forced<T>) -> simd_forced<T>.
+     * @tparam ScalarOp  Callable: (T, T) -> T, the same operation on scalars.
+     *
+     * @param exec      Executor for task scheduling.
+     * @param in        Pointer to the input array.
+     * @param out       Pointer to the output array (may equal @p in).
+     * @param n         Number of elements.
+     * @param simd_op   Operation applied to SIMD registers.
+     * @param scalar_op Operation applied to leftover scalar elements and carries.
+     * @param identity  Identity element of the operation.
+     *
+     * @return lazy_task<T> The reduction of the whole input (identity if @p n is 0).
+     */
+    template <typename T, pot::simd::SIMDType ST, typename SimdOp, typename ScalarOp>
+    [[nodiscard]] pot::coroutines::lazy_task<T>
+    inclusive_scan_simd(pot::executor &exec, const T *in, T *out, std::size_t n, SimdOp simd_op, ScalarOp scalar_op, T identity)
+        requires(std::is_arithmetic_v<T>)
+    {
+        return details::scan_simd<true, T, ST>(exec, in, out, n, simd_op, scalar_op, identity);
+    }
+
+    /**
+     * @brief Asynchronously computes an exclusive prefix scan with SIMD-vectorized blocks.
+     * @copydetails inclusive_scan_simd(pot::executor&, const T*, T*, std::size_t, SimdOp, ScalarOp, T)
+     */
+    template <typename T, pot::simd::SIMDType ST, typename SimdOp, typename ScalarOp>
+    [[nodiscard]] pot::coroutines::lazy_task<T>
+    exclusive_scan_simd(pot::executor &exec, const T *in, T *out, std::size_t n, SimdOp simd_op, ScalarOp scalar_op, T identity)
+        requires(std::is_arithmetic_v<T>)
+    {
+        return details::scan_simd<false, T, ST>(exec, in, out, n, simd_op, scalar_op, identity);
+    }
+} // namespace pot::algorithms
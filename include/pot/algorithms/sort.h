@@ -0,0 +1,444 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pot/algorithms/parfor.h"
+#include "pot/algorithms/sort_network.h"
+#include "pot/simd/dispatch.h"
+
+namespace pot::algorithms::details
+{
+    // Below this many elements per chunk a thread is better off sorting alone.
+    inline constexpr std::size_t sort_min_chunk = std::size_t(1) << 13;
+
+    // ---- SIMD sorting network for leaves ----------------------------------------------------
+
+    // The network itself lives in sort_network.h.
+    template <typename It, typename Compare>
+    inline constexpr bool sort_network_eligible_v =
+        std::contiguous_iterator<It> && sort_network_key_v<std::iter_value_t<It>> &&
+        (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<std::iter_value_t<It>>>);
+
+    // Introsort whose small partitions go to the sorting network instead of insertion sort.
+    template <typename T>
+    void sort_network_introsort(T *first, std::size_t n, int depth)
+    {
+        while (n > sort_network<T>::tile_size)
+        {
+            if (depth-- == 0)
+            {
+                std::make_heap(first, first + n);
+                std::sort_heap(first, first + n);
+                return;
+            }
+
+            // Median of three as the pivot value: neither end of the partition below can be empty,
+            // and the pivot itself stops both scans on the first sweep.
+            const T a = first[0], b = first[n / 2], c = first[n - 1];
+            const T pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+            T *lo = first;
+            T *hi = first + n - 1;
+            while (true)
+            {
+                while (*lo < pivot) ++lo;
+                while (pivot < *hi) --hi;
+                if (lo >= hi) break;
+                std::swap(*lo++, *hi--);
+            }
+
+            const auto left = static_cast<std::size_t>(hi - first) + 1;
+            if (left < n - left)
+            {
+                sort_network_introsort(first, left, depth);
+                first += left;
+                n -= left;
+            }
+            else
+            {
+                sort_network_introsort(first + left, n - left, depth);
+                n = left;
+            }
+        }
+        if (n > 1)
+            sort_network_leaf(first, n);
+    }
+
+    template <typename It, typename Compare>
+    void sort_sequential(It first, It last, Compare &comp)
+    {
+        if constexpr (sort_network_eligible_v<It, Compare>)
+        {
+            // The tile network runs on AVX registers in the library; hosts limited to SSE take std::sort.
+            if (pot::simd::active_simd_type() != pot::simd::SIMDType::SSE)
+            {
+                const auto n = static_cast<std::size_t>(last - first);
+                sort_network_introsort(std::to_address(first), n, 2 * std::bit_width(n));
+                return;
+            }
+        }
+        std::sort(first, last, comp);
+    }
+
+    // ---- parallel merge ---------------------------------------------------------------------
+
+    // Number of elements of `a` among the first k outputs of a stable merge of a and b.
+    template <typename ItA, typename ItB, typename Compare>
+    std::size_t merge_co_rank(std::size_t k, ItA a, std::size_t la, ItB b, std::size_t lb, Compare &comp)
+    {
+        std::size_t lo = k > lb ? k - lb : 0;
+        std::size_t hi = std::min(k, la);
+        while (lo < hi)
+        {
+            const std::size_t i = lo + (hi - lo) / 2;
+            const std::size_t j = k - i;
+            if (j > 0 && !comp(b[j - 1], a[i]))
+                lo = i + 1;
+            else
+                hi = i;
+        }
+        return lo;
+    }
+
+    /**
+     * One round of the bottom-up merge: pairs of sorted runs [bound(2pw), bound(2pw+w)) and
+     * [bound(2pw+w), bound(2pw+2w)) from @p src are merged into @p dst. Every pair is cut into
+     * equal slices of output by co-ranking, so even the final round runs on all threads. All cuts
+     * are found before any slice is merged: merging moves from @p src, and a moved-from element
+     * no longer compares like the original.
+     */
+    template <typename SrcIt, typename DstIt, typename Bound, typename Compare>
+    pot::coroutines::lazy_task<void> merge_round(pot::executor &exec, SrcIt src, DstIt dst, std::size_t chunks,
+                                                 std::size_t width, Bound bound, Compare &comp)
+    {
+        const std::size_t pairs = chunks / (2 * width);
+        const std::size_t slices = std::max<std::size_t>(1, (2 * std::max<std::size_t>(1, exec.thread_count()) + pairs - 1) / pairs);
+
+        struct runs
+        {
+            std::size_t lo, mid, hi;
+        };
+        auto pair_runs = [&](std::size_t pair) -> runs
+        {
+            return {bound(pair * 2 * width), bound(pair * 2 * width + width), bound((pair + 1) * 2 * width)};
+        };
+
+        // cuts[pair * (slices + 1) + s]: elements of the first run among the first
+        // (hi - lo) * s / slices outputs of the pair.
+        std::vector<std::size_t> cuts(pairs * (slices + 1));
+        co_await pot::algorithms::parfor(exec, std::size_t(0), cuts.size(),
+        [&](std::size_t cut)
+        {
+            const runs r = pair_runs(cut / (slices + 1));
+            const std::size_t k = (r.hi - r.lo) * (cut % (slices + 1)) / slices;
+            cuts[cut] = merge_co_rank(k, src + r.lo, r.mid - r.lo, src + r.mid, r.hi - r.mid, comp);
+        });
+
+        co_await pot::algorithms::parfor(exec, std::size_t(0), pairs * slices,
+        [&](std::size_t job)
+        {
+            const std::size_t pair = job / slices;
+            const std::size_t slice = job % slices;
+            const runs r = pair_runs(pair);
+
+            const SrcIt a = src + r.lo;
+            const SrcIt b = src + r.mid;
+            const std::size_t k0 = (r.hi - r.lo) * slice / slices;
+            const std::size_t k1 = (r.hi - r.lo) * (slice + 1) / slices;
+            const std::size_t i0 = cuts[pair * (slices + 1) + slice];
+            const std::size_t i1 = cuts[pair * (slices + 1) + slice + 1];
+
+            std::merge(std::make_move_iterator(a + i0), std::make_move_iterator(a + i1),
+                       std::make_move_iterator(b + (k0 - i0)), std::make_move_iterator(b + (k1 - i1)),
+                       dst + r.lo + k0, comp);
+        });
+    }
+
+    // ---- radix sort -------------------------------------------------------------------------
+
+    template <typename K>
+    inline constexpr bool radix_key_v =
+        (std::is_integral_v<K> && !std::is_same_v<K, bool> && (sizeof(K) == 4 || sizeof(K) == 8)) ||
+        std::is_same_v<K, float> || std::is_same_v<K, double>;
+
+    // Order-preserving map from a key to an unsigned integer of the same width.
+    template <typename K>
+    auto radix_bits(K key)
+    {
+        using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+        constexpr U sign = U(1) << (sizeof(K) * 8 - 1);
+
+        const U bits = std::bit_cast<U>(key);
+        if constexpr (std::is_floating_point_v<K>)
+            return (bits & sign) ? U(~bits) : U(bits | sign);
+        else if constexpr (std::is_signed_v<K>)
+            return U(bits ^ sign);
+        else
+            return bits;
+    }
+
+    inline constexpr std::size_t radix_bits_per_pass = 8;
+    inline constexpr std::size_t radix_buckets = std::size_t(1) << radix_bits_per_pass;
+
+    /**
+     * LSD radix sort, one byte per pass. Every pass counts digits per block in parallel, turns the
+     * counts into per-block write offsets (digit-major, so the sort stays stable), and scatters each
+     * block in parallel. A pass whose digit is the same for every key is skipped. Values, if any,
+     * move together with their keys.
+     */
+    template <typename K, typename V>
+    pot::coroutines::lazy_task<void> radix_sort(pot::executor &exec, K *keys, V *values, std::size_t n)
+    {
+        constexpr bool has_values = !std::is_void_v<V>;
+        using value_storage = std::conditional_t<has_values, V, char>;
+
+        if (n < 2)
+            co_return;
+
+        const std::size_t threads = std::max<std::size_t>(1, exec.thread_count());
+        const std::size_t blocks = std::clamp<std::size_t>(n / sort_min_chunk, 1, threads);
+        const std::size_t block_size = (n + blocks - 1) / blocks;
+
+        std::vector<K> key_buffer(n);
+        std::vector<value_storage> value_buffer(has_values ? n : 0);
+        std::vector<std::array<std::size_t, radix_buckets>> counts(blocks);
+
+        K *key_src = keys;
+        K *key_dst = key_buffer.data();
+        value_storage *value_src = nullptr;
+        value_storage *value_dst = value_buffer.data();
+        if constexpr (has_values)
+            value_src = values;
+
+        for (std::size_t pass = 0; pass < sizeof(K); ++pass)
+        {
+            const std::size_t shift = pass * radix_bits_per_pass;
+            auto digit = [shift](K key) { return static_cast<std::size_t>(radix_bits(key) >> shift) & (radix_buckets - 1); };
+
+            co_await pot::algorithms::parfor(exec, std::size_t(0), blocks,
+            [&](std::size_t block)
+            {
+                auto &count = counts[block];
+                count.fill(0);
+                const std::size_t end = std::min(n, (block + 1) * block_size);
+                for (std::size_t i = block * block_size; i < end; ++i)
+                    ++count[digit(key_src[i])];
+            });
+
+            std::size_t offset = 0;
+            bool trivial = false;
+            for (std::size_t d = 0; d < radix_buckets; ++d)
+            {
+                std::size_t total = 0;
+                for (std::size_t block = 0; block < blocks; ++block)
+                {
+                    const std::size_t c = counts[block][d];
+                    counts[block][d] = offset + total;
+                    total += c;
+                }
+                trivial |= total == n;
+                offset += total;
+            }
+            if (trivial)
+                continue;
+
+            co_await pot::algorithms::parfor(exec, std::size_t(0), blocks,
+            [&](std::size_t block)
+            {
+                auto &next = counts[block];
+                const std::size_t end = std::min(n, (block + 1) * block_size);
+                for (std::size_t i = block * block_size; i < end; ++i)
+                {
+                    const std::size_t to = next[digit(key_src[i])]++;
+                    key_dst[to] = key_src[i];
+                    if constexpr (has_values)
+                        value_dst[to] = std::move(value_src[i]);
+                }
+            });
+
+            std::swap(key_src, key_dst);
+            std::swap(value_src, value_dst);
+        }
+
+        if (key_src != keys)
+        {
+            co_await pot::algorithms::parfor(exec, std::size_t(0), blocks,
+            [&](std::size_t block)
+            {
+                const std::size_t begin = block * block_size;
+                const std::size_t end = std::min(n, begin + block_size);
+                std::copy(key_src + begin, key_src + end, keys + begin);
+                if constexpr (has_values)
+                    std::move(value_src + begin, value_src + end, values + begin);
+            });
+        }
+    }
+} // namespace pot::algorithms::details
+
+namespace pot::algorithms
+{
+    /**
+     * @brief Asynchronously sorts [first, last) in parallel.
+     *
+     * Parallel merge sort: the range is cut into a power-of-two number of chunks (about one per
+     * thread), each chunk is sorted by one task, and the sorted chunks are merged pairwise in
+     * log2(chunks) rounds through a temporary buffer. Each merge is split into equal slices by
+     * co-ranking (merge path), so all threads stay busy up to the last round.
+     *
+     * Chunks of `float`, `double` and `int32_t` sorted with `std::less` use an introsort whose
+     * small partitions are finished by an AVX sorting network; other chunks use `std::sort`.
+     * Like `std::sort` the result is not stable, and float keys must not contain NaN.
+     *
+     * @tparam It       Random-access iterator; its value type must be default-constructible and movable.
+     * @tparam Compare  Strict weak ordering: (const T&, const T&) -> bool.
+     *
+     * @param exec   Executor for task scheduling.
+     * @param first  Start of the range.
+     * @param last   End of the range.
+     * @param comp   Comparison object.
+     *
+     * @return lazy_task<void> Completes once the range is sorted.
+     */
+    template <std::random_access_iterator It, typename Compare = std::less<>>
+    [[nodiscard]] pot::coroutines::lazy_task<void>
+    sort(pot::executor &exec, It first, It last, Compare comp = {})
+    {
+        using value_type = std::iter_value_t<It>;
+
+        const auto n = static_cast<std::size_t>(last - first);
+        const std::size_t threads = std::max<std::size_t>(1, exec.thread_count());
+
+        std::size_t chunks = std::bit_ceil(threads);
+        while (chunks > 1 && n / chunks < details::sort_min_chunk)
+            chunks /= 2;
+
+        if (chunks == 1)
+        {
+            details::sort_sequential(first, last, comp);
+            co_return;
+        }
+
+        auto bound = [n, chunks](std::size_t chunk) { return n * chunk / chunks; };
+
+        co_await pot::algorithms::parfor(exec, std::size_t(0), chunks,
+        [&](std::size_t chunk)
+        {
+            details::sort_sequential(first + bound(chunk), first + bound(chunk + 1), comp);
+        });
+
+        std::vector<value_type> buffer(n);
+        bool in_buffer = false;
+        for (std::size_t width = 1; width < chunks; width *= 2)
+        {
+            if (in_buffer)
+                co_await details::merge_round(exec, buffer.begin(), first, chunks, width, bound, comp);
+            else
+                co_await details::merge_round(exec, first, buffer.begin(), chunks, width, bound, comp);
+            in_buffer = !in_buffer;
+        }
+
+        if (in_buffer)
+        {
+            co_await pot::algorithms::parfor(exec, std::size_t(0), chunks,
+            [&](std::size_t chunk)
+            {
+                std::move(buffer.begin() + bound(chunk), buffer.begin() + bound(chunk + 1), first + bound(chunk));
+            });
+        }
+    }
+
+    /**
+     * @brief Convenience overload of sort for random-access ranges.
+     *
+     * The returned task keeps iterators into @p range, so it must be an lvalue or a borrowed view.
+     * @copydetails sort(pot::executor&, It, It, Compare)
+     */
+    template <std::ranges::random_access_range Range, typename Compare = std::less<>>
+        requires std::ranges::borrowed_range<Range>
+    [[nodiscard]] pot::coroutines::lazy_task<void>
+    sort(pot::executor &exec, Range &&range, Compare comp = {})
+    {
+        return pot::algorithms::sort(exec, std::ranges::begin(range), std::ranges::end(range), std::move(comp));
+    }
+
+    /**
+     * @brief Asynchronously sorts 32- or 64-bit integer or floating-point keys with a parallel LSD radix sort.
+     *
+     * Each of the sizeof(K) byte passes runs a parallel histogram, a scan of the per-block
+     * counts and a parallel stable scatter through a temporary buffer. Passes whose byte is the
+     * same for every key are skipped. Floats are ordered like `std::less`, with -0.0 before +0.0
+     * and NaNs (by sign) at the ends.
+     *
+     * @tparam K  Key type: 32/64-bit integer, float or double.
+     *
+     * @param exec  Executor for task scheduling.
+     * @param keys  Keys to sort in place.
+     *
+     * @return lazy_task<void> Completes once the keys are sorted.
+     */
+    template <typename K>
+        requires details::radix_key_v<K>
+    [[nodiscard]] pot::coroutines::lazy_task<void>
+    radix_sort(pot::executor &exec, std::span<K> keys)
+    {
+        return details::radix_sort<K, void>(exec, keys.data(), nullptr, keys.size());
+    }
+
+    /**
+     * @brief Key-value radix sort: reorders @p values together with @p keys.
+     *
+     * The sort is stable, so values of equal keys keep their relative order.
+     * @copydetails radix_sort(pot::executor&, std::span<K>)
+     * @param values Values moved along with their keys; must be default-constructible and movable.
+     * @throws std::invalid_argument if the spans differ in size.
+     */
+    template <typename K, typename V>
+        requires details::radix_key_v<K>
+    [[nodiscard]] pot::coroutines::lazy_task<void>
+    radix_sort(pot::executor &exec, std::span<K> keys, std::span<V> values)
+    {
+        if (keys.size() != values.size())
+            throw std::invalid_argument("radix_sort: keys and values must have equal sizes");
+        return details::radix_sort<K, V>(exec, keys.data(), values.data(), keys.size());
+    }
+
+    /**
+     * @brief Convenience overload of radix_sort for std::vector.
+     * @copydetails radix_sort(pot::executor&, std::span<K>)
+     */
+    template <typename K>
+        requires details::radix_key_v<K>
+    [[nodiscard]] pot::coroutines::lazy_task<void>
+    radix_sort(pot::executor &exec, std::vector<K> &keys)
+    {
+        return radix_sort(exec, std::span<K>(keys));
+    }
+
+    /**
+     * @brief Convenience overload of the key-value radix_sort for std::vector.
+     * @copydetails radix_sort(pot::executor&, std::span<K>, std::span<V>)
+     */
+    template <typename K, typename V>
+        requires details::radix_key_v<K>
+    [[nodiscard]] pot::coroutines::lazy_task<void>
+    radix_sort(pot::executor &exec, std::vector<K> &keys, std::vector<V> &values)
+    {
+        return radix_sort(exec, std::span<K>(keys), std::span<V>(values));
+    }
+} // namespace pot::algorithms
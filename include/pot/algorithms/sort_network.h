@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "pot/simd/simd_forced.h"
+
+// SIMD sorting network for the leaves of pot::algorithms::sort. It uses nothing but the SIMD
+// headers, so the library builds it with AVX2 flags on its own (src/algorithms/simd_kernels_avx2.cpp).
+
+namespace pot::algorithms::details
+{
+    // Keys for which AVX min/max are exact: the integer lanes of simd_traits are signed 32-bit.
+    template <typename T>
+    inline constexpr bool sort_network_key_v =
+        std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>;
+
+    // Optimal comparator networks (Knuth, TAOCP 5.3.4) for 4 and 8 inputs.
+    inline constexpr std::pair<int, int> sort_network_4[] = {{0, 1}, {2, 3}, {0, 2}, {1, 3}, {1, 2}};
+    inline constexpr std::pair<int, int> sort_network_8[] = {
+        {0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3},
+        {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+    /**
+     * Sorts a square tile of lanes x lanes keys. The tile is loaded as `lanes` registers and the
+     * comparator network runs across registers with vector min/max, which sorts every column at
+     * once. The columns are then transposed into runs and merged with log2(lanes) merge passes.
+     */
+    template <typename T>
+    struct sort_network
+    {
+        static constexpr pot::simd::SIMDType simd_type = pot::simd::SIMDType::AVX;
+        static constexpr std::size_t lanes = pot::simd::details::simd_traits<T, simd_type>::scalar_count;
+        static constexpr std::size_t tile_size = lanes * lanes;
+
+        static void sort_tile(T *tile)
+        {
+            using simd_t = pot::simd::simd_forced<T, simd_type>;
+
+            simd_t rows[lanes];
+            for (std::size_t r = 0; r < lanes; ++r)
+                rows[r].loadu(tile + r * lanes);
+
+            constexpr auto &network = []() -> auto & {
+                if constexpr (lanes == 8) return sort_network_8;
+                else return sort_network_4;
+            }();
+            for (const auto &[a, b] : network)
+            {
+                const simd_t lo = rows[a].min(rows[b]);
+                rows[b] = rows[a].max(rows[b]);
+                rows[a] = lo;
+            }
+
+            alignas(32) T row_major[tile_size];
+            for (std::size_t r = 0; r < lanes; ++r)
+                rows[r].storeu(row_major + r * lanes);
+
+            T runs[tile_size];
+            for (std::size_t c = 0; c < lanes; ++c)
+                for (std::size_t r = 0; r < lanes; ++r)
+                    runs[c * lanes + r] = row_major[r * lanes + c];
+
+            T *src = runs;
+            T *dst = row_major;
+            for (std::size_t width = lanes; width < tile_size; width *= 2)
+            {
+                for (std::size_t lo = 0; lo < tile_size; lo += 2 * width)
+                    std::merge(src + lo, src + lo + width, src + lo + width, src + lo + 2 * width, dst + lo);
+                std::swap(src, dst);
+            }
+            std::memcpy(tile, src, sizeof(T) * tile_size);
+        }
+
+        // Sorts fewer than tile_size keys by padding the tile with the largest key.
+        static void sort_leaf(T *first, std::size_t n)
+        {
+            T tile[tile_size];
+            std::copy(first, first + n, tile);
+            std::fill(tile + n, tile + tile_size,
+                      std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                           : std::numeric_limits<T>::max());
+            sort_tile(tile);
+            std::copy(tile, tile + n, first);
+        }
+    };
+
+    // sort_network<T>::sort_leaf, built into the library for float, double and int32_t.
+    template <typename T>
+    void sort_network_leaf(T *first, std::size_t n);
+} // namespace pot::algorithms::details
@@ -7,7 +7,7 @@
 #include <type_traits>
 #include <utility>
 #include <variant>
-#include <functional>
+#include <vector>
 #include <iostream>
 
 #include "pot/memory/coro_memory.h"
@@ -19,25 +19,33 @@ namespace pot
 
 namespace pot::coroutines::details
 {
+	/**
+	 * @brief Scheduling data carried by every promise.
+	 *
+	 * Kept to two words: the executor a waiting thread may help is stored as a raw pointer and reached
+	 * through its virtual `try_steal`, so assigning it never allocates.
+	 */
 	struct task_meta
 	{
 		std::atomic<size_t> run_count{0};
-		std::function<bool()> steal;
+		pot::executor *executor{nullptr};
 		static inline std::vector<int> sorted_cpu_list{};
 
 		task_meta() = default;
 		task_meta(const task_meta &other)
+			: run_count(other.run_count.load(std::memory_order_relaxed)), executor(other.executor)
 		{
-			run_count.store(other.run_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
-			steal = other.steal;
 		}
 		task_meta &operator=(const task_meta &other)
 		{
 			run_count.store(other.run_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
-			steal = other.steal;
+			executor = other.executor;
 
 			return *this;
 		}
+
+		/// Runs one pending task of the attached executor, if any. Returns false when nothing was run.
+		bool steal() const;
 	};
 } // namespace pot::coroutines::details
 
@@ -101,7 +109,7 @@ namespace pot::coroutines::detail
 		{
 			while (!m_ready.load(std::memory_order_acquire))
 			{
-				if (!meta.steal()) 
+				if (!meta.steal())
 				{
 					std::this_thread::yield();
 				}
@@ -265,15 +273,9 @@ namespace pot::coroutines
 				throw std::runtime_error("Coroutine is invalid");
 			}
 
-			if (executor)
-			{
-				m_handle.promise().meta.steal = [executor]() 
-				{
-					return executor->try_steal();
-				};
-			}
+			m_handle.promise().meta.executor = executor;
 
-			handle_guard gurad{m_handle}; 
+			handle_guard gurad{m_handle};
 			return m_handle.promise().get();
 		}
 
@@ -391,12 +393,7 @@ namespace pot::coroutines
 				throw std::runtime_error("Coroutine is invalid or already done");
 			}
 
-			if (executor)
-			{
-				m_handle.promise().meta.steal = [executor]() {
-					return executor->try_steal();
-				};
-			}
+			m_handle.promise().meta.executor = executor;
 
 			m_handle.resume();
 
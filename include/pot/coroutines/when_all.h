@@ -1,82 +1,373 @@
 #pragma once
 
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
 #include <iterator>
 #include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include "pot/coroutines/task.h"
+#include "pot/executors/executor.h"
+#include "pot/memory/coro_memory.h"
+#include "pot/utils/unique_function.h"
+
+namespace pot::coroutines::details
+{
+/**
+ * @brief Shared join point of one `when_all` call.
+ *
+ * The counter starts at `count + 1`: one arrival per input plus one for the awaiting coroutine
+ * itself, so whoever arrives last (an input or the awaiter) is the one that resumes it. The
+ * continuation is resumed exactly once, no matter how many inputs there are.
+ */
+struct when_all_state
+{
+    explicit when_all_state(size_t count) noexcept : remaining(count + 1) {}
+
+    bool arrive() noexcept { return remaining.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+    std::atomic<size_t> remaining;
+    std::coroutine_handle<> continuation;
+};
+
+template <typename T> class when_all_task;
+
+template <typename T> struct when_all_promise_base
+{
+    using stored_type = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    static void *operator new(std::size_t size) { return pot::memory::allocate(size); }
+    static void operator delete(void *ptr, std::size_t size) noexcept
+    {
+        pot::memory::deallocate(ptr, size);
+    }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    struct final_awaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept
+        {
+            auto *state = h.promise().state;
+            return state->arrive() ? state->continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept { result.template emplace<2>(std::current_exception()); }
+
+    stored_type take()
+    {
+        if (result.index() == 2)
+            std::rethrow_exception(std::get<2>(result));
+        return std::move(std::get<1>(result));
+    }
+
+    when_all_state *state = nullptr;
+    std::variant<std::monostate, stored_type, std::exception_ptr> result;
+};
+
+template <typename T> struct when_all_promise : when_all_promise_base<T>
+{
+    when_all_task<T> get_return_object() noexcept;
+
+    template <typename U> void return_value(U &&value)
+    {
+        this->result.template emplace<1>(std::forward<U>(value));
+    }
+};
+
+template <> struct when_all_promise<void> : when_all_promise_base<void>
+{
+    when_all_task<void> get_return_object() noexcept;
+
+    void return_void() noexcept { this->result.template emplace<1>(); }
+};
+
+/// Lazily started wrapper that awaits one input and reports to the shared `when_all_state`.
+template <typename T> class when_all_task
+{
+  public:
+    using promise_type = when_all_promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    explicit when_all_task(handle_type handle) noexcept : m_handle(handle) {}
+
+    when_all_task(const when_all_task &) = delete;
+    when_all_task &operator=(const when_all_task &) = delete;
+
+    when_all_task(when_all_task &&other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    when_all_task &operator=(when_all_task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_handle)
+                m_handle.destroy();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+
+    ~when_all_task()
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    void start(when_all_state &state) noexcept
+    {
+        m_handle.promise().state = &state;
+        m_handle.resume();
+    }
+
+    typename promise_type::stored_type take() { return m_handle.promise().take(); }
+
+  private:
+    handle_type m_handle;
+};
+
+template <typename T> when_all_task<T> when_all_promise<T>::get_return_object() noexcept
+{
+    return when_all_task<T>{std::coroutine_handle<when_all_promise<T>>::from_promise(*this)};
+}
+
+inline when_all_task<void> when_all_promise<void>::get_return_object() noexcept
+{
+    return when_all_task<void>{std::coroutine_handle<when_all_promise<void>>::from_promise(*this)};
+}
+
+template <typename Awaitable, typename T = pot::traits::awaitable_value_t<Awaitable>>
+when_all_task<T> make_when_all_task(Awaitable awaitable)
+{
+    if constexpr (std::is_void_v<T>)
+        co_await std::move(awaitable);
+    else
+        co_return co_await std::move(awaitable);
+}
+
+/// Parks the `when_all` coroutine until the last input arrives; never suspends if all are done.
+struct when_all_awaiter
+{
+    when_all_state &state;
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept
+    {
+        state.continuation = h;
+        return !state.arrive();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+template <typename T> using when_all_value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+template <typename Iterator>
+using when_all_range_value_t = pot::traits::awaitable_value_t<std::iter_value_t<Iterator>>;
+
+template <typename Iterator>
+using when_all_range_result_t =
+    std::conditional_t<std::is_void_v<when_all_range_value_t<Iterator>>, void,
+                       std::vector<when_all_value_t<when_all_range_value_t<Iterator>>>>;
+
+template <typename Iterator>
+auto make_when_all_tasks(Iterator begin, Iterator end)
+{
+    std::vector<when_all_task<when_all_range_value_t<Iterator>>> helpers;
+    helpers.reserve(static_cast<size_t>(std::distance(begin, end)));
+    for (auto it = begin; it != end; ++it)
+        helpers.push_back(make_when_all_task(std::move(*it)));
+    return helpers;
+}
+
+/// Results of finished helpers in input order; rethrows the first stored exception.
+template <typename T> auto collect_when_all_results(std::vector<when_all_task<T>> &helpers)
+{
+    if constexpr (std::is_void_v<T>)
+    {
+        for (auto &helper : helpers)
+            helper.take();
+    }
+    else
+    {
+        std::vector<T> results;
+        results.reserve(helpers.size());
+        for (auto &helper : helpers)
+            results.push_back(helper.take());
+        return results;
+    }
+}
+} // namespace pot::coroutines::details
 
 namespace pot::coroutines
 {
 /**
  * @brief Await multiple coroutine tasks and resume once all have completed.
  *
- * `when_all` provides a convenient way to wait for a collection or a pack of
- * coroutine tasks. Each task is awaited sequentially, ensuring that all tasks
- * complete before returning.
+ * All inputs are started on the calling thread before the caller suspends. Inputs that hand
+ * themselves to an executor, such as `executor::lazy_run` tasks, therefore run concurrently; a plain
+ * lazy coroutine runs inline up to its first suspension, so plain ones run one after another. Use
+ * `when_all_on` to run plain lazy tasks on an executor. Completion is tracked by a single atomic
+ * countdown and the awaiting coroutine is resumed exactly once, by whichever input finishes last.
+ * The tasks are consumed (moved from).
+ *
+ * If any task throws, the exception of the first such task in input order is rethrown after all
+ * of them have finished.
  *
  * @tparam Iterator Forward iterator type yielding coroutine tasks.
- * @tparam Container Container type holding coroutine tasks.
- * @tparam FuturePtr Pointer-like or task type stored in container.
- * @tparam Futures Variadic list of coroutine tasks.
  *
  * @param begin Iterator to the beginning of a range of tasks.
  * @param end   Iterator to the end of a range of tasks.
  *
- * @return task<void> A coroutine that completes once all provided tasks finish.
+ * @return task<std::vector<T>> with the results in input order, or task<void> for `void` tasks.
  */
 template <typename Iterator>
     requires std::forward_iterator<Iterator>
-pot::coroutines::task<void> when_all(Iterator begin, Iterator end)
+pot::coroutines::task<details::when_all_range_result_t<Iterator>> when_all(Iterator begin, Iterator end)
 {
-    for (auto it = begin; it != end; ++it)
-    {
-        co_await std::move(*it);
-    }
-    co_return;
+    auto helpers = details::make_when_all_tasks(begin, end);
+
+    details::when_all_state state(helpers.size());
+    for (auto &helper : helpers)
+        helper.start(state);
+
+    co_await details::when_all_awaiter{state};
+
+    if constexpr (std::is_void_v<details::when_all_range_value_t<Iterator>>)
+        details::collect_when_all_results(helpers);
+    else
+        co_return details::collect_when_all_results(helpers);
 }
 
 /**
  * @brief Await multiple coroutine tasks and resume once all have completed.
  *
- * `when_all` provides a convenient way to wait for a collection or a pack of
- * coroutine tasks. Each task is awaited sequentially, ensuring that all tasks
- * complete before returning.
+ * Container overload of the range form, see above.
  *
- * @tparam Iterator Forward iterator type yielding coroutine tasks.
  * @tparam Container Container type holding coroutine tasks.
- * @tparam FuturePtr Pointer-like or task type stored in container.
- * @tparam Futures Variadic list of coroutine tasks.
+ * @tparam FuturePtr Task type stored in container.
  *
  * @param futures Container of coroutine tasks.
  *
- * @return task<void> A coroutine that completes once all provided tasks finish.
+ * @return task<std::vector<T>> with the results in input order, or task<void> for `void` tasks.
  */
 template <template <class, class...> class Container, typename FuturePtr, typename... OtherTypes>
-pot::coroutines::task<void> when_all(Container<FuturePtr, OtherTypes...> &futures)
+auto when_all(Container<FuturePtr, OtherTypes...> &futures)
 {
-    co_return co_await when_all(std::begin(futures), std::end(futures));
+    return when_all(std::begin(futures), std::end(futures));
+}
+
+/**
+ * @brief Start a range of lazy tasks on an executor and resume once all have completed.
+ *
+ * Where `when_all` starts its inputs on the calling thread, `when_all_on` hands them to
+ * @p executor with a single `run_bulk` call, so the queue is locked once and idle workers are
+ * woken together. Meant for `lazy_task` inputs; eager tasks have already started and only their
+ * completion is awaited on the executor. Results and exceptions are reported as by `when_all`.
+ * If the executor rejects the inputs (it is stopped), its exception is rethrown once the inputs it
+ * did accept have finished.
+ *
+ * @param executor Executor the inputs are started on.
+ * @param begin    Iterator to the beginning of a range of tasks.
+ * @param end      Iterator to the end of a range of tasks.
+ *
+ * @return task<std::vector<T>> with the results in input order, or task<void> for `void` tasks.
+ */
+template <typename Iterator>
+    requires std::forward_iterator<Iterator>
+pot::coroutines::task<details::when_all_range_result_t<Iterator>> when_all_on(pot::executor &executor,
+                                                                               Iterator begin, Iterator end)
+{
+    auto helpers = details::make_when_all_tasks(begin, end);
+
+    details::when_all_state state(helpers.size());
+    std::exception_ptr error;
+    {
+        std::vector<pot::utils::unique_function_once> starts;
+        starts.reserve(helpers.size());
+        for (auto &helper : helpers)
+            starts.emplace_back([&helper, &state] { helper.start(state); });
+        try
+        {
+            executor.run_bulk(starts);
+        }
+        catch (...)
+        {
+            // The executor may have taken part of the batch; the starts it left here never run, so
+            // they arrive for their helpers now.
+            error = std::current_exception();
+            for (auto &start : starts)
+            {
+                if (start)
+                    state.arrive();
+            }
+        }
+    }
+
+    // Wait for the starts handed out even if the rest failed, so none outlives this frame.
+    co_await details::when_all_awaiter{state};
+    if (error)
+        std::rethrow_exception(error);
+
+    if constexpr (std::is_void_v<details::when_all_range_value_t<Iterator>>)
+        details::collect_when_all_results(helpers);
+    else
+        co_return details::collect_when_all_results(helpers);
+}
+
+/**
+ * @brief Start a container of lazy tasks on an executor and resume once all have completed.
+ *
+ * Container overload of `when_all_on`, see above.
+ */
+template <template <class, class...> class Container, typename FuturePtr, typename... OtherTypes>
+auto when_all_on(pot::executor &executor, Container<FuturePtr, OtherTypes...> &futures)
+{
+    return when_all_on(executor, std::begin(futures), std::end(futures));
 }
 
 /**
  * @brief Await multiple coroutine tasks and resume once all have completed.
  *
- * `when_all` provides a convenient way to wait for a collection or a pack of
- * coroutine tasks. Each task is awaited sequentially, ensuring that all tasks
- * complete before returning.
+ * Variadic form: all tasks are started concurrently and joined with a single countdown.
  *
- * @tparam Iterator Forward iterator type yielding coroutine tasks.
- * @tparam Container Container type holding coroutine tasks.
- * @tparam FuturePtr Pointer-like or task type stored in container.
- * @tparam Futures Variadic list of coroutine tasks.
+ * @tparam Futures Variadic list of coroutine tasks (passed as rvalues).
  *
  * @param futures... Variadic coroutine tasks to be awaited.
  *
- * @return task<void> A coroutine that completes once all provided tasks finish.
+ * @return task<std::tuple<T...>> with one element per task; `void` tasks yield `std::monostate`.
  */
-template <typename... Futures> pot::coroutines::task<void> when_all(Futures &&...futures)
+template <typename... Futures>
+pot::coroutines::task<std::tuple<details::when_all_value_t<pot::traits::awaitable_value_t<std::remove_cvref_t<Futures>>>...>>
+when_all(Futures &&...futures)
 {
-    (co_await std::forward<Futures>(futures), ...);
-    co_return;
+    std::tuple<details::when_all_task<pot::traits::awaitable_value_t<std::remove_cvref_t<Futures>>>...> helpers{
+        details::make_when_all_task(std::forward<Futures>(futures))...};
+
+    details::when_all_state state(sizeof...(Futures));
+    std::apply([&state](auto &...helper) { (helper.start(state), ...); }, helpers);
+
+    co_await details::when_all_awaiter{state};
+
+    co_return std::apply(
+        [](auto &...helper)
+        {
+            return std::tuple<details::when_all_value_t<pot::traits::awaitable_value_t<std::remove_cvref_t<Futures>>>...>{
+                helper.take()...};
+        },
+        helpers);
 }
 } // namespace pot::coroutines
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "pot/coroutines/task.h"
+#include "pot/coroutines/when_all.h"
+#include "pot/memory/coro_memory.h"
+
+namespace pot::coroutines
+{
+/**
+ * @brief Result of `when_any`: position of the first completed input and its value.
+ */
+template <typename T> struct when_any_result
+{
+    size_t index;
+    T value;
+};
+
+template <> struct when_any_result<void>
+{
+    size_t index;
+};
+} // namespace pot::coroutines
+
+namespace pot::coroutines::details
+{
+/**
+ * @brief Shared state of one `when_any` call.
+ *
+ * The first input to finish claims the result. It then meets the awaiting coroutine on a two-party
+ * rendezvous, so the continuation is resumed exactly once, whichever side gets there second.
+ * Inputs that finish later only drop their reference.
+ */
+template <typename R> struct when_any_state
+{
+    bool try_claim() noexcept { return !claimed.exchange(true, std::memory_order_acq_rel); }
+    bool arrive() noexcept { return rendezvous.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+    std::atomic<bool> claimed{false};
+    std::atomic<int> rendezvous{2};
+    std::coroutine_handle<> continuation;
+
+    size_t index = 0;
+    std::optional<R> value;
+    std::exception_ptr exception;
+};
+
+/// Detached, self-destroying wrapper that awaits one input and races for the result.
+class when_any_task
+{
+  public:
+    struct promise_type
+    {
+        static void *operator new(std::size_t size) { return pot::memory::allocate(size); }
+        static void operator delete(void *ptr, std::size_t size) noexcept
+        {
+            pot::memory::deallocate(ptr, size);
+        }
+
+        when_any_task get_return_object() noexcept
+        {
+            return when_any_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) const noexcept
+            {
+                std::coroutine_handle<> next = h.promise().next;
+                h.destroy();
+                return next ? next : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        final_awaiter final_suspend() const noexcept { return {}; }
+
+        void return_value(std::coroutine_handle<> handle) noexcept { next = handle; }
+
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        std::coroutine_handle<> next;
+    };
+
+    explicit when_any_task(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+    void start() noexcept { m_handle.resume(); }
+
+  private:
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+template <size_t Alternative, typename R, typename Value>
+void emplace_when_any_value(std::optional<R> &slot, Value &&value)
+{
+    if constexpr (Alternative == std::variant_npos)
+        slot.emplace(std::forward<Value>(value));
+    else
+        slot.emplace(std::in_place_index<Alternative>, std::forward<Value>(value));
+}
+
+template <size_t Alternative, typename R, typename Awaitable>
+when_any_task make_when_any_task(std::shared_ptr<when_any_state<R>> state, size_t index, Awaitable awaitable)
+{
+    using value_type = pot::traits::awaitable_value_t<Awaitable>;
+
+    try
+    {
+        if constexpr (std::is_void_v<value_type>)
+        {
+            co_await std::move(awaitable);
+            if (!state->try_claim())
+                co_return nullptr;
+            emplace_when_any_value<Alternative>(state->value, std::monostate{});
+        }
+        else
+        {
+            auto value = co_await std::move(awaitable);
+            if (!state->try_claim())
+                co_return nullptr;
+            emplace_when_any_value<Alternative>(state->value, std::move(value));
+        }
+    }
+    catch (...)
+    {
+        if (!state->try_claim())
+            co_return nullptr;
+        state->exception = std::current_exception();
+    }
+
+    state->index = index;
+    co_return state->arrive() ? state->continuation : nullptr;
+}
+
+template <typename R> struct when_any_awaiter
+{
+    when_any_state<R> &state;
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept
+    {
+        state.continuation = h;
+        return !state.arrive();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+template <typename Iterator>
+using when_any_range_value_t = pot::traits::awaitable_value_t<std::iter_value_t<Iterator>>;
+
+template <typename... Futures>
+using when_any_variant_t =
+    std::variant<when_all_value_t<pot::traits::awaitable_value_t<std::remove_cvref_t<Futures>>>...>;
+} // namespace pot::coroutines::details
+
+namespace pot::coroutines
+{
+/**
+ * @brief Await a range of coroutine tasks and resume as soon as the first one completes.
+ *
+ * Every task is awaited through its regular awaiter slot (`m_awaiter`), so no thread spins while
+ * waiting. The caller is resumed exactly once, by the first task to finish; the remaining tasks keep
+ * running detached and their results are discarded, so whatever they reference must outlive them.
+ * If the first task to finish threw, its exception is rethrown. The tasks are consumed (moved from).
+ *
+ * @tparam Iterator Forward iterator type yielding coroutine tasks.
+ *
+ * @param begin Iterator to the beginning of a non-empty range of tasks.
+ * @param end   Iterator to the end of the range.
+ *
+ * @return task<when_any_result<T>> with the index of the winner and its value.
+ *
+ * @throws std::invalid_argument if the range is empty.
+ */
+template <typename Iterator>
+    requires std::forward_iterator<Iterator>
+pot::coroutines::task<when_any_result<details::when_any_range_value_t<Iterator>>> when_any(Iterator begin,
+                                                                                            Iterator end)
+{
+    using value_type = details::when_any_range_value_t<Iterator>;
+    using stored_type = details::when_all_value_t<value_type>;
+
+    if (begin == end)
+        throw std::invalid_argument("when_any: empty range");
+
+    auto state = std::make_shared<details::when_any_state<stored_type>>();
+
+    size_t index = 0;
+    for (auto it = begin; it != end; ++it, ++index)
+        details::make_when_any_task<std::variant_npos>(state, index, std::move(*it)).start();
+
+    co_await details::when_any_awaiter<stored_type>{*state};
+
+    if (state->exception)
+        std::rethrow_exception(state->exception);
+
+    if constexpr (std::is_void_v<value_type>)
+        co_return when_any_result<void>{state->index};
+    else
+        co_return when_any_result<value_type>{state->index, std::move(*state->value)};
+}
+
+/**
+ * @brief Await a container of coroutine tasks and resume as soon as the first one completes.
+ *
+ * Container overload of the range form, see above.
+ */
+template <template <class, class...> class Container, typename FuturePtr, typename... OtherTypes>
+auto when_any(Container<FuturePtr, OtherTypes...> &futures)
+{
+    return when_any(std::begin(futures), std::end(futures));
+}
+
+/**
+ * @brief Await several coroutine tasks and resume as soon as the first one completes.
+ *
+ * Variadic form of `when_any`. The value is a `std::variant` whose active alternative is the
+ * position of the winning task; `void` tasks yield `std::monostate`.
+ *
+ * @tparam Futures Non-empty list of coroutine tasks (passed as rvalues).
+ *
+ * @return task<when_any_result<std::variant<T...>>>.
+ */
+template <typename... Futures>
+    requires(sizeof...(Futures) > 0)
+pot::coroutines::task<when_any_result<details::when_any_variant_t<Futures...>>> when_any(Futures &&...futures)
+{
+    using stored_type = details::when_any_variant_t<Futures...>;
+
+    auto state = std::make_shared<details::when_any_state<stored_type>>();
+
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (details::make_when_any_task<I>(state, I, std::forward<Futures>(futures)).start(), ...);
+    }(std::index_sequence_for<Futures...>{});
+
+    co_await details::when_any_awaiter<stored_type>{*state};
+
+    if (state->exception)
+        std::rethrow_exception(state->exception);
+
+    co_return when_any_result<stored_type>{state->index, std::move(*state->value)};
+}
+} // namespace pot::coroutines
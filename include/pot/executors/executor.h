@@ -1,13 +1,18 @@
 #pragma once
 
 #include <functional>
+#include <iterator>
 #include <memory>
+#include <ranges>
+#include <span>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "pot/coroutines/task.h"
 #include "pot/utils/time_it.h"
 #include "pot/utils/platform.h"
+#include "pot/utils/unique_function.h"
 
 namespace pot
 {
@@ -16,9 +21,24 @@ namespace pot
 	protected:
 		std::string m_name;
 
-		virtual void derived_execute(std::function<void()> &&func,
+		virtual void derived_execute(pot::utils::unique_function_once &&func,
 									 pot::coroutines::details::task_meta *meta = nullptr) = 0;
 
+		/**
+		 * @brief Enqueue a batch of tasks; the tasks are moved from as they are enqueued.
+		 *
+		 * Throws before enqueuing anything if the executor is stopped. Any other exception (a queue
+		 * failing to allocate) may come after part of the batch is enqueued: the enqueued tasks still
+		 * run, and the rest are left in @p funcs, not moved from. The default forwards them one by
+		 * one; pools override it to take their queue lock once and to wake at most as many idle
+		 * workers as there are tasks.
+		 */
+		virtual void derived_execute_bulk(std::span<pot::utils::unique_function_once> funcs)
+		{
+			for (auto &func : funcs)
+				derived_execute(std::move(func));
+		}
+
 	public:
 		explicit executor(std::string name) : m_name(std::move(name))
 		{
@@ -45,11 +65,51 @@ namespace pot
 			requires std::is_invocable_v<Func, Args...>
 		void run_detached(Func &&func, Args &&...args)
 		{
+			if constexpr (sizeof...(Args) == 0)
+			{
+				// invoke_result_t is only well-formed here, so the checks must stay nested.
+				if constexpr (std::is_void_v<std::invoke_result_t<std::decay_t<Func> &>>)
+				{
+					// Nothing to bind: hand the callable over as is instead of wrapping it, so it keeps
+					// fitting into the small buffer of unique_function_once.
+					derived_execute(std::forward<Func>(func));
+					return;
+				}
+			}
+
 			derived_execute([f = std::decay_t<Func>(std::forward<Func>(func)),
 							 ... captured_args = std::decay_t<Args>(std::forward<Args>(args))]() mutable
 							{ std::invoke(f, std::move(captured_args)...); });
 		}
 
+		/**
+		 * @brief Submit every callable of @p funcs as a detached task with a single enqueue.
+		 *
+		 * Cheaper than calling `run_detached` in a loop: the queue is locked once and idle workers are
+		 * woken together. The range elements must be convertible to `unique_function_once`; they are
+		 * moved from if the range yields rvalues or is itself a range of `unique_function_once`.
+		 */
+		template <std::ranges::input_range Range> void run_bulk(Range &&funcs)
+		{
+			using reference = std::ranges::range_reference_t<Range>;
+
+			if constexpr (std::ranges::contiguous_range<Range> &&
+						  std::is_same_v<reference, pot::utils::unique_function_once &>)
+			{
+				// Already type-erased and stored contiguously: hand the storage over as is.
+				derived_execute_bulk(std::span(std::ranges::data(funcs), std::ranges::size(funcs)));
+			}
+			else
+			{
+				std::vector<pot::utils::unique_function_once> tasks;
+				if constexpr (std::ranges::sized_range<Range>)
+					tasks.reserve(std::ranges::size(funcs));
+				for (auto &&func : funcs)
+					tasks.emplace_back(std::forward<decltype(func)>(func));
+				derived_execute_bulk(tasks);
+			}
+		}
+
 		template <typename Func, typename... Args>
 		auto run(Func &&func, Args &&...args)
 			-> pot::coroutines::task<pot::traits::awaitable_value_t<std::invoke_result_t<Func, Args...>>>
@@ -70,6 +130,17 @@ namespace pot
 			return 1;
 		}
 
+		/**
+		 * @brief Best-effort number of workers that are currently waiting for work.
+		 *
+		 * Used by adaptive algorithms to decide whether splitting off more work is worth it. The value
+		 * is a racy snapshot; executors that cannot tell report 0.
+		 */
+		[[nodiscard]] virtual size_t idle_thread_count() const
+		{
+			return 0;
+		}
+
 		static void cpu_set()
 		{
 			unsigned int num_cores = std::thread::hardware_concurrency();
@@ -112,7 +183,7 @@ namespace pot
 
 			std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) 
 			{
-				return a.second > b.second; 
+				return a.second < b.second; 
 			});
 
 			std::vector<int> sorted_cores;
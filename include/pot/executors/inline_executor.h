@@ -15,5 +15,6 @@ class pot::executors::inline_executor final : public executor
     void shutdown() override {}
 
   protected:
-    void derived_execute(pot::utils::unique_function_once &&func) override;
+    void derived_execute(pot::utils::unique_function_once &&func,
+                         pot::coroutines::details::task_meta *meta = nullptr) override;
 };
@@ -23,7 +23,8 @@ public:
     void shutdown() override;
 
 protected:
-    void derived_execute(pot::utils::unique_function_once&& func) override;
+    void derived_execute(pot::utils::unique_function_once &&func,
+                         pot::coroutines::details::task_meta *meta = nullptr) override;
 
 private:
     void thread_loop();
@@ -31,7 +32,7 @@ private:
     bool m_shutdown;
     std::thread m_thread;
 
-    std::queue<std::function<void()>> m_queue;
+    std::queue<pot::utils::unique_function_once> m_queue;
     std::mutex m_queue_mtx;
     std::condition_variable m_queue_cv;
 
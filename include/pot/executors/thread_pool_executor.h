@@ -1,16 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
-#include <condition_variable>
-#include <functional>
+#include <deque>
 #include <mutex>
 #include <queue>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "pot/algorithms/lfdequeue.h"
 #include "pot/executors/executor.h"
+#include "pot/threads/idle_policy.h"
+#include "pot/threads/placement_policy.h"
 #include "pot/threads/thread.h"
+#include "pot/utils/cpu_topology.h"
+#include "pot/utils/this_thread.h"
+#include "pot/utils/unique_function.h"
 
 namespace pot::executors
 {
@@ -19,14 +27,20 @@ class thread_pool_executor_gq : public executor
 {
   public:
     thread_pool_executor_gq(std::string name,
-                            size_t num_threads = std::thread::hardware_concurrency())
-        : executor(std::move(name))
+                            size_t num_threads = std::thread::hardware_concurrency(),
+                            pot::idle_policy policy = {},
+                            pot::placement_policy placement = {})
+        : executor(std::move(name)), m_policy(policy)
     {
+        const auto cpus = placement.resolve(num_threads);
+
         m_threads.reserve(num_threads);
         for (size_t i = 0; i < num_threads; ++i)
         {
             std::string worker_name = m_name + "-W" + std::to_string(i);
             auto t = std::make_unique<pot::thread>(std::move(worker_name), i, this);
+            if (!cpus.empty())
+                t->set_affinity(cpus[i]);
             t->run([this] { worker_loop(); });
             m_threads.push_back(std::move(t));
         }
@@ -34,7 +48,8 @@ class thread_pool_executor_gq : public executor
 
     ~thread_pool_executor_gq() override { shutdown(); }
 
-    void derived_execute(std::function<void()> &&func) override
+    void derived_execute(pot::utils::unique_function_once &&func,
+                         pot::coroutines::details::task_meta * /*meta*/ = nullptr) override
     {
         {
             std::lock_guard<std::mutex> lock(m_mutex);
@@ -42,7 +57,30 @@ class thread_pool_executor_gq : public executor
                 throw std::runtime_error("Executor " + m_name + " is stopped.");
             m_tasks.emplace(std::move(func));
         }
-        m_cv.notify_one();
+        m_idle.notify_one();
+    }
+
+    void derived_execute_bulk(std::span<pot::utils::unique_function_once> funcs) override
+    {
+        size_t queued = 0;
+        try
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop)
+                throw std::runtime_error("Executor " + m_name + " is stopped.");
+            for (auto &func : funcs)
+            {
+                m_tasks.emplace(std::move(func));
+                ++queued;
+            }
+        }
+        catch (...)
+        {
+            // The tasks queued before the failure still have to run.
+            m_idle.notify(queued);
+            throw;
+        }
+        m_idle.notify(queued);
     }
 
     void shutdown() override
@@ -53,37 +91,44 @@ class thread_pool_executor_gq : public executor
                 return;
             m_stop = true;
         }
-        m_cv.notify_all();
+        m_idle.notify_all();
         m_threads.clear();
     }
 
     [[nodiscard]] size_t thread_count() const override { return m_threads.size(); }
 
+    [[nodiscard]] size_t idle_thread_count() const override { return m_idle.idle_count(); }
+
   private:
     void worker_loop()
     {
         while (true)
         {
-            std::function<void()> task;
+            const uint32_t epoch = m_idle.prepare_wait();
+            pot::utils::unique_function_once task;
             {
-                std::unique_lock<std::mutex> lock(m_mutex);
-                m_cv.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
-
+                std::lock_guard<std::mutex> lock(m_mutex);
                 if (m_stop && m_tasks.empty())
                     return;
 
-                task = std::move(m_tasks.front());
-                m_tasks.pop();
+                if (!m_tasks.empty())
+                {
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop();
+                }
             }
             if (task)
                 task();
+            else
+                m_idle.wait(epoch, m_policy);
         }
     }
 
     std::vector<std::unique_ptr<pot::thread>> m_threads;
-    std::queue<std::function<void()>> m_tasks;
+    std::queue<pot::utils::unique_function_once> m_tasks;
     std::mutex m_mutex;
-    std::condition_variable m_cv;
+    pot::idle_notifier m_idle;
+    pot::idle_policy m_policy;
     bool m_stop{false};
 };
 
@@ -91,20 +136,28 @@ class thread_pool_executor_lq : public executor
 {
   public:
     thread_pool_executor_lq(std::string name, size_t num_threads = std::max<size_t>(
-                                                  1, std::thread::hardware_concurrency()))
+                                                  1, std::thread::hardware_concurrency()),
+                            pot::idle_policy policy = {},
+                            pot::placement_policy placement = {})
         : executor(std::move(name))
     {
+        const auto cpus = placement.resolve(num_threads);
+
         m_threads.reserve(num_threads);
         for (size_t i = 0; i < num_threads; ++i)
         {
             std::string worker_name = m_name + "-W" + std::to_string(i);
-            m_threads.push_back(std::make_unique<pot::thread>(std::move(worker_name), i, this));
+            m_threads.push_back(
+                std::make_unique<pot::thread>(std::move(worker_name), i, this, policy));
+            if (!cpus.empty())
+                m_threads.back()->set_affinity(cpus[i]);
         }
     }
 
     ~thread_pool_executor_lq() override { shutdown(); }
 
-    void derived_execute(std::function<void()> &&func) override
+    void derived_execute(pot::utils::unique_function_once &&func,
+                         pot::coroutines::details::task_meta * /*meta*/ = nullptr) override
     {
         if (m_stop.load(std::memory_order_acquire))
             throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -113,6 +166,23 @@ class thread_pool_executor_lq : public executor
         m_threads[idx]->run(std::move(func));
     }
 
+    void derived_execute_bulk(std::span<pot::utils::unique_function_once> funcs) override
+    {
+        if (m_stop.load(std::memory_order_acquire))
+            throw std::runtime_error("Executor " + m_name + " is stopped.");
+
+        // One contiguous slice per thread, so every thread is locked and woken once.
+        const size_t threads = std::min(funcs.size(), m_threads.size());
+        const size_t first = m_next_thread_idx.fetch_add(threads, std::memory_order_relaxed);
+        size_t offset = 0;
+        for (size_t k = 0; k < threads; ++k)
+        {
+            const size_t count = funcs.size() / threads + (k < funcs.size() % threads ? 1 : 0);
+            m_threads[(first + k) % m_threads.size()]->run_bulk(funcs.subspan(offset, count));
+            offset += count;
+        }
+    }
+
     void shutdown() override
     {
         bool expected = false;
@@ -128,6 +198,12 @@ class thread_pool_executor_lq : public executor
 
     [[nodiscard]] size_t thread_count() const override { return m_threads.size(); }
 
+    [[nodiscard]] size_t idle_thread_count() const override
+    {
+        return static_cast<size_t>(std::count_if(m_threads.begin(), m_threads.end(),
+                                                 [](const auto &thread) { return thread->idle(); }));
+    }
+
   private:
     std::vector<std::unique_ptr<pot::thread>> m_threads;
     std::atomic<size_t> m_next_thread_idx{0};
@@ -138,14 +214,20 @@ class thread_pool_executor_lfgq : public executor
 {
   public:
     thread_pool_executor_lfgq(std::string name,
-                              size_t num_threads = std::thread::hardware_concurrency())
-        : executor(std::move(name))
+                              size_t num_threads = std::thread::hardware_concurrency(),
+                              pot::idle_policy policy = {},
+                              pot::placement_policy placement = {})
+        : executor(std::move(name)), m_policy(policy)
     {
+        const auto cpus = placement.resolve(num_threads);
+
         m_threads.reserve(num_threads);
         for (size_t i = 0; i < num_threads; ++i)
         {
             std::string worker_name = m_name + "-W" + std::to_string(i);
             auto t = std::make_unique<pot::thread_lf>(std::move(worker_name), i, this);
+            if (!cpus.empty())
+                t->set_affinity(cpus[i]);
             t->run([this] { worker_loop(); });
             m_threads.push_back(std::move(t));
         }
@@ -153,7 +235,8 @@ class thread_pool_executor_lfgq : public executor
 
     ~thread_pool_executor_lfgq() override { shutdown(); }
 
-    void derived_execute(std::function<void()> &&func) override
+    void derived_execute(pot::utils::unique_function_once &&func,
+                         pot::coroutines::details::task_meta * /*meta*/ = nullptr) override
     {
         {
             std::lock_guard<std::mutex> lock(m_mutex);
@@ -161,7 +244,30 @@ class thread_pool_executor_lfgq : public executor
                 throw std::runtime_error("Executor " + m_name + " is stopped.");
             m_tasks.emplace(std::move(func));
         }
-        m_cv.notify_one();
+        m_idle.notify_one();
+    }
+
+    void derived_execute_bulk(std::span<pot::utils::unique_function_once> funcs) override
+    {
+        size_t queued = 0;
+        try
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop)
+                throw std::runtime_error("Executor " + m_name + " is stopped.");
+            for (auto &func : funcs)
+            {
+                m_tasks.emplace(std::move(func));
+                ++queued;
+            }
+        }
+        catch (...)
+        {
+            // The tasks queued before the failure still have to run.
+            m_idle.notify(queued);
+            throw;
+        }
+        m_idle.notify(queued);
     }
 
     void shutdown() override
@@ -172,22 +278,23 @@ class thread_pool_executor_lfgq : public executor
                 return;
             m_stop = true;
         }
-        m_cv.notify_all();
+        m_idle.notify_all();
         m_threads.clear();
     }
 
     [[nodiscard]] size_t thread_count() const override { return m_threads.size(); }
 
+    [[nodiscard]] size_t idle_thread_count() const override { return m_idle.idle_count(); }
+
   private:
     void worker_loop()
     {
         while (true)
         {
-            std::function<void()> task;
+            const uint32_t epoch = m_idle.prepare_wait();
+            pot::utils::unique_function_once task;
             {
-                std::unique_lock<std::mutex> lock(m_mutex);
-                m_cv.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
-
+                std::lock_guard<std::mutex> lock(m_mutex);
                 if (m_stop && m_tasks.empty())
                     return;
 
@@ -199,13 +306,16 @@ class thread_pool_executor_lfgq : public executor
             }
             if (task)
                 task();
+            else
+                m_idle.wait(epoch, m_policy);
         }
     }
 
     std::vector<std::unique_ptr<pot::thread_lf>> m_threads;
-    std::queue<std::function<void()>> m_tasks;
+    std::queue<pot::utils::unique_function_once> m_tasks;
     std::mutex m_mutex;
-    std::condition_variable m_cv;
+    pot::idle_notifier m_idle;
+    pot::idle_policy m_policy;
     bool m_stop{false};
 };
 
@@ -213,20 +323,28 @@ class thread_pool_executor_lflq : public executor
 {
   public:
     thread_pool_executor_lflq(std::string name, size_t num_threads = std::max<size_t>(
-                                                    1, std::thread::hardware_concurrency()))
+                                                    1, std::thread::hardware_concurrency()),
+                              pot::idle_policy policy = {},
+                              pot::placement_policy placement = {})
         : executor(std::move(name))
     {
+        const auto cpus = placement.resolve(num_threads);
+
         m_threads.reserve(num_threads);
         for (size_t i = 0; i < num_threads; ++i)
         {
             std::string worker_name = m_name + "-W" + std::to_string(i);
-            m_threads.push_back(std::make_unique<pot::thread_lf>(std::move(worker_name), i, this));
+            m_threads.push_back(
+                std::make_unique<pot::thread_lf>(std::move(worker_name), i, this, 65536, policy));
+            if (!cpus.empty())
+                m_threads.back()->set_affinity(cpus[i]);
         }
     }
 
     ~thread_pool_executor_lflq() override { shutdown(); }
 
-    void derived_execute(std::function<void()> &&func) override
+    void derived_execute(pot::utils::unique_function_once &&func,
+                         pot::coroutines::details::task_meta * /*meta*/ = nullptr) override
     {
         if (m_stop.load(std::memory_order_acquire))
             throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -235,6 +353,23 @@ class thread_pool_executor_lflq : public executor
         m_threads[idx]->run(std::move(func));
     }
 
+    void derived_execute_bulk(std::span<pot::utils::unique_function_once> funcs) override
+    {
+        if (m_stop.load(std::memory_order_acquire))
+            throw std::runtime_error("Executor " + m_name + " is stopped.");
+
+        // One contiguous slice per thread, so every thread is locked and woken once.
+        const size_t threads = std::min(funcs.size(), m_threads.size());
+        const size_t first = m_next_thread_idx.fetch_add(threads, std::memory_order_relaxed);
+        size_t offset = 0;
+        for (size_t k = 0; k < threads; ++k)
+        {
+            const size_t count = funcs.size() / threads + (k < funcs.size() % threads ? 1 : 0);
+            m_threads[(first + k) % m_threads.size()]->run_bulk(funcs.subspan(offset, count));
+            offset += count;
+        }
+    }
+
     void shutdown() override
     {
         bool expected = false;
@@ -250,10 +385,779 @@ class thread_pool_executor_lflq : public executor
 
     [[nodiscard]] size_t thread_count() const override { return m_threads.size(); }
 
+    [[nodiscard]] size_t idle_thread_count() const override
+    {
+        return static_cast<size_t>(std::count_if(m_threads.begin(), m_threads.end(),
+                                                 [](const auto &thread) { return thread->idle(); }));
+    }
+
   private:
     std::vector<std::unique_ptr<pot::thread_lf>> m_threads;
     std::atomic<size_t> m_next_thread_idx{0};
     std::atomic<bool> m_stop{false};
 };
 
+/**
+ * @brief Work-stealing pool built on per-worker Chase-Lev deques.
+ *
+ * Every worker owns a `pot::algorithms::lfdequeue`. Tasks submitted from a worker of this pool
+ * are pushed to the bottom of that worker's deque and popped back LIFO, so freshly spawned
+ * coroutine frames are resumed while still hot in cache. Submissions from foreign threads go
+ * through a shared injection queue. Idle workers steal from the top of randomly chosen victims.
+ *
+ * A thief may read a deque slot while the owner is growing the buffer, so the deque holds plain
+ * pointers to task nodes. Nodes are recycled through a small per-thread cache to keep the hot path
+ * free of heap allocations.
+ */
+class thread_pool_executor_lfws : public executor
+{
+    using task_type = pot::utils::unique_function_once;
+    using deque_type = pot::algorithms::lfdequeue<task_type *>;
+    using stealer_token = deque_type::stealer_token;
+
+    struct thread_context
+    {
+        deque_type deque;
+        std::vector<stealer_token *> tokens; // tokens[v] steals from worker v
+    };
+
+  public:
+    thread_pool_executor_lfws(std::string name, size_t num_threads = std::max<size_t>(
+                                                    1, std::thread::hardware_concurrency()),
+                              pot::idle_policy policy = {},
+                              pot::placement_policy placement = {})
+        : executor(std::move(name)), m_policy(policy)
+    {
+        num_threads = std::max<size_t>(1, num_threads);
+        m_cpus = placement.resolve(num_threads);
+
+        m_contexts.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+            m_contexts.push_back(std::make_unique<thread_context>());
+
+        m_external_tokens.resize(num_threads, nullptr);
+        for (size_t v = 0; v < num_threads; ++v)
+        {
+            for (size_t i = 0; i < num_threads; ++i)
+            {
+                m_contexts[i]->tokens.push_back(i == v ? nullptr
+                                                       : m_contexts[v]->deque.register_stealer());
+            }
+            m_external_tokens[v] = m_contexts[v]->deque.register_stealer();
+        }
+
+        m_threads.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            std::string worker_name = m_name + "-W" + std::to_string(i);
+            m_threads.emplace_back([this, worker_name = std::move(worker_name), i](std::stop_token st)
+                                   { worker_loop(std::move(st), std::move(worker_name), static_cast<int64_t>(i)); });
+        }
+    }
+
+    ~thread_pool_executor_lfws() override
+    {
+        shutdown();
+
+        for (auto &ctx : m_contexts)
+        {
+            while (auto node = ctx->deque.pop())
+                delete *node;
+        }
+        for (; !m_injected.empty(); m_injected.pop())
+            delete m_injected.front();
+    }
+
+    void derived_execute(pot::utils::unique_function_once &&func,
+                         pot::coroutines::details::task_meta * /*meta*/ = nullptr) override
+    {
+        if (m_stop.load(std::memory_order_acquire))
+            throw std::runtime_error("Executor " + m_name + " is stopped.");
+
+        if (pot::details::this_thread::tl_owner_executor == this)
+        {
+            // Only the owning worker may push to the bottom of its deque.
+            auto &deque = m_contexts[static_cast<size_t>(pot::this_thread::local_id())]->deque;
+            push_node(func, [&](task_type *node) { deque.push(node); });
+        }
+        else
+        {
+            {
+                std::lock_guard lock(m_injected_mutex);
+                push_node(func, [&](task_type *node) { m_injected.push(node); });
+            }
+            m_injected_count.fetch_add(1, std::memory_order_release);
+        }
+
+        m_notifier.notify_one();
+    }
+
+    void derived_execute_bulk(std::span<pot::utils::unique_function_once> funcs) override
+    {
+        if (m_stop.load(std::memory_order_acquire))
+            throw std::runtime_error("Executor " + m_name + " is stopped.");
+
+        const bool owner = pot::details::this_thread::tl_owner_executor == this;
+        size_t queued = 0;
+        auto publish = [&]
+        {
+            if (!owner)
+                m_injected_count.fetch_add(queued, std::memory_order_release);
+            m_notifier.notify(queued);
+        };
+
+        try
+        {
+            if (owner)
+            {
+                auto &deque = m_contexts[static_cast<size_t>(pot::this_thread::local_id())]->deque;
+                for (auto &func : funcs)
+                {
+                    push_node(func, [&](task_type *node) { deque.push(node); });
+                    ++queued;
+                }
+            }
+            else
+            {
+                std::lock_guard lock(m_injected_mutex);
+                for (auto &func : funcs)
+                {
+                    push_node(func, [&](task_type *node) { m_injected.push(node); });
+                    ++queued;
+                }
+            }
+        }
+        catch (...)
+        {
+            // The tasks queued before the failure still have to be found and run.
+            publish();
+            throw;
+        }
+        publish();
+    }
+
+    bool try_steal() override
+    {
+        task_type *task = nullptr;
+
+        if (pot::details::this_thread::tl_owner_executor == this)
+        {
+            auto local_id = static_cast<size_t>(pot::this_thread::local_id());
+            if (auto local_task = m_contexts[local_id]->deque.pop())
+                task = *local_task;
+            else if (!pop_injected(task))
+                steal(m_contexts[local_id]->tokens, local_id, task);
+        }
+        else if (!pop_injected(task))
+        {
+            // Stealer tokens are single-threaded, so foreign threads take turns on a shared set.
+            std::unique_lock lock(m_external_mutex, std::try_to_lock);
+            if (lock)
+                steal(m_external_tokens, m_contexts.size(), task);
+        }
+
+        if (!task)
+            return false;
+
+        run_node(task);
+        return true;
+    }
+
+    void shutdown() override
+    {
+        bool expected = false;
+        if (!m_stop.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            return;
+
+        for (auto &thread : m_threads)
+            thread.request_stop();
+
+        m_notifier.notify_all();
+
+        m_threads.clear();
+    }
+
+    [[nodiscard]] size_t thread_count() const override { return m_contexts.size(); }
+
+    [[nodiscard]] size_t idle_thread_count() const override { return m_notifier.idle_count(); }
+
+  private:
+    void worker_loop(std::stop_token st, std::string name, int64_t local_id)
+    {
+        pot::this_thread::init_thread_variables(local_id, this);
+        pot::this_thread::set_name(name);
+        if (!m_cpus.empty())
+            (void)pot::this_thread::set_affinity({m_cpus[static_cast<size_t>(local_id)]});
+
+        auto &ctx = *m_contexts[static_cast<size_t>(local_id)];
+
+        // A stopped pool still runs what is queued: workers leave only once a search comes back
+        // empty, so coroutines waiting on queued tasks are resumed before the pool goes away.
+        while (true)
+        {
+            const uint32_t wait_val = m_notifier.prepare_wait();
+            task_type *task = nullptr;
+
+            if (auto local_task = ctx.deque.pop())
+                task = *local_task;
+            else if (!pop_injected(task))
+                steal(ctx.tokens, static_cast<size_t>(local_id), task);
+
+            if (task)
+            {
+                run_node(task);
+            }
+            else
+            {
+                if (st.stop_requested())
+                    return;
+                m_notifier.wait(wait_val, m_policy);
+            }
+        }
+    }
+
+    bool pop_injected(task_type *&task)
+    {
+        if (m_injected_count.load(std::memory_order_acquire) == 0)
+            return false;
+
+        std::lock_guard lock(m_injected_mutex);
+        if (m_injected.empty())
+            return false;
+
+        task = m_injected.front();
+        m_injected.pop();
+        m_injected_count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool steal(const std::vector<stealer_token *> &tokens, size_t self, task_type *&task)
+    {
+        const size_t n = m_contexts.size();
+        const size_t start = next_random() % n;
+
+        for (size_t k = 0; k < n; ++k)
+        {
+            const size_t victim = (start + k) % n;
+            if (victim == self)
+                continue;
+
+            if (auto stolen = m_contexts[victim]->deque.pop_back(tokens[victim]))
+            {
+                task = *stolen;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    struct node_cache
+    {
+        static constexpr size_t max_size = 1024;
+        std::vector<task_type *> nodes;
+
+        ~node_cache()
+        {
+            for (auto *node : nodes)
+                delete node;
+        }
+    };
+
+    static node_cache &local_node_cache()
+    {
+        thread_local node_cache cache;
+        return cache;
+    }
+
+    static task_type *make_node(task_type &&func)
+    {
+        auto &cache = local_node_cache();
+        if (cache.nodes.empty())
+            return new task_type(std::move(func));
+
+        auto *node = cache.nodes.back();
+        cache.nodes.pop_back();
+        *node = std::move(func);
+        return node;
+    }
+
+    // Moves func into a node and hands it to push; if push throws, func gets its task back.
+    template <typename Push> static void push_node(task_type &func, Push &&push)
+    {
+        auto *node = make_node(std::move(func));
+        try
+        {
+            push(node);
+        }
+        catch (...)
+        {
+            func = std::move(*node);
+            delete node;
+            throw;
+        }
+    }
+
+    static void run_node(task_type *node)
+    {
+        // Nodes migrate from the submitting thread to the one that ran them; the cache is capped so
+        // a pure consumer does not hoard them forever.
+        struct recycle_guard
+        {
+            task_type *node;
+            ~recycle_guard()
+            {
+                auto &cache = local_node_cache();
+                if (cache.nodes.size() < node_cache::max_size)
+                    cache.nodes.push_back(node);
+                else
+                    delete node;
+            }
+        } guard{node};
+
+        (*node)();
+    }
+
+    static uint64_t next_random()
+    {
+        thread_local uint64_t state =
+            0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(pot::this_thread::system_id());
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    std::vector<std::unique_ptr<thread_context>> m_contexts;
+    std::vector<stealer_token *> m_external_tokens;
+    std::mutex m_external_mutex;
+
+    std::queue<task_type *> m_injected;
+    std::mutex m_injected_mutex;
+    std::atomic<size_t> m_injected_count{0};
+
+    pot::idle_notifier m_notifier;
+    pot::idle_policy m_policy;
+    std::vector<int> m_cpus;
+    std::atomic<bool> m_stop{false};
+    std::vector<std::jthread> m_threads;
+};
+
+
+/**
+ * @brief Pool partitioned by NUMA node.
+ *
+ * Workers are spread over the NUMA nodes of `topology` in proportion to their CPU counts and
+ * pinned to the CPUs of their node. Every worker owns a queue. Tasks submitted from a worker stay
+ * in its own queue, tasks from foreign threads are dealt round-robin over all workers. An idle
+ * worker looks at its own queue, then at the queues of the other workers of its node, and only
+ * then crosses to other nodes, so memory-bound chunks are moved off their node only when that
+ * node has nothing left to give.
+ *
+ * `run_on_node` places work on a given node; such tasks are never stolen across nodes. Node ids
+ * are the ids used by sysfs (`/sys/devices/system/node/nodeN`).
+ */
+class thread_pool_executor_numa : public executor
+{
+    using task_type = pot::utils::unique_function_once;
+
+    struct task_queue
+    {
+        std::deque<task_type> tasks;
+        std::mutex mtx;
+        std::atomic<size_t> size{0};
+
+        void push(task_type &&task)
+        {
+            std::lock_guard lock(mtx);
+            tasks.push_back(std::move(task));
+            size.fetch_add(1, std::memory_order_release);
+        }
+
+        void push_many(std::span<task_type> batch)
+        {
+            std::lock_guard lock(mtx);
+            size_t pushed = 0;
+            try
+            {
+                for (auto &task : batch)
+                {
+                    tasks.push_back(std::move(task));
+                    ++pushed;
+                }
+            }
+            catch (...)
+            {
+                size.fetch_add(pushed, std::memory_order_release);
+                throw;
+            }
+            size.fetch_add(pushed, std::memory_order_release);
+        }
+
+        bool pop(task_type &task)
+        {
+            if (size.load(std::memory_order_acquire) == 0)
+                return false;
+
+            std::lock_guard lock(mtx);
+            if (tasks.empty())
+                return false;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    };
+
+    struct node_context
+    {
+        int id = 0;
+        std::vector<int> cpus;
+        std::vector<size_t> workers;
+        task_queue bound; // run_on_node tasks, served by this node only
+        pot::idle_notifier notifier;
+        std::atomic<size_t> next_worker{0};
+    };
+
+    struct worker_context
+    {
+        size_t node = 0;
+        task_queue queue;
+    };
+
+  public:
+    thread_pool_executor_numa(std::string name,
+                              size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+                              pot::idle_policy policy = {},
+                              const pot::utils::cpu_topology &topology = pot::utils::cpu_topology::system())
+        : executor(std::move(name)), m_policy(policy)
+    {
+        num_threads = std::max<size_t>(1, num_threads);
+
+        auto node_ids = topology.numa_nodes();
+        if (node_ids.empty())
+            node_ids.push_back(0);
+
+        for (int id : node_ids)
+        {
+            auto node = std::make_unique<node_context>();
+            node->id = id;
+            node->cpus = topology.cpus_on_node(id);
+            m_nodes.push_back(std::move(node));
+        }
+
+        // Give each worker to the node with the fewest workers per CPU.
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            size_t best = 0;
+            for (size_t n = 1; n < m_nodes.size(); ++n)
+            {
+                // (workers_n + 1) / cpus_n < (workers_best + 1) / cpus_best, without division
+                const size_t lhs = (m_nodes[n]->workers.size() + 1) * std::max<size_t>(1, m_nodes[best]->cpus.size());
+                const size_t rhs = (m_nodes[best]->workers.size() + 1) * std::max<size_t>(1, m_nodes[n]->cpus.size());
+                if (lhs < rhs)
+                    best = n;
+            }
+
+            auto worker = std::make_unique<worker_context>();
+            worker->node = best;
+            m_nodes[best]->workers.push_back(i);
+            m_workers.push_back(std::move(worker));
+        }
+
+        m_threads.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+            std::string worker_name = m_name + "-N" + std::to_string(m_nodes[m_workers[i]->node]->id) + "-W" +
+                                      std::to_string(i);
+            m_threads.emplace_back([this, worker_name = std::move(worker_name), i](std::stop_token st)
+                                   { worker_loop(std::move(st), std::move(worker_name), i); });
+        }
+    }
+
+    ~thread_pool_executor_numa() override { shutdown(); }
+
+    void derived_execute(pot::utils::unique_function_once &&func,
+                         pot::coroutines::details::task_meta * /*meta*/ = nullptr) override
+    {
+        if (m_stop.load(std::memory_order_acquire))
+            throw std::runtime_error("Executor " + m_name + " is stopped.");
+
+        size_t worker;
+        if (pot::details::this_thread::tl_owner_executor == this)
+            worker = static_cast<size_t>(pot::this_thread::local_id());
+        else
+            worker = m_next_worker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+        m_workers[worker]->queue.push(std::move(func));
+        notify_node(m_workers[worker]->node, 1);
+    }
+
+    void derived_execute_bulk(std::span<pot::utils::unique_function_once> funcs) override
+    {
+        if (m_stop.load(std::memory_order_acquire))
+            throw std::runtime_error("Executor " + m_name + " is stopped.");
+
+        if (pot::details::this_thread::tl_owner_executor == this)
+        {
+            // Keep the batch on our node; idle siblings pick it up through local stealing.
+            auto &worker = *m_workers[static_cast<size_t>(pot::this_thread::local_id())];
+            push_to_worker(worker, funcs);
+            return;
+        }
+
+        const size_t workers = std::min(funcs.size(), m_workers.size());
+        const size_t first = m_next_worker.fetch_add(workers, std::memory_order_relaxed);
+        size_t offset = 0;
+        for (size_t k = 0; k < workers; ++k)
+        {
+            const size_t count = funcs.size() / workers + (k < funcs.size() % workers ? 1 : 0);
+            auto &worker = *m_workers[(first + k) % m_workers.size()];
+            push_to_worker(worker, funcs.subspan(offset, count));
+            offset += count;
+        }
+    }
+
+    /**
+     * @brief Run `func(args...)` on a worker of NUMA node `node`.
+     *
+     * @return task with the result, as `run` does.
+     *
+     * @throws std::out_of_range if the pool has no workers on `node`.
+     */
+    template <typename Func, typename... Args>
+    auto run_on_node(int node, Func &&func, Args &&...args)
+        -> pot::coroutines::task<pot::traits::awaitable_value_t<std::invoke_result_t<Func, Args...>>>
+    {
+        return run_on_node_impl(node_index(node), std::decay_t<Func>(std::forward<Func>(func)),
+                                std::decay_t<Args>(std::forward<Args>(args))...);
+    }
+
+    /// Fire-and-forget variant of `run_on_node`.
+    template <typename Func> void run_detached_on_node(int node, Func &&func)
+    {
+        submit_to_node(node_index(node), std::forward<Func>(func));
+    }
+
+    bool try_steal() override
+    {
+        task_type task;
+        bool found = false;
+
+        if (pot::details::this_thread::tl_owner_executor == this)
+        {
+            found = find_task(static_cast<size_t>(pot::this_thread::local_id()), task);
+        }
+        else
+        {
+            for (auto &worker : m_workers)
+            {
+                if ((found = worker->queue.pop(task)))
+                    break;
+            }
+        }
+
+        if (!found)
+            return false;
+
+        task();
+        return true;
+    }
+
+    void shutdown() override
+    {
+        bool expected = false;
+        if (!m_stop.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            return;
+
+        for (auto &thread : m_threads)
+            thread.request_stop();
+        for (auto &node : m_nodes)
+            node->notifier.notify_all();
+
+        m_threads.clear();
+    }
+
+    [[nodiscard]] size_t thread_count() const override { return m_workers.size(); }
+
+    [[nodiscard]] size_t idle_thread_count() const override
+    {
+        size_t idle = 0;
+        for (const auto &node : m_nodes)
+            idle += node->notifier.idle_count();
+        return idle;
+    }
+
+    [[nodiscard]] size_t node_count() const { return m_nodes.size(); }
+
+    /// NUMA node ids the pool has workers on, ascending.
+    [[nodiscard]] std::vector<int> node_ids() const
+    {
+        std::vector<int> ids;
+        for (const auto &node : m_nodes)
+        {
+            if (!node->workers.empty())
+                ids.push_back(node->id);
+        }
+        return ids;
+    }
+
+    /// NUMA node of the calling worker, or -1 if the caller is not a worker of this pool.
+    [[nodiscard]] int current_node() const
+    {
+        if (pot::details::this_thread::tl_owner_executor != this)
+            return -1;
+        return m_nodes[m_workers[static_cast<size_t>(pot::this_thread::local_id())]->node]->id;
+    }
+
+  private:
+    size_t node_index(int node) const
+    {
+        for (size_t n = 0; n < m_nodes.size(); ++n)
+        {
+            if (m_nodes[n]->id == node && !m_nodes[n]->workers.empty())
+                return n;
+        }
+        throw std::out_of_range("Executor " + m_name + " has no workers on NUMA node " + std::to_string(node));
+    }
+
+    /**
+     * Wake up to `count` workers of `node` for freshly queued work. Workers only wait on their own
+     * node's notifier, so the tasks the node's idle workers cannot take right away are announced to
+     * the idle workers of the nearest other nodes as well; otherwise those would stay parked and
+     * never get to the remote-steal step of `find_task`, however busy this node is.
+     */
+    void notify_node(size_t node, size_t count)
+    {
+        auto &local = *m_nodes[node];
+        const size_t idle = local.notifier.idle_count();
+        local.notifier.notify(count);
+
+        size_t excess = count > idle ? count - idle : 0;
+        for (size_t d = 1; d < m_nodes.size() && excess > 0; ++d)
+        {
+            auto &remote = *m_nodes[(node + d) % m_nodes.size()];
+            const size_t wake = std::min(excess, remote.notifier.idle_count());
+            remote.notifier.notify(wake);
+            excess -= wake;
+        }
+    }
+
+    // Queue `batch` on `worker` and wake its node, also when a push throws partway: the tasks queued
+    // by then still have to run, and waking for the whole batch is merely one wakeup too many.
+    void push_to_worker(worker_context &worker, std::span<task_type> batch)
+    {
+        try
+        {
+            worker.queue.push_many(batch);
+        }
+        catch (...)
+        {
+            notify_node(worker.node, batch.size());
+            throw;
+        }
+        notify_node(worker.node, batch.size());
+    }
+
+    void submit_to_node(size_t node, task_type &&func)
+    {
+        if (m_stop.load(std::memory_order_acquire))
+            throw std::runtime_error("Executor " + m_name + " is stopped.");
+
+        m_nodes[node]->bound.push(std::move(func));
+        m_nodes[node]->notifier.notify_one();
+    }
+
+    template <typename Func, typename... Args>
+    auto run_on_node_impl(size_t node, Func func, Args... args)
+        -> pot::coroutines::task<pot::traits::awaitable_value_t<std::invoke_result_t<Func, Args...>>>
+    {
+        using Ret = std::invoke_result_t<Func, Args...>;
+
+        struct node_awaiter
+        {
+            thread_pool_executor_numa *exec;
+            size_t node;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { exec->submit_to_node(node, [h] { h.resume(); }); }
+            void await_resume() const noexcept {}
+        };
+
+        co_await node_awaiter{this, node};
+
+        if constexpr (std::is_void_v<Ret>)
+            std::invoke(std::move(func), std::move(args)...);
+        else if constexpr (pot::traits::is_task_v<Ret> || pot::traits::is_lazy_task_v<Ret>)
+            co_return co_await std::invoke(std::move(func), std::move(args)...);
+        else
+            co_return std::invoke(std::move(func), std::move(args)...);
+    }
+
+    bool find_task(size_t self, task_type &task)
+    {
+        auto &worker = *m_workers[self];
+        auto &node = *m_nodes[worker.node];
+
+        if (worker.queue.pop(task) || node.bound.pop(task))
+            return true;
+
+        // Siblings on the same node first, starting after ourselves to spread the contention.
+        const size_t siblings = node.workers.size();
+        const size_t start = node.next_worker.fetch_add(1, std::memory_order_relaxed);
+        for (size_t k = 0; k < siblings; ++k)
+        {
+            const size_t victim = node.workers[(start + k) % siblings];
+            if (victim != self && m_workers[victim]->queue.pop(task))
+                return true;
+        }
+
+        // Then the other nodes, nearest index first; their bound queues are off limits.
+        for (size_t d = 1; d < m_nodes.size(); ++d)
+        {
+            const auto &remote = *m_nodes[(worker.node + d) % m_nodes.size()];
+            for (size_t victim : remote.workers)
+            {
+                if (m_workers[victim]->queue.pop(task))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(std::stop_token st, std::string name, size_t local_id)
+    {
+        pot::this_thread::init_thread_variables(static_cast<int64_t>(local_id), this);
+        pot::this_thread::set_name(name);
+
+        auto &node = *m_nodes[m_workers[local_id]->node];
+        if (!node.cpus.empty())
+            (void)pot::this_thread::set_affinity(node.cpus);
+
+        // Like the work-stealing pool, a stopped pool drains its queues before the workers leave.
+        while (true)
+        {
+            const uint32_t wait_val = node.notifier.prepare_wait();
+            task_type task;
+
+            if (find_task(local_id, task))
+            {
+                task();
+            }
+            else
+            {
+                if (st.stop_requested())
+                    return;
+                node.notifier.wait(wait_val, m_policy);
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<node_context>> m_nodes;
+    std::vector<std::unique_ptr<worker_context>> m_workers;
+    std::atomic<size_t> m_next_worker{0};
+    pot::idle_policy m_policy;
+    std::atomic<bool> m_stop{false};
+    std::vector<std::jthread> m_threads;
+};
+
 } // namespace pot::executors
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pot/utils/cache_line.h"
+
+namespace pot::memory
+{
+
+/**
+ * @brief Size-class frame allocator with per-thread free lists.
+ *
+ * Meant to be installed with `pot::memory::set_memory_resource`. Every thread that allocates gets
+ * its own cache holding one intrusive free list per size class; blocks are carved from slabs taken
+ * from the upstream resource and never returned to it before the resource itself is destroyed.
+ *
+ * Each block remembers the cache it was carved from. A block released on its owning thread goes
+ * straight back to the local list, a block released on any other thread is pushed onto a lock-free
+ * remote list of the owner, which the owner drains the next time its local list runs dry.
+ *
+ * Requests above `max_block_size` or with an alignment above `block_alignment` go to upstream.
+ * The resource must outlive every frame allocated from it.
+ */
+class frame_pool_resource final : public std::pmr::memory_resource
+{
+  public:
+    static constexpr std::size_t block_granularity = 64;
+    static constexpr std::size_t size_class_count = 16;
+    static constexpr std::size_t max_block_size = block_granularity * size_class_count;
+    static constexpr std::size_t block_alignment = alignof(std::max_align_t);
+    static constexpr std::size_t slab_size = 64 * 1024;
+
+    explicit frame_pool_resource(
+        std::pmr::memory_resource *upstream = std::pmr::new_delete_resource()) noexcept
+        : m_upstream(upstream), m_id(s_next_id.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+    frame_pool_resource(const frame_pool_resource &) = delete;
+    frame_pool_resource &operator=(const frame_pool_resource &) = delete;
+
+    ~frame_pool_resource() override
+    {
+        for (auto &cache : m_caches)
+        {
+            for (void *slab : cache->slabs)
+                m_upstream->deallocate(slab, slab_size, block_alignment);
+        }
+    }
+
+    [[nodiscard]] std::pmr::memory_resource *upstream_resource() const noexcept
+    {
+        return m_upstream;
+    }
+
+  private:
+    struct thread_cache;
+
+    struct block_header
+    {
+        thread_cache *owner;
+        block_header *next;
+    };
+
+    static_assert(sizeof(block_header) % block_alignment == 0,
+                  "block header must keep the payload aligned");
+
+    struct thread_cache
+    {
+        std::array<block_header *, size_class_count> local{};
+        alignas(pot::cache_line_alignment) std::array<std::atomic<block_header *>, size_class_count> remote{};
+
+        std::byte *slab_cursor = nullptr;
+        std::byte *slab_end = nullptr;
+        std::vector<void *> slabs;
+    };
+
+    struct cache_slot
+    {
+        std::uint64_t resource_id = 0;
+        thread_cache *cache = nullptr;
+    };
+
+    static bool is_pooled(std::size_t bytes, std::size_t alignment) noexcept
+    {
+        return alignment <= block_alignment && bytes + sizeof(block_header) <= max_block_size;
+    }
+
+    static std::size_t size_class(std::size_t bytes) noexcept
+    {
+        return (bytes + sizeof(block_header) - 1) / block_granularity;
+    }
+
+    static cache_slot &local_slot() noexcept
+    {
+        thread_local cache_slot slot;
+        return slot;
+    }
+
+    thread_cache *current_cache() noexcept
+    {
+        auto &slot = local_slot();
+        return slot.resource_id == m_id ? slot.cache : nullptr;
+    }
+
+    thread_cache &acquire_cache()
+    {
+        if (auto *cache = current_cache())
+            return *cache;
+
+        // Slow path, once per thread and resource (or after the thread last touched another pool).
+        std::lock_guard lock(m_mutex);
+        const auto self = std::this_thread::get_id();
+        thread_cache *cache = nullptr;
+        for (std::size_t i = 0; i < m_threads.size(); ++i)
+        {
+            if (m_threads[i] == self)
+            {
+                cache = m_caches[i].get();
+                break;
+            }
+        }
+        if (!cache)
+        {
+            m_caches.push_back(std::make_unique<thread_cache>());
+            m_threads.push_back(self);
+            cache = m_caches.back().get();
+        }
+
+        local_slot() = {m_id, cache};
+        return *cache;
+    }
+
+    block_header *carve(thread_cache &cache, std::size_t cls)
+    {
+        const std::size_t block_size = (cls + 1) * block_granularity;
+        if (static_cast<std::size_t>(cache.slab_end - cache.slab_cursor) < block_size)
+        {
+            auto *slab = static_cast<std::byte *>(m_upstream->allocate(slab_size, block_alignment));
+            cache.slabs.push_back(slab);
+            cache.slab_cursor = slab;
+            cache.slab_end = slab + slab_size;
+        }
+
+        auto *block = reinterpret_cast<block_header *>(cache.slab_cursor);
+        cache.slab_cursor += block_size;
+        block->owner = &cache;
+        return block;
+    }
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (!is_pooled(bytes, alignment))
+            return m_upstream->allocate(bytes, alignment);
+
+        auto &cache = acquire_cache();
+        const std::size_t cls = size_class(bytes);
+
+        block_header *block = cache.local[cls];
+        if (!block)
+            block = cache.remote[cls].exchange(nullptr, std::memory_order_acquire);
+
+        if (block)
+            cache.local[cls] = block->next;
+        else
+            block = carve(cache, cls);
+
+        return block + 1;
+    }
+
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        if (!is_pooled(bytes, alignment))
+            return m_upstream->deallocate(ptr, bytes, alignment);
+
+        auto *block = static_cast<block_header *>(ptr) - 1;
+        thread_cache *owner = block->owner;
+        const std::size_t cls = size_class(bytes);
+
+        if (owner == current_cache())
+        {
+            block->next = owner->local[cls];
+            owner->local[cls] = block;
+            return;
+        }
+
+        auto &remote = owner->remote[cls];
+        block->next = remote.load(std::memory_order_relaxed);
+        while (!remote.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                             std::memory_order_relaxed))
+        {
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    static inline std::atomic<std::uint64_t> s_next_id{1};
+
+    std::pmr::memory_resource *m_upstream;
+    const std::uint64_t m_id;
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<thread_cache>> m_caches;
+    std::vector<std::thread::id> m_threads;
+};
+
+} // namespace pot::memory
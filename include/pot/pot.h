@@ -4,19 +4,33 @@
 #include "pot/coroutines/resume_on.h"
 #include "pot/coroutines/task.h"
 #include "pot/coroutines/when_all.h"
+#include "pot/coroutines/when_any.h"
 
 #include "pot/algorithms/dot.h"
+#include "pot/algorithms/filter.h"
 #include "pot/algorithms/parfor.h"
+#include "pot/algorithms/parfor_nd.h"
 #include "pot/algorithms/parsections.h"
 #include "pot/algorithms/reduce.h"
+#include "pot/algorithms/scan.h"
+#include "pot/algorithms/sort.h"
 
 #include "pot/executors/executor.h"
 #include "pot/executors/inline_executor.h"
 #include "pot/executors/thread_executor.h"
 #include "pot/executors/thread_pool_executor.h"
 
+#include "pot/memory/coro_memory.h"
+#include "pot/memory/frame_pool.h"
+
+#include "pot/simd/cpu_features.h"
+#include "pot/simd/dispatch.h"
+#include "pot/simd/float16.h"
 #include "pot/simd/simd_auto.h"
 #include "pot/simd/simd_forced.h"
+#include "pot/simd/simd_mask.h"
+#include "pot/simd/simd_math.h"
+#include "pot/simd/simd_widen.h"
 
 #include "pot/utils/cache_line.h"
 #include "pot/utils/platform.h"
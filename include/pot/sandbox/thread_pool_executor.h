@@ -14,7 +14,9 @@
 #include <vector>
 
 #include "pot/executors/executor.h"
+#include "pot/threads/idle_policy.h"
 #include "pot/utils/this_thread.h"
+#include "pot/utils/unique_function.h"
 #include "pot/algorithms/lfqueue.h"
 #include "pot/algorithms/lfdequeue.h"
 
@@ -23,19 +25,19 @@ namespace pot
 
 	struct work_queue
 	{
-		std::queue<std::function<void()>> tasks;
+		std::queue<pot::utils::unique_function_once> tasks;
 		std::mutex mtx;
 	};
 
 	struct work_stack
 	{
-		std::stack<std::function<void()>> tasks;
+		std::stack<pot::utils::unique_function_once> tasks;
 		std::mutex mtx;
 	};
 
 	struct work_deque
 	{
-		std::deque<std::function<void()>> tasks;
+		std::deque<pot::utils::unique_function_once> tasks;
 		std::mutex mtx;
 	};
 
@@ -47,8 +49,9 @@ namespace pot::executors
 	{
 	public:
 		thread_pool_executor_gq(std::string name,
-								size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+								size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+								pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_threads.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -64,7 +67,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 				throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -73,7 +76,6 @@ namespace pot::executors
 				std::lock_guard lock(m_queue.mtx);
 				m_queue.tasks.emplace(std::move(func));
 			}
-			m_notifier.fetch_add(1, std::memory_order_release);
 			m_notifier.notify_one();
 		}
 
@@ -86,7 +88,6 @@ namespace pot::executors
 			for (auto &thread : m_threads)
 				thread.request_stop();
 
-			m_notifier.fetch_add(m_threads.size(), std::memory_order_release);
 			m_notifier.notify_all();
 
 			m_threads.clear();
@@ -105,8 +106,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = m_notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = m_notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				{
 					std::lock_guard lock(m_queue.mtx);
@@ -125,14 +126,15 @@ namespace pot::executors
 				{
 					if (st.stop_requested())
 						return;
-					m_notifier.wait(wait_val, std::memory_order_acquire);
+					m_notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
 
 		std::vector<std::jthread> m_threads;
 		pot::work_queue m_queue;
-		std::atomic<uint64_t> m_notifier{0};
+		pot::idle_notifier m_notifier;
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -141,13 +143,14 @@ namespace pot::executors
 		struct thread_context
 		{
 			pot::work_queue queue;
-			std::atomic<uint64_t> notifier{0};
+			pot::idle_notifier notifier;
 		};
 
 	public:
 		thread_pool_executor_lq(std::string name,
-								size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+								size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+								pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_contexts.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -169,7 +172,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 				throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -181,7 +184,6 @@ namespace pot::executors
 				std::lock_guard lock(ctx.queue.mtx);
 				ctx.queue.tasks.emplace(std::move(func));
 			}
-			ctx.notifier.fetch_add(1, std::memory_order_release);
 			ctx.notifier.notify_one();
 		}
 
@@ -196,7 +198,6 @@ namespace pot::executors
 
 			for (auto &ctx : m_contexts)
 			{
-				ctx->notifier.fetch_add(1, std::memory_order_release);
 				ctx->notifier.notify_all();
 			}
 
@@ -218,8 +219,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = ctx.notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = ctx.notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				{
 					std::lock_guard lock(ctx.queue.mtx);
@@ -238,7 +239,7 @@ namespace pot::executors
 				{
 					if (st.stop_requested())
 						return;
-					ctx.notifier.wait(wait_val, std::memory_order_acquire);
+					ctx.notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
@@ -246,6 +247,7 @@ namespace pot::executors
 		std::vector<std::jthread> m_threads;
 		std::vector<std::unique_ptr<thread_context>> m_contexts;
 		std::atomic<size_t> m_next_thread_idx{0};
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -254,13 +256,14 @@ namespace pot::executors
 		struct thread_context
 		{
 			pot::work_queue queue;
-			std::atomic<uint64_t> notifier{0};
+			pot::idle_notifier notifier;
 		};
 
 	public:
 		thread_pool_executor_lq_steal_seq(std::string name,
-										  size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+										  size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+										  pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_contexts.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -282,7 +285,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 				throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -295,7 +298,6 @@ namespace pot::executors
 				ctx.queue.tasks.emplace(std::move(func));
 			}
 
-			ctx.notifier.fetch_add(1, std::memory_order_release);
 			ctx.notifier.notify_one();
 		}
 
@@ -310,7 +312,6 @@ namespace pot::executors
 
 			for (auto &ctx : m_contexts)
 			{
-				ctx->notifier.fetch_add(1, std::memory_order_release);
 				ctx->notifier.notify_all();
 			}
 
@@ -333,8 +334,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = my_ctx.notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = my_ctx.notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				{
 					std::lock_guard lock(my_ctx.queue.mtx);
@@ -370,7 +371,7 @@ namespace pot::executors
 				{
 					if (st.stop_requested())
 						return;
-					my_ctx.notifier.wait(wait_val, std::memory_order_acquire);
+					my_ctx.notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
@@ -378,6 +379,7 @@ namespace pot::executors
 		std::vector<std::jthread> m_threads;
 		std::vector<std::unique_ptr<thread_context>> m_contexts;
 		std::atomic<size_t> m_next_thread_idx{0};
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -386,13 +388,14 @@ namespace pot::executors
 		struct thread_context
 		{
 			pot::work_queue queue;
-			std::atomic<uint64_t> notifier{0};
+			pot::idle_notifier notifier;
 		};
 
 	public:
 		thread_pool_executor_lq_steal_neighbor(
-			std::string name, size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+			std::string name, size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+			pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_contexts.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -414,7 +417,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 				throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -426,7 +429,6 @@ namespace pot::executors
 				std::lock_guard lock(ctx.queue.mtx);
 				ctx.queue.tasks.emplace(std::move(func));
 			}
-			ctx.notifier.fetch_add(1, std::memory_order_release);
 			ctx.notifier.notify_one();
 		}
 
@@ -441,7 +443,6 @@ namespace pot::executors
 
 			for (auto &ctx : m_contexts)
 			{
-				ctx->notifier.fetch_add(1, std::memory_order_release);
 				ctx->notifier.notify_all();
 			}
 
@@ -464,8 +465,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = my_ctx.notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = my_ctx.notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				{
 					std::lock_guard lock(my_ctx.queue.mtx);
@@ -502,7 +503,7 @@ namespace pot::executors
 				{
 					if (st.stop_requested())
 						return;
-					my_ctx.notifier.wait(wait_val, std::memory_order_acquire);
+					my_ctx.notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
@@ -510,6 +511,7 @@ namespace pot::executors
 		std::vector<std::jthread> m_threads;
 		std::vector<std::unique_ptr<thread_context>> m_contexts;
 		std::atomic<size_t> m_next_thread_idx{0};
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -517,8 +519,9 @@ namespace pot::executors
 	{
 	public:
 		thread_pool_executor_gs(std::string name,
-								size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+								size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+								pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_threads.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -534,7 +537,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 				throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -543,7 +546,6 @@ namespace pot::executors
 				std::lock_guard lock(m_stack.mtx);
 				m_stack.tasks.emplace(std::move(func));
 			}
-			m_notifier.fetch_add(1, std::memory_order_release);
 			m_notifier.notify_one();
 		}
 
@@ -556,7 +558,6 @@ namespace pot::executors
 			for (auto &thread : m_threads)
 				thread.request_stop();
 
-			m_notifier.fetch_add(m_threads.size(), std::memory_order_release);
 			m_notifier.notify_all();
 
 			m_threads.clear();
@@ -575,8 +576,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = m_notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = m_notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				{
 					std::lock_guard lock(m_stack.mtx);
@@ -595,14 +596,15 @@ namespace pot::executors
 				{
 					if (st.stop_requested())
 						return;
-					m_notifier.wait(wait_val, std::memory_order_acquire);
+					m_notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
 
 		std::vector<std::jthread> m_threads;
 		pot::work_stack m_stack;
-		std::atomic<uint64_t> m_notifier{0};
+		pot::idle_notifier m_notifier;
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -611,13 +613,14 @@ namespace pot::executors
 		struct thread_context
 		{
 			pot::work_stack stack;
-			std::atomic<uint64_t> notifier{0};
+			pot::idle_notifier notifier;
 		};
 
 	public:
 		thread_pool_executor_ls(std::string name,
-								size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+								size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+								pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_contexts.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -639,7 +642,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 				throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -651,7 +654,6 @@ namespace pot::executors
 				std::lock_guard lock(ctx.stack.mtx);
 				ctx.stack.tasks.emplace(std::move(func));
 			}
-			ctx.notifier.fetch_add(1, std::memory_order_release);
 			ctx.notifier.notify_one();
 		}
 
@@ -666,7 +668,6 @@ namespace pot::executors
 
 			for (auto &ctx : m_contexts)
 			{
-				ctx->notifier.fetch_add(1, std::memory_order_release);
 				ctx->notifier.notify_all();
 			}
 
@@ -688,8 +689,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = ctx.notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = ctx.notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				{
 					std::lock_guard lock(ctx.stack.mtx);
@@ -708,7 +709,7 @@ namespace pot::executors
 				{
 					if (st.stop_requested())
 						return;
-					ctx.notifier.wait(wait_val, std::memory_order_acquire);
+					ctx.notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
@@ -716,6 +717,7 @@ namespace pot::executors
 		std::vector<std::jthread> m_threads;
 		std::vector<std::unique_ptr<thread_context>> m_contexts;
 		std::atomic<size_t> m_next_thread_idx{0};
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -723,8 +725,9 @@ namespace pot::executors
 	{
 	public:
 		thread_pool_executor_gs_hot(std::string name,
-									size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+									size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+									pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_threads.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -740,7 +743,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 				throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -760,7 +763,6 @@ namespace pot::executors
 				}
 			}
 
-			m_notifier.fetch_add(1, std::memory_order_release);
 			m_notifier.notify_one();
 		}
 
@@ -773,7 +775,6 @@ namespace pot::executors
 			for (auto &thread : m_threads)
 				thread.request_stop();
 
-			m_notifier.fetch_add(m_threads.size(), std::memory_order_release);
 			m_notifier.notify_all();
 
 			m_threads.clear();
@@ -792,8 +793,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = m_notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = m_notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				{
 					std::lock_guard lock(m_deque.mtx);
@@ -812,14 +813,15 @@ namespace pot::executors
 				{
 					if (st.stop_requested())
 						return;
-					m_notifier.wait(wait_val, std::memory_order_acquire);
+					m_notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
 
 		std::vector<std::jthread> m_threads;
 		pot::work_deque m_deque;
-		std::atomic<uint64_t> m_notifier{0};
+		pot::idle_notifier m_notifier;
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -828,13 +830,14 @@ namespace pot::executors
 		struct thread_context
 		{
 			pot::work_deque deque;
-			std::atomic<uint64_t> notifier{0};
+			pot::idle_notifier notifier;
 		};
 
 	public:
 		thread_pool_executor_ls_hot(std::string name,
-									size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+									size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+									pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 
 			m_contexts.reserve(num_threads);
@@ -857,7 +860,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 				throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -882,7 +885,6 @@ namespace pot::executors
 				}
 			}
 
-			ctx.notifier.fetch_add(1, std::memory_order_release);
 			ctx.notifier.notify_one();
 		}
 
@@ -897,7 +899,6 @@ namespace pot::executors
 
 			for (auto &ctx : m_contexts)
 			{
-				ctx->notifier.fetch_add(1, std::memory_order_release);
 				ctx->notifier.notify_all();
 			}
 
@@ -919,8 +920,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = ctx.notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = ctx.notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				{
 					std::lock_guard lock(ctx.deque.mtx);
@@ -939,7 +940,7 @@ namespace pot::executors
 				{
 					if (st.stop_requested())
 						return;
-					ctx.notifier.wait(wait_val, std::memory_order_acquire);
+					ctx.notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
@@ -947,6 +948,7 @@ namespace pot::executors
 		std::vector<std::jthread> m_threads;
 		std::vector<std::unique_ptr<thread_context>> m_contexts;
 		std::atomic<size_t> m_next_thread_idx{0};
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -954,7 +956,8 @@ namespace pot::executors
 	{
 		struct task_item
 		{
-			std::function<void()> func;
+			// priority_queue::top() is const, so the task has to be movable out of it.
+			mutable pot::utils::unique_function_once func;
 			uint64_t priority;
 			uint64_t sequence;
 
@@ -977,8 +980,9 @@ namespace pot::executors
 
 	public:
 		thread_pool_executor_gpq(std::string name,
-								 size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+								 size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+								 pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_threads.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -994,7 +998,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 				throw std::runtime_error("Executor " + m_name + " is stopped.");
@@ -1006,7 +1010,6 @@ namespace pot::executors
 				m_queue.tasks.push(task_item{std::move(func), priority, m_queue.seq_counter++});
 			}
 
-			m_notifier.fetch_add(1, std::memory_order_release);
 			m_notifier.notify_one();
 		}
 
@@ -1019,7 +1022,6 @@ namespace pot::executors
 			for (auto &thread : m_threads)
 				thread.request_stop();
 
-			m_notifier.fetch_add(m_threads.size(), std::memory_order_release);
 			m_notifier.notify_all();
 
 			m_threads.clear();
@@ -1038,8 +1040,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = m_notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = m_notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				{
 					std::lock_guard lock(m_queue.mtx);
@@ -1058,14 +1060,15 @@ namespace pot::executors
 				{
 					if (st.stop_requested())
 						return;
-					m_notifier.wait(wait_val, std::memory_order_acquire);
+					m_notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
 
 		std::vector<std::jthread> m_threads;
 		work_pqueue m_queue;
-		std::atomic<uint64_t> m_notifier{0};
+		pot::idle_notifier m_notifier;
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -1073,14 +1076,15 @@ namespace pot::executors
 	{
 		struct thread_context
 		{
-			pot::algorithms::lfqueue<std::function<void()>> queue; 
-			std::atomic<uint64_t> notifier{0};
+			pot::algorithms::lfqueue<pot::utils::unique_function_once> queue; 
+			pot::idle_notifier notifier;
 		};
 
 	public:
 		thread_pool_executor_lqlf_steal_seq(std::string name,
-												  size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+												  size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+												  pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_contexts.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -1102,7 +1106,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 			{
@@ -1112,13 +1116,11 @@ namespace pot::executors
 			size_t idx = m_next_thread_idx.fetch_add(1, std::memory_order_relaxed) % m_threads.size();
 			auto &ctx = *m_contexts[idx];
 
-			std::function<void()> f = std::move(func);
-			while (!ctx.queue.push(f))
+			while (!ctx.queue.push(std::move(func)))
 			{
 				std::this_thread::yield();
 			}
 
-			ctx.notifier.fetch_add(1, std::memory_order_release);
 			ctx.notifier.notify_one();
 		}
 
@@ -1150,7 +1152,6 @@ namespace pot::executors
 
 			for (auto &ctx : m_contexts)
 			{
-				ctx->notifier.fetch_add(1, std::memory_order_release);
 				ctx->notifier.notify_all();
 			}
 
@@ -1173,8 +1174,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = my_ctx.notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = my_ctx.notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				if (auto local_task = my_ctx.queue.pop())
 				{
@@ -1206,7 +1207,7 @@ namespace pot::executors
 					{
 						return;
 					}
-					my_ctx.notifier.wait(wait_val, std::memory_order_acquire);
+					my_ctx.notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
@@ -1214,6 +1215,7 @@ namespace pot::executors
 		std::vector<std::jthread> m_threads;
 		std::vector<std::unique_ptr<thread_context>> m_contexts;
 		std::atomic<size_t> m_next_thread_idx{0};
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -1221,8 +1223,9 @@ namespace pot::executors
 	{
 	public:
 		thread_pool_executor_lfgq(std::string name,
-								  size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+								  size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+								  pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_threads.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -1238,7 +1241,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 			{
@@ -1246,13 +1249,11 @@ namespace pot::executors
 			}
 
 			
-			std::function<void()> f = std::move(func);
-			while (!m_queue.push(f))
+			while (!m_queue.push(std::move(func)))
 			{
 				std::this_thread::yield();
 			}
 
-			m_notifier.fetch_add(1, std::memory_order_release);
 			m_notifier.notify_one();
 		}
 
@@ -1269,7 +1270,6 @@ namespace pot::executors
 				thread.request_stop();
 			}
 
-			m_notifier.fetch_add(m_threads.size(), std::memory_order_release);
 			m_notifier.notify_all();
 
 			m_threads.clear();
@@ -1288,8 +1288,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = m_notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = m_notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				if (auto local_task = m_queue.pop())
 				{
@@ -1306,14 +1306,15 @@ namespace pot::executors
 					{
 						return;
 					}
-					m_notifier.wait(wait_val, std::memory_order_acquire);
+					m_notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
 
 		std::vector<std::jthread> m_threads;
-		pot::algorithms::lfqueue<std::function<void()>> m_queue;
-		std::atomic<uint64_t> m_notifier{0};
+		pot::algorithms::lfqueue<pot::utils::unique_function_once> m_queue;
+		pot::idle_notifier m_notifier;
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 
@@ -1321,14 +1322,15 @@ namespace pot::executors
 	{
 		struct thread_context
 		{
-			pot::algorithms::lfqueue<std::function<void()>> queue;
-			std::atomic<uint64_t> notifier{0};
+			pot::algorithms::lfqueue<pot::utils::unique_function_once> queue;
+			pot::idle_notifier notifier;
 		};
 
 	public:
 		thread_pool_executor_lflq(std::string name,
-								  size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
-			: executor(std::move(name))
+								  size_t num_threads = std::max<size_t>(1, std::thread::hardware_concurrency()),
+								  pot::idle_policy policy = {})
+			: executor(std::move(name)), m_policy(policy)
 		{
 			m_contexts.reserve(num_threads);
 			for (size_t i = 0; i < num_threads; ++i)
@@ -1350,7 +1352,7 @@ namespace pot::executors
 			shutdown();
 		}
 
-		void derived_execute(std::function<void()> &&func, pot::coroutines::details::task_meta *meta = nullptr) override
+		void derived_execute(pot::utils::unique_function_once &&func, pot::coroutines::details::task_meta *meta = nullptr) override
 		{
 			if (m_stop.load(std::memory_order_acquire))
 			{
@@ -1360,13 +1362,11 @@ namespace pot::executors
 			size_t idx = m_next_thread_idx.fetch_add(1, std::memory_order_relaxed) % m_threads.size();
 			auto &ctx = *m_contexts[idx];
 
-			std::function<void()> f = std::move(func);
-			while (!ctx.queue.push(f))
+			while (!ctx.queue.push(std::move(func)))
 			{
 				std::this_thread::yield();
 			}
 
-			ctx.notifier.fetch_add(1, std::memory_order_release);
 			ctx.notifier.notify_one();
 		}
 
@@ -1385,7 +1385,6 @@ namespace pot::executors
 
 			for (auto &ctx : m_contexts)
 			{
-				ctx->notifier.fetch_add(1, std::memory_order_release);
 				ctx->notifier.notify_all();
 			}
 
@@ -1407,8 +1406,8 @@ namespace pot::executors
 
 			while (!st.stop_requested())
 			{
-				uint64_t wait_val = ctx.notifier.load(std::memory_order_acquire);
-				std::function<void()> task;
+				const uint32_t wait_val = ctx.notifier.prepare_wait();
+				pot::utils::unique_function_once task;
 
 				
 				if (auto local_task = ctx.queue.pop())
@@ -1426,7 +1425,7 @@ namespace pot::executors
 					{
 						return;
 					}
-					ctx.notifier.wait(wait_val, std::memory_order_acquire);
+					ctx.notifier.wait(wait_val, m_policy);
 				}
 			}
 		}
@@ -1434,6 +1433,7 @@ namespace pot::executors
 		std::vector<std::jthread> m_threads;
 		std::vector<std::unique_ptr<thread_context>> m_contexts;
 		std::atomic<size_t> m_next_thread_idx{0};
+		pot::idle_policy m_policy;
 		std::atomic<bool> m_stop{false};
 	};
 } 
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+#include "pot/simd/simd_type.h"
+
+namespace pot::simd
+{
+/**
+ * @brief Instruction set extensions the SIMD kernels can use.
+ *
+ * A flag is set only when both the CPU and the operating system support the extension (the AVX
+ * and AVX-512 register state must be enabled in XCR0).
+ */
+struct cpu_features
+{
+    bool sse41 = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool avx512vl = false;
+    bool avx512vnni = false;
+    bool avx512bf16 = false;
+
+    /// Probe this machine with CPUID and XGETBV. Non-x86 targets report no features.
+    static cpu_features detect();
+
+    /// Features of this machine. Probed once.
+    static const cpu_features &system();
+
+    /// True when every feature set in `required` is set here too.
+    [[nodiscard]] bool covers(const cpu_features &required) const noexcept;
+};
+
+/// Parse `sse`, `avx` or `avx512` (any case). Anything else gives nullopt.
+[[nodiscard]] std::optional<SIMDType> parse_simd_type(std::string_view name);
+
+/// Width limit from the `POT_SIMD` environment variable, e.g. `POT_SIMD=sse` in tests. Read once.
+[[nodiscard]] std::optional<SIMDType> simd_type_override();
+
+/**
+ * @brief Widest SIMD width that may run here.
+ *
+ * A width qualifies when the kernels are compiled for it (@p compiled has its base extension:
+ * SSE4.1, AVX2, or AVX-512 F+BW) and @p cpu covers every extension @p compiled enables up to that
+ * width. @p limit caps the result. SSE is the floor.
+ */
+[[nodiscard]] SIMDType select_simd_type(const cpu_features &cpu, const cpu_features &compiled,
+                                        std::optional<SIMDType> limit = std::nullopt);
+} // namespace pot::simd
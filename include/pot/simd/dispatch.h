@@ -0,0 +1,114 @@
+#pragma once
+
+#include "pot/simd/cpu_features.h"
+
+namespace pot::simd
+{
+namespace details
+{
+    /// Extensions the kernels of this translation unit are compiled to use, from the -m flags.
+    consteval cpu_features compiled_features()
+    {
+        cpu_features f;
+#if defined(__SSE4_1__)
+        f.sse41 = true;
+#endif
+#if defined(__AVX2__)
+        f.avx2 = true;
+#endif
+#if defined(__FMA__)
+        f.fma = true;
+#endif
+#if defined(__F16C__)
+        f.f16c = true;
+#endif
+#if defined(__AVX512F__)
+        f.avx512f = true;
+#endif
+#if defined(__AVX512BW__)
+        f.avx512bw = true;
+#endif
+#if defined(__AVX512VL__)
+        f.avx512vl = true;
+#endif
+#if defined(__AVX512VNNI__)
+        f.avx512vnni = true;
+#endif
+#if defined(__AVX512BF16__)
+        f.avx512bf16 = true;
+#endif
+        return f;
+    }
+
+    /// Widest width this translation unit has kernels for.
+    consteval SIMDType widest_compiled()
+    {
+        constexpr cpu_features compiled = compiled_features();
+        if constexpr (compiled.avx512f && compiled.avx512bw)
+            return SIMDType::AVX512;
+        else if constexpr (compiled.avx2)
+            return SIMDType::AVX;
+        else
+            return SIMDType::SSE;
+    }
+
+    /// Extensions the library kernels of width `W` are built with, defined next to them.
+    template <SIMDType W>
+    cpu_features width_features();
+    template <>
+    cpu_features width_features<SIMDType::SSE>();
+    template <>
+    cpu_features width_features<SIMDType::AVX>();
+    template <>
+    cpu_features width_features<SIMDType::AVX512>();
+} // namespace details
+
+/**
+ * @brief Extensions the library's own SIMD kernels are built with.
+ *
+ * The library compiles its kernels once per width, each translation unit with the flags of that
+ * width (src/algorithms/simd_kernels_*.cpp), while the rest of the code stays at the SSE baseline.
+ */
+[[nodiscard]] cpu_features kernel_features();
+
+/**
+ * @brief SIMD width used for `SIMDType::Auto`.
+ *
+ * The widest width the library has kernels for and this CPU supports, capped by `POT_SIMD`
+ * (`sse`, `avx`, `avx512`). Chosen on the first call.
+ */
+[[nodiscard]] SIMDType active_simd_type();
+
+/**
+ * @brief Calls `kernel.template operator()<W>()` with the width to run at.
+ *
+ * For a concrete @p ST that width is used directly, at no cost. For `SIMDType::Auto` the width is
+ * `active_simd_type()`, narrowed to @p Widest: a kernel supplied by the caller is only compiled
+ * for the widths its own translation unit is built for. @p Widest is part of the signature so
+ * translation units built with different flags never share an instantiation.
+ *
+ *     return pot::simd::dispatch<ST>([&]<pot::simd::SIMDType W>() { return kernel<T, W>(args...); });
+ */
+template <SIMDType ST, SIMDType Widest = details::widest_compiled(), typename Kernel>
+decltype(auto) dispatch(Kernel &&kernel)
+{
+    if constexpr (ST != SIMDType::Auto)
+        return kernel.template operator()<ST>();
+    else
+    {
+        switch (active_simd_type())
+        {
+        case SIMDType::AVX512:
+            if constexpr (Widest == SIMDType::AVX512)
+                return kernel.template operator()<SIMDType::AVX512>();
+            [[fallthrough]];
+        case SIMDType::AVX:
+            if constexpr (Widest != SIMDType::SSE)
+                return kernel.template operator()<SIMDType::AVX>();
+            [[fallthrough]];
+        default:
+            return kernel.template operator()<SIMDType::SSE>();
+        }
+    }
+}
+} // namespace pot::simd
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+namespace pot::simd
+{
+    /**
+     * @brief IEEE 754 binary16 storage type.
+     *
+     * Only a container for the 16 bits: arithmetic goes through `float`. Conversion from `float`
+     * rounds to nearest even; overflow becomes infinity and NaN stays NaN.
+     */
+    struct float16
+    {
+        uint16_t bits = 0;
+
+        float16() = default;
+        explicit float16(float value) : bits(from_float(value)) {}
+
+        static constexpr float16 from_bits(uint16_t bits) noexcept
+        {
+            float16 h;
+            h.bits = bits;
+            return h;
+        }
+
+        explicit operator float() const noexcept
+        {
+            const uint32_t sign = static_cast<uint32_t>(bits & 0x8000u) << 16;
+            const uint32_t exponent = (bits >> 10) & 0x1fu;
+            const uint32_t mantissa = bits & 0x3ffu;
+
+            if (exponent == 0)
+            {
+                // Zero or subnormal: mantissa * 2^-24.
+                const float magnitude = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+                return std::bit_cast<float>(std::bit_cast<uint32_t>(magnitude) | sign);
+            }
+            if (exponent == 0x1f)
+                return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13));
+            return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+        }
+
+      private:
+        static uint16_t from_float(float value) noexcept
+        {
+            uint32_t x = std::bit_cast<uint32_t>(value);
+            const auto sign = static_cast<uint16_t>((x >> 16) & 0x8000u);
+            x &= 0x7fffffffu;
+
+            if (x >= 0x7f800000u) // inf or NaN
+                return static_cast<uint16_t>(sign | (x > 0x7f800000u ? 0x7e00u : 0x7c00u));
+            if (x >= 0x477ff000u) // rounds to a value above the largest half
+                return static_cast<uint16_t>(sign | 0x7c00u);
+            if (x < 0x38800000u)
+            {
+                // Subnormal half: adding 0.5 makes the FPU round at 2^-24, the half subnormal step.
+                const float shifted = std::bit_cast<float>(x) + 0.5f;
+                return static_cast<uint16_t>(sign | (std::bit_cast<uint32_t>(shifted) - 0x3f000000u));
+            }
+
+            const uint32_t odd = (x >> 13) & 1u;
+            x += 0xc8000fffu + odd; // rebias the exponent and round to nearest even
+            return static_cast<uint16_t>(sign | (x >> 13));
+        }
+    };
+
+    /**
+     * @brief bfloat16 storage type: the upper half of a `float`.
+     *
+     * Conversion from `float` rounds to nearest even and keeps NaNs quiet; conversion back is exact.
+     */
+    struct bfloat16
+    {
+        uint16_t bits = 0;
+
+        bfloat16() = default;
+        explicit bfloat16(float value) : bits(from_float(value)) {}
+
+        static constexpr bfloat16 from_bits(uint16_t bits) noexcept
+        {
+            bfloat16 h;
+            h.bits = bits;
+            return h;
+        }
+
+        explicit operator float() const noexcept { return std::bit_cast<float>(static_cast<uint32_t>(bits) << 16); }
+
+      private:
+        static uint16_t from_float(float value) noexcept
+        {
+            const uint32_t x = std::bit_cast<uint32_t>(value);
+            if ((x & 0x7fffffffu) > 0x7f800000u)
+                return static_cast<uint16_t>((x >> 16) | 0x40u);
+            return static_cast<uint16_t>((x + 0x7fffu + ((x >> 16) & 1u)) >> 16);
+        }
+    };
+
+    static_assert(sizeof(float16) == 2 && sizeof(bfloat16) == 2);
+} // namespace pot::simd
@@ -1,12 +1,66 @@
 #pragma once
 
 #include <math.h>
+#include <bitset>
 #include <cassert> 
+#include <cstdint>
 
 #include "pot/simd/simd_traits.h"
 
 namespace pot::simd
 {
+    /**
+     * @brief Per-lane booleans of a simd_auto<..., scalar_count>, as returned by its comparisons.
+     *
+     * Same interface as pot::simd::simd_mask; movemask() needs at most 64 lanes.
+     */
+    template <size_t scalar_count>
+    class simd_auto_mask
+    {
+        std::bitset<scalar_count> m_value;
+
+    public:
+        static constexpr size_t lanes = scalar_count;
+
+        simd_auto_mask() = default;
+        explicit simd_auto_mask(bool value)
+        {
+            if (value)
+                m_value.set();
+        }
+
+        static simd_auto_mask first(size_t count)
+        {
+            simd_auto_mask res;
+            for (size_t i = 0; i < count; ++i)
+                res.m_value.set(i);
+            return res;
+        }
+
+        void set(size_t index, bool value) { m_value.set(index, value); }
+
+        uint64_t movemask() const
+            requires(scalar_count <= 64)
+        {
+            return m_value.to_ullong();
+        }
+        size_t popcount() const { return m_value.count(); }
+        bool any () const { return m_value.any(); }
+        bool none() const { return m_value.none(); }
+        bool all () const { return m_value.all(); }
+
+        bool operator[](size_t index) const { return m_value[index]; }
+
+        simd_auto_mask operator&(const simd_auto_mask &rhs) const { simd_auto_mask res; res.m_value = m_value & rhs.m_value; return res; }
+        simd_auto_mask operator|(const simd_auto_mask &rhs) const { simd_auto_mask res; res.m_value = m_value | rhs.m_value; return res; }
+        simd_auto_mask operator^(const simd_auto_mask &rhs) const { simd_auto_mask res; res.m_value = m_value ^ rhs.m_value; return res; }
+        simd_auto_mask operator~() const { simd_auto_mask res; res.m_value = ~m_value; return res; }
+
+        simd_auto_mask &operator&=(const simd_auto_mask &rhs) { m_value &= rhs.m_value; return *this; }
+        simd_auto_mask &operator|=(const simd_auto_mask &rhs) { m_value |= rhs.m_value; return *this; }
+        simd_auto_mask &operator^=(const simd_auto_mask &rhs) { m_value ^= rhs.m_value; return *this; }
+    };
+
     /**
      * @brief Generic SIMD-like wrapper using plain scalar array.
      * 
@@ -103,19 +157,19 @@ namespace pot::simd
         simd_auto operator<<(const scalar_type rhs) const;
         simd_auto operator>>(const scalar_type rhs) const;
 
-        bool operator==(const simd_auto &rhs) const;
-        bool operator!=(const simd_auto &rhs) const;
-        bool operator<(const simd_auto &rhs) const;
-        bool operator<=(const simd_auto &rhs) const;
-        bool operator>(const simd_auto &rhs) const;
-        bool operator>=(const simd_auto &rhs) const;
+        using mask = simd_auto_mask<scalar_count>;
 
-        // simd_auto operator==(const simd_auto &rhs) const;
-        // simd_auto operator!=(const simd_auto &rhs) const;
-        // simd_auto operator<(const simd_auto &rhs) const;
-        // simd_auto operator<=(const simd_auto &rhs) const;
-        // simd_auto operator>(const simd_auto &rhs) const;
-        // simd_auto operator>=(const simd_auto &rhs) const;
+        mask operator==(const simd_auto &rhs) const;
+        mask operator!=(const simd_auto &rhs) const;
+        mask operator<(const simd_auto &rhs) const;
+        mask operator<=(const simd_auto &rhs) const;
+        mask operator>(const simd_auto &rhs) const;
+        mask operator>=(const simd_auto &rhs) const;
+
+        /// The lanes selected by `m` moved to the front in order, the rest zero.
+        simd_auto compress(const mask &m) const;
+        /// Writes the lanes selected by `m` to ptr[0], ptr[1], ... and returns m.popcount().
+        size_t compress_store(scalar_type *ptr, const mask &m) const;
 
         simd_auto operator~() const;
         simd_auto operator-() const;
@@ -603,79 +657,121 @@ namespace pot::simd
     }
 
     template <simdable scalar_type, size_t scalar_count>
-    inline bool simd_auto<scalar_type, scalar_count>::operator==(const simd_auto &rhs) const
+    inline simd_auto_mask<scalar_count> simd_auto<scalar_type, scalar_count>::operator==(const simd_auto &rhs) const
     {
+        mask res;
         for (size_t i = 0; i < scalar_count; ++i)
         {
-            if (m_value[i] != rhs.m_value[i])
-            {
-                return false;
-            }
+            res.set(i, m_value[i] == rhs.m_value[i]);
         }
 
-        return true;
+        return res;
     }
 
     template <simdable scalar_type, size_t scalar_count>
-    inline bool simd_auto<scalar_type, scalar_count>::operator!=(const simd_auto &rhs) const
+    inline simd_auto_mask<scalar_count> simd_auto<scalar_type, scalar_count>::operator!=(const simd_auto &rhs) const
     {
-        return !(*this == rhs);
+        mask res;
+        for (size_t i = 0; i < scalar_count; ++i)
+        {
+            res.set(i, m_value[i] != rhs.m_value[i]);
+        }
+
+        return res;
     }
 
     template <simdable scalar_type, size_t scalar_count>
-    inline bool simd_auto<scalar_type, scalar_count>::operator<(const simd_auto &rhs) const
+    inline simd_auto_mask<scalar_count> simd_auto<scalar_type, scalar_count>::operator<(const simd_auto &rhs) const
     {
+        mask res;
         for (size_t i = 0; i < scalar_count; ++i)
         {
-            if (m_value[i] >= rhs.m_value[i])
-            {
-                return false;
-            }
+            res.set(i, m_value[i] < rhs.m_value[i]);
         }
 
-        return true;
+        return res;
     }
 
     template <simdable scalar_type, size_t scalar_count>
-    inline bool simd_auto<scalar_type, scalar_count>::operator<=(const simd_auto &rhs) const
+    inline simd_auto_mask<scalar_count> simd_auto<scalar_type, scalar_count>::operator<=(const simd_auto &rhs) const
     {
+        mask res;
         for (size_t i = 0; i < scalar_count; ++i)
         {
-            if (m_value[i] > rhs.m_value[i])
-            {
-                return false;
-            }
+            res.set(i, m_value[i] <= rhs.m_value[i]);
+        }
+
+        return res;
+    }
+
+    template <simdable scalar_type, size_t scalar_count>
+    inline simd_auto_mask<scalar_count> simd_auto<scalar_type, scalar_count>::operator>(const simd_auto &rhs) const
+    {
+        mask res;
+        for (size_t i = 0; i < scalar_count; ++i)
+        {
+            res.set(i, m_value[i] > rhs.m_value[i]);
         }
 
-        return true;
+        return res;
     }
 
     template <simdable scalar_type, size_t scalar_count>
-    inline bool simd_auto<scalar_type, scalar_count>::operator>(const simd_auto &rhs) const
+    inline simd_auto_mask<scalar_count> simd_auto<scalar_type, scalar_count>::operator>=(const simd_auto &rhs) const
     {
+        mask res;
         for (size_t i = 0; i < scalar_count; ++i)
         {
-            if (m_value[i] <= rhs.m_value[i])
+            res.set(i, m_value[i] >= rhs.m_value[i]);
+        }
+
+        return res;
+    }
+
+    template <simdable scalar_type, size_t scalar_count>
+    inline simd_auto<scalar_type, scalar_count> simd_auto<scalar_type, scalar_count>::compress(const mask &m) const
+    {
+        simd_auto res = zeros();
+        size_t count = 0;
+        for (size_t i = 0; i < scalar_count; ++i)
+        {
+            if (m[i])
             {
-                return false;
+                res.m_value[count++] = m_value[i];
             }
         }
 
-        return true;
+        return res;
     }
 
     template <simdable scalar_type, size_t scalar_count>
-    inline bool simd_auto<scalar_type, scalar_count>::operator>=(const simd_auto &rhs) const
+    inline size_t simd_auto<scalar_type, scalar_count>::compress_store(scalar_type *ptr, const mask &m) const
     {
+        size_t count = 0;
         for (size_t i = 0; i < scalar_count; ++i)
         {
-            if (m_value[i] < rhs.m_value[i])
+            if (m[i])
             {
-                return false;
+                ptr[count++] = m_value[i];
             }
         }
 
-        return true;
+        return count;
+    }
+
+    /// Lane i from `a` where `m` has lane i set, from `b` elsewhere.
+    template <simdable scalar_type, size_t scalar_count>
+    inline simd_auto<scalar_type, scalar_count> select(const simd_auto_mask<scalar_count> &m,
+                                                       const simd_auto<scalar_type, scalar_count> &a,
+                                                       const simd_auto<scalar_type, scalar_count> &b)
+    {
+        simd_auto<scalar_type, scalar_count> res;
+        for (size_t i = 0; i < scalar_count; ++i)
+        {
+            res[i] = m[i] ? a[i] : b[i];
+        }
+
+        return res;
     }
 
     // template <simdable scalar_type, size_t scalar_count>
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <immintrin.h>
+#include <utility>
 
+#include "pot/simd/simd_mask.h"
 #include "pot/simd/simd_traits.h"
 
 namespace pot::simd
@@ -11,7 +13,13 @@ namespace pot::simd
     {
         using trait = details::simd_traits<scalar_type, simd_type>;
         trait::vector_type m_value;
+
+        template<simdable T, SIMDType ST>
+        friend simd_forced<T, ST> select(const simd_mask<T, ST>&, const simd_forced<T, ST>&, const simd_forced<T, ST>&);
     public:
+        static constexpr size_t lanes = trait::scalar_count;
+        using mask = simd_mask<scalar_type, simd_type>;
+
         simd_forced() = default;
         simd_forced(const simd_forced&) = default;
         simd_forced(simd_forced&&) = default;
@@ -31,9 +39,15 @@ namespace pot::simd
 
         void load(const scalar_type* ptr) { m_value = trait::load(ptr); }
         void loadu(const scalar_type* ptr) { m_value = trait::loadu(ptr); }
+        /// Loads the first `count` lanes and zeroes the rest; nothing past ptr + count is read.
+        void loadu(const scalar_type* ptr, size_t count) { m_value = trait::load_partial(ptr, count); }
+        /// Lane k = base[idx[k]]; indices must be below 2^31.
+        void gather(const scalar_type* base, const uint32_t* idx) { m_value = trait::gather(base, idx); }
 
         void store(scalar_type* ptr) const { trait::store(ptr, m_value); }
         void storeu(scalar_type* ptr) const { trait::storeu(ptr, m_value); }
+        /// Writes only the first `count` lanes.
+        void storeu(scalar_type* ptr, size_t count) const { trait::store_partial(ptr, m_value, count); }
 
         static simd_forced zeros() { return simd_forced(scalar_type(0)); }
         static simd_forced ones()  { return simd_forced(scalar_type(1)); }
@@ -63,11 +77,33 @@ namespace pot::simd
         simd_forced asinh() const { return trait::asinh(m_value); }
         simd_forced acosh() const { return trait::acosh(m_value); }
         simd_forced atanh() const { return trait::atanh(m_value); }
+        simd_forced erf  () const { return trait::erf(m_value); }
+        /// 1 / (1 + e^-x), float and double lanes.
+        simd_forced sigmoid() const { return trait::sigmoid(m_value); }
         simd_forced ceil () const { return trait::ceil(m_value); }
         simd_forced floor() const { return trait::floor(m_value); }
         simd_forced trunc() const { return trait::trunc(m_value); }
         simd_forced round() const { return trait::round(m_value); }
 
+        /// this * b + c. Float and double lanes round once when the build has FMA (always on AVX-512).
+        simd_forced fma (const simd_forced& b, const simd_forced& c) const { return trait::fmadd (m_value, b.m_value, c.m_value); }
+        /// this * b - c.
+        simd_forced fms (const simd_forced& b, const simd_forced& c) const { return trait::fmsub (m_value, b.m_value, c.m_value); }
+        /// c - this * b.
+        simd_forced fnma(const simd_forced& b, const simd_forced& c) const { return trait::fnmadd(m_value, b.m_value, c.m_value); }
+
+        /// The lanes selected by `m` moved to the front in order; the lanes past m.popcount() are unspecified.
+        simd_forced compress(const mask& m) const { return trait::compress(m_value, m.value()); }
+        /// Writes the lanes selected by `m` to ptr[0], ptr[1], ... and returns m.popcount(); nothing else is written.
+        size_t compress_store(scalar_type* ptr, const mask& m) const { return trait::compress_store(ptr, m_value, m.value()); }
+
+        /// The first `count` lanes of this vector, the rest from `rest`.
+        simd_forced first(size_t count, const simd_forced& rest) const { return trait::blend_first(m_value, rest.m_value, count); }
+
+        /// Lanes move K positions up; the K lowest lanes are filled from `fill` (a broadcast value).
+        template<size_t K>
+        simd_forced shift_lanes_up(const simd_forced& fill) const { return trait::template shift_lanes_up<K>(m_value, fill.m_value); }
+
         simd_forced operator+ (const simd_forced& rhs) const { return trait::add (m_value, rhs.m_value); }
         simd_forced operator- (const simd_forced& rhs) const { return trait::sub (m_value, rhs.m_value); }
         simd_forced operator* (const simd_forced& rhs) const { return trait::mul (m_value, rhs.m_value); }
@@ -79,19 +115,12 @@ namespace pot::simd
         simd_forced operator<<(const scalar_type  rhs) const { return trait::shl (m_value, static_cast<int>(rhs)); }
         simd_forced operator>>(const scalar_type  rhs) const { return trait::shr (m_value, static_cast<int>(rhs)); }
 
-        bool operator==(const simd_forced& rhs) const { return trait::cmpeq_bool (m_value, rhs.m_value); }
-        bool operator!=(const simd_forced& rhs) const { return trait::cmpneq_bool(m_value, rhs.m_value); }
-        bool operator< (const simd_forced& rhs) const { return trait::cmplt_bool (m_value, rhs.m_value); }
-        bool operator<=(const simd_forced& rhs) const { return trait::cmple_bool (m_value, rhs.m_value); }
-        bool operator> (const simd_forced& rhs) const { return trait::cmpgt_bool (m_value, rhs.m_value); }
-        bool operator>=(const simd_forced& rhs) const { return trait::cmpge_bool (m_value, rhs.m_value); }
-
-        // simd_forced operator==(const simd_forced& rhs) const { return trait::cmpeq (m_value, rhs.m_value); }
-        // simd_forced operator!=(const simd_forced& rhs) const { return trait::cmpneq(m_value, rhs.m_value); }
-        // simd_forced operator< (const simd_forced& rhs) const { return trait::cmplt (m_value, rhs.m_value); }
-        // simd_forced operator<=(const simd_forced& rhs) const { return trait::cmple (m_value, rhs.m_value); }
-        // simd_forced operator> (const simd_forced& rhs) const { return trait::cmpgt (m_value, rhs.m_value); }
-        // simd_forced operator>=(const simd_forced& rhs) const { return trait::cmpge (m_value, rhs.m_value); }
+        mask operator==(const simd_forced& rhs) const { return trait::cmpeq (m_value, rhs.m_value); }
+        mask operator!=(const simd_forced& rhs) const { return trait::cmpneq(m_value, rhs.m_value); }
+        mask operator< (const simd_forced& rhs) const { return trait::cmplt (m_value, rhs.m_value); }
+        mask operator<=(const simd_forced& rhs) const { return trait::cmple (m_value, rhs.m_value); }
+        mask operator> (const simd_forced& rhs) const { return trait::cmpgt (m_value, rhs.m_value); }
+        mask operator>=(const simd_forced& rhs) const { return trait::cmpge (m_value, rhs.m_value); }
 
         simd_forced operator~() const { return trait::not_(m_value); }
         simd_forced operator-() const { return trait::neg(m_value); }
@@ -119,7 +148,62 @@ namespace pot::simd
 
     };
 
-
-
+    /// Lane k from `a` where `m` has lane k set, from `b` elsewhere.
+    template<simdable scalar_type, SIMDType simd_type>
+    simd_forced<scalar_type, simd_type> select(const simd_mask<scalar_type, simd_type>& m,
+                                               const simd_forced<scalar_type, simd_type>& a,
+                                               const simd_forced<scalar_type, simd_type>& b)
+    {
+        return details::simd_traits<scalar_type, simd_type>::select(m.value(), a.m_value, b.m_value);
+    }
+
+    /**
+     * @brief N independent accumulator registers for one reduction loop.
+     *
+     * A single `sum = a.fma(b, sum)` chain issues one FMA per FMA latency (4 cycles on current x86
+     * cores), so a loop with one accumulator runs at a fraction of the FMA throughput. Splitting
+     * the sum over N registers gives N independent chains; 4 cover a load-bound loop such as a dot
+     * product, 8 are needed to saturate two FMA ports from registers.
+     *
+     * @code
+     * pot::simd::accumulators<simd_forced<float, SIMDType::AVX>, 4> acc;
+     * for (; i + acc.stride <= n; i += acc.stride)
+     *     acc.each([&](auto &sum, size_t k) { sum = load(a + i + k * 8).fma(load(b + i + k * 8), sum); });
+     * float dot = acc.total().sum();
+     * @endcode
+     */
+    template<typename simd_t, size_t N>
+    class accumulators
+    {
+        static_assert(N > 0, "accumulators: N must be positive");
+        simd_t m_acc[N];
+    public:
+        /// Elements one call of `each` consumes when every accumulator takes one register.
+        static constexpr size_t stride = N * simd_t::lanes;
+
+        accumulators() { for (auto& acc : m_acc) acc = simd_t::zeros(); }
+
+        simd_t& operator[](size_t k) { return m_acc[k]; }
+        const simd_t& operator[](size_t k) const { return m_acc[k]; }
+
+        /// Calls f(acc[k], k) for k = 0 .. N - 1, unrolled at compile time.
+        template<typename F>
+        void each(F&& f)
+        {
+            [&]<size_t... K>(std::index_sequence<K...>) { (f(m_acc[K], K), ...); }(std::make_index_sequence<N>{});
+        }
+
+        /// The accumulators added as a balanced tree: (acc0 + acc1) + (acc2 + acc3) ...
+        simd_t total() const
+        {
+            simd_t values[N];
+            for (size_t k = 0; k < N; ++k)
+                values[k] = m_acc[k];
+            for (size_t step = 1; step < N; step *= 2)
+                for (size_t k = 0; k + step < N; k += 2 * step)
+                    values[k] += values[k + step];
+            return values[0];
+        }
+    };
 } // namespace pot::simd
 
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+#include "pot/simd/simd_traits.h"
+
+namespace pot::simd
+{
+    /**
+     * @brief Per-lane booleans of a simd_forced<scalar_type, simd_type>, as returned by its comparisons.
+     *
+     * SSE and AVX hold the mask in a vector register whose lanes are all ones or all zeros, AVX-512
+     * in a k-register with one bit per lane. Either way bit k of movemask() is lane k, and the mask
+     * feeds select() and simd_forced::compress_store().
+     */
+    template<simdable scalar_type, SIMDType simd_type>
+    class simd_mask
+    {
+        using trait = details::simd_traits<scalar_type, simd_type>;
+        trait::mask_type m_value;
+    public:
+        static constexpr size_t lanes = trait::scalar_count;
+
+        simd_mask() = default;
+        simd_mask(const trait::mask_type& value) : m_value(value) {}
+        /// Every lane set to `value`.
+        explicit simd_mask(bool value) : m_value(trait::mask_set1(value)) {}
+
+        /// Lanes [0, count) set, the rest clear; count <= lanes.
+        static simd_mask first(size_t count) { return trait::lane_mask(count); }
+
+        const trait::mask_type& value() const { return m_value; }
+
+        /// Bit k is lane k.
+        uint64_t movemask() const { return trait::movemask(m_value); }
+        size_t   popcount() const { return static_cast<size_t>(std::popcount(movemask())); }
+        bool     any     () const { return movemask() != 0; }
+        bool     none    () const { return movemask() == 0; }
+        bool     all     () const { return movemask() == all_lanes; }
+
+        bool operator[](size_t index) const { return ((movemask() >> index) & 1) != 0; }
+
+        simd_mask operator&(const simd_mask& rhs) const { return trait::mask_and(m_value, rhs.m_value); }
+        simd_mask operator|(const simd_mask& rhs) const { return trait::mask_or (m_value, rhs.m_value); }
+        simd_mask operator^(const simd_mask& rhs) const { return trait::mask_xor(m_value, rhs.m_value); }
+        simd_mask operator~() const { return trait::mask_not(m_value); }
+
+        simd_mask& operator&=(const simd_mask& rhs) { m_value = trait::mask_and(m_value, rhs.m_value); return *this; }
+        simd_mask& operator|=(const simd_mask& rhs) { m_value = trait::mask_or (m_value, rhs.m_value); return *this; }
+        simd_mask& operator^=(const simd_mask& rhs) { m_value = trait::mask_xor(m_value, rhs.m_value); return *this; }
+
+    private:
+        static constexpr uint64_t all_lanes = lanes >= 64 ? ~uint64_t(0) : (uint64_t(1) << lanes) - 1;
+    };
+} // namespace pot::simd
@@ -0,0 +1,557 @@
+#pragma once
+
+#include <immintrin.h>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "pot/simd/simd_traits.h"
+
+namespace pot::simd::details
+{
+    /**
+     * Lane operations the transcendental kernels below are written in, for float and double
+     * registers of one width. `I` is the same register viewed as integers of the lane size and
+     * `M` is a lane mask: a register of all-ones lanes up to AVX2, a k-mask on AVX-512.
+     */
+    template<typename T, SIMDType ST>
+    struct math_ops;
+
+    template<typename T>
+    struct math_ops<T, SIMDType::SSE>
+    {
+        static constexpr bool is_float = std::is_same_v<T, float>;
+        using V = std::conditional_t<is_float, __m128, __m128d>;
+        using I = __m128i;
+        using M = V;
+        using bits_type = std::conditional_t<is_float, uint32_t, uint64_t>;
+
+        static V set1(T v) { if constexpr (is_float) return _mm_set1_ps(v); else return _mm_set1_pd(v); }
+        static I set1_bits(bits_type v)
+        {
+            if constexpr (is_float) return _mm_set1_epi32(static_cast<int>(v));
+            else return _mm_set1_epi64x(static_cast<long long>(v));
+        }
+        static V loadu(const T* p) { if constexpr (is_float) return _mm_loadu_ps(p); else return _mm_loadu_pd(p); }
+        static void storeu(T* p, V a) { if constexpr (is_float) _mm_storeu_ps(p, a); else _mm_storeu_pd(p, a); }
+
+        static V add(V a, V b) { if constexpr (is_float) return _mm_add_ps(a, b); else return _mm_add_pd(a, b); }
+        static V sub(V a, V b) { if constexpr (is_float) return _mm_sub_ps(a, b); else return _mm_sub_pd(a, b); }
+        static V mul(V a, V b) { if constexpr (is_float) return _mm_mul_ps(a, b); else return _mm_mul_pd(a, b); }
+        static V div(V a, V b) { if constexpr (is_float) return _mm_div_ps(a, b); else return _mm_div_pd(a, b); }
+        // a * b + c, fused when the build has FMA.
+        static V madd(V a, V b, V c)
+        {
+#if defined(__FMA__)
+            if constexpr (is_float) return _mm_fmadd_ps(a, b, c); else return _mm_fmadd_pd(a, b, c);
+#else
+            return add(mul(a, b), c);
+#endif
+        }
+        // NaN in `b` is returned as is.
+        static V min(V a, V b) { if constexpr (is_float) return _mm_min_ps(a, b); else return _mm_min_pd(a, b); }
+        static V max(V a, V b) { if constexpr (is_float) return _mm_max_ps(a, b); else return _mm_max_pd(a, b); }
+        static V round(V a)
+        {
+            if constexpr (is_float) return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            else return _mm_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+        static V floor(V a) { if constexpr (is_float) return _mm_floor_ps(a); else return _mm_floor_pd(a); }
+
+        static I to_bits(V a) { if constexpr (is_float) return _mm_castps_si128(a); else return _mm_castpd_si128(a); }
+        static V from_bits(I a) { if constexpr (is_float) return _mm_castsi128_ps(a); else return _mm_castsi128_pd(a); }
+        static I add_bits(I a, I b) { if constexpr (is_float) return _mm_add_epi32(a, b); else return _mm_add_epi64(a, b); }
+        static I and_bits(I a, I b) { return _mm_and_si128(a, b); }
+        static I or_bits(I a, I b) { return _mm_or_si128(a, b); }
+        static I xor_bits(I a, I b) { return _mm_xor_si128(a, b); }
+        template<int N> static I shl(I a) { if constexpr (is_float) return _mm_slli_epi32(a, N); else return _mm_slli_epi64(a, N); }
+        template<int N> static I shr(I a) { if constexpr (is_float) return _mm_srli_epi32(a, N); else return _mm_srli_epi64(a, N); }
+
+        static M lt(V a, V b) { if constexpr (is_float) return _mm_cmplt_ps(a, b); else return _mm_cmplt_pd(a, b); }
+        static M gt(V a, V b) { if constexpr (is_float) return _mm_cmpgt_ps(a, b); else return _mm_cmpgt_pd(a, b); }
+        static M eq(V a, V b) { if constexpr (is_float) return _mm_cmpeq_ps(a, b); else return _mm_cmpeq_pd(a, b); }
+        // Not less-than / not less-or-equal: also true when either side is NaN.
+        static M nlt(V a, V b) { if constexpr (is_float) return _mm_cmpnlt_ps(a, b); else return _mm_cmpnlt_pd(a, b); }
+        static M nle(V a, V b) { if constexpr (is_float) return _mm_cmpnle_ps(a, b); else return _mm_cmpnle_pd(a, b); }
+        static M isnan(V a) { if constexpr (is_float) return _mm_cmpunord_ps(a, a); else return _mm_cmpunord_pd(a, a); }
+        // Lanes whose lowest integer bit is set.
+        static M low_bit(I a)
+        {
+            const I one = set1_bits(1);
+            if constexpr (is_float) return from_bits(_mm_cmpeq_epi32(_mm_and_si128(a, one), one));
+            else return from_bits(_mm_cmpeq_epi64(_mm_and_si128(a, one), one));
+        }
+        // m ? a : b
+        static V select(M m, V a, V b) { if constexpr (is_float) return _mm_blendv_ps(b, a, m); else return _mm_blendv_pd(b, a, m); }
+        static bool any(M m) { if constexpr (is_float) return _mm_movemask_ps(m) != 0; else return _mm_movemask_pd(m) != 0; }
+    };
+
+    template<typename T>
+    struct math_ops<T, SIMDType::AVX>
+    {
+        static constexpr bool is_float = std::is_same_v<T, float>;
+        using V = std::conditional_t<is_float, __m256, __m256d>;
+        using I = __m256i;
+        using M = V;
+        using bits_type = std::conditional_t<is_float, uint32_t, uint64_t>;
+
+        static V set1(T v) { if constexpr (is_float) return _mm256_set1_ps(v); else return _mm256_set1_pd(v); }
+        static I set1_bits(bits_type v)
+        {
+            if constexpr (is_float) return _mm256_set1_epi32(static_cast<int>(v));
+            else return _mm256_set1_epi64x(static_cast<long long>(v));
+        }
+        static V loadu(const T* p) { if constexpr (is_float) return _mm256_loadu_ps(p); else return _mm256_loadu_pd(p); }
+        static void storeu(T* p, V a) { if constexpr (is_float) _mm256_storeu_ps(p, a); else _mm256_storeu_pd(p, a); }
+
+        static V add(V a, V b) { if constexpr (is_float) return _mm256_add_ps(a, b); else return _mm256_add_pd(a, b); }
+        static V sub(V a, V b) { if constexpr (is_float) return _mm256_sub_ps(a, b); else return _mm256_sub_pd(a, b); }
+        static V mul(V a, V b) { if constexpr (is_float) return _mm256_mul_ps(a, b); else return _mm256_mul_pd(a, b); }
+        static V div(V a, V b) { if constexpr (is_float) return _mm256_div_ps(a, b); else return _mm256_div_pd(a, b); }
+        static V madd(V a, V b, V c)
+        {
+#if defined(__FMA__)
+            if constexpr (is_float) return _mm256_fmadd_ps(a, b, c); else return _mm256_fmadd_pd(a, b, c);
+#else
+            return add(mul(a, b), c);
+#endif
+        }
+        static V min(V a, V b) { if constexpr (is_float) return _mm256_min_ps(a, b); else return _mm256_min_pd(a, b); }
+        static V max(V a, V b) { if constexpr (is_float) return _mm256_max_ps(a, b); else return _mm256_max_pd(a, b); }
+        static V round(V a)
+        {
+            if constexpr (is_float) return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            else return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+        static V floor(V a) { if constexpr (is_float) return _mm256_floor_ps(a); else return _mm256_floor_pd(a); }
+
+        static I to_bits(V a) { if constexpr (is_float) return _mm256_castps_si256(a); else return _mm256_castpd_si256(a); }
+        static V from_bits(I a) { if constexpr (is_float) return _mm256_castsi256_ps(a); else return _mm256_castsi256_pd(a); }
+        static I add_bits(I a, I b) { if constexpr (is_float) return _mm256_add_epi32(a, b); else return _mm256_add_epi64(a, b); }
+        static I and_bits(I a, I b) { return _mm256_and_si256(a, b); }
+        static I or_bits(I a, I b) { return _mm256_or_si256(a, b); }
+        static I xor_bits(I a, I b) { return _mm256_xor_si256(a, b); }
+        template<int N> static I shl(I a) { if constexpr (is_float) return _mm256_slli_epi32(a, N); else return _mm256_slli_epi64(a, N); }
+        template<int N> static I shr(I a) { if constexpr (is_float) return _mm256_srli_epi32(a, N); else return _mm256_srli_epi64(a, N); }
+
+        static M lt(V a, V b) { if constexpr (is_float) return _mm256_cmp_ps(a, b, _CMP_LT_OQ); else return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+        static M gt(V a, V b) { if constexpr (is_float) return _mm256_cmp_ps(a, b, _CMP_GT_OQ); else return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+        static M eq(V a, V b) { if constexpr (is_float) return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); else return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+        static M nlt(V a, V b) { if constexpr (is_float) return _mm256_cmp_ps(a, b, _CMP_NLT_UQ); else return _mm256_cmp_pd(a, b, _CMP_NLT_UQ); }
+        static M nle(V a, V b) { if constexpr (is_float) return _mm256_cmp_ps(a, b, _CMP_NLE_UQ); else return _mm256_cmp_pd(a, b, _CMP_NLE_UQ); }
+        static M isnan(V a) { if constexpr (is_float) return _mm256_cmp_ps(a, a, _CMP_UNORD_Q); else return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+        static M low_bit(I a)
+        {
+            const I one = set1_bits(1);
+            if constexpr (is_float) return from_bits(_mm256_cmpeq_epi32(_mm256_and_si256(a, one), one));
+            else return from_bits(_mm256_cmpeq_epi64(_mm256_and_si256(a, one), one));
+        }
+        static V select(M m, V a, V b) { if constexpr (is_float) return _mm256_blendv_ps(b, a, m); else return _mm256_blendv_pd(b, a, m); }
+        static bool any(M m) { if constexpr (is_float) return _mm256_movemask_ps(m) != 0; else return _mm256_movemask_pd(m) != 0; }
+    };
+
+    template<typename T>
+    struct math_ops<T, SIMDType::AVX512>
+    {
+        static constexpr bool is_float = std::is_same_v<T, float>;
+        using V = std::conditional_t<is_float, __m512, __m512d>;
+        using I = __m512i;
+        using M = std::conditional_t<is_float, __mmask16, __mmask8>;
+        using bits_type = std::conditional_t<is_float, uint32_t, uint64_t>;
+
+        static V set1(T v) { if constexpr (is_float) return _mm512_set1_ps(v); else return _mm512_set1_pd(v); }
+        static I set1_bits(bits_type v)
+        {
+            if constexpr (is_float) return _mm512_set1_epi32(static_cast<int>(v));
+            else return _mm512_set1_epi64(static_cast<long long>(v));
+        }
+        static V loadu(const T* p) { if constexpr (is_float) return _mm512_loadu_ps(p); else return _mm512_loadu_pd(p); }
+        static void storeu(T* p, V a) { if constexpr (is_float) _mm512_storeu_ps(p, a); else _mm512_storeu_pd(p, a); }
+
+        static V add(V a, V b) { if constexpr (is_float) return _mm512_add_ps(a, b); else return _mm512_add_pd(a, b); }
+        static V sub(V a, V b) { if constexpr (is_float) return _mm512_sub_ps(a, b); else return _mm512_sub_pd(a, b); }
+        static V mul(V a, V b) { if constexpr (is_float) return _mm512_mul_ps(a, b); else return _mm512_mul_pd(a, b); }
+        static V div(V a, V b) { if constexpr (is_float) return _mm512_div_ps(a, b); else return _mm512_div_pd(a, b); }
+        static V madd(V a, V b, V c) { if constexpr (is_float) return _mm512_fmadd_ps(a, b, c); else return _mm512_fmadd_pd(a, b, c); }
+        static V min(V a, V b) { if constexpr (is_float) return _mm512_min_ps(a, b); else return _mm512_min_pd(a, b); }
+        static V max(V a, V b) { if constexpr (is_float) return _mm512_max_ps(a, b); else return _mm512_max_pd(a, b); }
+        static V round(V a)
+        {
+            if constexpr (is_float) return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            else return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+        static V floor(V a)
+        {
+            if constexpr (is_float) return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+            else return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        }
+
+        static I to_bits(V a) { if constexpr (is_float) return _mm512_castps_si512(a); else return _mm512_castpd_si512(a); }
+        static V from_bits(I a) { if constexpr (is_float) return _mm512_castsi512_ps(a); else return _mm512_castsi512_pd(a); }
+        static I add_bits(I a, I b) { if constexpr (is_float) return _mm512_add_epi32(a, b); else return _mm512_add_epi64(a, b); }
+        static I and_bits(I a, I b) { return _mm512_and_si512(a, b); }
+        static I or_bits(I a, I b) { return _mm512_or_si512(a, b); }
+        static I xor_bits(I a, I b) { return _mm512_xor_si512(a, b); }
+        template<int N> static I shl(I a) { if constexpr (is_float) return _mm512_slli_epi32(a, N); else return _mm512_slli_epi64(a, N); }
+        template<int N> static I shr(I a) { if constexpr (is_float) return _mm512_srli_epi32(a, N); else return _mm512_srli_epi64(a, N); }
+
+        static M lt(V a, V b) { if constexpr (is_float) return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); else return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+        static M gt(V a, V b) { if constexpr (is_float) return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); else return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+        static M eq(V a, V b) { if constexpr (is_float) return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); else return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+        static M nlt(V a, V b) { if constexpr (is_float) return _mm512_cmp_ps_mask(a, b, _CMP_NLT_UQ); else return _mm512_cmp_pd_mask(a, b, _CMP_NLT_UQ); }
+        static M nle(V a, V b) { if constexpr (is_float) return _mm512_cmp_ps_mask(a, b, _CMP_NLE_UQ); else return _mm512_cmp_pd_mask(a, b, _CMP_NLE_UQ); }
+        static M isnan(V a) { if constexpr (is_float) return _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q); else return _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q); }
+        static M low_bit(I a)
+        {
+            if constexpr (is_float) return _mm512_test_epi32_mask(a, set1_bits(1));
+            else return _mm512_test_epi64_mask(a, set1_bits(1));
+        }
+        static V select(M m, V a, V b) { if constexpr (is_float) return _mm512_mask_blend_ps(m, b, a); else return _mm512_mask_blend_pd(m, b, a); }
+        static bool any(M m) { return m != 0; }
+    };
+
+    /**
+     * Constants of the float and double kernels. Polynomial coefficients are Chebyshev
+     * interpolants of the named remainder functions on the reduced range, refitted until the
+     * truncation error is well under half an ulp; coefficients go from the constant term up.
+     */
+    template<typename T>
+    struct math_constants;
+
+    template<>
+    struct math_constants<float>
+    {
+        using bits_type = uint32_t;
+        static constexpr int mantissa_bits = 23;
+        static constexpr int exponent_bias = 127;
+        // x + 1.5 * 2^23 leaves round(x) in the low mantissa bits for |x| < 2^22.
+        static constexpr float int_magic = 12582912.0f;
+        static constexpr float two_pow_mantissa = 8388608.0f;
+        static constexpr bits_type sign_mask = 0x80000000u;
+
+        // exp(x) overflows above exp_hi and is below half the smallest subnormal under exp_lo.
+        static constexpr float exp_hi = 88.7228394f;
+        static constexpr float exp_lo = -104.0f;
+        static constexpr float expm1_lo = -87.0f;
+        static constexpr float log2e = 1.44269502f;
+        // ln 2 = ln2_hi + ln2_lo; k * ln2_hi is exact for every exponent k.
+        static constexpr float ln2_hi = 0.693145752f;
+        static constexpr float ln2_lo = 1.42860677e-06f;
+        // (e^r - 1 - r) / r^2 on |r| <= ln2 / 2.
+        static constexpr float exp_poly[] = {0.5f, 0.166665778f, 0.0416665561f, 0.00836317334f, 0.00139261759f};
+
+        static constexpr float min_normal = std::numeric_limits<float>::min();
+        static constexpr float subnormal_scale = 33554432.0f; // 2^25
+        static constexpr float subnormal_shift = 25.0f;
+        // Mantissas are reduced to [sqrt(1/2), sqrt(2)).
+        static constexpr bits_type sqrt_half_bits = 0x3f3504f3u;
+        static constexpr bits_type one_bits = 0x3f800000u;
+        static constexpr bits_type mantissa_mask = 0x007fffffu;
+        // R(z) / z with log(1 + f) = f - f^2 / 2 + s (f^2 / 2 + R(z)), s = f / (2 + f), z = s^2.
+        static constexpr float log_poly[] = {0.666666865f, 0.3998878f, 0.295799494f};
+
+        static constexpr float two_over_pi = 0.636619747f;
+        // pi / 2 in parts whose products with the quadrant n are exact while |x| <= trig_limit,
+        // all but the last part.
+        static constexpr float pio2_parts[] = {1.5703125f, 0.000483751297f, 7.54953362e-08f, 2.56334407e-12f};
+        static constexpr float trig_limit = 8192.0f;
+        // (sin r - r) / r^3 and (cos r - 1 + r^2 / 2) / r^4 as polynomials in r^2 on |r| <= pi / 4.
+        static constexpr float sin_poly[] = {-0.166666642f, 0.00833274797f, -0.000195878907f};
+        static constexpr float cos_poly[] = {0.0416666642f, -0.00138883025f, 2.45479423e-05f};
+
+        // erf(x) / x as a polynomial in t = u * scale + offset, u = x^2, for |x| < erf_small.
+        static constexpr float erf_small = 1.5f;
+        static constexpr float erf_small_scale = 0.888888889f;
+        static constexpr float erf_small_offset = -1.0f;
+        static constexpr float erf_small_poly[] = {0.816836178f, -0.225252539f, 0.0659087896f, -0.016287595f, 0.00338507234f,
+                                                   -0.000601298001f, 9.29996313e-05f, -1.30993858e-05f, 1.5922933e-06f};
+        // erfc(x) e^(x^2) as a polynomial in t = |x| * scale + offset up to erf_cut; erf is 1 beyond.
+        static constexpr float erf_cut = 4.0f;
+        static constexpr float erf_big_scale = 0.8f;
+        static constexpr float erf_big_offset = -2.2f;
+        static constexpr float erf_big_poly[] = {0.193662092f, -0.0790463164f, 0.0308725797f, -0.0116001442f, 0.00420113234f,
+                                                 -0.00143747195f, 0.000490041799f, -0.000208954996f, 6.65598636e-05f};
+    };
+
+    template<>
+    struct math_constants<double>
+    {
+        using bits_type = uint64_t;
+        static constexpr int mantissa_bits = 52;
+        static constexpr int exponent_bias = 1023;
+        static constexpr double int_magic = 6755399441055744.0;
+        static constexpr double two_pow_mantissa = 4503599627370496.0;
+        static constexpr bits_type sign_mask = 0x8000000000000000ull;
+
+        static constexpr double exp_hi = 709.782712893384;
+        static constexpr double exp_lo = -746.0;
+        static constexpr double expm1_lo = -708.0;
+        static constexpr double log2e = 1.4426950408889634;
+        static constexpr double ln2_hi = 0.6931471803691238;
+        static constexpr double ln2_lo = 1.9082149292705877e-10;
+        static constexpr double exp_poly[] = {0.5, 0.1666666666666667, 0.04166666666666667, 0.008333333333326141,
+                                              0.0013888888888883752, 0.00019841269874800493, 2.4801587325533363e-05,
+                                              2.7557255425746435e-06, 2.7557273661348637e-07, 2.510520637395701e-08,
+                                              2.0914679376583935e-09};
+
+        static constexpr double min_normal = std::numeric_limits<double>::min();
+        static constexpr double subnormal_scale = 18014398509481984.0; // 2^54
+        static constexpr double subnormal_shift = 54.0;
+        static constexpr bits_type sqrt_half_bits = 0x3fe6a09e667f3bcdull;
+        static constexpr bits_type one_bits = 0x3ff0000000000000ull;
+        static constexpr bits_type mantissa_mask = 0x000fffffffffffffull;
+        static constexpr double log_poly[] = {0.666666666666667, 0.39999999999899505, 0.28571428625975487, 0.2222221113479508,
+                                              0.18182889125261723, 0.15331721600556042, 0.14616449685043406};
+
+        static constexpr double two_over_pi = 0.6366197723675814;
+        static constexpr double pio2_parts[] = {1.5707963267341256, 6.077100506303966e-11, 2.0222662487959506e-21};
+        static constexpr double trig_limit = 1048576.0;
+        static constexpr double sin_poly[] = {-0.16666666666666666, 0.008333333333330948, -0.00019841269836758574,
+                                              2.755731610255244e-06, -2.5051131845003624e-08, 1.5918129294866608e-10};
+        static constexpr double cos_poly[] = {0.041666666666666664, -0.0013888888888887398, 2.480158729876569e-05,
+                                              -2.7557317271729793e-07, 2.08761462684032e-09, -1.1382632425521717e-11};
+
+        static constexpr double erf_small = 2.0;
+        static constexpr double erf_small_scale = 0.5;
+        static constexpr double erf_small_offset = -1.0;
+        static constexpr double erf_small_poly[] = {
+            0.674933236039655, -0.2611118609312449, 0.11947913860985182, -0.04866277744917855, 0.017128344571819113,
+            -0.005234875835829469, 0.0014050914236176134, -0.0003351435355952211, 7.180100865470197e-05,
+            -1.3946266839339954e-05, 2.4758013291882113e-06, -4.045225228502215e-07, 6.119703939808185e-08,
+            -8.603632056264318e-09, 1.1333579234901372e-09, -1.4817570672621855e-10, 1.7169664781829218e-11};
+        static constexpr double erf_cut = 6.0;
+        static constexpr double erf_big_scale = 0.5;
+        static constexpr double erf_big_offset = -2.0;
+        static constexpr double erf_big_poly[] = {
+            0.13699945762506138, -0.06476701219002746, 0.029861732979897134, -0.013449456615099843, 0.005925639504306034,
+            -0.002557084145437522, 0.0010819615443804634, -0.000449327170817165, 0.00018330777006575385,
+            -7.352008568773549e-05, 2.9011515082962187e-05, -1.1275073990509855e-05, 4.314825741710838e-06,
+            -1.618701135767133e-06, 6.024756248132528e-07, -2.3270040011180073e-07, 8.400637713845437e-08,
+            -2.0848628708497824e-08, 7.51985535709463e-09, -6.7237580409382605e-09, 2.289129018275158e-09};
+    };
+
+    /**
+     * Vectorized exp, log, log2, sin, cos, tanh, erf and sigmoid for float and double registers,
+     * built from range reduction and polynomials only, so they need no SVML. Maximum errors
+     * measured against long double libm over the whole range of each function, with and without
+     * FMA (see the "SIMD: transcendental functions" test), are the same for float and double:
+     *
+     * | function | max error |
+     * |----------|-----------|
+     * | exp      | 1.5 ulp   |
+     * | log      | 1 ulp     |
+     * | log2     | 2 ulp     |
+     * | sin, cos | 2.5 ulp   |
+     * | tanh     | 3 ulp     |
+     * | erf      | 3 ulp     |
+     * | sigmoid  | 2.5 ulp   |
+     *
+     * sin and cos subtract multiples of pi / 2 split in four (float) or three (double) parts, which
+     * is accurate up to |x| = 8192 for float and 2^20 for double; lanes beyond that, and infinities, go through std::sin / std::cos.
+     * exp results below the smallest normal number are subnormal, not flushed. NaN inputs give NaN.
+     */
+    template<typename T, SIMDType ST>
+    struct vmath
+    {
+        static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "vmath supports float and double lanes");
+
+        using o = math_ops<T, ST>;
+        using c = math_constants<T>;
+        using V = typename o::V;
+        using I = typename o::I;
+        using M = typename o::M;
+
+        static constexpr size_t lanes = byteness(ST) / sizeof(T);
+
+        static V exp(V x)
+        {
+            // max/min return their second operand for NaN, so NaN survives the clamp.
+            const V xc = o::min(o::set1(c::exp_hi), o::max(o::set1(c::exp_lo), x));
+            V n;
+            const V em1 = expm1_reduced(xc, n);
+
+            // 2^n in two halves keeps both factors normal over the whole range, subnormal results included.
+            const V n1 = o::floor(o::mul(n, o::set1(T(0.5))));
+            const V n2 = o::sub(n, n1);
+            V result = o::mul(o::mul(o::add(em1, o::set1(T(1))), pow2(n1)), pow2(n2));
+
+            result = o::select(o::gt(x, o::set1(c::exp_hi)), o::set1(std::numeric_limits<T>::infinity()), result);
+            return o::select(o::lt(x, o::set1(c::exp_lo)), o::set1(T(0)), result);
+        }
+
+        static V log(V x)
+        {
+            V k, f, s, hfsq, r;
+            reduce_log(x, k, f, s, hfsq, r);
+            // k ln2_hi + (f - hfsq + s (hfsq + R) + k ln2_lo), summed from the small terms up.
+            const V tail = o::sub(hfsq, o::madd(s, o::add(hfsq, r), o::mul(k, o::set1(c::ln2_lo))));
+            return log_special(x, o::madd(k, o::set1(c::ln2_hi), o::sub(f, tail)));
+        }
+
+        static V log2(V x)
+        {
+            V k, f, s, hfsq, r;
+            reduce_log(x, k, f, s, hfsq, r);
+            const V ln_m = o::sub(f, o::sub(hfsq, o::mul(s, o::add(hfsq, r))));
+            return log_special(x, o::madd(ln_m, o::set1(c::log2e), k));
+        }
+
+        static V sin(V x) { return sin_cos<false>(x); }
+        static V cos(V x) { return sin_cos<true>(x); }
+
+        static V tanh(V x)
+        {
+            // tanh|x| = -expm1(-2|x|) / (2 + expm1(-2|x|)), which keeps full precision near zero.
+            const V ax = abs(x);
+            const V y = o::max(o::set1(c::expm1_lo), o::mul(ax, o::set1(T(-2))));
+            V n;
+            const V em1_r = expm1_reduced(y, n);
+            const V scale = pow2(n);
+            const V em1 = o::madd(scale, em1_r, o::sub(scale, o::set1(T(1))));
+            const V t = o::div(o::sub(o::set1(T(0)), em1), o::add(o::set1(T(2)), em1));
+            return o::select(o::isnan(x), x, copysign(t, x));
+        }
+
+        static V erf(V x)
+        {
+            const V ax = abs(x);
+            const V u = o::mul(ax, ax);
+            const M small = o::lt(ax, o::set1(c::erf_small));
+
+            V small_result = o::set1(T(0));
+            if (o::any(small))
+            {
+                const V t = o::madd(u, o::set1(c::erf_small_scale), o::set1(c::erf_small_offset));
+                small_result = o::mul(ax, poly(t, c::erf_small_poly));
+            }
+
+            V big_result = o::select(o::isnan(x), x, o::set1(T(1)));
+            const M below_cut = o::lt(ax, o::set1(c::erf_cut));
+            if (o::any(o::nlt(ax, o::set1(c::erf_small))) && o::any(below_cut))
+            {
+                // erf = 1 - e^(-x^2) * (erfc(x) e^(x^2)); the product is below 2^-mantissa past erf_cut.
+                const V t = o::madd(ax, o::set1(c::erf_big_scale), o::set1(c::erf_big_offset));
+                // Lanes past erf_cut keep 1; capping u keeps them out of slow subnormals.
+                const V capped = o::min(o::set1(c::erf_cut * c::erf_cut), u);
+                const V tail = o::mul(exp(o::sub(o::set1(T(0)), capped)), poly(t, c::erf_big_poly));
+                big_result = o::select(below_cut, o::sub(o::set1(T(1)), tail), big_result);
+            }
+            return copysign(o::select(small, small_result, big_result), x);
+        }
+
+        static V sigmoid(V x)
+        {
+            // e = e^-|x| never overflows: 1 / (1 + e) for x >= 0, e / (1 + e) below.
+            const V e = exp(o::sub(o::set1(T(0)), abs(x)));
+            const V one = o::set1(T(1));
+            return o::div(o::select(o::lt(x, o::set1(T(0))), e, one), o::add(one, e));
+        }
+
+    private:
+        template<size_t N>
+        static V poly(V x, const T (&coefficients)[N])
+        {
+            V result = o::set1(coefficients[N - 1]);
+            for (size_t k = N - 1; k-- > 0;)
+                result = o::madd(result, x, o::set1(coefficients[k]));
+            return result;
+        }
+
+        static V abs(V x) { return o::from_bits(o::and_bits(o::to_bits(x), o::set1_bits(~c::sign_mask))); }
+
+        // |magnitude| with the sign of `sign`.
+        static V copysign(V magnitude, V sign)
+        {
+            const I sign_bits = o::set1_bits(c::sign_mask);
+            return o::from_bits(o::xor_bits(o::to_bits(magnitude), o::and_bits(o::to_bits(sign), sign_bits)));
+        }
+
+        // 2^k for integral k in the normal exponent range.
+        static V pow2(V k)
+        {
+            const I biased = o::to_bits(o::add(k, o::set1(c::int_magic + T(c::exponent_bias))));
+            return o::from_bits(o::template shl<c::mantissa_bits>(biased));
+        }
+
+        // Splits x = n ln2 + r with |r| <= ln2 / 2 and returns e^r - 1.
+        static V expm1_reduced(V x, V &n)
+        {
+            n = o::round(o::mul(x, o::set1(c::log2e)));
+            V r = o::madd(n, o::set1(-c::ln2_hi), x);
+            r = o::madd(n, o::set1(-c::ln2_lo), r);
+            return o::madd(o::mul(r, r), poly(r, c::exp_poly), r);
+        }
+
+        // x = 2^k (1 + f) with 1 + f in [sqrt(1/2), sqrt(2)); s = f / (2 + f), hfsq = f^2 / 2, r = R(s^2).
+        static void reduce_log(V x, V &k, V &f, V &s, V &hfsq, V &r)
+        {
+            const M subnormal = o::lt(x, o::set1(c::min_normal));
+            const V xs = o::select(subnormal, o::mul(x, o::set1(c::subnormal_scale)), x);
+            const V shift = o::select(subnormal, o::set1(c::subnormal_shift), o::set1(T(0)));
+
+            const I ix = o::add_bits(o::to_bits(xs), o::set1_bits(c::one_bits - c::sqrt_half_bits));
+            // The biased exponent, converted exactly by placing it in the mantissa of 2^mantissa_bits.
+            const V exponent = o::sub(o::from_bits(o::or_bits(o::template shr<c::mantissa_bits>(ix),
+                                                             o::set1_bits(std::bit_cast<typename c::bits_type>(c::two_pow_mantissa)))),
+                                      o::set1(c::two_pow_mantissa + T(c::exponent_bias)));
+            k = o::sub(exponent, shift);
+
+            const V m = o::from_bits(o::add_bits(o::and_bits(ix, o::set1_bits(c::mantissa_mask)), o::set1_bits(c::sqrt_half_bits)));
+            f = o::sub(m, o::set1(T(1)));
+            s = o::div(f, o::add(o::set1(T(2)), f));
+            const V z = o::mul(s, s);
+            hfsq = o::mul(o::set1(T(0.5)), o::mul(f, f));
+            r = o::mul(z, poly(z, c::log_poly));
+        }
+
+        static V log_special(V x, V result)
+        {
+            result = o::select(o::eq(x, o::set1(T(0))), o::set1(-std::numeric_limits<T>::infinity()), result);
+            result = o::select(o::eq(x, o::set1(std::numeric_limits<T>::infinity())), x, result);
+            result = o::select(o::lt(x, o::set1(T(0))), o::set1(std::numeric_limits<T>::quiet_NaN()), result);
+            return o::select(o::isnan(x), x, result);
+        }
+
+        template<bool Cos>
+        static V sin_cos(V x)
+        {
+            const V n = o::round(o::mul(x, o::set1(c::two_over_pi)));
+            V r = x;
+            for (const T part : c::pio2_parts)
+                r = o::madd(n, o::set1(-part), r);
+
+            // cos(x) = sin(x + pi / 2): one quadrant further. Bit 0 of the quadrant picks the
+            // cosine polynomial, bit 1 flips the sign.
+            const V quadrant = Cos ? o::add(n, o::set1(T(1))) : n;
+            const I q = o::to_bits(o::add(quadrant, o::set1(c::int_magic)));
+
+            const V z = o::mul(r, r);
+            const V sin_r = o::madd(o::mul(r, z), poly(z, c::sin_poly), r);
+            const V cos_r = o::madd(o::mul(z, z), poly(z, c::cos_poly), o::madd(z, o::set1(T(-0.5)), o::set1(T(1))));
+
+            V result = o::select(o::low_bit(q), cos_r, sin_r);
+            constexpr int sign_shift = static_cast<int>(sizeof(T) * 8) - 2;
+            result = o::from_bits(o::xor_bits(o::to_bits(result),
+                                              o::and_bits(o::template shl<sign_shift>(q), o::set1_bits(c::sign_mask))));
+
+            if constexpr (!Cos)
+                result = o::select(o::eq(x, o::set1(T(0))), x, result); // sin(-0) = -0
+
+            const M out_of_range = o::nle(abs(x), o::set1(c::trig_limit));
+            if (o::any(out_of_range))
+            {
+                T in[lanes], out[lanes];
+                o::storeu(in, x);
+                o::storeu(out, result);
+                for (size_t k = 0; k < lanes; ++k)
+                    if (!(std::abs(in[k]) <= c::trig_limit))
+                        out[k] = Cos ? std::cos(in[k]) : std::sin(in[k]);
+                result = o::loadu(out);
+            }
+            return result;
+        }
+    };
+} // namespace pot::simd::details
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <immintrin.h>
+#include <array>
+#include <bit>
 #include <cinttypes>
+#include <cstring>
 #include <utility>
 
+#include "pot/simd/simd_type.h"
 #include "pot/traits/compare.h"
 
 namespace pot::simd
@@ -12,13 +16,6 @@ namespace pot::simd
     concept simdable = (pot::traits::compare::is_one_of_type<scalar_type,
         int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, float, double>);
 
-    enum class SIMDType
-    {
-        SSE    = 128,
-        AVX    = 256,
-        AVX512 = 512,
-    };
-
     template<simdable scalar_type, SIMDType simd_type>
     class simd_forced;
     template<simdable scalar_type, size_t scalar_count>
@@ -35,12 +32,96 @@ namespace pot::simd
 
     namespace details
     {
-        constexpr auto bitness(SIMDType simd_type) { return std::to_underlying(simd_type); }
-        constexpr auto byteness(SIMDType simd_type) { return bitness(simd_type) / 8; }
-
         template<simdable scalar_type, SIMDType simd_type>
         struct simd_traits;
 
+        // Portable exp/log/sin/... for float and double lanes, defined in pot/simd/simd_math.h.
+        template<typename scalar_type, SIMDType simd_type>
+        struct vmath;
+
+        // Horizontal fold for lane types without a shuffle sequence (8/16-bit lanes, some 64-bit ones):
+        // spills the register and folds the lanes in order.
+        template<typename scalar_type, typename vector_type, typename Op>
+        scalar_type fold_spilled(const vector_type& a, Op op)
+        {
+            scalar_type lane[sizeof(vector_type) / sizeof(scalar_type)];
+            std::memcpy(lane, &a, sizeof(a));
+            scalar_type result = lane[0];
+            for (size_t k = 1; k < sizeof(vector_type) / sizeof(scalar_type); ++k)
+                result = static_cast<scalar_type>(op(result, lane[k]));
+            return result;
+        }
+
+        // Compress for lane types without a shuffle table: the lanes whose bit is set in `bits` move to
+        // the front in order, the rest are zero.
+        template<typename scalar_type, typename vector_type>
+        vector_type compress_spilled(const vector_type& a, uint64_t bits)
+        {
+            constexpr size_t lanes = sizeof(vector_type) / sizeof(scalar_type);
+            scalar_type in[lanes];
+            scalar_type out[lanes] = {};
+            std::memcpy(in, &a, sizeof(a));
+            size_t count = 0;
+            for (size_t k = 0; k < lanes; ++k)
+                if ((bits >> k) & 1)
+                    out[count++] = in[k];
+            vector_type result;
+            std::memcpy(&result, out, sizeof(result));
+            return result;
+        }
+
+        // Every 64-bit lane is a pair of 32-bit lanes: bit k of `bits` becomes bits 2k and 2k + 1.
+        constexpr uint64_t spread_lane_bits(uint64_t bits, size_t lanes)
+        {
+            uint64_t result = 0;
+            for (size_t k = 0; k < lanes; ++k)
+                if ((bits >> k) & 1)
+                    result |= uint64_t(3) << (2 * k);
+            return result;
+        }
+
+        // Entry m is the pshufb control that packs the 32-bit lanes selected by m to the front of an
+        // SSE register; 0x80 zeroes the rest.
+        inline constexpr auto compress_bytes_4x32 = []
+        {
+            std::array<std::array<uint8_t, 16>, 16> table{};
+            for (size_t m = 0; m < 16; ++m)
+            {
+                size_t out = 0;
+                for (size_t k = 0; k < 4; ++k)
+                    if ((m >> k) & 1)
+                    {
+                        for (size_t b = 0; b < 4; ++b)
+                            table[m][out * 4 + b] = static_cast<uint8_t>(k * 4 + b);
+                        ++out;
+                    }
+                for (size_t b = out * 4; b < 16; ++b)
+                    table[m][b] = 0x80;
+            }
+            return table;
+        }();
+
+        // Entry m lists the 32-bit lanes selected by m, for vpermd on an AVX register; the lanes past
+        // popcount(m) repeat lane 0.
+        inline constexpr auto compress_lanes_8x32 = []
+        {
+            std::array<std::array<uint8_t, 8>, 256> table{};
+            for (size_t m = 0; m < 256; ++m)
+            {
+                size_t out = 0;
+                for (size_t k = 0; k < 8; ++k)
+                    if ((m >> k) & 1)
+                        table[m][out++] = static_cast<uint8_t>(k);
+            }
+            return table;
+        }();
+
+        // 32 bytes of ones then 32 of zeros: an unaligned load at 32 - count * sizeof(lane) gives a
+        // vector whose first `count` lanes are all ones, which is how SSE and AVX express lane masks.
+        alignas(64) inline constexpr int8_t partial_mask_bytes[64] = {
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+
         template<simdable scalar_type>
         struct simd_traits<scalar_type, SIMDType::SSE>
         {
@@ -66,7 +147,13 @@ namespace pot::simd
             {
                 if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_set1_ps(value);
                 if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_set1_pd(value);
-                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_set1_epi32(static_cast<int>(value));
+                if constexpr (std::is_same_v<vector_type, __m128i>)
+                {
+                    if constexpr (sizeof(scalar_type) == 8) return _mm_set1_epi64x(static_cast<long long>(value));
+                    else if constexpr (sizeof(scalar_type) == 2) return _mm_set1_epi16(static_cast<short>(value));
+                    else if constexpr (sizeof(scalar_type) == 1) return _mm_set1_epi8(static_cast<char>(value));
+                    else return _mm_set1_epi32(static_cast<int>(value));
+                }
             }
 
             static auto store(scalar_type* ptr, vector_type value)
@@ -96,6 +183,100 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
             }
 
+            // Loads lane k from base[idx[k]]. Hardware gathers take signed 32-bit indices, so every
+            // index must be below 2^31; lane types without a gather instruction are loaded one by one.
+            static auto gather(const scalar_type* base, const uint32_t* idx)
+            {
+#if defined(__AVX2__)
+                if constexpr (std::is_same_v<vector_type, __m128 >)
+                    return _mm_i32gather_ps(base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)), 4);
+                else if constexpr (std::is_same_v<vector_type, __m128d>)
+                    return _mm_i32gather_pd(base, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(idx)), 8);
+                else if constexpr (sizeof(scalar_type) == 4)
+                    return _mm_i32gather_epi32(reinterpret_cast<const int*>(base), _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)), 4);
+                else
+#endif
+                {
+                    scalar_type lanes[scalar_count];
+                    for (size_t k = 0; k < scalar_count; ++k)
+                        lanes[k] = base[idx[k]];
+                    return loadu(lanes);
+                }
+            }
+
+            // Lanes [0, count) all ones, the rest zero.
+            static __m128i lane_mask(size_t count)
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(partial_mask_bytes + 32 - count * sizeof(scalar_type)));
+            }
+
+            // Loads the first `count` lanes (count <= scalar_count) and zeroes the rest. Nothing past
+            // ptr + count is read, so the call is safe at the end of an array.
+            static auto load_partial(const scalar_type* ptr, size_t count)
+            {
+#if defined(__AVX2__)
+                if constexpr (std::is_same_v<vector_type, __m128 >)
+                    return _mm_maskload_ps(ptr, lane_mask(count));
+                else if constexpr (std::is_same_v<vector_type, __m128d>)
+                    return _mm_maskload_pd(ptr, lane_mask(count));
+                else if constexpr (sizeof(scalar_type) == 4)
+                    return _mm_maskload_epi32(reinterpret_cast<const int*>(ptr), lane_mask(count));
+                else if constexpr (sizeof(scalar_type) == 8)
+                    return _mm_maskload_epi64(reinterpret_cast<const long long*>(ptr), lane_mask(count));
+                else
+#endif
+                {
+                    scalar_type lanes[scalar_count] = {};
+                    for (size_t k = 0; k < count; ++k)
+                        lanes[k] = ptr[k];
+                    return loadu(lanes);
+                }
+            }
+
+            // Writes the first `count` lanes of `value`; memory past ptr + count is left untouched.
+            static void store_partial(scalar_type* ptr, vector_type value, size_t count)
+            {
+#if defined(__AVX2__)
+                if constexpr (std::is_same_v<vector_type, __m128 >)
+                    _mm_maskstore_ps(ptr, lane_mask(count), value);
+                else if constexpr (std::is_same_v<vector_type, __m128d>)
+                    _mm_maskstore_pd(ptr, lane_mask(count), value);
+                else if constexpr (sizeof(scalar_type) == 4)
+                    _mm_maskstore_epi32(reinterpret_cast<int*>(ptr), lane_mask(count), value);
+                else if constexpr (sizeof(scalar_type) == 8)
+                    _mm_maskstore_epi64(reinterpret_cast<long long*>(ptr), lane_mask(count), value);
+                else
+#endif
+                {
+                    scalar_type lanes[scalar_count];
+                    storeu(lanes, value);
+                    for (size_t k = 0; k < count; ++k)
+                        ptr[k] = lanes[k];
+                }
+            }
+
+            // Lanes [0, count) from `a`, the rest from `b`.
+            static auto blend_first(const vector_type& a, const vector_type& b, size_t count)
+            {
+                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_blendv_ps(b, a, _mm_castsi128_ps(lane_mask(count)));
+                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_blendv_pd(b, a, _mm_castsi128_pd(lane_mask(count)));
+                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_blendv_epi8(b, a, lane_mask(count));
+            }
+
+            // Moves every lane K positions up (towards the higher index); the K lowest lanes are taken
+            // from the top of `fill`, which is expected to hold the same value in every lane.
+            template<size_t K>
+            static auto shift_lanes_up(const vector_type& a, const vector_type& fill)
+            {
+                static_assert(0 < K && K < scalar_count, "shift out of range");
+                constexpr int bytes = static_cast<int>(16 - K * sizeof(scalar_type));
+                if constexpr (std::is_same_v<vector_type, __m128 >)
+                    return _mm_castsi128_ps(_mm_alignr_epi8(_mm_castps_si128(a), _mm_castps_si128(fill), bytes));
+                if constexpr (std::is_same_v<vector_type, __m128d>)
+                    return _mm_castsi128_pd(_mm_alignr_epi8(_mm_castpd_si128(a), _mm_castpd_si128(fill), bytes));
+                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_alignr_epi8(a, fill, bytes);
+            }
+
             static auto max(const vector_type& a, const vector_type& b)
             {
                 if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_max_ps(a, b);
@@ -104,34 +285,34 @@ namespace pot::simd
             }
 
             // need tests
-            static scalar_type max_scalar(const vector_type& a)
+            // Lane 0 of the result is `op` over all lanes, in log2(lanes) shuffle steps; float and double
+            // lanes and 32/64-bit integer lanes only.
+            template<typename Op>
+            static scalar_type fold_lanes(const vector_type& a, Op op)
             {
                 if constexpr (std::is_same_v<vector_type, __m128 >)
                 {
-                    __m128 max1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
-                    __m128 max2 = _mm_max_ps(a, max1);
-
-                    __m128 max3 = _mm_shuffle_ps(max2, max2, _MM_SHUFFLE(1, 0, 3, 2));
-                    __m128 max4 = _mm_max_ps(max2, max3);
-
-                    return _mm_cvtss_f32(max4);
+                    const __m128 t = op(a, _mm_movehl_ps(a, a));
+                    return _mm_cvtss_f32(op(t, _mm_movehdup_ps(t)));
                 }
-                if constexpr (std::is_same_v<vector_type, __m128d>)
+                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_cvtsd_f64(op(a, _mm_unpackhi_pd(a, a)));
+                if constexpr (std::is_same_v<vector_type, __m128i>)
                 {
-                    __m128d max1 = _mm_shuffle_pd(a, a, _MM_SHUFFLE2(0, 1));
-                    __m128d max2 = _mm_max_pd(a, max1);
-
-                    return _mm_cvtsd_f64(max2);
+                    const __m128i t = op(a, _mm_unpackhi_epi64(a, a));
+                    if constexpr (sizeof(scalar_type) == 8) return static_cast<scalar_type>(_mm_cvtsi128_si64(t));
+                    else return static_cast<scalar_type>(_mm_cvtsi128_si32(op(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(1, 1, 1, 1)))));
                 }
+            }
+
+            static scalar_type max_scalar(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m128 >) return fold_lanes(a, [](__m128 x, __m128 y) { return _mm_max_ps(x, y); });
+                if constexpr (std::is_same_v<vector_type, __m128d>) return fold_lanes(a, [](__m128d x, __m128d y) { return _mm_max_pd(x, y); });
                 if constexpr (std::is_same_v<vector_type, __m128i>)
                 {
-                    __m128i max1 = _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1));
-                    __m128i max2 = _mm_max_epi32(a, max1);
-
-                    __m128i max3 = _mm_shuffle_epi32(max2, _MM_SHUFFLE(1, 0, 3, 2));
-                    __m128i max4 = _mm_max_epi32(max2, max3);
-
-                    return static_cast<scalar_type>(_mm_cvtsi128_si32(max4));
+                    if constexpr (sizeof(scalar_type) == 4 && std::is_signed_v<scalar_type>) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_max_epi32(x, y); });
+                    else if constexpr (sizeof(scalar_type) == 4) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_max_epu32(x, y); });
+                    else return fold_spilled<scalar_type>(a, [](scalar_type x, scalar_type y) { return x < y ? y : x; });
                 }
             }
 
@@ -142,35 +323,15 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_min_epi32(a, b);
             }
 
-            // need tests
-            static scalar_type min(const vector_type& a)
+            static scalar_type min_scalar(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >)
-                {
-                    __m128 min1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
-                    __m128 min2 = _mm_min_ps(a, min1);
-
-                    __m128 min3 = _mm_shuffle_ps(min2, min2, _MM_SHUFFLE(1, 0, 3, 2));
-                    __m128 min4 = _mm_min_ps(min2, min3);
-
-                    return _mm_cvtss_f32(min4);
-                }
-                if constexpr (std::is_same_v<vector_type, __m128d>)
-                {
-                    __m128d min1 = _mm_shuffle_pd(a, a, _MM_SHUFFLE2(0, 1));
-                    __m128d min2 = _mm_min_pd(a, min1);
-
-                    return _mm_cvtsd_f64(min2);
-                }
+                if constexpr (std::is_same_v<vector_type, __m128 >) return fold_lanes(a, [](__m128 x, __m128 y) { return _mm_min_ps(x, y); });
+                if constexpr (std::is_same_v<vector_type, __m128d>) return fold_lanes(a, [](__m128d x, __m128d y) { return _mm_min_pd(x, y); });
                 if constexpr (std::is_same_v<vector_type, __m128i>)
                 {
-                    __m128i min1 = _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1));
-                    __m128i min2 = _mm_min_epi32(a, min1);
-
-                    __m128i min3 = _mm_shuffle_epi32(min2, _MM_SHUFFLE(1, 0, 3, 2));
-                    __m128i min4 = _mm_min_epi32(min2, min3);
-
-                    return static_cast<scalar_type>(_mm_cvtsi128_si32(min4));
+                    if constexpr (sizeof(scalar_type) == 4 && std::is_signed_v<scalar_type>) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_min_epi32(x, y); });
+                    else if constexpr (sizeof(scalar_type) == 4) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_min_epu32(x, y); });
+                    else return fold_spilled<scalar_type>(a, [](scalar_type x, scalar_type y) { return y < x ? y : x; });
                 }
             }
 
@@ -195,11 +356,16 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_mul_epi32(a, a);
             }
 
-            static auto sum(const vector_type& a)
+            static scalar_type sum(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_hadd_ps(a, a);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_hadd_pd(a, a);
-                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_hadd_epi32(a, a);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return fold_lanes(a, [](__m128 x, __m128 y) { return _mm_add_ps(x, y); });
+                if constexpr (std::is_same_v<vector_type, __m128d>) return fold_lanes(a, [](__m128d x, __m128d y) { return _mm_add_pd(x, y); });
+                if constexpr (std::is_same_v<vector_type, __m128i>)
+                {
+                    if constexpr (sizeof(scalar_type) == 8) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_add_epi64(x, y); });
+                    else if constexpr (sizeof(scalar_type) == 4) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_add_epi32(x, y); });
+                    else return fold_spilled<scalar_type>(a, [](scalar_type x, scalar_type y) { return x + y; });
+                }
             }
 
             static auto prod(const vector_type& a)
@@ -211,22 +377,22 @@ namespace pot::simd
 
             static auto exp(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_exp_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_exp_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return vmath<scalar_type, SIMDType::SSE>::exp(a);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return vmath<scalar_type, SIMDType::SSE>::exp(a);
                 if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_exp_epi32(a);
             }
 
             static auto log(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_log_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_log_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return vmath<scalar_type, SIMDType::SSE>::log(a);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return vmath<scalar_type, SIMDType::SSE>::log(a);
                 if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_log_epi32(a);
             }
 
             static auto log2(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_log2_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_log2_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return vmath<scalar_type, SIMDType::SSE>::log2(a);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return vmath<scalar_type, SIMDType::SSE>::log2(a);
                 if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_log2_epi32(a);
             }
 
@@ -239,15 +405,15 @@ namespace pot::simd
 
             static auto sin(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_sin_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_sin_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return vmath<scalar_type, SIMDType::SSE>::sin(a);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return vmath<scalar_type, SIMDType::SSE>::sin(a);
                 if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_sin_epi32(a);
             }
 
             static auto cos(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_cos_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_cos_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return vmath<scalar_type, SIMDType::SSE>::cos(a);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return vmath<scalar_type, SIMDType::SSE>::cos(a);
                 if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_cos_epi32(a);
             }
 
@@ -295,11 +461,23 @@ namespace pot::simd
 
             static auto tanh(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_tanh_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_tanh_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return vmath<scalar_type, SIMDType::SSE>::tanh(a);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return vmath<scalar_type, SIMDType::SSE>::tanh(a);
                 if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_tanh_epi32(a);
             }
 
+            static auto erf(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m128 >) return vmath<scalar_type, SIMDType::SSE>::erf(a);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return vmath<scalar_type, SIMDType::SSE>::erf(a);
+            }
+
+            static auto sigmoid(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m128 >) return vmath<scalar_type, SIMDType::SSE>::sigmoid(a);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return vmath<scalar_type, SIMDType::SSE>::sigmoid(a);
+            }
+
             static auto asinh(const vector_type& a)
             {
                 if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_asinh_ps(a);
@@ -370,7 +548,42 @@ namespace pot::simd
             {
                 if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_mul_ps(a, b);
                 if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_mul_pd(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_mul_epi32(a, b);
+                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_mullo_epi32(a, b);
+            }
+
+            // a * b + c, a * b - c and c - a * b. Float and double lanes round once when the build has FMA
+            // (always on AVX-512); otherwise, and for integer lanes, they multiply and then add.
+            static auto fmadd(const vector_type& a, const vector_type& b, const vector_type& c)
+            {
+#if defined(__FMA__)
+                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_fmadd_ps(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_fmadd_pd(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m128i>) return add(mul(a, b), c);
+#else
+                return add(mul(a, b), c);
+#endif
+            }
+
+            static auto fmsub(const vector_type& a, const vector_type& b, const vector_type& c)
+            {
+#if defined(__FMA__)
+                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_fmsub_ps(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_fmsub_pd(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m128i>) return sub(mul(a, b), c);
+#else
+                return sub(mul(a, b), c);
+#endif
+            }
+
+            static auto fnmadd(const vector_type& a, const vector_type& b, const vector_type& c)
+            {
+#if defined(__FMA__)
+                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_fnmadd_ps(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_fnmadd_pd(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m128i>) return sub(c, mul(a, b));
+#else
+                return sub(c, mul(a, b));
+#endif
             }
 
             // operator/
@@ -450,91 +663,140 @@ namespace pot::simd
                 return a;
             }
 
-            // operator ==
-            static auto cmpeq(const vector_type& a, const vector_type& b)
+            // Lane masks (see simd_mask): every lane all ones or all zeros, held as integer bits.
+            using mask_type = __m128i;
+
+            static __m128i to_bits(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_cmpeq_ps(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_cmpeq_pd(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_cmpeq_epi32(a, b);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_castps_si128(a);
+                else if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_castpd_si128(a);
+                else return a;
             }
 
-            static bool cmpeq_bool(const vector_type& a, const vector_type& b)
+            static vector_type from_bits(const __m128i& a)
             {
-                auto temp = cmpeq(a, b);
-                return _mm_test_all_ones(_mm_castps_si128(temp));
+                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_castsi128_ps(a);
+                else if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_castsi128_pd(a);
+                else return a;
             }
 
+            static mask_type mask_set1(bool value) { return _mm_set1_epi32(value ? -1 : 0); }
+            static mask_type mask_and(const mask_type& a, const mask_type& b) { return _mm_and_si128(a, b); }
+            static mask_type mask_or (const mask_type& a, const mask_type& b) { return _mm_or_si128(a, b); }
+            static mask_type mask_xor(const mask_type& a, const mask_type& b) { return _mm_xor_si128(a, b); }
+            static mask_type mask_not(const mask_type& a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
 
-            // operator !=
-            static auto cmpneq(const vector_type& a, const vector_type& b)
+            // Bit k of the result is lane k of the mask.
+            static uint64_t movemask(const mask_type& m)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_cmpneq_ps(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_cmpneq_pd(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_cmpneq_epi32(a, b);
+                if constexpr (sizeof(scalar_type) == 8) return static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(m)));
+                else if constexpr (sizeof(scalar_type) == 4) return static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+                else if constexpr (sizeof(scalar_type) == 2) return static_cast<uint64_t>(_mm_movemask_epi8(_mm_packs_epi16(m, _mm_setzero_si128())));
+                else return static_cast<uint64_t>(_mm_movemask_epi8(m));
             }
 
-            static bool cmpneq_bool(const vector_type& a, const vector_type& b)
+            // Integer lanes compare as signed; unsigned lanes are shifted by the sign bit first.
+            static __m128i int_biased(const __m128i& a)
             {
-                auto temp = cmpneq(a, b);
-                return _mm_test_all_ones(_mm_castps_si128(temp));
+                if constexpr (std::is_signed_v<scalar_type>) return a;
+                else return _mm_xor_si128(a, set1(static_cast<scalar_type>(scalar_type(1) << (sizeof(scalar_type) * 8 - 1))));
             }
 
-
-            // operator <
-            static auto cmplt(const vector_type& a, const vector_type& b)
+            static mask_type int_eq(const __m128i& a, const __m128i& b)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_cmplt_ps(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_cmplt_pd(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_cmplt_epi32(a, b);
+                if constexpr (sizeof(scalar_type) == 8) return _mm_cmpeq_epi64(a, b);
+                else if constexpr (sizeof(scalar_type) == 4) return _mm_cmpeq_epi32(a, b);
+                else if constexpr (sizeof(scalar_type) == 2) return _mm_cmpeq_epi16(a, b);
+                else return _mm_cmpeq_epi8(a, b);
             }
-            static bool cmplt_bool(const vector_type& a, const vector_type& b)
+
+            static mask_type int_gt(const __m128i& a, const __m128i& b)
             {
-                auto temp = cmplt(a, b);
-                return _mm_test_all_ones(_mm_castps_si128(temp));
+                const __m128i x = int_biased(a), y = int_biased(b);
+                if constexpr (sizeof(scalar_type) == 8) return _mm_cmpgt_epi64(x, y);
+                else if constexpr (sizeof(scalar_type) == 4) return _mm_cmpgt_epi32(x, y);
+                else if constexpr (sizeof(scalar_type) == 2) return _mm_cmpgt_epi16(x, y);
+                else return _mm_cmpgt_epi8(x, y);
             }
 
-
-            // operator <=
-            static auto cmple(const vector_type& a, const vector_type& b)
+            // Float and double comparisons are ordered (false when either lane is NaN) except !=.
+            // operator==
+            static mask_type cmpeq(const vector_type& a, const vector_type& b)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_cmple_ps(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_cmple_pd(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_cmple_epi32(a, b);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return to_bits(_mm_cmpeq_ps(a, b));
+                else if constexpr (std::is_same_v<vector_type, __m128d>) return to_bits(_mm_cmpeq_pd(a, b));
+                else return int_eq(a, b);
             }
-            static bool cmple_bool(const vector_type& a, const vector_type& b)
+
+            // operator!=
+            static mask_type cmpneq(const vector_type& a, const vector_type& b)
             {
-                auto temp = cmple(a, b);
-                return _mm_test_all_ones(_mm_castps_si128(temp));
+                if constexpr (std::is_same_v<vector_type, __m128 >) return to_bits(_mm_cmpneq_ps(a, b));
+                else if constexpr (std::is_same_v<vector_type, __m128d>) return to_bits(_mm_cmpneq_pd(a, b));
+                else return mask_not(int_eq(a, b));
             }
 
+            // operator<
+            static mask_type cmplt(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m128 >) return to_bits(_mm_cmplt_ps(a, b));
+                else if constexpr (std::is_same_v<vector_type, __m128d>) return to_bits(_mm_cmplt_pd(a, b));
+                else return int_gt(b, a);
+            }
 
+            // operator<=
+            static mask_type cmple(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m128 >) return to_bits(_mm_cmple_ps(a, b));
+                else if constexpr (std::is_same_v<vector_type, __m128d>) return to_bits(_mm_cmple_pd(a, b));
+                else return mask_not(int_gt(a, b));
+            }
 
-            // operator >
-            static auto cmpgt(const vector_type& a, const vector_type& b)
+            // operator>
+            static mask_type cmpgt(const vector_type& a, const vector_type& b)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_cmpgt_ps(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_cmpgt_pd(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_cmpgt_epi32(a, b);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return to_bits(_mm_cmpgt_ps(a, b));
+                else if constexpr (std::is_same_v<vector_type, __m128d>) return to_bits(_mm_cmpgt_pd(a, b));
+                else return int_gt(a, b);
             }
-            static bool cmpgt_bool(const vector_type& a, const vector_type& b)
+
+            // operator>=
+            static mask_type cmpge(const vector_type& a, const vector_type& b)
             {
-                auto temp = cmpgt(a, b);
-                return _mm_test_all_ones(_mm_castps_si128(temp));
+                if constexpr (std::is_same_v<vector_type, __m128 >) return to_bits(_mm_cmpge_ps(a, b));
+                else if constexpr (std::is_same_v<vector_type, __m128d>) return to_bits(_mm_cmpge_pd(a, b));
+                else return mask_not(int_gt(b, a));
             }
 
-            // operator >=
-            static auto cmpge(const vector_type& a, const vector_type& b)
+            // Lane k from `a` where the mask has lane k set, from `b` elsewhere.
+            static vector_type select(const mask_type& m, const vector_type& a, const vector_type& b)
             {
-                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_cmpge_ps(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_cmpge_pd(a, b);
-                if constexpr (std::is_same_v<vector_type, __m128i>) return _mm_cmpge_epi32(a, b);
+                if constexpr (std::is_same_v<vector_type, __m128 >) return _mm_blendv_ps(b, a, _mm_castsi128_ps(m));
+                else if constexpr (std::is_same_v<vector_type, __m128d>) return _mm_blendv_pd(b, a, _mm_castsi128_pd(m));
+                else return _mm_blendv_epi8(b, a, m);
             }
-            static bool cmpge_bool(const vector_type& a, const vector_type& b)
+
+            // The lanes selected by `m` moved to the front in order, the rest zero. 32/64-bit lanes use a
+            // pshufb table, 8/16-bit lanes go through memory.
+            static vector_type compress(const vector_type& a, const mask_type& m)
             {
-                auto temp = cmpge(a, b);
-                return _mm_test_all_ones(_mm_castps_si128(temp));
+                if constexpr (sizeof(scalar_type) >= 4)
+                {
+                    uint64_t bits = movemask(m);
+                    if constexpr (sizeof(scalar_type) == 8) bits = spread_lane_bits(bits, scalar_count);
+                    const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(compress_bytes_4x32[bits].data()));
+                    return from_bits(_mm_shuffle_epi8(to_bits(a), control));
+                }
+                else return compress_spilled<scalar_type>(a, movemask(m));
             }
 
+            // Writes the selected lanes to ptr[0], ptr[1], ... and returns how many there were.
+            static size_t compress_store(scalar_type* ptr, const vector_type& a, const mask_type& m)
+            {
+                const size_t count = static_cast<size_t>(std::popcount(movemask(m)));
+                store_partial(ptr, compress(a, m), count);
+                return count;
+            }
 
         };
 
@@ -571,7 +833,13 @@ namespace pot::simd
             {
                 if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_set1_ps(value);
                 if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_set1_pd(value);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_set1_epi32(static_cast<int>(value));
+                if constexpr (std::is_same_v<vector_type, __m256i>)
+                {
+                    if constexpr (sizeof(scalar_type) == 8) return _mm256_set1_epi64x(static_cast<long long>(value));
+                    else if constexpr (sizeof(scalar_type) == 2) return _mm256_set1_epi16(static_cast<short>(value));
+                    else if constexpr (sizeof(scalar_type) == 1) return _mm256_set1_epi8(static_cast<char>(value));
+                    else return _mm256_set1_epi32(static_cast<int>(value));
+                }
             }
 
             static auto store(scalar_type* ptr, vector_type value)
@@ -602,30 +870,134 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
             }
 
-            static auto max(const vector_type& a, const vector_type& b)
+            static auto gather(const scalar_type* base, const uint32_t* idx)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_max_ps(a, b);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_max_pd(a, b);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_max_epi32(a, b);
+                if constexpr (std::is_same_v<vector_type, __m256 >)
+                    return _mm256_i32gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), 4);
+                else if constexpr (std::is_same_v<vector_type, __m256d>)
+                    return _mm256_i32gather_pd(base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)), 8);
+                else if constexpr (sizeof(scalar_type) == 4)
+                    return _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), 4);
+                else
+                {
+                    scalar_type lanes[scalar_count];
+                    for (size_t k = 0; k < scalar_count; ++k)
+                        lanes[k] = base[idx[k]];
+                    return loadu(lanes);
+                }
             }
 
-            // need tests
-            static scalar_type max_scalar(const vector_type& a)
+            static __m256i lane_mask(size_t count)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(partial_mask_bytes + 32 - count * sizeof(scalar_type)));
+            }
+
+            static auto load_partial(const scalar_type* ptr, size_t count)
             {
                 if constexpr (std::is_same_v<vector_type, __m256 >)
+                    return _mm256_maskload_ps(ptr, lane_mask(count));
+                else if constexpr (std::is_same_v<vector_type, __m256d>)
+                    return _mm256_maskload_pd(ptr, lane_mask(count));
+                else if constexpr (sizeof(scalar_type) == 4)
+                    return _mm256_maskload_epi32(reinterpret_cast<const int*>(ptr), lane_mask(count));
+                else if constexpr (sizeof(scalar_type) == 8)
+                    return _mm256_maskload_epi64(reinterpret_cast<const long long*>(ptr), lane_mask(count));
+                else
                 {
-                    auto temp = _mm256_max_ps(a, _mm256_permute2f128_ps(a, a, 1));
-                    return _mm_cvtss_f32(_mm_max_ps(_mm_movehl_ps(temp, temp), temp));
+                    scalar_type lanes[scalar_count] = {};
+                    for (size_t k = 0; k < count; ++k)
+                        lanes[k] = ptr[k];
+                    return loadu(lanes);
                 }
-                if constexpr (std::is_same_v<vector_type, __m256d>)
+            }
+
+            static void store_partial(scalar_type* ptr, vector_type value, size_t count)
+            {
+                if constexpr (std::is_same_v<vector_type, __m256 >)
+                    _mm256_maskstore_ps(ptr, lane_mask(count), value);
+                else if constexpr (std::is_same_v<vector_type, __m256d>)
+                    _mm256_maskstore_pd(ptr, lane_mask(count), value);
+                else if constexpr (sizeof(scalar_type) == 4)
+                    _mm256_maskstore_epi32(reinterpret_cast<int*>(ptr), lane_mask(count), value);
+                else if constexpr (sizeof(scalar_type) == 8)
+                    _mm256_maskstore_epi64(reinterpret_cast<long long*>(ptr), lane_mask(count), value);
+                else
                 {
-                    auto temp = _mm256_max_pd(a, _mm256_permute2f128_pd(a, a, 1));
-                    return _mm_cvtsd_f64(_mm_max_pd(_mm_movehl_pd(temp, temp), temp));
+                    scalar_type lanes[scalar_count];
+                    storeu(lanes, value);
+                    for (size_t k = 0; k < count; ++k)
+                        ptr[k] = lanes[k];
                 }
+            }
+
+            static auto blend_first(const vector_type& a, const vector_type& b, size_t count)
+            {
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(lane_mask(count)));
+                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_blendv_pd(b, a, _mm256_castsi256_pd(lane_mask(count)));
+                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_blendv_epi8(b, a, lane_mask(count));
+            }
+
+            template<size_t K>
+            static auto shift_lanes_up(const vector_type& a, const vector_type& fill)
+            {
+                static_assert(0 < K && K < scalar_count, "shift out of range");
+                if constexpr (std::is_same_v<vector_type, __m256 >)
+                    return _mm256_castsi256_ps(shift_bytes_up<K * sizeof(scalar_type)>(_mm256_castps_si256(a), _mm256_castps_si256(fill)));
+                if constexpr (std::is_same_v<vector_type, __m256d>)
+                    return _mm256_castsi256_pd(shift_bytes_up<K * sizeof(scalar_type)>(_mm256_castpd_si256(a), _mm256_castpd_si256(fill)));
+                if constexpr (std::is_same_v<vector_type, __m256i>) return shift_bytes_up<K * sizeof(scalar_type)>(a, fill);
+            }
+
+            // alignr only works inside 128-bit halves, so the low half of `a` is first moved into the
+            // high half (with `fill` below it) to provide the bytes that cross the middle.
+            template<size_t Bytes>
+            static __m256i shift_bytes_up(__m256i a, __m256i fill)
+            {
+                static_assert(Bytes <= 16, "shift out of range");
+                const __m256i crossed = _mm256_permute2x128_si256(a, fill, 0x02);
+                if constexpr (Bytes == 16) return crossed;
+                else return _mm256_alignr_epi8(a, crossed, 16 - Bytes);
+            }
+
+            static auto max(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_max_ps(a, b);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_max_pd(a, b);
+                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_max_epi32(a, b);
+            }
+
+            using half_traits = simd_traits<scalar_type, SIMDType::SSE>;
+
+            static auto low_half(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_castps256_ps128(a);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_castpd256_pd128(a);
+                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_castsi256_si128(a);
+            }
+
+            static auto high_half(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_extractf128_ps(a, 1);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_extractf128_pd(a, 1);
+                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_extracti128_si256(a, 1);
+            }
+
+            // Folds the two 128-bit halves with `op`, then the SSE lanes; see simd_traits<SSE>::fold_lanes.
+            template<typename Op>
+            static scalar_type fold_lanes(const vector_type& a, Op op)
+            {
+                return half_traits::fold_lanes(op(low_half(a), high_half(a)), op);
+            }
+
+            static scalar_type max_scalar(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m256 >) return fold_lanes(a, [](__m128 x, __m128 y) { return _mm_max_ps(x, y); });
+                if constexpr (std::is_same_v<vector_type, __m256d>) return fold_lanes(a, [](__m128d x, __m128d y) { return _mm_max_pd(x, y); });
                 if constexpr (std::is_same_v<vector_type, __m256i>)
                 {
-                    auto temp = _mm256_max_epi32(a, _mm256_permute2f128_si256(a, a, 1));
-                    return _mm_cvtsi128_si32(_mm_max_epi32(_mm_movehl_epi32(temp, temp), temp));
+                    if constexpr (sizeof(scalar_type) == 4 && std::is_signed_v<scalar_type>) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_max_epi32(x, y); });
+                    else if constexpr (sizeof(scalar_type) == 4) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_max_epu32(x, y); });
+                    else return fold_spilled<scalar_type>(a, [](scalar_type x, scalar_type y) { return x < y ? y : x; });
                 }
             }
 
@@ -636,23 +1008,15 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_min_epi32(a, b);
             }
 
-            // need tests
-            static scalar_type min(const vector_type& a)
+            static scalar_type min_scalar(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >)
-                {
-                    auto temp = _mm256_min_ps(a, _mm256_permute2f128_ps(a, a, 1));
-                    return _mm_cvtss_f32(_mm_min_ps(_mm_movehl_ps(temp, temp), temp));
-                }
-                if constexpr (std::is_same_v<vector_type, __m256d>)
-                {
-                    auto temp = _mm256_min_pd(a, _mm256_permute2f128_pd(a, a, 1));
-                    return _mm_cvtsd_f64(_mm_min_pd(_mm_movehl_pd(temp, temp), temp));
-                }
+                if constexpr (std::is_same_v<vector_type, __m256 >) return fold_lanes(a, [](__m128 x, __m128 y) { return _mm_min_ps(x, y); });
+                if constexpr (std::is_same_v<vector_type, __m256d>) return fold_lanes(a, [](__m128d x, __m128d y) { return _mm_min_pd(x, y); });
                 if constexpr (std::is_same_v<vector_type, __m256i>)
                 {
-                    auto temp = _mm256_min_epi32(a, _mm256_permute2f128_si256(a, a, 1));
-                    return _mm_cvtsi128_si32(_mm_min_epi32(_mm_movehl_epi32(temp, temp), temp));
+                    if constexpr (sizeof(scalar_type) == 4 && std::is_signed_v<scalar_type>) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_min_epi32(x, y); });
+                    else if constexpr (sizeof(scalar_type) == 4) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_min_epu32(x, y); });
+                    else return fold_spilled<scalar_type>(a, [](scalar_type x, scalar_type y) { return y < x ? y : x; });
                 }
             }
 
@@ -677,11 +1041,16 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_mul_epi32(a, a);
             }
 
-            static auto sum(const vector_type& a)
+            static scalar_type sum(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_hadd_ps(a, a);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_hadd_pd(a, a);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_hadd_epi32(a, a);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return fold_lanes(a, [](__m128 x, __m128 y) { return _mm_add_ps(x, y); });
+                if constexpr (std::is_same_v<vector_type, __m256d>) return fold_lanes(a, [](__m128d x, __m128d y) { return _mm_add_pd(x, y); });
+                if constexpr (std::is_same_v<vector_type, __m256i>)
+                {
+                    if constexpr (sizeof(scalar_type) == 8) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_add_epi64(x, y); });
+                    else if constexpr (sizeof(scalar_type) == 4) return fold_lanes(a, [](__m128i x, __m128i y) { return _mm_add_epi32(x, y); });
+                    else return fold_spilled<scalar_type>(a, [](scalar_type x, scalar_type y) { return x + y; });
+                }
             }
 
             static auto prod(const vector_type& a)
@@ -693,22 +1062,22 @@ namespace pot::simd
 
             static auto exp(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_exp_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_exp_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return vmath<scalar_type, SIMDType::AVX>::exp(a);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return vmath<scalar_type, SIMDType::AVX>::exp(a);
                 if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_exp_epi32(a);
             }
 
             static auto log(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_log_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_log_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return vmath<scalar_type, SIMDType::AVX>::log(a);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return vmath<scalar_type, SIMDType::AVX>::log(a);
                 if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_log_epi32(a);
             }
 
             static auto log2(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_log2_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_log2_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return vmath<scalar_type, SIMDType::AVX>::log2(a);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return vmath<scalar_type, SIMDType::AVX>::log2(a);
                 if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_log2_epi32(a);
             }
 
@@ -721,15 +1090,15 @@ namespace pot::simd
 
             static auto sin(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_sin_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_sin_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return vmath<scalar_type, SIMDType::AVX>::sin(a);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return vmath<scalar_type, SIMDType::AVX>::sin(a);
                 if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_sin_epi32(a);
             }
 
             static auto cos(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_cos_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_cos_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return vmath<scalar_type, SIMDType::AVX>::cos(a);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return vmath<scalar_type, SIMDType::AVX>::cos(a);
                 if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_cos_epi32(a);
             }
 
@@ -777,11 +1146,23 @@ namespace pot::simd
 
             static auto tanh(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_tanh_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_tanh_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return vmath<scalar_type, SIMDType::AVX>::tanh(a);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return vmath<scalar_type, SIMDType::AVX>::tanh(a);
                 if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_tanh_epi32(a);
             }
 
+            static auto erf(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m256 >) return vmath<scalar_type, SIMDType::AVX>::erf(a);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return vmath<scalar_type, SIMDType::AVX>::erf(a);
+            }
+
+            static auto sigmoid(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m256 >) return vmath<scalar_type, SIMDType::AVX>::sigmoid(a);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return vmath<scalar_type, SIMDType::AVX>::sigmoid(a);
+            }
+
             static auto asinh(const vector_type& a)
             {
                 if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_asinh_ps(a);
@@ -852,7 +1233,40 @@ namespace pot::simd
             {
                 if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_mul_ps(a, b);
                 if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_mul_pd(a, b);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_mul_epi32(a, b);
+                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_mullo_epi32(a, b);
+            }
+
+            static auto fmadd(const vector_type& a, const vector_type& b, const vector_type& c)
+            {
+#if defined(__FMA__)
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_fmadd_ps(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_fmadd_pd(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m256i>) return add(mul(a, b), c);
+#else
+                return add(mul(a, b), c);
+#endif
+            }
+
+            static auto fmsub(const vector_type& a, const vector_type& b, const vector_type& c)
+            {
+#if defined(__FMA__)
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_fmsub_ps(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_fmsub_pd(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m256i>) return sub(mul(a, b), c);
+#else
+                return sub(mul(a, b), c);
+#endif
+            }
+
+            static auto fnmadd(const vector_type& a, const vector_type& b, const vector_type& c)
+            {
+#if defined(__FMA__)
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_fnmadd_ps(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_fnmadd_pd(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m256i>) return sub(c, mul(a, b));
+#else
+                return sub(c, mul(a, b));
+#endif
             }
 
             // operator/
@@ -933,84 +1347,134 @@ namespace pot::simd
                 return a;
             }
 
-            // operator==
-            static auto cmpeq(const vector_type& a, const vector_type& b)
+            // Lane masks (see simd_mask): every lane all ones or all zeros, held as integer bits.
+            using mask_type = __m256i;
+
+            static __m256i to_bits(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_cmp_pd(a, b, _CMP_EQ_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_cmp_epi32(a, b, _CMP_EQ_OQ);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_castps_si256(a);
+                else if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_castpd_si256(a);
+                else return a;
             }
 
-            static bool cmpeq_bool(const vector_type& a, const vector_type& b)
+            static vector_type from_bits(const __m256i& a)
             {
-                auto temp = cmpeq(a, b);
-                return _mm256_test_all_ones(_mm256_castps_si256(temp));
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_castsi256_ps(a);
+                else if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_castsi256_pd(a);
+                else return a;
             }
 
-            // operator!=
-            static auto cmpneq(const vector_type& a, const vector_type& b)
+            static mask_type mask_set1(bool value) { return _mm256_set1_epi32(value ? -1 : 0); }
+            static mask_type mask_and(const mask_type& a, const mask_type& b) { return _mm256_and_si256(a, b); }
+            static mask_type mask_or (const mask_type& a, const mask_type& b) { return _mm256_or_si256(a, b); }
+            static mask_type mask_xor(const mask_type& a, const mask_type& b) { return _mm256_xor_si256(a, b); }
+            static mask_type mask_not(const mask_type& a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+
+            static uint64_t movemask(const mask_type& m)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_cmp_ps(a, b, _CMP_NEQ_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_cmp_pd(a, b, _CMP_NEQ_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_cmp_epi32(a, b, _CMP_NEQ_OQ);
+                if constexpr (sizeof(scalar_type) == 8) return static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+                else if constexpr (sizeof(scalar_type) == 4) return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+                else if constexpr (sizeof(scalar_type) == 2) return static_cast<uint64_t>(_mm_movemask_epi8(_mm_packs_epi16(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1))));
+                else return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(m)));
             }
 
-            static bool cmpneq_bool(const vector_type& a, const vector_type& b)
+            static __m256i int_biased(const __m256i& a)
             {
-                auto temp = cmpneq(a, b);
-                return _mm256_test_all_ones(_mm256_castps_si256(temp));
+                if constexpr (std::is_signed_v<scalar_type>) return a;
+                else return _mm256_xor_si256(a, set1(static_cast<scalar_type>(scalar_type(1) << (sizeof(scalar_type) * 8 - 1))));
             }
 
-            // operator<
-            static auto cmplt(const vector_type& a, const vector_type& b)
+            static mask_type int_eq(const __m256i& a, const __m256i& b)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_cmp_epi32(a, b, _CMP_LT_OQ);
+                if constexpr (sizeof(scalar_type) == 8) return _mm256_cmpeq_epi64(a, b);
+                else if constexpr (sizeof(scalar_type) == 4) return _mm256_cmpeq_epi32(a, b);
+                else if constexpr (sizeof(scalar_type) == 2) return _mm256_cmpeq_epi16(a, b);
+                else return _mm256_cmpeq_epi8(a, b);
             }
-            static bool cmplt_bool(const vector_type& a, const vector_type& b)
+
+            static mask_type int_gt(const __m256i& a, const __m256i& b)
             {
-                auto temp = cmplt(a, b);
-                return _mm256_test_all_ones(_mm256_castps_si256(temp));
+                const __m256i x = int_biased(a), y = int_biased(b);
+                if constexpr (sizeof(scalar_type) == 8) return _mm256_cmpgt_epi64(x, y);
+                else if constexpr (sizeof(scalar_type) == 4) return _mm256_cmpgt_epi32(x, y);
+                else if constexpr (sizeof(scalar_type) == 2) return _mm256_cmpgt_epi16(x, y);
+                else return _mm256_cmpgt_epi8(x, y);
             }
 
-            // operator<=
-            static auto cmple(const vector_type& a, const vector_type& b)
+            // operator==
+            static mask_type cmpeq(const vector_type& a, const vector_type& b)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_cmp_pd(a, b, _CMP_LE_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_cmp_epi32(a, b, _CMP_LE_OQ);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return to_bits(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+                else if constexpr (std::is_same_v<vector_type, __m256d>) return to_bits(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+                else return int_eq(a, b);
             }
-            static bool cmple_bool(const vector_type& a, const vector_type& b)
+
+            // operator!=
+            static mask_type cmpneq(const vector_type& a, const vector_type& b)
             {
-                auto temp = cmple(a, b);
-                return _mm256_test_all_ones(_mm256_castps_si256(temp));
+                if constexpr (std::is_same_v<vector_type, __m256 >) return to_bits(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ));
+                else if constexpr (std::is_same_v<vector_type, __m256d>) return to_bits(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ));
+                else return mask_not(int_eq(a, b));
             }
 
-            // operator>
-            static auto cmpgt(const vector_type& a, const vector_type& b)
+            // operator<
+            static mask_type cmplt(const vector_type& a, const vector_type& b)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_cmp_epi32(a, b, _CMP_GT_OQ);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return to_bits(_mm256_cmp_ps(a, b, _CMP_LT_OQ));
+                else if constexpr (std::is_same_v<vector_type, __m256d>) return to_bits(_mm256_cmp_pd(a, b, _CMP_LT_OQ));
+                else return int_gt(b, a);
             }
-            static bool cmpgt_bool(const vector_type& a, const vector_type& b)
+
+            // operator<=
+            static mask_type cmple(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m256 >) return to_bits(_mm256_cmp_ps(a, b, _CMP_LE_OQ));
+                else if constexpr (std::is_same_v<vector_type, __m256d>) return to_bits(_mm256_cmp_pd(a, b, _CMP_LE_OQ));
+                else return mask_not(int_gt(a, b));
+            }
+
+            // operator>
+            static mask_type cmpgt(const vector_type& a, const vector_type& b)
             {
-                auto temp = cmpgt(a, b);
-                return _mm256_test_all_ones(_mm256_castps_si256(temp));
+                if constexpr (std::is_same_v<vector_type, __m256 >) return to_bits(_mm256_cmp_ps(a, b, _CMP_GT_OQ));
+                else if constexpr (std::is_same_v<vector_type, __m256d>) return to_bits(_mm256_cmp_pd(a, b, _CMP_GT_OQ));
+                else return int_gt(a, b);
             }
 
             // operator>=
-            static auto cmpge(const vector_type& a, const vector_type& b)
+            static mask_type cmpge(const vector_type& a, const vector_type& b)
             {
-                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_cmp_ps(a, b, _CMP_GE_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_cmp_pd(a, b, _CMP_GE_OQ);
-                if constexpr (std::is_same_v<vector_type, __m256i>) return _mm256_cmp_epi32(a, b, _CMP_GE_OQ);
+                if constexpr (std::is_same_v<vector_type, __m256 >) return to_bits(_mm256_cmp_ps(a, b, _CMP_GE_OQ));
+                else if constexpr (std::is_same_v<vector_type, __m256d>) return to_bits(_mm256_cmp_pd(a, b, _CMP_GE_OQ));
+                else return mask_not(int_gt(b, a));
             }
-            static bool cmpge_bool(const vector_type& a, const vector_type& b)
+
+            static vector_type select(const mask_type& m, const vector_type& a, const vector_type& b)
             {
-                auto temp = cmpge(a, b);
-                return _mm256_test_all_ones(_mm256_castps_si256(temp));
+                if constexpr (std::is_same_v<vector_type, __m256 >) return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(m));
+                else if constexpr (std::is_same_v<vector_type, __m256d>) return _mm256_blendv_pd(b, a, _mm256_castsi256_pd(m));
+                else return _mm256_blendv_epi8(b, a, m);
+            }
+
+            // The lanes selected by `m` moved to the front in order; the lanes past their count are
+            // unspecified. 32/64-bit lanes use a vpermd table, 8/16-bit lanes go through memory.
+            static vector_type compress(const vector_type& a, const mask_type& m)
+            {
+                if constexpr (sizeof(scalar_type) >= 4)
+                {
+                    uint64_t bits = movemask(m);
+                    if constexpr (sizeof(scalar_type) == 8) bits = spread_lane_bits(bits, scalar_count);
+                    const __m256i control = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(compress_lanes_8x32[bits].data())));
+                    return from_bits(_mm256_permutevar8x32_epi32(to_bits(a), control));
+                }
+                else return compress_spilled<scalar_type>(a, movemask(m));
+            }
+
+            static size_t compress_store(scalar_type* ptr, const vector_type& a, const mask_type& m)
+            {
+                const size_t count = static_cast<size_t>(std::popcount(movemask(m)));
+                store_partial(ptr, compress(a, m), count);
+                return count;
             }
 
         };
@@ -1042,7 +1506,13 @@ namespace pot::simd
             {
                 if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_set1_ps(value);
                 if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_set1_pd(value);
-                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_set1_epi32(static_cast<int>(value));
+                if constexpr (std::is_same_v<vector_type, __m512i>)
+                {
+                    if constexpr (sizeof(scalar_type) == 8) return _mm512_set1_epi64(static_cast<long long>(value));
+                    else if constexpr (sizeof(scalar_type) == 2) return _mm512_set1_epi16(static_cast<short>(value));
+                    else if constexpr (sizeof(scalar_type) == 1) return _mm512_set1_epi8(static_cast<char>(value));
+                    else return _mm512_set1_epi32(static_cast<int>(value));
+                }
             }
 
             static auto store(scalar_type* ptr, vector_type value)
@@ -1073,6 +1543,145 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_loadu_si512(reinterpret_cast<const __m512i*>(ptr));
             }
 
+            static auto gather(const scalar_type* base, const uint32_t* idx)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >)
+                    return _mm512_i32gather_ps(_mm512_loadu_si512(idx), base, 4);
+                else if constexpr (std::is_same_v<vector_type, __m512d>)
+                    return _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), base, 8);
+                else if constexpr (sizeof(scalar_type) == 4)
+                    return _mm512_i32gather_epi32(_mm512_loadu_si512(idx), base, 4);
+                else
+                {
+                    scalar_type lanes[scalar_count];
+                    for (size_t k = 0; k < scalar_count; ++k)
+                        lanes[k] = base[idx[k]];
+                    return loadu(lanes);
+                }
+            }
+
+            using mask_type = std::conditional_t<scalar_count == 8, __mmask8, std::conditional_t<scalar_count == 16, __mmask16,
+                std::conditional_t<scalar_count == 32, __mmask32, __mmask64>>>;
+
+            // k-mask with bits [0, count) set.
+            static mask_type lane_mask(size_t count)
+            {
+                return static_cast<mask_type>(count >= 64 ? ~0ULL : (1ULL << count) - 1);
+            }
+
+            // Loads the first `count` lanes (count <= scalar_count) and zeroes the rest. Masked-off
+            // lanes do not fault, so the call is safe at the end of an array. 8- and 16-bit lanes need AVX512BW.
+            static auto load_partial(const scalar_type* ptr, size_t count)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_maskz_loadu_ps(lane_mask(count), ptr);
+                else if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_maskz_loadu_pd(lane_mask(count), ptr);
+                else if constexpr (sizeof(scalar_type) == 8) return _mm512_maskz_loadu_epi64(lane_mask(count), ptr);
+                else if constexpr (sizeof(scalar_type) == 4) return _mm512_maskz_loadu_epi32(lane_mask(count), ptr);
+                else if constexpr (sizeof(scalar_type) == 2) return _mm512_maskz_loadu_epi16(lane_mask(count), ptr);
+                else return _mm512_maskz_loadu_epi8(lane_mask(count), ptr);
+            }
+
+            static void store_partial(scalar_type* ptr, vector_type value, size_t count)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) _mm512_mask_storeu_ps(ptr, lane_mask(count), value);
+                else if constexpr (std::is_same_v<vector_type, __m512d>) _mm512_mask_storeu_pd(ptr, lane_mask(count), value);
+                else if constexpr (sizeof(scalar_type) == 8) _mm512_mask_storeu_epi64(ptr, lane_mask(count), value);
+                else if constexpr (sizeof(scalar_type) == 4) _mm512_mask_storeu_epi32(ptr, lane_mask(count), value);
+                else if constexpr (sizeof(scalar_type) == 2) _mm512_mask_storeu_epi16(ptr, lane_mask(count), value);
+                else _mm512_mask_storeu_epi8(ptr, lane_mask(count), value);
+            }
+
+            static auto blend_first(const vector_type& a, const vector_type& b, size_t count)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_mask_blend_ps(lane_mask(count), b, a);
+                else if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_mask_blend_pd(lane_mask(count), b, a);
+                else if constexpr (sizeof(scalar_type) == 8) return _mm512_mask_blend_epi64(lane_mask(count), b, a);
+                else if constexpr (sizeof(scalar_type) == 4) return _mm512_mask_blend_epi32(lane_mask(count), b, a);
+                else if constexpr (sizeof(scalar_type) == 2) return _mm512_mask_blend_epi16(lane_mask(count), b, a);
+                else return _mm512_mask_blend_epi8(lane_mask(count), b, a);
+            }
+
+            template<size_t K>
+            static auto shift_lanes_up(const vector_type& a, const vector_type& fill)
+            {
+                static_assert(0 < K && K < scalar_count, "shift out of range");
+                static_assert(sizeof(scalar_type) >= 4, "lane shifts need 32- or 64-bit lanes");
+                constexpr int lanes = static_cast<int>(scalar_count - K);
+                if constexpr (std::is_same_v<vector_type, __m512 >)
+                    return _mm512_castsi512_ps(_mm512_alignr_epi32(_mm512_castps_si512(a), _mm512_castps_si512(fill), lanes));
+                if constexpr (std::is_same_v<vector_type, __m512d>)
+                    return _mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(a), _mm512_castpd_si512(fill), lanes));
+                if constexpr (std::is_same_v<vector_type, __m512i>)
+                {
+                    if constexpr (sizeof(scalar_type) == 4) return _mm512_alignr_epi32(a, fill, lanes);
+                    else return _mm512_alignr_epi64(a, fill, lanes);
+                }
+            }
+
+            // operator+
+            static auto add(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_add_ps(a, b);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_add_pd(a, b);
+                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_add_epi32(a, b);
+            }
+
+            // operator-
+            static auto sub(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_sub_ps(a, b);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_sub_pd(a, b);
+                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_sub_epi32(a, b);
+            }
+
+            // operator*
+            static auto mul(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_mul_ps(a, b);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_mul_pd(a, b);
+                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_mullo_epi32(a, b);
+            }
+
+            // a * b + c, a * b - c and c - a * b; float and double lanes round once, integer lanes multiply
+            // and then add.
+            static auto fmadd(const vector_type& a, const vector_type& b, const vector_type& c)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_fmadd_ps(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_fmadd_pd(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m512i>) return add(mul(a, b), c);
+            }
+
+            static auto fmsub(const vector_type& a, const vector_type& b, const vector_type& c)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_fmsub_ps(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_fmsub_pd(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m512i>) return sub(mul(a, b), c);
+            }
+
+            static auto fnmadd(const vector_type& a, const vector_type& b, const vector_type& c)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_fnmadd_ps(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_fnmadd_pd(a, b, c);
+                if constexpr (std::is_same_v<vector_type, __m512i>) return sub(c, mul(a, b));
+            }
+
+            // operator/
+            static auto div(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_div_ps(a, b);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_div_pd(a, b);
+                if constexpr (std::is_same_v<vector_type, __m512i>)
+                {
+                    // No integer division instruction: divide each half in double, which is exact for
+                    // 32-bit operands, and truncate toward zero like the scalar operator.
+                    static_assert(sizeof(scalar_type) == 4, "integer division needs 32-bit lanes");
+                    const auto half = [](__m256i x, __m256i y)
+                    { return _mm512_cvttpd_epi32(_mm512_div_pd(_mm512_cvtepi32_pd(x), _mm512_cvtepi32_pd(y))); };
+                    return _mm512_inserti64x4(_mm512_castsi256_si512(half(_mm512_castsi512_si256(a), _mm512_castsi512_si256(b))),
+                                              half(_mm512_extracti64x4_epi64(a, 1), _mm512_extracti64x4_epi64(b, 1)), 1);
+                }
+            }
+
             static auto max(const vector_type& a, const vector_type& b)
             {
                 if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_max_ps(a, b);
@@ -1080,12 +1689,45 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_max_epi32(a, b);
             }
 
+            using half_traits = simd_traits<scalar_type, SIMDType::AVX>;
+
+            // The extracts go through the masked forms with a zeroed pass-through: GCC 12 builds the plain
+            // 512-bit extracts and casts (and _mm512_reduce_* on top of them) on _mm*_undefined_*, which
+            // trips -Wuninitialized once the kernels are inlined.
+            static auto low_half(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xff, _mm512_castps_pd(a), 0));
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xff, a, 0);
+                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_mask_extracti64x4_epi64(_mm256_setzero_si256(), 0xff, a, 0);
+            }
+
+            static auto high_half(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xff, _mm512_castps_pd(a), 1));
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xff, a, 1);
+                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_mask_extracti64x4_epi64(_mm256_setzero_si256(), 0xff, a, 1);
+            }
+
+            // Folds the two 256-bit halves with `op`; the reductions below finish on half_traits.
+            template<typename Op>
+            static auto fold_halves(const vector_type& a, Op op)
+            {
+                return op(low_half(a), high_half(a));
+            }
+
             // need tests
             static scalar_type max_scalar(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_reduce_max_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_reduce_max_pd(a);
-                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_reduce_max_epi32(a);
+                if constexpr (std::is_same_v<vector_type, __m512 >) return half_traits::max_scalar(fold_halves(a, [](__m256 x, __m256 y) { return _mm256_max_ps(x, y); }));
+                if constexpr (std::is_same_v<vector_type, __m512d>) return half_traits::max_scalar(fold_halves(a, [](__m256d x, __m256d y) { return _mm256_max_pd(x, y); }));
+                if constexpr (std::is_same_v<vector_type, __m512i>)
+                {
+                    if constexpr (sizeof(scalar_type) == 4 && std::is_signed_v<scalar_type>) return half_traits::max_scalar(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_max_epi32(x, y); }));
+                    else if constexpr (sizeof(scalar_type) == 4) return half_traits::max_scalar(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_max_epu32(x, y); }));
+                    else if constexpr (sizeof(scalar_type) == 8 && std::is_signed_v<scalar_type>) return half_traits::max_scalar(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_max_epi64(x, y); }));
+                    else if constexpr (sizeof(scalar_type) == 8) return half_traits::max_scalar(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_max_epu64(x, y); }));
+                    else return fold_spilled<scalar_type>(a, [](scalar_type x, scalar_type y) { return x < y ? y : x; });
+                }
             }
 
             static auto min(const vector_type& a, const vector_type& b)
@@ -1097,9 +1739,16 @@ namespace pot::simd
 
             static scalar_type min_scalar(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_reduce_min_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_reduce_min_pd(a);
-                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_reduce_min_epi32(a);
+                if constexpr (std::is_same_v<vector_type, __m512 >) return half_traits::min_scalar(fold_halves(a, [](__m256 x, __m256 y) { return _mm256_min_ps(x, y); }));
+                if constexpr (std::is_same_v<vector_type, __m512d>) return half_traits::min_scalar(fold_halves(a, [](__m256d x, __m256d y) { return _mm256_min_pd(x, y); }));
+                if constexpr (std::is_same_v<vector_type, __m512i>)
+                {
+                    if constexpr (sizeof(scalar_type) == 4 && std::is_signed_v<scalar_type>) return half_traits::min_scalar(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_min_epi32(x, y); }));
+                    else if constexpr (sizeof(scalar_type) == 4) return half_traits::min_scalar(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_min_epu32(x, y); }));
+                    else if constexpr (sizeof(scalar_type) == 8 && std::is_signed_v<scalar_type>) return half_traits::min_scalar(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_min_epi64(x, y); }));
+                    else if constexpr (sizeof(scalar_type) == 8) return half_traits::min_scalar(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_min_epu64(x, y); }));
+                    else return fold_spilled<scalar_type>(a, [](scalar_type x, scalar_type y) { return y < x ? y : x; });
+                }
             }
 
             static auto abs(const vector_type& a)
@@ -1123,11 +1772,16 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_mul_epi32(a, a);
             }
 
-            static auto sum(const vector_type& a)
+            static scalar_type sum(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_reduce_add_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_reduce_add_pd(a);
-                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_reduce_add_epi32(a);
+                if constexpr (std::is_same_v<vector_type, __m512 >) return half_traits::sum(fold_halves(a, [](__m256 x, __m256 y) { return _mm256_add_ps(x, y); }));
+                if constexpr (std::is_same_v<vector_type, __m512d>) return half_traits::sum(fold_halves(a, [](__m256d x, __m256d y) { return _mm256_add_pd(x, y); }));
+                if constexpr (std::is_same_v<vector_type, __m512i>)
+                {
+                    if constexpr (sizeof(scalar_type) == 8) return half_traits::sum(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }));
+                    else if constexpr (sizeof(scalar_type) == 4) return half_traits::sum(fold_halves(a, [](__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }));
+                    else return fold_spilled<scalar_type>(a, [](scalar_type x, scalar_type y) { return x + y; });
+                }
             }
 
             static auto prod(const vector_type& a)
@@ -1139,22 +1793,22 @@ namespace pot::simd
 
             static auto exp(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_exp_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_exp_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m512 >) return vmath<scalar_type, SIMDType::AVX512>::exp(a);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return vmath<scalar_type, SIMDType::AVX512>::exp(a);
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_exp_epi32(a);
             }
 
             static auto log(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_log_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_log_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m512 >) return vmath<scalar_type, SIMDType::AVX512>::log(a);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return vmath<scalar_type, SIMDType::AVX512>::log(a);
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_log_epi32(a);
             }
 
             static auto log2(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_log2_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_log2_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m512 >) return vmath<scalar_type, SIMDType::AVX512>::log2(a);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return vmath<scalar_type, SIMDType::AVX512>::log2(a);
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_log2_epi32(a);
             }
 
@@ -1167,15 +1821,15 @@ namespace pot::simd
 
             static auto sin(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_sin_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_sin_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m512 >) return vmath<scalar_type, SIMDType::AVX512>::sin(a);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return vmath<scalar_type, SIMDType::AVX512>::sin(a);
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_sin_epi32(a);
             }
 
             static auto cos(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_cos_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_cos_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m512 >) return vmath<scalar_type, SIMDType::AVX512>::cos(a);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return vmath<scalar_type, SIMDType::AVX512>::cos(a);
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_cos_epi32(a);
             }
 
@@ -1223,11 +1877,23 @@ namespace pot::simd
 
             static auto tanh(const vector_type& a)
             {
-                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_tanh_ps(a);
-                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_tanh_pd(a);
+                if constexpr (std::is_same_v<vector_type, __m512 >) return vmath<scalar_type, SIMDType::AVX512>::tanh(a);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return vmath<scalar_type, SIMDType::AVX512>::tanh(a);
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_tanh_epi32(a);
             }
 
+            static auto erf(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return vmath<scalar_type, SIMDType::AVX512>::erf(a);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return vmath<scalar_type, SIMDType::AVX512>::erf(a);
+            }
+
+            static auto sigmoid(const vector_type& a)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return vmath<scalar_type, SIMDType::AVX512>::sigmoid(a);
+                if constexpr (std::is_same_v<vector_type, __m512d>) return vmath<scalar_type, SIMDType::AVX512>::sigmoid(a);
+            }
+
             static auto asinh(const vector_type& a)
             {
                 if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_asinh_ps(a);
@@ -1277,9 +1943,119 @@ namespace pot::simd
                 if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_round_epi32(a, _MM_FROUND_TO_NEAREST_INT);
             }
 
+
+            // operator&
+            static auto and_(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_and_si512(a, b);
+            }
+
+            // operator|
+            static auto or_(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_or_si512(a, b);
+            }
+
+            // operator^
+            static auto xor_(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+                if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+                if constexpr (std::is_same_v<vector_type, __m512i>) return _mm512_xor_si512(a, b);
+            }
+
+            // Comparisons give k-masks with bit k for lane k. Float and double comparisons are ordered
+            // (false when either lane is NaN) except !=.
+            template<int Predicate>
+            static mask_type cmp_fp(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_cmp_ps_mask(a, b, Predicate);
+                else return _mm512_cmp_pd_mask(a, b, Predicate);
+            }
+
+            template<int Predicate>
+            static mask_type cmp_int(const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_signed_v<scalar_type>)
+                {
+                    if constexpr (sizeof(scalar_type) == 8) return _mm512_cmp_epi64_mask(a, b, Predicate);
+                    else if constexpr (sizeof(scalar_type) == 4) return _mm512_cmp_epi32_mask(a, b, Predicate);
+                    else if constexpr (sizeof(scalar_type) == 2) return _mm512_cmp_epi16_mask(a, b, Predicate);
+                    else return _mm512_cmp_epi8_mask(a, b, Predicate);
+                }
+                else
+                {
+                    if constexpr (sizeof(scalar_type) == 8) return _mm512_cmp_epu64_mask(a, b, Predicate);
+                    else if constexpr (sizeof(scalar_type) == 4) return _mm512_cmp_epu32_mask(a, b, Predicate);
+                    else if constexpr (sizeof(scalar_type) == 2) return _mm512_cmp_epu16_mask(a, b, Predicate);
+                    else return _mm512_cmp_epu8_mask(a, b, Predicate);
+                }
+            }
+
+            static constexpr bool is_fp = std::is_floating_point_v<scalar_type>;
+
+            static mask_type cmpeq (const vector_type& a, const vector_type& b) { if constexpr (is_fp) return cmp_fp<_CMP_EQ_OQ >(a, b); else return cmp_int<_MM_CMPINT_EQ >(a, b); }
+            static mask_type cmpneq(const vector_type& a, const vector_type& b) { if constexpr (is_fp) return cmp_fp<_CMP_NEQ_UQ>(a, b); else return cmp_int<_MM_CMPINT_NE >(a, b); }
+            static mask_type cmplt (const vector_type& a, const vector_type& b) { if constexpr (is_fp) return cmp_fp<_CMP_LT_OQ >(a, b); else return cmp_int<_MM_CMPINT_LT >(a, b); }
+            static mask_type cmple (const vector_type& a, const vector_type& b) { if constexpr (is_fp) return cmp_fp<_CMP_LE_OQ >(a, b); else return cmp_int<_MM_CMPINT_LE >(a, b); }
+            static mask_type cmpgt (const vector_type& a, const vector_type& b) { if constexpr (is_fp) return cmp_fp<_CMP_GT_OQ >(a, b); else return cmp_int<_MM_CMPINT_NLE>(a, b); }
+            static mask_type cmpge (const vector_type& a, const vector_type& b) { if constexpr (is_fp) return cmp_fp<_CMP_GE_OQ >(a, b); else return cmp_int<_MM_CMPINT_NLT>(a, b); }
+
+            static mask_type mask_set1(bool value) { return value ? lane_mask(scalar_count) : mask_type(0); }
+            static mask_type mask_and(const mask_type& a, const mask_type& b) { return static_cast<mask_type>(a & b); }
+            static mask_type mask_or (const mask_type& a, const mask_type& b) { return static_cast<mask_type>(a | b); }
+            static mask_type mask_xor(const mask_type& a, const mask_type& b) { return static_cast<mask_type>(a ^ b); }
+            static mask_type mask_not(const mask_type& a) { return static_cast<mask_type>(~a); }
+
+            static uint64_t movemask(const mask_type& m) { return static_cast<uint64_t>(m); }
+
+            // Lane k from `a` where bit k of the mask is set, from `b` elsewhere.
+            static vector_type select(const mask_type& m, const vector_type& a, const vector_type& b)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_mask_blend_ps(m, b, a);
+                else if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_mask_blend_pd(m, b, a);
+                else if constexpr (sizeof(scalar_type) == 8) return _mm512_mask_blend_epi64(m, b, a);
+                else if constexpr (sizeof(scalar_type) == 4) return _mm512_mask_blend_epi32(m, b, a);
+                else if constexpr (sizeof(scalar_type) == 2) return _mm512_mask_blend_epi16(m, b, a);
+                else return _mm512_mask_blend_epi8(m, b, a);
+            }
+
+            // The lanes selected by `m` moved to the front in order, the rest zero: vpcompress, which
+            // needs AVX512-VBMI2 for 8/16-bit lanes (otherwise they go through memory).
+            static vector_type compress(const vector_type& a, const mask_type& m)
+            {
+                if constexpr (std::is_same_v<vector_type, __m512 >) return _mm512_maskz_compress_ps(m, a);
+                else if constexpr (std::is_same_v<vector_type, __m512d>) return _mm512_maskz_compress_pd(m, a);
+                else if constexpr (sizeof(scalar_type) == 8) return _mm512_maskz_compress_epi64(m, a);
+                else if constexpr (sizeof(scalar_type) == 4) return _mm512_maskz_compress_epi32(m, a);
+                else
+                {
+#if defined(__AVX512VBMI2__)
+                    if constexpr (sizeof(scalar_type) == 2) return _mm512_maskz_compress_epi16(m, a);
+                    else return _mm512_maskz_compress_epi8(m, a);
+#else
+                    return compress_spilled<scalar_type>(a, movemask(m));
+#endif
+                }
+            }
+
+            // Writes the selected lanes to ptr[0], ptr[1], ... and returns how many there were. Compresses
+            // in a register and stores with a mask: the memory form of vpcompress is microcoded on Zen 4.
+            static size_t compress_store(scalar_type* ptr, const vector_type& a, const mask_type& m)
+            {
+                const size_t count = static_cast<size_t>(std::popcount(movemask(m)));
+                store_partial(ptr, compress(a, m), count);
+                return count;
+            }
         };
 
 
 
     }
 } // namespace pot::simd
+
+#include "pot/simd/simd_math.h"
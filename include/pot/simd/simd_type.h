@@ -0,0 +1,20 @@
+#pragma once
+
+#include <utility>
+
+namespace pot::simd
+{
+    enum class SIMDType
+    {
+        Auto   = 0,   ///< Chosen at run time, see pot/simd/dispatch.h. Has no simd_traits of its own.
+        SSE    = 128,
+        AVX    = 256,
+        AVX512 = 512,
+    };
+
+    namespace details
+    {
+        constexpr auto bitness(SIMDType simd_type) { return std::to_underlying(simd_type); }
+        constexpr auto byteness(SIMDType simd_type) { return bitness(simd_type) / 8; }
+    } // namespace details
+} // namespace pot::simd
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <immintrin.h>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "pot/simd/float16.h"
+#include "pot/simd/simd_traits.h"
+
+namespace pot::simd::details
+{
+    /// Converts one input element to the accumulator type; 16-bit floats go through float.
+    template<typename Acc, typename In>
+    Acc widen(In value)
+    {
+        if constexpr (std::is_same_v<In, float16> || std::is_same_v<In, bfloat16>)
+            return static_cast<Acc>(static_cast<float>(value));
+        else
+            return static_cast<Acc>(value);
+    }
+
+    template<typename Acc, SIMDType simd_type>
+    Acc horizontal_sum(const typename simd_traits<Acc, simd_type>::vector_type& value)
+    {
+        constexpr size_t count = simd_traits<Acc, simd_type>::scalar_count;
+        Acc lanes[count];
+        simd_traits<Acc, simd_type>::storeu(lanes, value);
+
+        // Integer lanes are added unsigned: the kernels let them wrap, and so may their sum.
+        using sum_type = typename std::conditional_t<std::is_integral_v<Acc>, std::make_unsigned<Acc>,
+                                                     std::type_identity<Acc>>::type;
+        sum_type sum = 0;
+        for (size_t i = 0; i < count; ++i)
+            sum += static_cast<sum_type>(lanes[i]);
+        return static_cast<Acc>(sum);
+    }
+
+    /// Extension beyond its width a widening kernel is built for; the caller picks it when it dispatches.
+    enum class widen_extension
+    {
+        none,
+        f16c,
+        avx512_vnni,
+        avx512_bf16
+    };
+
+    /**
+     * Widening multiply-accumulate kernels for mixed-precision dot products. `madd` consumes
+     * `step` elements of each array, multiplies them in a wider type and adds the products into an
+     * accumulator register of `Acc` lanes; `reduce` sums an accumulator to a scalar. Combinations
+     * without a specialization are not supported.
+     */
+    template<typename In, typename Acc, SIMDType simd_type, widen_extension ext = widen_extension::none>
+    struct widening_dot_traits;
+
+    // float x float -> double
+    template<SIMDType simd_type>
+    struct widening_dot_traits<float, double, simd_type, widen_extension::none>
+    {
+        using acc_traits = simd_traits<double, simd_type>;
+        using acc_type = typename acc_traits::vector_type;
+        static constexpr size_t step = 2 * acc_traits::scalar_count;
+
+        static acc_type zero() { return acc_traits::set1(0.0); }
+
+        static acc_type madd(acc_type acc, const float* a, const float* b)
+        {
+            constexpr size_t half = acc_traits::scalar_count;
+            if constexpr (simd_type == SIMDType::SSE)
+            {
+                const __m128 va = _mm_loadu_ps(a);
+                const __m128 vb = _mm_loadu_ps(b);
+                acc = _mm_add_pd(acc, _mm_mul_pd(_mm_cvtps_pd(va), _mm_cvtps_pd(vb)));
+                return _mm_add_pd(acc, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(va, va)), _mm_cvtps_pd(_mm_movehl_ps(vb, vb))));
+            }
+            if constexpr (simd_type == SIMDType::AVX)
+            {
+                acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(a)), _mm256_cvtps_pd(_mm_loadu_ps(b))));
+                return _mm256_add_pd(acc, _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(a + half)),
+                                                        _mm256_cvtps_pd(_mm_loadu_ps(b + half))));
+            }
+            if constexpr (simd_type == SIMDType::AVX512)
+            {
+                acc = _mm512_add_pd(acc, _mm512_mul_pd(_mm512_cvtps_pd(_mm256_loadu_ps(a)), _mm512_cvtps_pd(_mm256_loadu_ps(b))));
+                return _mm512_add_pd(acc, _mm512_mul_pd(_mm512_cvtps_pd(_mm256_loadu_ps(a + half)),
+                                                        _mm512_cvtps_pd(_mm256_loadu_ps(b + half))));
+            }
+        }
+
+        static double reduce(const acc_type& acc) { return horizontal_sum<double, simd_type>(acc); }
+    };
+
+    /**
+     * int8 / uint8 / int16 -> int32. The inputs are widened to int16 and multiplied with
+     * `pmaddwd`, which adds neighbouring products into int32 lanes without saturating (unlike
+     * `pmaddubsw`).
+     */
+    template<typename In, SIMDType simd_type>
+        requires(std::is_same_v<In, int8_t> || std::is_same_v<In, uint8_t> || std::is_same_v<In, int16_t>)
+    struct widening_dot_traits<In, int32_t, simd_type, widen_extension::none>
+    {
+        using acc_traits = simd_traits<int32_t, simd_type>;
+        using acc_type = typename acc_traits::vector_type;
+        static constexpr size_t step = byteness(simd_type) / sizeof(int16_t);
+
+        static acc_type zero() { return acc_traits::set1(0); }
+
+        static acc_type madd(acc_type acc, const In* a, const In* b)
+        {
+            if constexpr (simd_type == SIMDType::SSE) return _mm_add_epi32(acc, _mm_madd_epi16(load_widened(a), load_widened(b)));
+            if constexpr (simd_type == SIMDType::AVX) return _mm256_add_epi32(acc, _mm256_madd_epi16(load_widened(a), load_widened(b)));
+            if constexpr (simd_type == SIMDType::AVX512) return _mm512_add_epi32(acc, _mm512_madd_epi16(load_widened(a), load_widened(b)));
+        }
+
+        static int32_t reduce(const acc_type& acc) { return horizontal_sum<int32_t, simd_type>(acc); }
+
+      private:
+        // Loads `step` inputs as int16 lanes.
+        static acc_type load_widened(const In* p)
+        {
+            if constexpr (std::is_same_v<In, int16_t>)
+                return acc_traits::loadu(reinterpret_cast<const int32_t*>(p));
+            else if constexpr (simd_type == SIMDType::SSE)
+            {
+                const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+                if constexpr (std::is_same_v<In, int8_t>) return _mm_cvtepi8_epi16(bytes);
+                else return _mm_cvtepu8_epi16(bytes);
+            }
+            else if constexpr (simd_type == SIMDType::AVX)
+            {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                if constexpr (std::is_same_v<In, int8_t>) return _mm256_cvtepi8_epi16(bytes);
+                else return _mm256_cvtepu8_epi16(bytes);
+            }
+            else
+            {
+                const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                if constexpr (std::is_same_v<In, int8_t>) return _mm512_cvtepi8_epi16(bytes);
+                else return _mm512_cvtepu8_epi16(bytes);
+            }
+        }
+    };
+
+    /**
+     * int8 / uint8 -> int32 with AVX-512 VNNI: `vpdpbusd` on 64 bytes at a time. It multiplies
+     * unsigned by signed bytes, so one operand is shifted by 128 and the shift is subtracted again
+     * through a second `vpdpbusd` against a vector of ones.
+     */
+    template<typename In>
+        requires(std::is_same_v<In, int8_t> || std::is_same_v<In, uint8_t>)
+    struct widening_dot_traits<In, int32_t, SIMDType::AVX512, widen_extension::avx512_vnni>
+    {
+        struct acc_type
+        {
+            __m512i products;
+            __m512i bias;
+        };
+        static constexpr size_t step = 64;
+
+        static acc_type zero() { return {_mm512_setzero_si512(), _mm512_setzero_si512()}; }
+
+        static acc_type madd(acc_type acc, const In* a, const In* b)
+        {
+            const __m512i va = _mm512_loadu_si512(a);
+            const __m512i vb = _mm512_loadu_si512(b);
+            const __m512i flip = _mm512_set1_epi8(static_cast<char>(0x80));
+            if constexpr (std::is_same_v<In, int8_t>)
+            {
+                // sum (a + 128) * b - 128 * sum b
+                acc.products = _mm512_dpbusd_epi32(acc.products, _mm512_xor_si512(va, flip), vb);
+                acc.bias = _mm512_dpbusd_epi32(acc.bias, _mm512_set1_epi8(1), vb);
+            }
+            else
+            {
+                // sum a * (b - 128) + 128 * sum a
+                acc.products = _mm512_dpbusd_epi32(acc.products, va, _mm512_xor_si512(vb, flip));
+                acc.bias = _mm512_dpbusd_epi32(acc.bias, va, _mm512_set1_epi8(1));
+            }
+            return acc;
+        }
+
+        static int32_t reduce(const acc_type& acc)
+        {
+            const int32_t bias = horizontal_sum<int32_t, SIMDType::AVX512>(acc.bias);
+            const int32_t products = horizontal_sum<int32_t, SIMDType::AVX512>(acc.products);
+            // Unsigned arithmetic: the int32 accumulation wraps like the scalar one would.
+            if constexpr (std::is_same_v<In, int8_t>)
+                return static_cast<int32_t>(static_cast<uint32_t>(products) - 128u * static_cast<uint32_t>(bias));
+            else
+                return static_cast<int32_t>(static_cast<uint32_t>(products) + 128u * static_cast<uint32_t>(bias));
+        }
+    };
+
+    /**
+     * bfloat16 / float16 -> float. Inputs are converted to float lanes and multiplied there:
+     * bfloat16 by a 16-bit shift, float16 with `vcvtph2ps` (AVX-512, or narrower widths built for
+     * `widen_extension::f16c`) or else one element at a time.
+     */
+    template<typename In, SIMDType simd_type, widen_extension ext>
+        requires((std::is_same_v<In, bfloat16> || std::is_same_v<In, float16>) &&
+                 (ext == widen_extension::none || (ext == widen_extension::f16c && std::is_same_v<In, float16>)))
+    struct widening_dot_traits<In, float, simd_type, ext>
+    {
+        using acc_traits = simd_traits<float, simd_type>;
+        using acc_type = typename acc_traits::vector_type;
+        static constexpr size_t step = acc_traits::scalar_count;
+
+        static acc_type zero() { return acc_traits::set1(0.0f); }
+
+        static acc_type madd(acc_type acc, const In* a, const In* b)
+        {
+            const acc_type va = load_widened(a);
+            const acc_type vb = load_widened(b);
+            if constexpr (simd_type == SIMDType::SSE) return _mm_add_ps(acc, _mm_mul_ps(va, vb));
+            if constexpr (simd_type == SIMDType::AVX) return _mm256_add_ps(acc, _mm256_mul_ps(va, vb));
+            if constexpr (simd_type == SIMDType::AVX512) return _mm512_add_ps(acc, _mm512_mul_ps(va, vb));
+        }
+
+        static float reduce(const acc_type& acc) { return horizontal_sum<float, simd_type>(acc); }
+
+      private:
+        static acc_type load_widened(const In* p)
+        {
+            if constexpr (std::is_same_v<In, bfloat16>)
+            {
+                if constexpr (simd_type == SIMDType::SSE)
+                    return _mm_castsi128_ps(_mm_slli_epi32(_mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))), 16));
+                if constexpr (simd_type == SIMDType::AVX)
+                    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))), 16));
+                if constexpr (simd_type == SIMDType::AVX512)
+                    return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))), 16));
+            }
+            else if constexpr (simd_type == SIMDType::AVX512)
+                return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+            else if constexpr (ext == widen_extension::f16c && simd_type == SIMDType::SSE)
+                return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+            else if constexpr (ext == widen_extension::f16c)
+                return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+            else
+            {
+                float lanes[acc_traits::scalar_count];
+                for (size_t i = 0; i < acc_traits::scalar_count; ++i)
+                    lanes[i] = static_cast<float>(p[i]);
+                return acc_traits::loadu(lanes);
+            }
+        }
+    };
+
+    /// bfloat16 -> float with AVX-512 BF16: `vdpbf16ps` on 32 elements at a time.
+    template<typename In>
+        requires(std::is_same_v<In, bfloat16>)
+    struct widening_dot_traits<In, float, SIMDType::AVX512, widen_extension::avx512_bf16>
+    {
+        using acc_type = __m512;
+        static constexpr size_t step = 32;
+
+        static acc_type zero() { return _mm512_setzero_ps(); }
+
+        static acc_type madd(acc_type acc, const In* a, const In* b)
+        {
+            return _mm512_dpbf16_ps(acc, std::bit_cast<__m512bh>(_mm512_loadu_si512(a)),
+                                    std::bit_cast<__m512bh>(_mm512_loadu_si512(b)));
+        }
+
+        static float reduce(const acc_type& acc) { return horizontal_sum<float, SIMDType::AVX512>(acc); }
+    };
+} // namespace pot::simd::details
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "pot/utils/cache_line.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace pot
+{
+/**
+ * @brief How an idle worker waits for new work.
+ *
+ * A worker that finds its queue empty first spins `spin_count` times on a `pause` instruction,
+ * then gives up its time slice `yield_count` times, and only then parks in the kernel. Spinning
+ * keeps the submit-to-run latency in the low microseconds at the cost of burning a core while
+ * idle; the default parks immediately.
+ */
+struct idle_policy
+{
+    uint32_t spin_count = 0;
+    uint32_t yield_count = 0;
+
+    /// Park as soon as there is no work.
+    static constexpr idle_policy park() noexcept { return {}; }
+
+    /// Yield a few times before parking.
+    static constexpr idle_policy yield_then_park(uint32_t yields = 64) noexcept { return {0, yields}; }
+
+    /// Spin, then yield, then park.
+    static constexpr idle_policy spin_then_park(uint32_t spins = 4096, uint32_t yields = 64) noexcept
+    {
+        return {spins, yields};
+    }
+
+    [[nodiscard]] constexpr bool parks_immediately() const noexcept
+    {
+        return spin_count == 0 && yield_count == 0;
+    }
+};
+
+/// Hint to the CPU that the caller is in a spin-wait loop.
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * @brief Event count that idle workers wait on and submitters bump.
+ *
+ * A worker reads `prepare_wait()` before checking its queue and passes the value to `wait()` if
+ * the queue was empty, so a submission that lands in between is never lost. `wait()` follows an
+ * `idle_policy`. A spinning worker sees a bumped counter by itself, so as long as there are more
+ * spinners than notifications already left to them, `notify` skips the wake-up and counts the
+ * skipped notification instead. The spinner that takes it wakes sleepers for the rest. The kernel
+ * is only entered when somebody is actually parked.
+ */
+class idle_notifier
+{
+  public:
+    [[nodiscard]] uint32_t prepare_wait() const noexcept { return m_epoch.load(std::memory_order_seq_cst); }
+
+    void wait(uint32_t epoch, const idle_policy &policy) noexcept
+    {
+        if (!policy.parks_immediately())
+        {
+            m_spinners.fetch_add(1, std::memory_order_seq_cst);
+
+            for (uint32_t i = 0; i < policy.spin_count; ++i)
+            {
+                if (m_epoch.load(std::memory_order_relaxed) != epoch)
+                    return leave_spin();
+                cpu_relax();
+            }
+            for (uint32_t i = 0; i < policy.yield_count; ++i)
+            {
+                if (m_epoch.load(std::memory_order_relaxed) != epoch)
+                    return leave_spin();
+                std::this_thread::yield();
+            }
+
+            // Become a sleeper before we stop being a spinner, so a concurrent submitter always
+            // sees at least one of the two.
+            m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            m_spinners.fetch_sub(1, std::memory_order_seq_cst);
+
+            // Notifications may have been skipped for us up to the moment we stopped spinning.
+            m_epoch.wait(epoch, std::memory_order_seq_cst);
+            m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+            hand_off_skipped();
+            return;
+        }
+
+        m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+        m_epoch.wait(epoch, std::memory_order_seq_cst);
+        m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void notify_one() noexcept { notify(1); }
+
+    /// Announce `count` new pieces of work: wakes up to `count` workers, minus the spinners that
+    /// have not been left any work yet.
+    void notify(size_t count) noexcept
+    {
+        if (count == 0)
+            return;
+
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+        const size_t spinners = m_spinners.load(std::memory_order_seq_cst);
+        size_t skipped = m_skipped.load(std::memory_order_seq_cst);
+        size_t skip = 0;
+        while (skipped < spinners)
+        {
+            skip = std::min(count, spinners - skipped);
+            if (m_skipped.compare_exchange_weak(skipped, skipped + skip, std::memory_order_seq_cst))
+                break;
+            skip = 0;
+        }
+
+        wake(count - skip);
+    }
+
+    /// Workers currently spinning, yielding or parked; a snapshot that may be stale on return.
+    [[nodiscard]] size_t idle_count() const noexcept
+    {
+        return static_cast<size_t>(m_spinners.load(std::memory_order_relaxed)) +
+               m_sleepers.load(std::memory_order_relaxed);
+    }
+
+    void notify_all() noexcept
+    {
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        m_epoch.notify_all();
+    }
+
+  private:
+    void leave_spin() noexcept
+    {
+        m_spinners.fetch_sub(1, std::memory_order_seq_cst);
+        hand_off_skipped();
+    }
+
+    // Submitters skipped their wake-ups while we were spinning. Take one piece of that work and
+    // hand the rest to parked workers instead of serializing it behind us.
+    void hand_off_skipped() noexcept
+    {
+        const size_t skipped = m_skipped.exchange(0, std::memory_order_seq_cst);
+        if (skipped > 1)
+            wake(skipped - 1);
+    }
+
+    void wake(size_t count) noexcept
+    {
+        if (count == 0)
+            return;
+
+        const size_t sleepers = m_sleepers.load(std::memory_order_seq_cst);
+        if (sleepers == 0)
+            return;
+
+        if (count >= sleepers)
+        {
+            m_epoch.notify_all();
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+                m_epoch.notify_one();
+        }
+    }
+
+    alignas(pot::cache_line_alignment) std::atomic<uint32_t> m_epoch{0};
+    alignas(pot::cache_line_alignment) std::atomic<uint32_t> m_spinners{0};
+    std::atomic<uint32_t> m_sleepers{0};
+    std::atomic<size_t> m_skipped{0}; // notifications left to spinners and not yet taken
+};
+} // namespace pot
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "pot/utils/cpu_topology.h"
+
+namespace pot
+{
+/**
+ * @brief Where the workers of a pool are pinned.
+ *
+ * The policy is resolved against a `pot::utils::cpu_topology` into one CPU per worker when the
+ * pool is built. If there are more workers than candidate CPUs, the list wraps around.
+ *
+ * - `none`           — leave scheduling to the OS (default);
+ * - `compact`        — fill the hardware threads of one core, then the next core, socket by socket;
+ * - `scatter`        — one worker per physical core, alternating sockets, before any SMT sibling;
+ * - `physical_cores` — only the first hardware thread of every core, SMT siblings stay free;
+ * - `cpus`           — an explicit list of CPU ids, in order;
+ * - `fastest_first`  — `task_meta::sorted_cpu_list` as measured by `executor::cpu_set()`,
+ *                      falling back to `compact` if it has not been measured.
+ */
+struct placement_policy
+{
+    enum class kind
+    {
+        none,
+        compact,
+        scatter,
+        physical_cores,
+        cpus,
+        fastest_first
+    };
+
+    kind type = kind::none;
+    std::vector<int> cpu_list;
+
+    static placement_policy none() { return {}; }
+    static placement_policy compact() { return {kind::compact, {}}; }
+    static placement_policy scatter() { return {kind::scatter, {}}; }
+    static placement_policy physical_cores() { return {kind::physical_cores, {}}; }
+    static placement_policy cpus(std::vector<int> list) { return {kind::cpus, std::move(list)}; }
+    static placement_policy fastest_first() { return {kind::fastest_first, {}}; }
+
+    /**
+     * @brief CPU id for each of `num_threads` workers, or an empty vector for `none`.
+     *
+     * @throws std::invalid_argument if an explicit list is empty.
+     */
+    [[nodiscard]] std::vector<int> resolve(size_t num_threads,
+                                           const pot::utils::cpu_topology &topology =
+                                               pot::utils::cpu_topology::system()) const;
+};
+} // namespace pot
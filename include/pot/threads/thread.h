@@ -1,9 +1,9 @@
 #pragma once
 
-#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <queue>
+#include <span>
 #include <stop_token>
 #include <string>
 #include <thread>
@@ -11,14 +11,35 @@
 
 #include "pot/algorithms/lfqueue.h"
 #include "pot/executors/executor.h"
+#include "pot/threads/idle_policy.h"
 #include "pot/utils/this_thread.h"
+#include "pot/utils/unique_function.h"
 
 namespace pot
 {
+namespace details
+{
+template <typename FuncType, typename... Args>
+pot::utils::unique_function_once make_thread_task(FuncType &&func, Args &&...args)
+{
+    if constexpr (sizeof...(Args) == 0)
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<std::decay_t<FuncType> &>>)
+            return pot::utils::unique_function_once(std::forward<FuncType>(func));
+    }
+
+    return [f = std::decay_t<FuncType>(std::forward<FuncType>(func)),
+            ... captured_args = std::decay_t<Args>(std::forward<Args>(args))]() mutable
+    { std::invoke(f, std::move(captured_args)...); };
+}
+} // namespace details
+
 class thread
 {
   public:
-    thread(std::string name = "Thread", int64_t local_id = 0, executor *owner = nullptr)
+    thread(std::string name = "Thread", int64_t local_id = 0, executor *owner = nullptr,
+           pot::idle_policy policy = {})
+        : m_policy(policy)
     {
         m_thread = std::jthread([this, name = std::move(name), local_id, owner](std::stop_token st)
                                 { worker_loop(st, std::move(name), local_id, owner); });
@@ -29,22 +50,45 @@ class thread
         run([name = std::move(name)] { pot::this_thread::set_name(name); });
     }
 
+    void set_affinity(int cpu)
+    {
+        run([cpu] { (void)pot::this_thread::set_affinity({cpu}); });
+    }
+
     template <typename FuncType, typename... Args> void run(FuncType &&func, Args &&...args)
     {
         {
             std::lock_guard lock(m_mutex);
-            m_queue.emplace(
-                [f = std::decay_t<FuncType>(std::forward<FuncType>(func)),
-                 ... captured_args = std::decay_t<Args>(std::forward<Args>(args))]() mutable
-                { std::invoke(f, std::move(captured_args)...); });
+            m_queue.emplace(details::make_thread_task(std::forward<FuncType>(func),
+                                                      std::forward<Args>(args)...));
+        }
+        m_idle.notify_one();
+    }
+
+    /// Enqueue several tasks under one lock and wake the thread once. The tasks are moved from as
+    /// they are queued; if the queue throws, the rest are left in `tasks`.
+    void run_bulk(std::span<pot::utils::unique_function_once> tasks)
+    {
+        if (tasks.empty())
+            return;
+        try
+        {
+            std::lock_guard lock(m_mutex);
+            for (auto &task : tasks)
+                m_queue.push(std::move(task));
+        }
+        catch (...)
+        {
+            m_idle.notify_one();
+            throw;
         }
-        m_cv.notify_one();
+        m_idle.notify_one();
     }
 
     void request_stop()
     {
         m_thread.request_stop();
-        m_cv.notify_all();
+        m_idle.notify_all();
     }
 
     void join()
@@ -56,6 +100,9 @@ class thread
 
     ~thread() { join(); }
 
+    /// True while the worker is waiting for work (spinning, yielding or parked).
+    [[nodiscard]] bool idle() const noexcept { return m_idle.idle_count() > 0; }
+
   private:
     void worker_loop(std::stop_token st, std::string name, int64_t local_id, executor *owner)
     {
@@ -64,17 +111,11 @@ class thread
 
         while (!st.stop_requested())
         {
-            std::function<void()> task;
+            const uint32_t epoch = m_idle.prepare_wait();
+            pot::utils::unique_function_once task;
 
             {
-                std::unique_lock lock(m_mutex);
-                m_cv.wait(lock, [&] { return st.stop_requested() || !m_queue.empty(); });
-
-                if (st.stop_requested() && m_queue.empty())
-                {
-                    return;
-                }
-
+                std::lock_guard lock(m_mutex);
                 if (!m_queue.empty())
                 {
                     task = std::move(m_queue.front());
@@ -86,21 +127,28 @@ class thread
             {
                 task();
             }
+            else
+            {
+                if (st.stop_requested())
+                    return;
+                m_idle.wait(epoch, m_policy);
+            }
         }
     }
 
     std::jthread m_thread;
-    std::queue<std::function<void()>> m_queue;
+    std::queue<pot::utils::unique_function_once> m_queue;
     std::mutex m_mutex;
-    std::condition_variable m_cv;
+    pot::idle_notifier m_idle;
+    pot::idle_policy m_policy;
 };
 
 class thread_lf
 {
   public:
     thread_lf(std::string name = "Thread", int64_t local_id = 0, executor *owner = nullptr,
-              size_t queue_size = 65536)
-        : m_queue()
+              size_t queue_size = 65536, pot::idle_policy policy = {})
+        : m_queue(), m_policy(policy)
     {
         m_thread = std::jthread([this, name = std::move(name), local_id, owner](std::stop_token st)
                                 { worker_loop(st, std::move(name), local_id, owner); });
@@ -111,27 +159,49 @@ class thread_lf
         run([name = std::move(name)] { pot::this_thread::set_name(name); });
     }
 
+    void set_affinity(int cpu)
+    {
+        run([cpu] { (void)pot::this_thread::set_affinity({cpu}); });
+    }
+
     template <typename FuncType, typename... Args> void run(FuncType &&func, Args &&...args)
     {
-        std::function<void()> task =
-            [f = std::decay_t<FuncType>(std::forward<FuncType>(func)),
-             ... captured_args = std::decay_t<Args>(std::forward<Args>(args))]() mutable
-        { std::invoke(f, std::move(captured_args)...); };
+        auto task =
+            details::make_thread_task(std::forward<FuncType>(func), std::forward<Args>(args)...);
 
         while (!m_queue.push(std::move(task)))
         {
             std::this_thread::yield();
         }
 
-        m_has_work.store(true, std::memory_order_release);
-        m_has_work.notify_one();
+        m_idle.notify_one();
+    }
+
+    /// Enqueue several tasks, reserving queue slots in blocks, and wake the thread once.
+    void run_bulk(std::span<pot::utils::unique_function_once> tasks)
+    {
+        if (tasks.empty())
+            return;
+
+        for (size_t pushed = 0; pushed < tasks.size();)
+        {
+            const size_t n = m_queue.push_bulk(tasks.data() + pushed, tasks.size() - pushed);
+            if (n == 0)
+            {
+                // Full: let the worker drain it before we retry.
+                m_idle.notify_one();
+                std::this_thread::yield();
+            }
+            pushed += n;
+        }
+
+        m_idle.notify_one();
     }
 
     void request_stop()
     {
         m_thread.request_stop();
-        m_has_work.store(true, std::memory_order_release);
-        m_has_work.notify_all();
+        m_idle.notify_all();
     }
 
     void join()
@@ -143,6 +213,9 @@ class thread_lf
 
     ~thread_lf() { join(); }
 
+    /// True while the worker is waiting for work (spinning, yielding or parked).
+    [[nodiscard]] bool idle() const noexcept { return m_idle.idle_count() > 0; }
+
   private:
     void worker_loop(std::stop_token st, std::string name, int64_t local_id, executor *owner)
     {
@@ -151,6 +224,7 @@ class thread_lf
 
         while (true)
         {
+            const uint32_t epoch = m_idle.prepare_wait();
             auto task_opt = m_queue.pop();
 
             if (task_opt.has_value())
@@ -164,23 +238,14 @@ class thread_lf
                 return;
             }
 
-            m_has_work.store(false, std::memory_order_release);
-
-            auto check_again = m_queue.pop();
-            if (check_again.has_value())
-            {
-                m_has_work.store(true, std::memory_order_relaxed);
-                (*check_again)();
-                continue;
-            }
-
-            m_has_work.wait(false, std::memory_order_acquire);
+            m_idle.wait(epoch, m_policy);
         }
     }
 
     std::jthread m_thread;
-    pot::algorithms::lfqueue<std::function<void()>> m_queue;
-    std::atomic<bool> m_has_work{false};
+    pot::algorithms::lfqueue<pot::utils::unique_function_once> m_queue;
+    pot::idle_notifier m_idle;
+    pot::idle_policy m_policy;
 };
 
 } // namespace pot
@@ -20,4 +20,16 @@ namespace pot
     constexpr std::size_t cache_line_alignment = 64;
 #endif
 
+    /**
+     * @brief A value on a cache line of its own.
+     *
+     * Per-worker partial results are kept in arrays of these so that workers writing neighbouring
+     * slots do not invalidate each other's lines.
+     */
+    template <typename T>
+    struct alignas(cache_line_alignment) cache_padded
+    {
+        T value;
+    };
+
 } // namespace pot
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace pot::utils
+{
+/**
+ * @brief One logical CPU as the kernel describes it.
+ *
+ * `smt_index` is the position of the CPU among its hardware-thread siblings: 0 for the first
+ * thread of a physical core, 1 for its hyper-thread, and so on.
+ */
+struct cpu_info
+{
+    int id = 0;
+    int core_id = 0;
+    int package_id = 0;
+    int smt_index = 0;
+    int numa_node = 0;
+};
+
+/**
+ * @brief Logical CPUs of the machine with their core and socket layout.
+ *
+ * Read from `/sys/devices/system/cpu` (`online` and `cpuN/topology/...`) and from the sibling
+ * `/sys/devices/system/node` directory (`nodeN/cpulist`). Missing files are not an error: a CPU
+ * without topology information is treated as its own core on package 0 and NUMA node 0, so on
+ * platforms without sysfs the result degrades to a flat list of `hardware_concurrency()` CPUs.
+ */
+class cpu_topology
+{
+  public:
+    cpu_topology() = default;
+    explicit cpu_topology(std::vector<cpu_info> cpus);
+
+    /// Parse a sysfs tree; `root` holds `online` and the `cpuN` entries, NUMA nodes are read from
+    /// `root/../node`.
+    static cpu_topology from_sysfs(const std::filesystem::path &root = "/sys/devices/system/cpu");
+
+    /// Topology of this machine restricted to the CPUs the process may run on. Read once.
+    static const cpu_topology &system();
+
+    [[nodiscard]] const std::vector<cpu_info> &cpus() const noexcept { return m_cpus; }
+    [[nodiscard]] size_t size() const noexcept { return m_cpus.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_cpus.empty(); }
+
+    [[nodiscard]] size_t physical_core_count() const;
+    [[nodiscard]] size_t package_count() const;
+
+    /// Ids of the NUMA nodes that have at least one CPU, ascending.
+    [[nodiscard]] std::vector<int> numa_nodes() const;
+    /// Ids of the CPUs on NUMA node `node`, ascending.
+    [[nodiscard]] std::vector<int> cpus_on_node(int node) const;
+
+    /// Keep only the CPUs listed in `allowed`.
+    [[nodiscard]] cpu_topology restricted_to(const std::vector<int> &allowed) const;
+
+  private:
+    std::vector<cpu_info> m_cpus; // sorted by id
+};
+
+/// Parse a kernel CPU list such as `0-3,8,10-11`. Malformed entries are skipped.
+[[nodiscard]] std::vector<int> parse_cpu_list(const std::string &list);
+} // namespace pot::utils
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include "pot/executors/executor.h"
 
@@ -44,4 +45,11 @@ void yield();
 bool set_params(int policy, int priority);
 std::pair<int, int> get_params();
 
+/// Restrict the calling thread to the given CPUs. Returns false if the OS refused or is unsupported.
+bool set_affinity(const std::vector<int> &cpus);
+/// CPUs the calling thread may run on; empty if unknown.
+[[nodiscard]] std::vector<int> get_affinity();
+/// CPU the calling thread is running on right now, or -1 if unknown.
+[[nodiscard]] int current_cpu();
+
 } // namespace pot::this_thread
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <concepts>
 #include <type_traits>
 #include <utility>
 #include <cstddef>
+#include <new>
 #include <cassert>
 #include <cstring>
 
@@ -142,18 +144,21 @@ namespace pot::details
     public:
         static constexpr bool is_inlinable() noexcept
         {
-            return std::is_nothrow_move_constructible_v<callable_type> && sizeof(callable_type) <= func_constants::buffer_size;
+            return std::is_nothrow_move_constructible_v<callable_type> && sizeof(callable_type) <= func_constants::buffer_size &&
+                   alignof(callable_type) <= alignof(std::max_align_t);
         }
 
         template <class passed_callable_type>
         static void build(void *dst, passed_callable_type &&callable)
         {
-            if (is_inlinable())
+            if constexpr (is_inlinable())
             {
                 return build_inlinable(dst, std::forward<passed_callable_type>(callable));
             }
-
-            build_allocated(dst, std::forward<passed_callable_type>(callable));
+            else
+            {
+                build_allocated(dst, std::forward<passed_callable_type>(callable));
+            }
         }
 
         static void move_destroy(void *src, void *dst) noexcept
@@ -0,0 +1,125 @@
+#pragma once
+
+// Kernels the library builds once per SIMD width. Each simd_kernels_<width>.cpp is compiled with
+// the flags of its width and instantiates them for that width only, through
+// POT_INSTANTIATE_SIMD_KERNELS.
+
+#include "pot/algorithms/dot_blocks.h"
+
+#if defined(__GNUC__)
+#define POT_SIMD_KERNEL [[gnu::flatten]]
+#else
+// MSVC cannot flatten, so it builds these files at the baseline flags (apply_simd_kernel_flags in
+// cmake/CompilerFlags.cmake) and its Auto stays at SSE: nothing wider is left for the linker to pick.
+#define POT_SIMD_KERNEL
+#endif
+
+namespace pot::algorithms::details
+{
+namespace
+{
+    // Everything a kernel calls is inlined into it and the kernels have internal linkage, so no
+    // inline function compiled with the flags of a wider width is left for the linker to pick
+    // in place of the baseline copy.
+    template <typename T, pot::simd::SIMDType W>
+    POT_SIMD_KERNEL T dot_contiguous_block(const T *a, const T *b, std::size_t begin, std::size_t end)
+    {
+        return simd_reduce_block<T, T, W>(contiguous_access<T>{a}, contiguous_access<T>{b}, begin, end,
+                                          fma_accumulate{}, std::plus<T>{}, T{0});
+    }
+
+    template <typename T, pot::simd::SIMDType W>
+    POT_SIMD_KERNEL T dot_strided_block(const T *a, std::size_t stride_a, const T *b, std::size_t stride_b,
+                                        std::size_t begin, std::size_t end)
+    {
+        return simd_reduce_block<T, T, W>(strided_access<T>{a, stride_a}, strided_access<T>{b, stride_b}, begin, end,
+                                          fma_accumulate{}, std::plus<T>{}, T{0});
+    }
+
+    template <typename T, pot::simd::SIMDType W>
+    POT_SIMD_KERNEL T dot_indexed_block(const T *values, const T *x, const uint32_t *idx, std::size_t begin, std::size_t end)
+    {
+        return simd_reduce_block<T, T, W>(contiguous_access<T>{values}, indexed_access<T>{x, idx}, begin, end,
+                                          fma_accumulate{}, std::plus<T>{}, T{0});
+    }
+
+    template <typename T, pot::simd::SIMDType W>
+    POT_SIMD_KERNEL T dot_reproducible_block(const T *a, const T *b, std::size_t begin, std::size_t end, summation method)
+    {
+        multiply_lanes simd_elem_op;
+        std::plus<T> reduce_op;
+        return reproducible_reduce_block<T, T, W>(a, b, begin, end, simd_elem_op, reduce_op, method);
+    }
+
+    template <typename In, typename Acc, pot::simd::SIMDType W, pot::simd::details::widen_extension Ext>
+    POT_SIMD_KERNEL Acc widening_dot_kernel_block(const In *a, const In *b, std::size_t begin, std::size_t end)
+    {
+        return widening_dot_block<In, Acc, W, Ext>(a, b, begin, end);
+    }
+
+    template <typename In, typename Acc, pot::simd::SIMDType W, pot::simd::details::widen_extension Ext>
+    widening_dot_kernel<In, Acc> make_widening_dot_kernel()
+    {
+        return {pot::simd::details::widening_dot_traits<In, Acc, W, Ext>::step, &widening_dot_kernel_block<In, Acc, W, Ext>};
+    }
+} // namespace
+
+    template <typename T, pot::simd::SIMDType W>
+    dot_kernels<T> dot_kernels_at()
+    {
+        return {pot::simd::details::simd_traits<T, W>::scalar_count, &dot_contiguous_block<T, W>,
+                &dot_strided_block<T, W>, &dot_indexed_block<T, W>, &dot_reproducible_block<T, W>};
+    }
+
+    template <typename In, typename Acc, pot::simd::SIMDType W>
+    widening_dot_kernel<In, Acc> widening_dot_kernel_at()
+    {
+        // F16C comes with the AVX2 flags; VNNI and BF16 are left to the files below.
+        constexpr auto ext = compiled_widen_extension<In, Acc, W>() == pot::simd::details::widen_extension::f16c
+                                 ? pot::simd::details::widen_extension::f16c
+                                 : pot::simd::details::widen_extension::none;
+        return make_widening_dot_kernel<In, Acc, W, ext>();
+    }
+
+    // The VNNI and BF16 files build the AVX-512 kernel again with one more extension, under names of
+    // their own: widening_dot_kernel_at<In, Acc, AVX512> is already defined by the AVX-512 file.
+    template <typename In, typename Acc>
+    widening_dot_kernel<In, Acc> widening_dot_kernel_avx512_vnni()
+    {
+        return make_widening_dot_kernel<In, Acc, pot::simd::SIMDType::AVX512, pot::simd::details::widen_extension::avx512_vnni>();
+    }
+
+    template <typename In, typename Acc>
+    widening_dot_kernel<In, Acc> widening_dot_kernel_avx512_bf16()
+    {
+        return make_widening_dot_kernel<In, Acc, pot::simd::SIMDType::AVX512, pot::simd::details::widen_extension::avx512_bf16>();
+    }
+} // namespace pot::algorithms::details
+
+#define POT_INSTANTIATE_DOT_KERNELS(T, W) \
+    template pot::algorithms::details::dot_kernels<T> pot::algorithms::details::dot_kernels_at<T, W>();
+
+#define POT_INSTANTIATE_WIDENING_DOT_KERNEL(In, Acc, W) \
+    template pot::algorithms::details::widening_dot_kernel<In, Acc>                 \
+    pot::algorithms::details::widening_dot_kernel_at<In, Acc, W>();
+
+#define POT_INSTANTIATE_AVX512_EXTENDED_KERNEL(name, In, Acc) \
+    template pot::algorithms::details::widening_dot_kernel<In, Acc>     \
+    pot::algorithms::details::name<In, Acc>();
+
+#define POT_INSTANTIATE_SIMD_KERNELS(W)                                                   \
+    POT_INSTANTIATE_DOT_KERNELS(float, W)                                                 \
+    POT_INSTANTIATE_DOT_KERNELS(double, W)                                                \
+    POT_INSTANTIATE_DOT_KERNELS(int32_t, W)                                               \
+    POT_INSTANTIATE_WIDENING_DOT_KERNEL(float, double, W)                                 \
+    POT_INSTANTIATE_WIDENING_DOT_KERNEL(int8_t, int32_t, W)                               \
+    POT_INSTANTIATE_WIDENING_DOT_KERNEL(uint8_t, int32_t, W)                              \
+    POT_INSTANTIATE_WIDENING_DOT_KERNEL(int16_t, int32_t, W)                              \
+    POT_INSTANTIATE_WIDENING_DOT_KERNEL(pot::simd::bfloat16, float, W)                    \
+    POT_INSTANTIATE_WIDENING_DOT_KERNEL(pot::simd::float16, float, W)                     \
+                                                                                          \
+    template <>                                                                           \
+    pot::simd::cpu_features pot::simd::details::width_features<W>()                       \
+    {                                                                                     \
+        return compiled_features();                                                       \
+    }
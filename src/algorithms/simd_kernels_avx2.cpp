@@ -0,0 +1,19 @@
+// Built with the AVX2 kernel flags (apply_simd_kernel_flags in cmake/CompilerFlags.cmake).
+#include "simd_kernels.h"
+
+#include "pot/algorithms/sort_network.h"
+
+POT_INSTANTIATE_SIMD_KERNELS(pot::simd::SIMDType::AVX)
+
+namespace pot::algorithms::details
+{
+    template <typename T>
+    POT_SIMD_KERNEL void sort_network_leaf(T *first, std::size_t n)
+    {
+        sort_network<T>::sort_leaf(first, n);
+    }
+
+    template void sort_network_leaf<float>(float *, std::size_t);
+    template void sort_network_leaf<double>(double *, std::size_t);
+    template void sort_network_leaf<int32_t>(int32_t *, std::size_t);
+} // namespace pot::algorithms::details
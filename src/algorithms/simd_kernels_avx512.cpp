@@ -0,0 +1,4 @@
+// Built with the AVX-512 kernel flags (apply_simd_kernel_flags in cmake/CompilerFlags.cmake).
+#include "simd_kernels.h"
+
+POT_INSTANTIATE_SIMD_KERNELS(pot::simd::SIMDType::AVX512)
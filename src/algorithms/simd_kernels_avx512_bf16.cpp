@@ -0,0 +1,6 @@
+// Built with the AVX-512 kernel flags plus BF16 (apply_simd_kernel_flags in cmake/CompilerFlags.cmake).
+// Only the bfloat16 widening dot product uses `vdpbf16ps`; active_widening_dot_kernel picks it when the
+// CPU reports AVX512_BF16.
+#include "simd_kernels.h"
+
+POT_INSTANTIATE_AVX512_EXTENDED_KERNEL(widening_dot_kernel_avx512_bf16, pot::simd::bfloat16, float)
@@ -0,0 +1,7 @@
+// Built with the AVX-512 kernel flags plus VNNI (apply_simd_kernel_flags in cmake/CompilerFlags.cmake).
+// Only the 8-bit widening dot products use `vpdpbusd`; active_widening_dot_kernel picks them when the
+// CPU reports AVX512_VNNI.
+#include "simd_kernels.h"
+
+POT_INSTANTIATE_AVX512_EXTENDED_KERNEL(widening_dot_kernel_avx512_vnni, int8_t, int32_t)
+POT_INSTANTIATE_AVX512_EXTENDED_KERNEL(widening_dot_kernel_avx512_vnni, uint8_t, int32_t)
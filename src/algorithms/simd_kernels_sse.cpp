@@ -0,0 +1,4 @@
+// Built at the baseline flags.
+#include "simd_kernels.h"
+
+POT_INSTANTIATE_SIMD_KERNELS(pot::simd::SIMDType::SSE)
@@ -0,0 +1,8 @@
+#include "pot/coroutines/task.h"
+
+#include "pot/executors/executor.h"
+
+bool pot::coroutines::details::task_meta::steal() const
+{
+    return executor != nullptr && executor->try_steal();
+}
@@ -1,6 +1,7 @@
 #include "pot/executors/inline_executor.h"
 
-void pot::executors::inline_executor::derived_execute(pot::utils::unique_function_once&& func)
+void pot::executors::inline_executor::derived_execute(pot::utils::unique_function_once&& func,
+                                                      pot::coroutines::details::task_meta *)
 {
-    std::invoke(std::move(func));
+    func();
 }
@@ -13,7 +13,8 @@ pot::executors::thread_executor::~thread_executor()
     shutdown();
 }
 
-void pot::executors::thread_executor::derived_execute(pot::utils::unique_function_once&& func)
+void pot::executors::thread_executor::derived_execute(pot::utils::unique_function_once&& func,
+                                                      pot::coroutines::details::task_meta *)
 {
     {
         std::unique_lock<std::mutex> lock(m_queue_mtx);
@@ -40,7 +41,7 @@ void pot::executors::thread_executor::thread_loop()
 {
     while (true)
     {
-        std::function<void()> task;
+        pot::utils::unique_function_once task;
         {
             std::unique_lock<std::mutex> lock(m_queue_mtx);
             m_queue_cv.wait(lock, [this]()
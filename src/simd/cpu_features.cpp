@@ -0,0 +1,137 @@
+#include "pot/simd/cpu_features.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace
+{
+#if defined(__x86_64__) || defined(__i386__)
+uint64_t read_xcr0()
+{
+    // Inline asm rather than _xgetbv, which needs -mxsave.
+    uint32_t lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+}
+#endif
+
+// The extensions in `f` that kernels up to `simd_type` wide may use.
+pot::simd::cpu_features up_to(pot::simd::SIMDType simd_type, const pot::simd::cpu_features &f)
+{
+    const auto bits = pot::simd::details::bitness(simd_type);
+
+    pot::simd::cpu_features t;
+    t.sse41 = f.sse41;
+    if (bits >= pot::simd::details::bitness(pot::simd::SIMDType::AVX))
+    {
+        t.avx2 = f.avx2;
+        t.fma = f.fma;
+        t.f16c = f.f16c;
+    }
+    if (bits >= pot::simd::details::bitness(pot::simd::SIMDType::AVX512))
+    {
+        t.avx512f = f.avx512f;
+        t.avx512bw = f.avx512bw;
+        t.avx512vl = f.avx512vl;
+        t.avx512vnni = f.avx512vnni;
+        t.avx512bf16 = f.avx512bf16;
+    }
+    return t;
+}
+} // namespace
+
+pot::simd::cpu_features pot::simd::cpu_features::detect()
+{
+    cpu_features f;
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return f;
+
+    f.sse41 = (ecx & bit_SSE4_1) != 0;
+
+    const uint64_t xcr0 = (ecx & bit_OSXSAVE) ? read_xcr0() : 0;
+    const bool os_avx = (xcr0 & 0x06) == 0x06;    // XMM and YMM state
+    const bool os_avx512 = (xcr0 & 0xe6) == 0xe6; // plus opmask and ZMM state
+    const bool avx = os_avx && (ecx & bit_AVX) != 0;
+
+    f.fma = avx && (ecx & bit_FMA) != 0;
+    f.f16c = avx && (ecx & bit_F16C) != 0;
+
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    {
+        f.avx2 = avx && (ebx & bit_AVX2) != 0;
+        f.avx512f = os_avx512 && (ebx & bit_AVX512F) != 0;
+        f.avx512bw = f.avx512f && (ebx & bit_AVX512BW) != 0;
+        f.avx512vl = f.avx512f && (ebx & bit_AVX512VL) != 0;
+        f.avx512vnni = f.avx512f && (ecx & bit_AVX512VNNI) != 0;
+    }
+    if (__get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx))
+        f.avx512bf16 = f.avx512f && (eax & bit_AVX512BF16) != 0;
+#endif
+    return f;
+}
+
+const pot::simd::cpu_features &pot::simd::cpu_features::system()
+{
+    static const cpu_features features = detect();
+    return features;
+}
+
+bool pot::simd::cpu_features::covers(const cpu_features &required) const noexcept
+{
+    auto ok = [](bool have, bool need) { return have || !need; };
+    return ok(sse41, required.sse41) && ok(avx2, required.avx2) && ok(fma, required.fma) && ok(f16c, required.f16c) &&
+           ok(avx512f, required.avx512f) && ok(avx512bw, required.avx512bw) && ok(avx512vl, required.avx512vl) &&
+           ok(avx512vnni, required.avx512vnni) && ok(avx512bf16, required.avx512bf16);
+}
+
+std::optional<pot::simd::SIMDType> pot::simd::parse_simd_type(std::string_view name)
+{
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (lower == "sse")
+        return SIMDType::SSE;
+    if (lower == "avx")
+        return SIMDType::AVX;
+    if (lower == "avx512")
+        return SIMDType::AVX512;
+    return std::nullopt;
+}
+
+std::optional<pot::simd::SIMDType> pot::simd::simd_type_override()
+{
+    static const std::optional<SIMDType> limit = []() -> std::optional<SIMDType>
+    {
+        const char *value = std::getenv("POT_SIMD");
+        return value ? parse_simd_type(value) : std::nullopt;
+    }();
+    return limit;
+}
+
+pot::simd::SIMDType pot::simd::select_simd_type(const cpu_features &cpu, const cpu_features &compiled,
+                                                std::optional<SIMDType> limit)
+{
+    const auto limit_bits = limit ? details::bitness(*limit) : details::bitness(SIMDType::AVX512);
+
+    SIMDType selected = SIMDType::SSE;
+    for (SIMDType width : {SIMDType::SSE, SIMDType::AVX, SIMDType::AVX512})
+    {
+        const bool compiled_for = width == SIMDType::SSE   ? compiled.sse41
+                                  : width == SIMDType::AVX ? compiled.avx2
+                                                           : compiled.avx512f && compiled.avx512bw;
+        if (!compiled_for || !cpu.covers(up_to(width, compiled)) || details::bitness(width) > limit_bits)
+            break;
+        selected = width;
+    }
+    return selected;
+}
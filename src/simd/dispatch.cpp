@@ -0,0 +1,29 @@
+#include "pot/simd/dispatch.h"
+
+pot::simd::cpu_features pot::simd::kernel_features()
+{
+    // Every width is built with the extensions of the narrower ones, so the union is the
+    // feature set of the widest.
+    const cpu_features widths[] = {details::width_features<SIMDType::SSE>(), details::width_features<SIMDType::AVX>(),
+                                   details::width_features<SIMDType::AVX512>()};
+    cpu_features all;
+    for (const cpu_features &f : widths)
+    {
+        all.sse41 |= f.sse41;
+        all.avx2 |= f.avx2;
+        all.fma |= f.fma;
+        all.f16c |= f.f16c;
+        all.avx512f |= f.avx512f;
+        all.avx512bw |= f.avx512bw;
+        all.avx512vl |= f.avx512vl;
+        all.avx512vnni |= f.avx512vnni;
+        all.avx512bf16 |= f.avx512bf16;
+    }
+    return all;
+}
+
+pot::simd::SIMDType pot::simd::active_simd_type()
+{
+    static const SIMDType selected = select_simd_type(cpu_features::system(), kernel_features(), simd_type_override());
+    return selected;
+}
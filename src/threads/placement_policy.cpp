@@ -0,0 +1,121 @@
+#include "pot/threads/placement_policy.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+
+#include "pot/coroutines/task.h"
+
+namespace
+{
+using pot::utils::cpu_info;
+using pot::utils::cpu_topology;
+
+std::vector<int> compact_order(const cpu_topology &topology, bool first_thread_only)
+{
+    std::vector<cpu_info> cpus = topology.cpus();
+    std::sort(cpus.begin(), cpus.end(), [](const cpu_info &a, const cpu_info &b) {
+        return std::tie(a.package_id, a.core_id, a.smt_index, a.id) <
+               std::tie(b.package_id, b.core_id, b.smt_index, b.id);
+    });
+
+    std::vector<int> order;
+    for (const auto &cpu : cpus)
+    {
+        if (!first_thread_only || cpu.smt_index == 0)
+            order.push_back(cpu.id);
+    }
+    return order;
+}
+
+std::vector<int> scatter_order(const cpu_topology &topology)
+{
+    // package -> core -> hardware threads ordered by SMT index
+    std::map<int, std::map<int, std::map<int, int>>> layout;
+    int max_smt = 0;
+    size_t max_cores = 0;
+    for (const auto &cpu : topology.cpus())
+    {
+        layout[cpu.package_id][cpu.core_id][cpu.smt_index] = cpu.id;
+        max_smt = std::max(max_smt, cpu.smt_index);
+    }
+
+    std::vector<std::vector<const std::map<int, int> *>> cores_by_package;
+    for (const auto &[package, cores] : layout)
+    {
+        auto &list = cores_by_package.emplace_back();
+        for (const auto &[core, threads] : cores)
+            list.push_back(&threads);
+        max_cores = std::max(max_cores, list.size());
+    }
+
+    std::vector<int> order;
+    for (int smt = 0; smt <= max_smt; ++smt)
+    {
+        for (size_t rank = 0; rank < max_cores; ++rank)
+        {
+            for (const auto &cores : cores_by_package)
+            {
+                if (rank >= cores.size())
+                    continue;
+                if (auto it = cores[rank]->find(smt); it != cores[rank]->end())
+                    order.push_back(it->second);
+            }
+        }
+    }
+    return order;
+}
+
+std::vector<int> fastest_order(const cpu_topology &topology)
+{
+    std::vector<int> order;
+    for (int cpu : pot::coroutines::details::task_meta::sorted_cpu_list)
+    {
+        const auto &cpus = topology.cpus();
+        if (std::any_of(cpus.begin(), cpus.end(), [cpu](const cpu_info &info) { return info.id == cpu; }))
+            order.push_back(cpu);
+    }
+    return order;
+}
+} // namespace
+
+std::vector<int> pot::placement_policy::resolve(size_t num_threads, const pot::utils::cpu_topology &topology) const
+{
+    if (type == kind::none || num_threads == 0)
+        return {};
+
+    std::vector<int> order;
+    switch (type)
+    {
+    case kind::cpus:
+        if (cpu_list.empty())
+            throw std::invalid_argument("placement_policy: empty CPU list");
+        order = cpu_list;
+        break;
+    case kind::fastest_first:
+        order = fastest_order(topology);
+        if (order.empty())
+            order = compact_order(topology, false);
+        break;
+    case kind::compact:
+        order = compact_order(topology, false);
+        break;
+    case kind::physical_cores:
+        order = compact_order(topology, true);
+        break;
+    case kind::scatter:
+        order = scatter_order(topology);
+        break;
+    case kind::none:
+        break;
+    }
+
+    if (order.empty())
+        return {};
+
+    std::vector<int> result(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)
+        result[i] = order[i % order.size()];
+    return result;
+}
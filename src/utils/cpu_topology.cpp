@@ -0,0 +1,213 @@
+#include "pot/utils/cpu_topology.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "pot/utils/this_thread.h"
+
+namespace
+{
+bool read_first_line(const std::filesystem::path &path, std::string &line)
+{
+    std::ifstream file(path);
+    return file && std::getline(file, line);
+}
+
+int read_int(const std::filesystem::path &path, int fallback)
+{
+    std::string line;
+    if (!read_first_line(path, line))
+        return fallback;
+
+    try
+    {
+        return std::stoi(line);
+    }
+    catch (const std::exception &)
+    {
+        return fallback;
+    }
+}
+
+std::vector<int> list_numbered_directories(const std::filesystem::path &root, const std::string &prefix)
+{
+    std::vector<int> ids;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(root, ec))
+    {
+        const std::string name = entry.path().filename().string();
+        if (name.size() > prefix.size() && name.starts_with(prefix) &&
+            std::all_of(name.begin() + static_cast<std::ptrdiff_t>(prefix.size()), name.end(),
+                        [](unsigned char c) { return std::isdigit(c); }))
+            ids.push_back(std::stoi(name.substr(prefix.size())));
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+} // namespace
+
+std::vector<int> pot::utils::parse_cpu_list(const std::string &list)
+{
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string item;
+
+    while (std::getline(stream, item, ','))
+    {
+        std::erase_if(item, [](unsigned char c) { return std::isspace(c); });
+        if (item.empty())
+            continue;
+
+        try
+        {
+            const auto dash = item.find('-');
+            if (dash == std::string::npos)
+            {
+                cpus.push_back(std::stoi(item));
+            }
+            else
+            {
+                const int first = std::stoi(item.substr(0, dash));
+                const int last = std::stoi(item.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu)
+                    cpus.push_back(cpu);
+            }
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+pot::utils::cpu_topology::cpu_topology(std::vector<cpu_info> cpus) : m_cpus(std::move(cpus))
+{
+    std::sort(m_cpus.begin(), m_cpus.end(), [](const cpu_info &a, const cpu_info &b) { return a.id < b.id; });
+}
+
+pot::utils::cpu_topology pot::utils::cpu_topology::from_sysfs(const std::filesystem::path &root)
+{
+    std::vector<int> ids;
+    std::string online;
+    if (read_first_line(root / "online", online))
+        ids = parse_cpu_list(online);
+    else
+        ids = list_numbered_directories(root, "cpu");
+
+    std::map<int, int> node_of_cpu;
+    const auto node_root = root.parent_path() / "node";
+    for (int node : list_numbered_directories(node_root, "node"))
+    {
+        std::string cpulist;
+        if (read_first_line(node_root / ("node" + std::to_string(node)) / "cpulist", cpulist))
+        {
+            for (int cpu : parse_cpu_list(cpulist))
+                node_of_cpu[cpu] = node;
+        }
+    }
+
+    std::vector<cpu_info> cpus;
+    cpus.reserve(ids.size());
+    for (int id : ids)
+    {
+        const auto topology = root / ("cpu" + std::to_string(id)) / "topology";
+
+        cpu_info cpu;
+        cpu.id = id;
+        cpu.core_id = read_int(topology / "core_id", id);
+        cpu.package_id = std::max(0, read_int(topology / "physical_package_id", 0));
+        if (auto it = node_of_cpu.find(id); it != node_of_cpu.end())
+            cpu.numa_node = it->second;
+
+        std::string siblings_line;
+        if (read_first_line(topology / "thread_siblings_list", siblings_line))
+        {
+            const auto siblings = parse_cpu_list(siblings_line);
+            const auto it = std::find(siblings.begin(), siblings.end(), id);
+            if (it != siblings.end())
+                cpu.smt_index = static_cast<int>(it - siblings.begin());
+        }
+
+        cpus.push_back(cpu);
+    }
+
+    return cpu_topology(std::move(cpus));
+}
+
+const pot::utils::cpu_topology &pot::utils::cpu_topology::system()
+{
+    static const cpu_topology topology = []
+    {
+        auto result = from_sysfs();
+
+        const auto allowed = pot::this_thread::get_affinity();
+        if (!allowed.empty())
+            result = result.restricted_to(allowed);
+
+        if (result.empty())
+        {
+            std::vector<cpu_info> flat;
+            for (unsigned i = 0; i < std::max(1u, std::thread::hardware_concurrency()); ++i)
+                flat.push_back({static_cast<int>(i), static_cast<int>(i), 0, 0, 0});
+            result = cpu_topology(std::move(flat));
+        }
+        return result;
+    }();
+    return topology;
+}
+
+size_t pot::utils::cpu_topology::physical_core_count() const
+{
+    std::set<std::pair<int, int>> cores;
+    for (const auto &cpu : m_cpus)
+        cores.emplace(cpu.package_id, cpu.core_id);
+    return cores.size();
+}
+
+size_t pot::utils::cpu_topology::package_count() const
+{
+    std::set<int> packages;
+    for (const auto &cpu : m_cpus)
+        packages.insert(cpu.package_id);
+    return packages.size();
+}
+
+std::vector<int> pot::utils::cpu_topology::numa_nodes() const
+{
+    std::set<int> nodes;
+    for (const auto &cpu : m_cpus)
+        nodes.insert(cpu.numa_node);
+    return {nodes.begin(), nodes.end()};
+}
+
+std::vector<int> pot::utils::cpu_topology::cpus_on_node(int node) const
+{
+    std::vector<int> cpus;
+    for (const auto &cpu : m_cpus)
+    {
+        if (cpu.numa_node == node)
+            cpus.push_back(cpu.id);
+    }
+    return cpus;
+}
+
+pot::utils::cpu_topology pot::utils::cpu_topology::restricted_to(const std::vector<int> &allowed) const
+{
+    std::vector<cpu_info> cpus;
+    for (const auto &cpu : m_cpus)
+    {
+        if (std::find(allowed.begin(), allowed.end(), cpu.id) != allowed.end())
+            cpus.push_back(cpu);
+    }
+    return cpu_topology(std::move(cpus));
+}
@@ -6,6 +6,10 @@
 #include "pot/traits/compare.h"
 #include "pot/utils/platform.h"
 
+#if defined(POT_PLATFORM_LINUX) || defined(POT_PLATFORM_ANDROID)
+#include <sched.h>
+#endif
+
 void pot::details::this_thread::init_thread_variables(const int64_t local_id,
                                                       executor *owner_executor)
 {
@@ -88,7 +92,6 @@ void pot::this_thread::set_name(const std::string &name)
 void pot::this_thread::yield() { std::this_thread::yield(); }
 
 #if defined(POT_PLATFORM_LINUX) || defined(POT_PLATFORM_ANDROID)
-
 bool pot::this_thread::set_params(int policy, int priority)
 {
     if (policy != SCHED_OTHER && policy != SCHED_FIFO && policy != SCHED_RR)
@@ -135,4 +138,65 @@ std::pair<int, int> pot::this_thread::get_params()
     return {policy, param.sched_priority};
 }
 
+bool pot::this_thread::set_affinity(const std::vector<int> &cpus)
+{
+    if (cpus.empty())
+    {
+        errno = EINVAL;
+        return false;
+    }
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int cpu : cpus)
+    {
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            errno = EINVAL;
+            return false;
+        }
+        CPU_SET(static_cast<size_t>(cpu), &cpuset);
+    }
+
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    if (err != 0)
+    {
+        errno = err;
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<int> pot::this_thread::get_affinity()
+{
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+
+    int err = pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    if (err != 0)
+    {
+        errno = err;
+        return {};
+    }
+
+    std::vector<int> cpus;
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &cpuset))
+            cpus.push_back(static_cast<int>(cpu));
+    }
+    return cpus;
+}
+
+int pot::this_thread::current_cpu() { return sched_getcpu(); }
+
+#else
+
+bool pot::this_thread::set_affinity(const std::vector<int> &) { return false; }
+
+std::vector<int> pot::this_thread::get_affinity() { return {}; }
+
+int pot::this_thread::current_cpu() { return -1; }
+
 #endif
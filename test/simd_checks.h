@@ -0,0 +1,727 @@
+#pragma once
+
+// Checks of the SIMD code that take the width as a template parameter. The main test executable
+// runs them at SSE and Auto; test_simd_widths.cpp runs them again at the width its executable is
+// built for.
+
+#include <catch2/catch_message.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "pot/algorithms/dot.h"
+#include "pot/algorithms/filter.h"
+#include "pot/algorithms/reduce.h"
+#include "pot/algorithms/scan.h"
+#include "pot/executors/inline_executor.h"
+#include "pot/simd/simd_forced.h"
+
+namespace simd_checks
+{
+using pot::simd::SIMDType;
+
+// Scan
+
+template <SIMDType... Ws, typename Executor>
+void scan_simd_blocks(Executor &pool, std::span<const size_t> sizes)
+{
+    auto simd_add = [](auto a, auto b) { return a + b; };
+
+    for (size_t n : sizes)
+    {
+        std::vector<int> in(n);
+        for (size_t i = 0; i < n; ++i)
+            in[i] = static_cast<int>(i % 17) - 8;
+
+        std::vector<int> inclusive(n), exclusive(n);
+        std::inclusive_scan(in.begin(), in.end(), inclusive.begin());
+        std::exclusive_scan(in.begin(), in.end(), exclusive.begin(), 0);
+
+        // Small integers stay exact in float and double, so the reordered sums compare equal.
+        std::vector<double> inclusive_d(n);
+        std::inclusive_scan(in.begin(), in.end(), inclusive_d.begin(), std::plus<>{}, 0.0);
+        std::vector<float> exclusive_f(n);
+        std::exclusive_scan(in.begin(), in.end(), exclusive_f.begin(), 0.0f);
+
+        auto check = [&]<SIMDType W>()
+        {
+            std::vector<int> out(n);
+            pot::algorithms::inclusive_scan_simd<int, W>(pool, in.data(), out.data(), n, simd_add, std::plus<>{}, 0)
+                .get(&pool);
+            REQUIRE(out == inclusive);
+
+            pot::algorithms::exclusive_scan_simd<int, W>(pool, in.data(), out.data(), n, simd_add, std::plus<>{}, 0)
+                .get(&pool);
+            REQUIRE(out == exclusive);
+
+            std::vector<double> in_d(in.begin(), in.end());
+            pot::algorithms::inclusive_scan_simd<double, W>(pool, in_d.data(), in_d.data(), n, simd_add, std::plus<>{}, 0.0)
+                .get(&pool);
+            REQUIRE(in_d == inclusive_d);
+
+            std::vector<float> in_f(in.begin(), in.end()), out_f(n);
+            pot::algorithms::exclusive_scan_simd<float, W>(pool, in_f.data(), out_f.data(), n, simd_add, std::plus<>{}, 0.0f)
+                .get(&pool);
+            REQUIRE(out_f == exclusive_f);
+        };
+        (check.template operator()<Ws>(), ...);
+    }
+}
+
+// Reduce
+
+template <SIMDType W, typename Executor>
+void compensated_summation(Executor &pool)
+{
+    // A long sum of identical terms: every addition rounds, so a plain running sum drifts.
+    const std::vector<float> ones(1 << 20, 1.0f), tenths(1 << 20, 0.1f);
+    const double exact = static_cast<double>(0.1f) * static_cast<double>(ones.size());
+
+    auto error = [&](pot::algorithms::summation method)
+    {
+        const pot::algorithms::reproducible mode{std::size_t(1) << 20, method};
+        const float r = pot::algorithms::dot_simd<float, W>(pool, ones.data(), tenths.data(), ones.size(), mode)
+                            .get(&pool);
+        return std::abs(static_cast<double>(r) - exact);
+    };
+
+    const double naive = error(pot::algorithms::summation::naive);
+    REQUIRE(error(pot::algorithms::summation::pairwise) < naive);
+    REQUIRE(error(pot::algorithms::summation::kahan) < naive);
+    REQUIRE(error(pot::algorithms::summation::kahan) / exact < 1e-6);
+}
+
+inline bool close(double value, double expected, double tolerance)
+{
+    return std::abs(value - expected) <= tolerance * std::max(1.0, std::abs(expected));
+}
+
+template <SIMDType... Ws, typename Executor>
+void column_dots(Executor &pool, std::mt19937 &rng)
+{
+    const size_t rows = 10'007, cols = 13;
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> m(rows * cols);
+    std::vector<float> mf(m.size());
+    for (size_t i = 0; i < m.size(); ++i)
+        mf[i] = static_cast<float>(m[i] = dist(rng));
+
+    for (size_t c = 0; c < cols; ++c)
+    {
+        double expected = 0.0;
+        for (size_t r = 0; r < rows; ++r)
+            expected += m[r * cols + c] * m[r * cols + c];
+
+        REQUIRE(close(pot::algorithms::dot_strided(pool, m.data() + c, cols, m.data() + c, cols, rows).get(&pool),
+                      expected, 1e-12));
+        auto check = [&]<SIMDType W>()
+        {
+            REQUIRE(close(pot::algorithms::dot_strided_simd<double, W>(pool, m.data() + c, cols, m.data() + c, cols, rows)
+                        .get(&pool), expected, 1e-12));
+            REQUIRE(close(pot::algorithms::dot_strided_simd<float, W>(pool, mf.data() + c, cols, mf.data() + c, cols, rows)
+                        .get(&pool), expected, 1e-4));
+        };
+        (check.template operator()<Ws>(), ...);
+    }
+
+    // Column against a contiguous vector, and a zero stride broadcasting one element.
+    std::vector<double> v(rows, 0.5);
+    double expected = 0.0;
+    for (size_t r = 0; r < rows; ++r)
+        expected += m[r * cols + 3] * 0.5;
+    auto broadcast = [&]<SIMDType W>()
+    {
+        REQUIRE(close(pot::algorithms::dot_strided_simd<double, W>(pool, m.data() + 3, cols, v.data(), 0, rows).get(&pool),
+                      expected, 1e-12));
+        REQUIRE(pot::algorithms::dot_strided_simd<double, W>(pool, m.data(), cols, v.data(), 1, 0).get(&pool) == 0.0);
+    };
+    (broadcast.template operator()<Ws>(), ...);
+}
+
+template <SIMDType... Ws, typename Executor>
+void integer_strides(Executor &pool, std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int32_t> dist(-1000, 1000);
+    for (size_t n : {size_t(1), size_t(7), size_t(8), size_t(9), size_t(50'001)})
+    {
+        std::vector<int32_t> a(n * 3), b(n * 5);
+        for (auto &x : a) x = dist(rng);
+        for (auto &x : b) x = dist(rng);
+
+        int32_t expected = 0, max_expected = std::numeric_limits<int32_t>::min();
+        for (size_t i = 0; i < n; ++i)
+        {
+            expected += a[i * 3] * b[i * 5];
+            max_expected = std::max(max_expected, a[i * 3] + b[i * 5]);
+        }
+
+        REQUIRE(pot::algorithms::dot_strided(pool, a.data(), 3, b.data(), 5, n).get(&pool) == expected);
+        auto check = [&]<SIMDType W>()
+        { REQUIRE(pot::algorithms::dot_strided_simd<int32_t, W>(pool, a.data(), 3, b.data(), 5, n).get(&pool) == expected); };
+        (check.template operator()<Ws>(), ...);
+
+        const int32_t max_sum = pot::algorithms::elementwise_reduce_strided(
+            pool, a.data(), 3, b.data(), 5, n, std::plus<int32_t>{},
+            [](int32_t x, int32_t y) { return std::max(x, y); }, std::numeric_limits<int32_t>::min()).get(&pool);
+        REQUIRE(max_sum == max_expected);
+    }
+}
+
+template <SIMDType... Ws, typename Executor>
+void sparse_dots(Executor &pool, std::mt19937 &rng)
+{
+    const size_t dense_size = 100'000, nnz = 20'011;
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::uniform_int_distribution<uint32_t> pick(0, dense_size - 1);
+
+    std::vector<float> x(dense_size), values(nnz);
+    std::vector<int32_t> xi(dense_size), values_i(nnz);
+    std::vector<uint32_t> idx(nnz);
+    for (size_t i = 0; i < dense_size; ++i)
+    {
+        x[i] = dist(rng);
+        xi[i] = static_cast<int32_t>(i % 201) - 100;
+    }
+
+    double expected = 0.0;
+    int32_t expected_i = 0;
+    for (size_t i = 0; i < nnz; ++i)
+    {
+        idx[i] = pick(rng);
+        values[i] = dist(rng);
+        values_i[i] = static_cast<int32_t>(i % 7) - 3;
+        expected += static_cast<double>(values[i]) * x[idx[i]];
+        expected_i += values_i[i] * xi[idx[i]];
+    }
+
+    // Gathering a subset of a vector against itself: the sum of squares of the picked elements.
+    double squares = 0.0;
+    for (size_t i = 0; i < 5; ++i)
+        squares += static_cast<double>(x[idx[i]]) * x[idx[i]];
+
+    REQUIRE(close(pot::algorithms::dot_indexed(pool, values.data(), x.data(), idx.data(), nnz).get(&pool), expected, 1e-3));
+    auto check = [&]<SIMDType W>()
+    {
+        REQUIRE(close(pot::algorithms::dot_indexed_simd<float, W>(pool, values.data(), x.data(), idx.data(), nnz).get(&pool),
+                      expected, 1e-3));
+        REQUIRE(pot::algorithms::dot_indexed_simd<int32_t, W>(pool, values_i.data(), xi.data(), idx.data(), nnz)
+                    .get(&pool) == expected_i);
+
+        const float picked = pot::algorithms::elementwise_reduce_indexed_simd<float, float, W>(
+            pool, values.data(), x.data(), idx.data(), 5,
+            [&](const auto &, const auto &y) { return y * y; }, std::plus<float>{}, 0.0f).get(&pool);
+        REQUIRE(close(picked, squares, 1e-5));
+    };
+    (check.template operator()<Ws>(), ...);
+}
+
+// Dot
+
+template <SIMDType... Ws, typename Executor>
+void float_to_double(Executor &pool, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> a(1'000'003), b(a.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = dist(rng);
+        b[i] = dist(rng) * 1e4f;
+    }
+
+    double expected = 0.0;
+    for (size_t i = 0; i < a.size(); ++i)
+        expected += static_cast<double>(a[i]) * b[i];
+
+    const double scalar = pot::algorithms::dot<float, double>(pool, a.data(), b.data(), a.size()).get(&pool);
+    REQUIRE(std::abs(scalar - expected) < 1e-6);
+
+    auto check = [&]<SIMDType W>()
+    {
+        const double wide = pot::algorithms::dot_simd<float, double, W>(pool, std::span<const float>(a),
+                                                                        std::span<const float>(b))
+                                .get(&pool);
+        REQUIRE(std::abs(wide - expected) < 1e-6);
+
+        const float narrow = pot::algorithms::dot_simd<float, W>(pool, a.data(), b.data(), a.size()).get(&pool);
+        REQUIRE(std::abs(wide - expected) < std::abs(static_cast<double>(narrow) - expected));
+    };
+    (check.template operator()<Ws>(), ...);
+}
+
+template <typename In, SIMDType... Ws, typename Executor>
+void integer_widening(Executor &pool, std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> dist(std::numeric_limits<In>::min(), std::numeric_limits<In>::max());
+    for (size_t n : {size_t(0), size_t(1), size_t(63), size_t(200'001)})
+    {
+        // int16 products are large: keep the int32 sum in range.
+        const size_t count = std::is_same_v<In, int16_t> ? std::min<size_t>(n, 1000) : n;
+        std::vector<In> a(count), b(count);
+        int32_t expected = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            a[i] = static_cast<In>(dist(rng));
+            b[i] = static_cast<In>(dist(rng));
+            expected += int32_t(a[i]) * int32_t(b[i]);
+        }
+
+        REQUIRE(pot::algorithms::dot<In, int32_t>(pool, a.data(), b.data(), count).get(&pool) == expected);
+        auto check = [&]<SIMDType W>()
+        { REQUIRE(pot::algorithms::dot_simd<In, int32_t, W>(pool, a.data(), b.data(), count).get(&pool) == expected); };
+        (check.template operator()<Ws>(), ...);
+    }
+}
+
+template <SIMDType... Ws, typename Executor>
+void widening_extremes(Executor &pool)
+{
+    // pmaddubsw would saturate here, the widening kernels must not.
+    const std::vector<int8_t> lo(4096, -128);
+    const std::vector<uint8_t> hi(4096, 255);
+    auto check = [&]<SIMDType W>()
+    {
+        REQUIRE(pot::algorithms::dot_simd<int8_t, int32_t, W>(pool, std::span<const int8_t>(lo), std::span<const int8_t>(lo))
+                    .get(&pool) == 4096 * 128 * 128);
+        REQUIRE(pot::algorithms::dot_simd<uint8_t, int32_t, W>(pool, hi.data(), hi.data(), hi.size()).get(&pool) ==
+                4096 * 255 * 255);
+    };
+    (check.template operator()<Ws>(), ...);
+}
+
+template <SIMDType... Ws>
+void widening_biased_sum()
+{
+    // The VNNI int8 kernel sums (a + 128) * b and subtracts 128 * sum(b) at the end. With a mostly 0
+    // and b = 127 the biased lane sums pass INT32_MAX inside one block, while the dot itself fits.
+    pot::executors::inline_executor exec("biased");
+    const size_t n = 6'000'000;
+    std::vector<int8_t> a(n), b(n, 127);
+    int64_t expected = 0;
+    for (size_t i = 0; i < n; i += 4)
+    {
+        a[i] = 1;
+        expected += 127;
+    }
+    REQUIRE(expected <= std::numeric_limits<int32_t>::max());
+
+    auto check = [&]<SIMDType W>()
+    { REQUIRE(pot::algorithms::dot_simd<int8_t, int32_t, W>(exec, a.data(), b.data(), n).get() == expected); };
+    (check.template operator()<Ws>(), ...);
+}
+
+template <typename In, SIMDType... Ws, typename Executor>
+void half_float_widening(Executor &pool, std::mt19937 &rng, float tolerance)
+{
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<In> a(100'003), b(a.size());
+    double expected = 0.0;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = In(dist(rng));
+        b[i] = In(dist(rng));
+        expected += static_cast<double>(static_cast<float>(a[i])) * static_cast<float>(b[i]);
+    }
+
+    REQUIRE(std::abs(pot::algorithms::dot<In, float>(pool, a.data(), b.data(), a.size()).get(&pool) - expected) < tolerance);
+    auto check = [&]<SIMDType W>()
+    {
+        REQUIRE(std::abs(pot::algorithms::dot_simd<In, float, W>(pool, a.data(), b.data(), a.size()).get(&pool) - expected) <
+                tolerance);
+    };
+    (check.template operator()<Ws>(), ...);
+}
+
+// SIMD types
+
+template <SIMDType W>
+void partial_loads()
+{
+    auto check = []<typename T>()
+    {
+        using simd_t = pot::simd::simd_forced<T, W>;
+        constexpr size_t lanes = pot::simd::details::simd_traits<T, W>::scalar_count;
+
+        std::vector<T> src(lanes), dst(lanes + 1);
+        for (size_t k = 0; k < lanes; ++k)
+            src[k] = static_cast<T>(k + 1);
+
+        for (size_t count = 0; count <= lanes; ++count)
+        {
+            T lane[lanes];
+            simd_t v; v.loadu(src.data(), count);
+            v.storeu(lane);
+            for (size_t k = 0; k < lanes; ++k)
+                REQUIRE(lane[k] == (k < count ? src[k] : T(0)));
+
+            std::fill(dst.begin(), dst.end(), T(-1));
+            simd_t(T(7)).storeu(dst.data(), count);
+            for (size_t k = 0; k <= lanes; ++k)
+                REQUIRE(dst[k] == (k < count ? T(7) : T(-1)));
+
+            simd_t(T(3)).first(count, simd_t(T(5))).storeu(lane);
+            for (size_t k = 0; k < lanes; ++k)
+                REQUIRE(lane[k] == (k < count ? T(3) : T(5)));
+        }
+    };
+    check.template operator()<float>();
+    check.template operator()<double>();
+    check.template operator()<int32_t>();
+    check.template operator()<uint32_t>();
+}
+
+// Reductions of length `n` whose tails end mid-vector; returns a float dot for comparing widths.
+template <SIMDType W, typename Executor>
+float short_vectors(Executor &pool, size_t n)
+{
+    std::vector<int> a(n), b(n);
+    std::vector<int8_t> q(n);
+    std::vector<float> f(n);
+    int expected = 0;
+    int32_t expected_q = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = static_cast<int>(i % 11) - 5;
+        b[i] = static_cast<int>(i % 7) - 3;
+        q[i] = static_cast<int8_t>(i * 37 % 255 - 127);
+        f[i] = static_cast<float>(i % 9) * 0.1f;
+        expected += a[i] * b[i];
+        expected_q += q[i] * q[i];
+    }
+
+    // The +1 maps the zero-filled lanes to 1, so a tail that leaks shows up in the count.
+    auto count_and_dot = [](auto x, auto y) { return x * y + decltype(x)(1); };
+
+    REQUIRE(pot::algorithms::dot_simd<int, W>(pool, a.data(), b.data(), n).get(&pool) == expected);
+    REQUIRE(pot::algorithms::elementwise_reduce_simd<int, int, W>(pool, a.data(), b.data(), n, count_and_dot,
+                                                                  std::plus<int>{}, 0)
+                .get(&pool) == expected + static_cast<int>(n));
+    REQUIRE(pot::algorithms::dot_strided_simd<int, W>(pool, a.data(), 1, b.data(), 1, n).get(&pool) == expected);
+    REQUIRE(pot::algorithms::dot_simd<int8_t, int32_t, W>(pool, q.data(), q.data(), n).get(&pool) == expected_q);
+    return pot::algorithms::dot_simd<float, W>(pool, f.data(), f.data(), n, {}).get(&pool);
+}
+
+template <SIMDType W>
+void transcendentals()
+{
+    // Distance to the long double reference in units of the lane type's last place.
+    auto ulps = []<typename T>(T got, long double ref) -> double
+    {
+        if (std::isnan(ref))
+            return std::isnan(got) ? 0.0 : 1e9;
+        if (std::isinf(static_cast<T>(ref)))
+            return got == static_cast<T>(ref) ? 0.0 : 1e9;
+        if (!std::isfinite(got))
+            return 1e9;
+        int exponent = 0;
+        std::frexp(ref, &exponent);
+        const long double ulp = std::max(std::ldexp(1.0L, exponent - std::numeric_limits<T>::digits),
+                                         static_cast<long double>(std::numeric_limits<T>::denorm_min()));
+        return static_cast<double>(std::fabs(static_cast<long double>(got) - ref) / ulp);
+    };
+
+    auto check = [&]<typename T>()
+    {
+        using simd_t = pot::simd::simd_forced<T, W>;
+        constexpr size_t lanes = pot::simd::details::simd_traits<T, W>::scalar_count;
+        constexpr bool is_float = std::is_same_v<T, float>;
+        std::mt19937_64 gen(23);
+
+        // Max error of `f` over `samples` inputs from [lo, hi], log-uniform with random sign when `log_scale`.
+        auto max_ulps = [&](auto f, auto ref, double lo, double hi, bool log_scale)
+        {
+            std::uniform_real_distribution<double> dist(log_scale ? std::log(lo) : lo, log_scale ? std::log(hi) : hi);
+            double worst = 0.0;
+            for (size_t i = 0; i < 20000; i += lanes)
+            {
+                T in[lanes], out[lanes];
+                for (size_t k = 0; k < lanes; ++k)
+                    in[k] = static_cast<T>(log_scale ? std::exp(dist(gen)) * ((gen() & 1) ? 1 : -1) : dist(gen));
+                simd_t v;
+                v.loadu(in);
+                f(v).storeu(out);
+                for (size_t k = 0; k < lanes; ++k)
+                    worst = std::max(worst, ulps(out[k], ref(static_cast<long double>(in[k]))));
+            }
+            return worst;
+        };
+
+        const double tiny = is_float ? 1e-44 : 1e-320;
+        const double huge = static_cast<double>(std::numeric_limits<T>::max());
+        const double exp_hi = is_float ? 89.0 : 710.0;
+
+        auto exp = [](simd_t v) { return v.exp(); };
+        auto log = [](simd_t v) { return v.log(); };
+        auto log2 = [](simd_t v) { return v.log2(); };
+        auto sin = [](simd_t v) { return v.sin(); };
+        auto cos = [](simd_t v) { return v.cos(); };
+        auto tanh = [](simd_t v) { return v.tanh(); };
+        auto erf = [](simd_t v) { return v.erf(); };
+        auto sigmoid = [](simd_t v) { return v.sigmoid(); };
+
+        CHECK(max_ulps(exp, [](long double x) { return expl(x); }, -1.0, 1.0, false) <= 1.5);
+        CHECK(max_ulps(exp, [](long double x) { return expl(x); }, is_float ? -110.0 : -750.0, exp_hi, false) <= 1.5);
+        CHECK(max_ulps(log, [](long double x) { return logl(x); }, 0.0, 4.0, false) <= 1.0);
+        CHECK(max_ulps(log, [](long double x) { return logl(x); }, tiny, huge, true) <= 1.0);
+        CHECK(max_ulps(log2, [](long double x) { return log2l(x); }, 0.0, 4.0, false) <= 2.0);
+        CHECK(max_ulps(log2, [](long double x) { return log2l(x); }, tiny, huge, true) <= 2.0);
+        CHECK(max_ulps(sin, [](long double x) { return sinl(x); }, -10.0, 10.0, false) <= 2.5);
+        CHECK(max_ulps(sin, [](long double x) { return sinl(x); }, 1e-30, 1e7, true) <= 2.5);
+        CHECK(max_ulps(cos, [](long double x) { return cosl(x); }, -10.0, 10.0, false) <= 2.5);
+        CHECK(max_ulps(cos, [](long double x) { return cosl(x); }, 1e-30, 1e7, true) <= 2.5);
+        CHECK(max_ulps(tanh, [](long double x) { return tanhl(x); }, -25.0, 25.0, false) <= 3.0);
+        CHECK(max_ulps(tanh, [](long double x) { return tanhl(x); }, 1e-30, 1.0, true) <= 3.0);
+        CHECK(max_ulps(erf, [](long double x) { return erfl(x); }, -7.0, 7.0, false) <= 3.0);
+        CHECK(max_ulps(erf, [](long double x) { return erfl(x); }, 1e-30, 1.0, true) <= 3.0);
+        CHECK(max_ulps(sigmoid, [](long double x) { return 1.0L / (1.0L + expl(-x)); }, -120.0, 120.0, false) <= 2.5);
+
+        // Edge inputs: zeros, infinities, NaN, subnormals, overflow and underflow of exp.
+        const T inf = std::numeric_limits<T>::infinity();
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        const T edges[] = {T(0), T(-0.0), inf, -inf, nan, std::numeric_limits<T>::denorm_min(),
+                           std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), T(-1), T(exp_hi), T(-exp_hi - 50)};
+        auto edge = [&](auto f, auto ref)
+        {
+            for (T x : edges)
+            {
+                T out[lanes];
+                f(simd_t(x)).storeu(out);
+                const T expected = ref(x);
+                INFO("x = " << x);
+                REQUIRE(ulps(out[0], static_cast<long double>(expected)) <= 1.0);
+                if (expected == T(0))
+                    REQUIRE(std::signbit(out[0]) == std::signbit(expected));
+            }
+        };
+        edge(exp, [](T x) { return std::exp(x); });
+        edge(log, [](T x) { return std::log(x); });
+        edge(log2, [](T x) { return std::log2(x); });
+        edge(sin, [](T x) { return std::sin(x); });
+        edge(cos, [](T x) { return std::cos(x); });
+        edge(tanh, [](T x) { return std::tanh(x); });
+        edge(erf, [](T x) { return std::erf(x); });
+        edge(sigmoid, [](T x) { return T(1) / (T(1) + std::exp(-x)); });
+    };
+    check.template operator()<float>();
+    check.template operator()<double>();
+}
+
+template <SIMDType W>
+void fused_ops()
+{
+    auto check = []<typename T>()
+    {
+        using simd_t = pot::simd::simd_forced<T, W>;
+        constexpr size_t lanes = simd_t::lanes;
+
+        std::vector<T> a(lanes), b(lanes), c(lanes), out(lanes);
+        for (size_t k = 0; k < lanes; ++k)
+        {
+            a[k] = static_cast<T>(static_cast<int>(k) - 3);
+            b[k] = static_cast<T>(2 * k + 1);
+            c[k] = static_cast<T>(7 - static_cast<int>(k));
+        }
+        simd_t va, vb, vc;
+        va.loadu(a.data()); vb.loadu(b.data()); vc.loadu(c.data());
+
+        va.fma(vb, vc).storeu(out.data());
+        for (size_t k = 0; k < lanes; ++k)
+            REQUIRE(out[k] == static_cast<T>(a[k] * b[k] + c[k]));
+        va.fms(vb, vc).storeu(out.data());
+        for (size_t k = 0; k < lanes; ++k)
+            REQUIRE(out[k] == static_cast<T>(a[k] * b[k] - c[k]));
+        va.fnma(vb, vc).storeu(out.data());
+        for (size_t k = 0; k < lanes; ++k)
+            REQUIRE(out[k] == static_cast<T>(c[k] - a[k] * b[k]));
+    };
+    check.template operator()<float>();
+    check.template operator()<double>();
+    check.template operator()<int32_t>();
+
+    // (1 + 2^-12)^2 - 1 keeps the 2^-24 term only when the product is not rounded first.
+    using simd_t = pot::simd::simd_forced<float, W>;
+    const float e = std::ldexp(1.0f, -12);
+    const simd_t x(1.0f + e);
+    const float fused = x.fma(x, simd_t(-1.0f)).sum() / static_cast<float>(simd_t::lanes);
+#if defined(__FMA__)
+    REQUIRE(fused == 2 * e + e * e);
+#else
+    REQUIRE(fused == 2 * e);
+#endif
+}
+
+template <SIMDType W>
+void horizontal_reductions()
+{
+    auto check = []<typename T>()
+    {
+        using simd_t = pot::simd::simd_forced<T, W>;
+        constexpr size_t lanes = simd_t::lanes;
+
+        // Every lane position takes a turn at holding the extreme values.
+        for (size_t hot = 0; hot < lanes; ++hot)
+        {
+            std::vector<T> v(lanes);
+            for (size_t k = 0; k < lanes; ++k)
+                v[k] = static_cast<T>(k % 5 + 10);
+            v[hot] = std::numeric_limits<T>::max() / 4;
+            v[(hot + 1) % lanes] = std::is_signed_v<T> ? static_cast<T>(-3) : static_cast<T>(1);
+
+            simd_t x; x.loadu(v.data());
+            REQUIRE(x.max() == *std::max_element(v.begin(), v.end()));
+            REQUIRE(x.min() == *std::min_element(v.begin(), v.end()));
+            REQUIRE(x.sum() == std::accumulate(v.begin(), v.end(), T{0}));
+        }
+    };
+    check.template operator()<float>();
+    check.template operator()<double>();
+    check.template operator()<int32_t>();
+    check.template operator()<uint32_t>();
+    check.template operator()<int64_t>();
+
+    using acc_t = pot::simd::simd_forced<int32_t, W>;
+    pot::simd::accumulators<acc_t, 4> acc;
+    STATIC_REQUIRE(acc.stride == 4 * acc_t::lanes);
+
+    std::vector<int32_t> data(100);
+    std::iota(data.begin(), data.end(), 1);
+    size_t i = 0;
+    for (; i + acc.stride <= data.size(); i += acc.stride)
+        acc.each([&](acc_t &sum, size_t k) { acc_t x; x.loadu(data.data() + i + k * acc_t::lanes); sum += x; });
+    int32_t total = acc.total().sum();
+    for (; i < data.size(); ++i)
+        total += data[i];
+    REQUIRE(total == 5050);
+}
+
+template <SIMDType W>
+void comparison_masks()
+{
+    auto check = []<typename T>()
+    {
+        using simd_t = pot::simd::simd_forced<T, W>;
+        using mask_t = typename simd_t::mask;
+        constexpr size_t lanes = simd_t::lanes;
+
+        std::mt19937 gen(7);
+        // Few distinct values, so equal lanes are common; unsigned extremes check the order.
+        const std::array<T, 5> values = {std::numeric_limits<T>::lowest(), static_cast<T>(0), static_cast<T>(1),
+                                         static_cast<T>(std::numeric_limits<T>::max() / 2), std::numeric_limits<T>::max()};
+        std::uniform_int_distribution<size_t> pick(0, values.size() - 1);
+
+        for (int round = 0; round < 50; ++round)
+        {
+            std::vector<T> a(lanes), b(lanes), out(lanes + 1);
+            for (size_t k = 0; k < lanes; ++k)
+            {
+                a[k] = values[pick(gen)];
+                b[k] = values[pick(gen)];
+            }
+            simd_t va, vb;
+            va.loadu(a.data());
+            vb.loadu(b.data());
+
+            auto expect = [&](auto cmp)
+            {
+                uint64_t bits = 0;
+                for (size_t k = 0; k < lanes; ++k)
+                    if (cmp(a[k], b[k]))
+                        bits |= uint64_t(1) << k;
+                return bits;
+            };
+            REQUIRE((va == vb).movemask() == expect(std::equal_to<T>{}));
+            REQUIRE((va != vb).movemask() == expect(std::not_equal_to<T>{}));
+            REQUIRE((va < vb).movemask() == expect(std::less<T>{}));
+            REQUIRE((va <= vb).movemask() == expect(std::less_equal<T>{}));
+            REQUIRE((va > vb).movemask() == expect(std::greater<T>{}));
+            REQUIRE((va >= vb).movemask() == expect(std::greater_equal<T>{}));
+
+            const mask_t lt = va < vb, eq = va == vb;
+            REQUIRE((lt | eq).movemask() == (va <= vb).movemask());
+            REQUIRE((lt & eq).none());
+            REQUIRE((lt ^ ~lt).all());
+            REQUIRE(lt.popcount() == static_cast<size_t>(std::popcount(lt.movemask())));
+            REQUIRE(lt.any() == (lt.movemask() != 0));
+
+            select(lt, va, vb).storeu(out.data());
+            for (size_t k = 0; k < lanes; ++k)
+                REQUIRE(out[k] == std::min(a[k], b[k]));
+
+            // compress_store writes exactly the selected lanes, in order.
+            const T sentinel = static_cast<T>(42);
+            std::fill(out.begin(), out.end(), sentinel);
+            const size_t written = va.compress_store(out.data(), lt);
+            std::vector<T> expected;
+            for (size_t k = 0; k < lanes; ++k)
+                if (a[k] < b[k])
+                    expected.push_back(a[k]);
+            REQUIRE(written == expected.size());
+            REQUIRE(std::equal(expected.begin(), expected.end(), out.begin()));
+            REQUIRE(std::all_of(out.begin() + static_cast<std::ptrdiff_t>(written), out.end(),
+                                [&](T x) { return x == sentinel; }));
+        }
+
+        for (size_t count = 0; count <= lanes; ++count)
+            REQUIRE(mask_t::first(count).popcount() == count);
+        REQUIRE(mask_t(true).all());
+        REQUIRE(mask_t(false).none());
+    };
+    check.template operator()<float>();
+    check.template operator()<double>();
+    check.template operator()<int8_t>();
+    check.template operator()<uint8_t>();
+    check.template operator()<int16_t>();
+    check.template operator()<uint16_t>();
+    check.template operator()<int32_t>();
+    check.template operator()<uint32_t>();
+    check.template operator()<int64_t>();
+    check.template operator()<uint64_t>();
+
+    // NaN lanes compare unordered.
+    using simd_t = pot::simd::simd_forced<float, W>;
+    const simd_t nan(std::numeric_limits<float>::quiet_NaN()), one(1.0f);
+    REQUIRE((nan == nan).none());
+    REQUIRE((nan != nan).all());
+    REQUIRE((nan < one).none());
+    REQUIRE((nan >= one).none());
+}
+
+// Filter
+
+template <SIMDType W, typename Executor>
+void filter_simd_matches_copy_if(Executor &pool, std::span<const float> in, std::span<const int32_t> ints)
+{
+    std::vector<float> expected;
+    std::copy_if(in.begin(), in.end(), std::back_inserter(expected), [](float x) { return x > 0.25f; });
+    std::vector<int32_t> expected_ints;
+    std::copy_if(ints.begin(), ints.end(), std::back_inserter(expected_ints), [](int32_t x) { return (x & 3) == 0 || x < -40; });
+
+    std::vector<float> out(in.size() + 1, -7.0f);
+    const size_t written = pot::algorithms::filter_simd<float, W>(pool, in.data(), out.data(), in.size(),
+        [](auto v) { return v > decltype(v)(0.25f); }).get(&pool);
+    REQUIRE(written == expected.size());
+    REQUIRE(std::equal(expected.begin(), expected.end(), out.begin()));
+    REQUIRE(out[written] == -7.0f);
+
+    // Masks combine: the predicate may be any expression of comparisons.
+    std::vector<int32_t> out_ints(ints.size());
+    const size_t written_ints = pot::algorithms::filter_simd<int32_t, W>(pool, ints.data(), out_ints.data(), ints.size(),
+        [](auto v)
+        {
+            using simd_t = decltype(v);
+            return ((v & simd_t(3)) == simd_t(0)) | (v < simd_t(-40));
+        }).get(&pool);
+    REQUIRE(written_ints == expected_ints.size());
+    REQUIRE(std::equal(expected_ints.begin(), expected_ints.end(), out_ints.begin()));
+}
+} // namespace simd_checks
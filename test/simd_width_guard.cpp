@@ -0,0 +1,34 @@
+// Linked into the per-width test executables and built at the baseline flags. Everything else in
+// them is compiled for a wider SIMD width, static initialization included, so the CPU check has to
+// run before any of it: an unsupported width exits with the code CTest reports as skipped.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "pot/simd/cpu_features.h"
+
+// Defined by test_simd_widths.cpp: the extensions its width is compiled with.
+extern const pot::simd::cpu_features required_cpu_features;
+
+namespace
+{
+constexpr int skip_return_code = 4; // SKIP_RETURN_CODE in test/CMakeLists.txt
+
+void skip_unless_supported()
+{
+    if (pot::simd::cpu_features::system().covers(required_cpu_features))
+        return;
+    std::fputs("this CPU does not support the SIMD width these tests are built for\n", stderr);
+    std::_Exit(skip_return_code);
+}
+
+#if defined(_MSC_VER)
+#pragma init_seg(lib)
+const struct width_guard
+{
+    width_guard() { skip_unless_supported(); }
+} guard;
+#else
+[[gnu::constructor(101)]] void run_guard() { skip_unless_supported(); }
+#endif
+} // namespace
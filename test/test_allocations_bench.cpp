@@ -0,0 +1,166 @@
+// Counts heap allocations per task by replacing the global operator new and delete. Built as its
+// own executable (see test/CMakeLists.txt) so the rest of the tests keep the default allocator.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "pot/sandbox/thread_pool_executor.h"
+#include "pot/utils/unique_function.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <fmt/core.h>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	std::atomic<bool> g_count_allocations{false};
+	std::atomic<int64_t> g_allocations{0};
+} // namespace
+
+void *operator new(std::size_t size)
+{
+	if (g_count_allocations.load(std::memory_order_relaxed))
+		g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void *ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+// The nothrow forms (std::get_temporary_buffer uses them) must come from malloc too, since the
+// deletes below hand every pointer to free.
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+	if (g_count_allocations.load(std::memory_order_relaxed))
+		g_allocations.fetch_add(1, std::memory_order_relaxed);
+	return std::malloc(size ? size : 1);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+template <size_t Bytes> auto make_payload_task(std::atomic<int64_t> &counter)
+{
+	std::array<char, Bytes - sizeof(void *)> payload{};
+	return [&counter, payload]() { counter.fetch_add(payload[0] + 1, std::memory_order_relaxed); };
+}
+
+template <typename Wrapper, size_t Bytes> double wrapper_allocations_per_task(int64_t total_tasks)
+{
+	std::atomic<int64_t> counter{0};
+	std::vector<Wrapper> tasks;
+	tasks.reserve(total_tasks);
+
+	g_allocations.store(0);
+	g_count_allocations.store(true);
+	for (int64_t i = 0; i < total_tasks; ++i)
+		tasks.emplace_back(make_payload_task<Bytes>(counter));
+	for (auto &task : tasks)
+		task();
+	g_count_allocations.store(false);
+
+	return static_cast<double>(g_allocations.load()) / static_cast<double>(total_tasks);
+}
+
+template <typename ExecutorType, size_t Bytes>
+double executor_allocations_per_task(int64_t total_tasks, std::shared_ptr<ExecutorType> executor)
+{
+	std::atomic<int64_t> counter{0};
+	std::latch completion(total_tasks);
+
+	g_allocations.store(0);
+	g_count_allocations.store(true);
+	for (int64_t i = 0; i < total_tasks; ++i)
+	{
+		executor->run_detached([&completion, task = make_payload_task<Bytes>(counter)]() mutable
+							   {
+								   task();
+								   completion.count_down();
+							   });
+	}
+	completion.wait();
+	g_count_allocations.store(false);
+
+	return static_cast<double>(g_allocations.load()) / static_cast<double>(total_tasks);
+}
+
+TEST_CASE("Heap allocations per task", "[benchmark]")
+{
+	const std::vector<int64_t> thread_counts = {std::thread::hardware_concurrency()};
+
+	constexpr int64_t total_tasks = 100'000;
+
+	fmt::print("\n=== Heap allocations per task ===\n");
+	fmt::print("{:>10} | {:>14} {:>14}\n", "Capture", "std::function", "unique_fn");
+	fmt::print("{:-<44}\n", "");
+
+	auto print_wrappers = [&]<size_t Bytes>()
+	{
+		fmt::print("{:>9}B | {:14.3f} {:14.3f}\n", Bytes,
+				   wrapper_allocations_per_task<std::function<void()>, Bytes>(total_tasks),
+				   wrapper_allocations_per_task<pot::utils::unique_function_once, Bytes>(total_tasks));
+	};
+	print_wrappers.template operator()<16>();
+	print_wrappers.template operator()<32>();
+	print_wrappers.template operator()<48>();
+
+	// Resume-sized callables must never touch the heap on the way through the wrapper.
+	REQUIRE(wrapper_allocations_per_task<pot::utils::unique_function_once, 16>(total_tasks) == 0.0);
+	REQUIRE(wrapper_allocations_per_task<pot::utils::unique_function_once, 48>(total_tasks) == 0.0);
+
+	fmt::print("\n{:>8} {:>10} | {:>8} {:>8} {:>8} {:>8} {:>8} {:>8} {:>8} {:>8} {:>8}\n", "Threads", "Capture",
+			   "GQ", "LQ", "LQ_Seq", "LQ_Neigh", "GS", "LS", "GS_Hot", "LS_Hot", "GPQ");
+	fmt::print("{:-<110}\n", "");
+
+	for (auto thread_count : thread_counts)
+	{
+		auto exec_gq = std::make_shared<pot::executors::thread_pool_executor_gq>("GQ", thread_count);
+		auto exec_lq = std::make_shared<pot::executors::thread_pool_executor_lq>("LQ", thread_count);
+		auto exec_lq_seq = std::make_shared<pot::executors::thread_pool_executor_lq_steal_seq>("LQSeq", thread_count);
+		auto exec_lq_neigh = std::make_shared<pot::executors::thread_pool_executor_lq_steal_neighbor>("LQNeigh", thread_count);
+		auto exec_gs = std::make_shared<pot::executors::thread_pool_executor_gs>("GS", thread_count);
+		auto exec_ls = std::make_shared<pot::executors::thread_pool_executor_ls>("LS", thread_count);
+		auto exec_gs_hot = std::make_shared<pot::executors::thread_pool_executor_gs_hot>("GSHot", thread_count);
+		auto exec_ls_hot = std::make_shared<pot::executors::thread_pool_executor_ls_hot>("LSHot", thread_count);
+		auto exec_gpq = std::make_shared<pot::executors::thread_pool_executor_gpq>("GPQ", thread_count);
+
+		auto print_pools = [&]<size_t Bytes>()
+		{
+			fmt::print("{:8} {:>9}B | {:8.3f} {:8.3f} {:8.3f} {:8.3f} {:8.3f} {:8.3f} {:8.3f} {:8.3f} {:8.3f}\n",
+					   thread_count, Bytes,
+					   executor_allocations_per_task<pot::executors::thread_pool_executor_gq, Bytes>(total_tasks, exec_gq),
+					   executor_allocations_per_task<pot::executors::thread_pool_executor_lq, Bytes>(total_tasks, exec_lq),
+					   executor_allocations_per_task<pot::executors::thread_pool_executor_lq_steal_seq, Bytes>(
+						   total_tasks, exec_lq_seq),
+					   executor_allocations_per_task<pot::executors::thread_pool_executor_lq_steal_neighbor, Bytes>(
+						   total_tasks, exec_lq_neigh),
+					   executor_allocations_per_task<pot::executors::thread_pool_executor_gs, Bytes>(total_tasks, exec_gs),
+					   executor_allocations_per_task<pot::executors::thread_pool_executor_ls, Bytes>(total_tasks, exec_ls),
+					   executor_allocations_per_task<pot::executors::thread_pool_executor_gs_hot, Bytes>(
+						   total_tasks, exec_gs_hot),
+					   executor_allocations_per_task<pot::executors::thread_pool_executor_ls_hot, Bytes>(
+						   total_tasks, exec_ls_hot),
+					   executor_allocations_per_task<pot::executors::thread_pool_executor_gpq, Bytes>(total_tasks,
+																									exec_gpq));
+		};
+		print_pools.template operator()<16>();
+		print_pools.template operator()<48>();
+	}
+}
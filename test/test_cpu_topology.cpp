@@ -0,0 +1,230 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pot/executors/thread_pool_executor.h"
+#include "pot/threads/placement_policy.h"
+#include "pot/utils/cpu_topology.h"
+#include "pot/utils/this_thread.h"
+
+namespace
+{
+    // Two sockets with two cores each and two hardware threads per core, numbered the way Linux
+    // does it: first threads of all cores, then their siblings. Each socket is one NUMA node.
+    class fake_sysfs
+    {
+      public:
+        fake_sysfs() : m_root(std::filesystem::temp_directory_path() / "pot_fake_sysfs")
+        {
+            std::filesystem::remove_all(m_root);
+            write("cpu/online", "0-7");
+            for (int cpu = 0; cpu < 8; ++cpu)
+            {
+                const int first = cpu % 4;
+                const auto topology = "cpu/cpu" + std::to_string(cpu) + "/topology/";
+                write(topology + "core_id", std::to_string(first % 2));
+                write(topology + "physical_package_id", std::to_string(first / 2));
+                write(topology + "thread_siblings_list", std::to_string(first) + "," + std::to_string(first + 4));
+            }
+            write("node/node0/cpulist", "0-1,4-5");
+            write("node/node1/cpulist", "2-3,6-7");
+        }
+
+        ~fake_sysfs() { std::filesystem::remove_all(m_root); }
+
+        [[nodiscard]] std::filesystem::path root() const { return m_root / "cpu"; }
+
+      private:
+        void write(const std::string &relative, const std::string &content)
+        {
+            const auto path = m_root / relative;
+            std::filesystem::create_directories(path.parent_path());
+            std::ofstream(path) << content << "\n";
+        }
+
+        std::filesystem::path m_root;
+    };
+} // namespace
+
+TEST_CASE("cpu topology")
+{
+    SECTION("cpu list parsing")
+    {
+        REQUIRE(pot::utils::parse_cpu_list("0-3,8,10-11\n") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+        REQUIRE(pot::utils::parse_cpu_list("5, 1 ,x,3-2").size() == 2);
+        REQUIRE(pot::utils::parse_cpu_list("").empty());
+    }
+
+    SECTION("sysfs layout")
+    {
+        fake_sysfs sysfs;
+        const auto topology = pot::utils::cpu_topology::from_sysfs(sysfs.root());
+
+        REQUIRE(topology.size() == 8);
+        REQUIRE(topology.physical_core_count() == 4);
+        REQUIRE(topology.package_count() == 2);
+        REQUIRE(topology.cpus()[6].package_id == 1);
+        REQUIRE(topology.cpus()[6].smt_index == 1);
+        REQUIRE(topology.restricted_to({0, 4, 9}).physical_core_count() == 1);
+
+        REQUIRE(topology.numa_nodes() == std::vector<int>{0, 1});
+        REQUIRE(topology.cpus_on_node(1) == std::vector<int>{2, 3, 6, 7});
+        REQUIRE(topology.restricted_to({0, 1}).numa_nodes() == std::vector<int>{0});
+    }
+
+    SECTION("missing sysfs falls back to flat cpus")
+    {
+        const auto topology = pot::utils::cpu_topology::from_sysfs("/nonexistent/pot/sysfs");
+        REQUIRE(topology.empty());
+        REQUIRE_FALSE(pot::utils::cpu_topology::system().empty());
+    }
+
+    SECTION("placement policies")
+    {
+        fake_sysfs sysfs;
+        const auto topology = pot::utils::cpu_topology::from_sysfs(sysfs.root());
+
+        REQUIRE(pot::placement_policy::none().resolve(4, topology).empty());
+        REQUIRE(pot::placement_policy::compact().resolve(8, topology) == std::vector<int>{0, 4, 1, 5, 2, 6, 3, 7});
+        REQUIRE(pot::placement_policy::scatter().resolve(8, topology) == std::vector<int>{0, 2, 1, 3, 4, 6, 5, 7});
+        REQUIRE(pot::placement_policy::physical_cores().resolve(6, topology) == std::vector<int>{0, 1, 2, 3, 0, 1});
+        REQUIRE(pot::placement_policy::cpus({7, 3}).resolve(3, topology) == std::vector<int>{7, 3, 7});
+        REQUIRE_THROWS_AS(pot::placement_policy::cpus({}).resolve(2, topology), std::invalid_argument);
+    }
+
+    SECTION("pool workers are pinned")
+    {
+        const auto allowed = pot::this_thread::get_affinity();
+        REQUIRE_FALSE(allowed.empty());
+
+        pot::executors::thread_pool_executor_lfws pool("pinned", 2, pot::idle_policy::park(),
+                                                       pot::placement_policy::cpus({allowed.back()}));
+        for (int i = 0; i < 4; ++i)
+        {
+            auto cpus = pool.run([] { return pot::this_thread::get_affinity(); }).get();
+            REQUIRE(cpus == std::vector<int>{allowed.back()});
+        }
+
+        pot::executors::thread_pool_executor_lq lq("pinned_lq", 2, pot::idle_policy::park(),
+                                                   pot::placement_policy::compact());
+        for (int i = 0; i < 4; ++i)
+            REQUIRE(lq.run([] { return pot::this_thread::get_affinity(); }).get().size() == 1);
+    }
+}
+
+TEST_CASE("thread_pool_executor_numa")
+{
+    fake_sysfs sysfs;
+    const auto topology = pot::utils::cpu_topology::from_sysfs(sysfs.root());
+
+    // The fake CPUs may not exist here; pinning is best effort and the pool must work regardless.
+    pot::executors::thread_pool_executor_numa pool("numa", 4, pot::idle_policy::park(), topology);
+
+    SECTION("workers are spread over the nodes")
+    {
+        REQUIRE(pool.thread_count() == 4);
+        REQUIRE(pool.node_ids() == std::vector<int>{0, 1});
+        REQUIRE(pool.current_node() == -1);
+    }
+
+    SECTION("run_on_node runs on the requested node")
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            const int node = i % 2;
+            REQUIRE(pool.run_on_node(node, [&pool] { return pool.current_node(); }).get() == node);
+        }
+
+        std::atomic<int> wrong_node{0};
+        std::atomic<int> done{0};
+        for (int i = 0; i < 1000; ++i)
+        {
+            pool.run_detached_on_node(1, [&]
+                                      {
+                                          if (pool.current_node() != 1)
+                                              wrong_node.fetch_add(1);
+                                          done.fetch_add(1);
+                                      });
+        }
+        while (done.load() != 1000)
+            std::this_thread::yield();
+        REQUIRE(wrong_node.load() == 0);
+
+        REQUIRE_THROWS_AS(pool.run_on_node(7, [] {}), std::out_of_range);
+    }
+
+    SECTION("tasks spawned by a worker all run")
+    {
+        auto result = pool.run_on_node(
+            0,
+            [&pool]() -> pot::coroutines::task<int>
+            {
+                std::vector<pot::coroutines::task<int>> children;
+                for (int i = 0; i < 64; ++i)
+                    children.push_back(pool.run([i] { return i; }));
+
+                int sum = 0;
+                for (auto &child : children)
+                    sum += co_await std::move(child);
+                co_return sum;
+            });
+        REQUIRE(result.get() == 64 * 63 / 2);
+    }
+
+    SECTION("a worker's bulk submission reaches the other node")
+    {
+        std::atomic<int> ran_on[2]{0, 0};
+        std::atomic<int> done{0};
+        constexpr int tasks = 64;
+
+        // Let every worker park first, so node 1 only runs something if it is woken for it.
+        while (pool.idle_thread_count() != pool.thread_count())
+            std::this_thread::yield();
+
+        pool.run_detached_on_node(0, [&]
+                                  {
+                                      std::vector<std::function<void()>> batch;
+                                      for (int i = 0; i < tasks; ++i)
+                                      {
+                                          batch.emplace_back([&]
+                                                             {
+                                                                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                                                                 ran_on[pool.current_node()].fetch_add(1);
+                                                                 done.fetch_add(1);
+                                                             });
+                                      }
+                                      pool.run_bulk(batch);
+                                  });
+
+        while (done.load() != tasks)
+            std::this_thread::yield();
+        REQUIRE(ran_on[0].load() > 0);
+        REQUIRE(ran_on[1].load() > 0);
+    }
+
+    SECTION("shutdown runs the queued tasks")
+    {
+        std::atomic<int> done{0};
+        for (int i = 0; i < 500; ++i)
+        {
+            auto task = [&done]
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                done.fetch_add(1);
+            };
+            if (i % 2 == 0)
+                pool.run_detached(task);
+            else
+                pool.run_detached_on_node(1, task);
+        }
+        pool.shutdown();
+        REQUIRE(done.load() == 500);
+    }
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "pot/algorithms/dot.h"
+#include "pot/executors/thread_pool_executor.h"
+#include "pot/simd/float16.h"
+
+#include "simd_checks.h"
+
+TEST_CASE("Dot: mixed-precision and widening", "[dot][widen]")
+{
+    using pot::simd::SIMDType;
+    using pot::simd::bfloat16;
+    using pot::simd::float16;
+
+    pot::executors::thread_pool_executor_lfws pool("widen", 3);
+    std::mt19937 rng(19);
+
+    SECTION("16-bit float conversions")
+    {
+        REQUIRE(float16(1.0f).bits == 0x3c00);
+        REQUIRE(float16(-2.5f).bits == 0xc100);
+        REQUIRE(float16(65504.0f).bits == 0x7bff);
+        REQUIRE(float16(1e6f).bits == 0x7c00);
+        REQUIRE(float16(std::ldexp(1.0f, -24)).bits == 0x0001);
+        REQUIRE(float16(1.0f + std::ldexp(1.0f, -11)).bits == 0x3c00); // tie rounds to even
+        REQUIRE(std::isnan(static_cast<float>(float16(std::numeric_limits<float>::quiet_NaN()))));
+        REQUIRE(static_cast<float>(float16::from_bits(0x0001)) == std::ldexp(1.0f, -24));
+
+        REQUIRE(bfloat16(1.0f).bits == 0x3f80);
+        REQUIRE(bfloat16(1.0f + std::ldexp(1.0f, -8)).bits == 0x3f80);
+        REQUIRE(bfloat16(1.0f + 3 * std::ldexp(1.0f, -8)).bits == 0x3f82);
+        REQUIRE(std::isnan(static_cast<float>(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+
+        std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+        for (int i = 0; i < 10000; ++i)
+        {
+            const float x = dist(rng);
+            REQUIRE(std::abs(static_cast<float>(float16(x)) - x) <= std::abs(x) * 0x1p-11f);
+            REQUIRE(std::abs(static_cast<float>(bfloat16(x)) - x) <= std::abs(x) * 0x1p-8f);
+        }
+    }
+
+    SECTION("float inputs, double accumulator")
+    {
+        simd_checks::float_to_double<SIMDType::SSE>(pool, rng);
+    }
+
+    SECTION("Integer inputs, int32 accumulator, exact")
+    {
+        // Auto runs the library kernels: with AVX-512 VNNI the 8-bit ones use vpdpbusd.
+        simd_checks::integer_widening<int8_t, SIMDType::SSE, SIMDType::Auto>(pool, rng);
+        simd_checks::integer_widening<uint8_t, SIMDType::SSE, SIMDType::Auto>(pool, rng);
+        simd_checks::integer_widening<int16_t, SIMDType::SSE, SIMDType::Auto>(pool, rng);
+        simd_checks::widening_extremes<SIMDType::SSE>(pool);
+        simd_checks::widening_biased_sum<SIMDType::SSE, SIMDType::Auto>();
+    }
+
+    SECTION("bfloat16 and float16 inputs, float accumulator")
+    {
+        simd_checks::half_float_widening<bfloat16, SIMDType::SSE, SIMDType::Auto>(pool, rng, 0.05f);
+        simd_checks::half_float_widening<float16, SIMDType::SSE, SIMDType::Auto>(pool, rng, 0.05f);
+
+        auto mismatched = [&]
+        {
+            const std::vector<bfloat16> x(3), y(4);
+            return pot::algorithms::dot_simd<bfloat16, float, SIMDType::SSE>(pool, std::span<const bfloat16>(x),
+                                                                             std::span<const bfloat16>(y))
+                .get(&pool);
+        };
+        REQUIRE_THROWS_AS(mismatched(), std::invalid_argument);
+    }
+}
@@ -3,6 +3,7 @@
 #include <thread>
 
 #include "pot/coroutines/when_all.h"
+#include "pot/coroutines/when_any.h"
 #include "pot/executors/thread_pool_executor.h"
 
 #include <fmt/core.h>
@@ -91,6 +92,28 @@ TEST_CASE("thread_pool_executor tests")
         REQUIRE(t3.get() == 30);
     }
 
+    SECTION("run_detached - passing arguments")
+    {
+        std::atomic<int> sum{0};
+        std::atomic<int> done{0};
+
+        pool.run_detached([&](int a, int b) { sum.fetch_add(a + b); done.fetch_add(1); }, 10, 32);
+        pool.run_detached([&](std::string s) { sum.fetch_add(static_cast<int>(s.size())); done.fetch_add(1); },
+                          std::string("abc"));
+        pool.run_detached(
+            [&](int a)
+            {
+                done.fetch_add(1);
+                return a;
+            },
+            1);
+
+        while (done.load() != 3)
+            std::this_thread::yield();
+
+        REQUIRE(sum.load() == 45);
+    }
+
     SECTION("lazy_run - basic test")
     {
         std::atomic<int> counter{0};
@@ -509,6 +532,130 @@ TEST_CASE("when_all integration tests")
         root_task().get();
     }
 
+    SECTION("when_all with lazy_run starts all tasks concurrently")
+    {
+        constexpr int task_count = 4;
+        pot::executors::thread_pool_executor_lq wide_pool("when_all_pool", task_count);
+
+        // Every task waits for all others to have started: a sequential when_all would time out.
+        std::atomic<int> started{0};
+        std::atomic<bool> timed_out{false};
+
+        std::vector<pot::coroutines::lazy_task<void>> tasks;
+        for (int i = 0; i < task_count; ++i)
+        {
+            tasks.emplace_back(wide_pool.lazy_run(
+                [&]()
+                {
+                    started.fetch_add(1);
+                    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                    while (started.load() < task_count)
+                    {
+                        if (std::chrono::steady_clock::now() > deadline)
+                        {
+                            timed_out = true;
+                            return;
+                        }
+                        std::this_thread::yield();
+                    }
+                }));
+        }
+
+        pot::coroutines::when_all(tasks).get();
+
+        REQUIRE(started.load() == task_count);
+        REQUIRE_FALSE(timed_out.load());
+    }
+
+    SECTION("when_all runs plain lazy coroutines inline, when_all_on runs them concurrently")
+    {
+        constexpr int task_count = 4;
+        pot::executors::thread_pool_executor_lq wide_pool("when_all_on_pool", task_count);
+
+        const auto caller = std::this_thread::get_id();
+        auto where = []() -> pot::coroutines::lazy_task<std::thread::id> { co_return std::this_thread::get_id(); };
+        std::vector<pot::coroutines::lazy_task<std::thread::id>> inline_tasks;
+        for (int i = 0; i < task_count; ++i)
+            inline_tasks.push_back(where());
+        for (auto id : pot::coroutines::when_all(inline_tasks).get())
+            REQUIRE(id == caller);
+
+        // Every task waits for all others to have started: run one after another, they would time out.
+        std::atomic<int> started{0};
+        std::atomic<bool> timed_out{false};
+        auto rendezvous = [&]() -> pot::coroutines::lazy_task<void>
+        {
+            started.fetch_add(1);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (started.load() < task_count)
+            {
+                if (std::chrono::steady_clock::now() > deadline)
+                {
+                    timed_out = true;
+                    co_return;
+                }
+                std::this_thread::yield();
+            }
+        };
+
+        std::vector<pot::coroutines::lazy_task<void>> tasks;
+        for (int i = 0; i < task_count; ++i)
+            tasks.push_back(rendezvous());
+        pot::coroutines::when_all_on(wide_pool, tasks).get();
+
+        REQUIRE(started.load() == task_count);
+        REQUIRE_FALSE(timed_out.load());
+    }
+
+    SECTION("when_all returns results in input order")
+    {
+        auto root_task = [&]() -> pot::coroutines::task<int>
+        {
+            std::vector<pot::coroutines::task<int>> tasks;
+            for (int i = 0; i < 16; ++i)
+                tasks.emplace_back(pool.run([i]() { return i * i; }));
+
+            std::vector<int> squares = co_await pot::coroutines::when_all(tasks);
+
+            for (int i = 0; i < 16; ++i)
+                REQUIRE(squares[i] == i * i);
+
+            auto [a, b, c] = co_await pot::coroutines::when_all(
+                pool.run([]() { return 1; }), pool.lazy_run([]() {}), coro_function(21));
+
+            REQUIRE(a == 1);
+            REQUIRE(std::is_same_v<decltype(b), std::monostate>);
+            co_return c;
+        };
+
+        REQUIRE(root_task().get() == 42);
+    }
+
+    SECTION("when_all rethrows after every task has finished")
+    {
+        std::atomic<int> finished{0};
+
+        auto root_task = [&]() -> pot::coroutines::task<void>
+        {
+            std::vector<pot::coroutines::task<int>> tasks;
+            tasks.emplace_back(pool.run([]() -> int { throw std::runtime_error("Oops"); }));
+            for (int i = 0; i < 8; ++i)
+            {
+                tasks.emplace_back(pool.run(
+                    [&finished]()
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        return finished.fetch_add(1) + 1;
+                    }));
+            }
+
+            co_await pot::coroutines::when_all(tasks);
+        };
+
+        REQUIRE_THROWS_AS(root_task().get(), std::runtime_error);
+        REQUIRE(finished.load() == 8);
+    }
+
     // SECTION("when_all exception safety (Basic check)")
     // {
     //     auto root_task = [&]() -> pot::coroutines::task<void>
@@ -530,6 +677,106 @@ TEST_CASE("when_all integration tests")
     // }
 }
 
+TEST_CASE("when_any integration tests")
+{
+    pot::executors::thread_pool_executor_lq race_pool("when_any_pool", 4);
+
+    // Losers keep running detached after when_any returns; every section waits for its tasks to
+    // finish so that no frame is still pending when the pool shuts down.
+    std::atomic<int> finished{0};
+    auto wait_finished = [&finished](int expected)
+    {
+        while (finished.load() < expected)
+            std::this_thread::yield();
+    };
+
+    SECTION("when_any(vector) - first finished task wins")
+    {
+        std::vector<pot::coroutines::task<int>> tasks;
+        for (int i = 0; i < 4; ++i)
+        {
+            tasks.emplace_back(race_pool.run(
+                [i, &finished]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(i == 2 ? 1 : 200));
+                    finished.fetch_add(1);
+                    return i * 10;
+                }));
+        }
+
+        auto result = pot::coroutines::when_any(tasks).get();
+
+        REQUIRE(result.index == 2);
+        REQUIRE(result.value == 20);
+        wait_finished(4);
+    }
+
+    SECTION("when_any(variadic) - hedged computation")
+    {
+        std::atomic<int> resumed{0};
+
+        auto root_task = [&]() -> pot::coroutines::task<void>
+        {
+            auto slow = race_pool.run(
+                [&finished]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                    finished.fetch_add(1);
+                    return 1.0;
+                });
+            auto fast = race_pool.lazy_run([]() { return std::string("fast"); });
+
+            auto result = co_await pot::coroutines::when_any(std::move(slow), std::move(fast));
+            resumed.fetch_add(1);
+
+            REQUIRE(result.index == 1);
+            REQUIRE(std::get<1>(result.value) == "fast");
+        };
+
+        root_task().get();
+        REQUIRE(resumed.load() == 1);
+        wait_finished(1);
+    }
+
+    SECTION("when_any - void tasks and already finished inputs")
+    {
+        std::vector<pot::coroutines::task<void>> tasks;
+        tasks.emplace_back([]() -> pot::coroutines::task<void> { co_return; }());
+        tasks.emplace_back(race_pool.run(
+            [&finished]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                finished.fetch_add(1);
+            }));
+
+        auto result = pot::coroutines::when_any(tasks.begin(), tasks.end()).get();
+        REQUIRE(result.index == 0);
+        wait_finished(1);
+    }
+
+    SECTION("when_any - exception of the winner is rethrown")
+    {
+        auto failing = race_pool.run([]() -> int { throw std::runtime_error("Oops"); });
+        auto slow = race_pool.run(
+            [&finished]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                finished.fetch_add(1);
+                return 2;
+            });
+
+        REQUIRE_THROWS_AS(pot::coroutines::when_any(std::move(failing), std::move(slow)).get(),
+                          std::runtime_error);
+        wait_finished(1);
+    }
+
+    SECTION("when_any - empty range")
+    {
+        std::vector<pot::coroutines::task<int>> tasks;
+        REQUIRE_THROWS_AS(pot::coroutines::when_any(tasks).get(), std::invalid_argument);
+    }
+}
+
 TEST_CASE("thread info test")
 {
     struct thread_info
@@ -603,3 +850,163 @@ TEST_CASE("thread info test")
         }
     }
 }
+
+TEST_CASE("idle policies")
+{
+    constexpr int submitters = 4;
+    constexpr int tasks_per_submitter = 2'000;
+
+    // Submitters pause now and then so workers go through spinning, yielding and parking; a lost
+    // wake-up shows up as a task that never runs.
+    auto check_pool = [&](auto &executor)
+    {
+        std::atomic<int> done{0};
+
+        std::vector<std::thread> threads;
+        for (int s = 0; s < submitters; ++s)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    for (int i = 0; i < tasks_per_submitter; ++i)
+                    {
+                        executor.run_detached([&done] { done.fetch_add(1); });
+                        if (i % 250 == 0)
+                            std::this_thread::sleep_for(std::chrono::microseconds(500));
+                    }
+                });
+        }
+        for (auto &thread : threads)
+            thread.join();
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (done.load() != submitters * tasks_per_submitter && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        REQUIRE(done.load() == submitters * tasks_per_submitter);
+    };
+
+    const pot::idle_policy policies[] = {pot::idle_policy::park(), pot::idle_policy::yield_then_park(),
+                                         pot::idle_policy::spin_then_park()};
+
+    for (const auto &policy : policies)
+    {
+        pot::executors::thread_pool_executor_gq gq("idle_gq", 4, policy);
+        check_pool(gq);
+        pot::executors::thread_pool_executor_lq lq("idle_lq", 4, policy);
+        check_pool(lq);
+        pot::executors::thread_pool_executor_lfgq lfgq("idle_lfgq", 4, policy);
+        check_pool(lfgq);
+        pot::executors::thread_pool_executor_lflq lflq("idle_lflq", 4, policy);
+        check_pool(lflq);
+        pot::executors::thread_pool_executor_lfws lfws("idle_lfws", 4, policy);
+        check_pool(lfws);
+    }
+}
+
+TEST_CASE("idle notifier wakes a sleeper per notification behind a spinner")
+{
+    pot::idle_notifier notifier;
+    std::atomic<int> woken{0};
+
+    auto waiter = [&](pot::idle_policy policy)
+    {
+        return std::thread(
+            [&, policy]
+            {
+                notifier.wait(notifier.prepare_wait(), policy);
+                woken.fetch_add(1);
+            });
+    };
+
+    // One worker keeps spinning while three are parked; each notification is a task of its own.
+    std::vector<std::thread> threads;
+    threads.push_back(waiter(pot::idle_policy::spin_then_park(1u << 30, 0)));
+    for (int i = 0; i < 3; ++i)
+        threads.push_back(waiter(pot::idle_policy::park()));
+    while (notifier.idle_count() != threads.size())
+        std::this_thread::yield();
+    // std::atomic::wait spins a little before it sleeps in the kernel; let the sleepers get there.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    for (size_t i = 0; i < threads.size(); ++i)
+        notifier.notify_one();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (woken.load() != 4 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const int woken_by_notify = woken.load();
+
+    notifier.notify_all();
+    for (auto &thread : threads)
+        thread.join();
+
+    REQUIRE(woken_by_notify == 4);
+}
+
+TEST_CASE("bulk submission")
+{
+    auto check_pool = [](pot::executor &executor)
+    {
+        constexpr int tasks = 1'000;
+
+        std::atomic<int> done{0};
+        std::vector<std::function<void()>> funcs;
+        for (int i = 0; i < tasks; ++i)
+            funcs.emplace_back([&done] { done.fetch_add(1); });
+        executor.run_bulk(funcs);
+
+        std::vector<pot::utils::unique_function_once> erased;
+        for (int i = 0; i < tasks; ++i)
+            erased.emplace_back([&done] { done.fetch_add(1); });
+        executor.run_bulk(erased);
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (done.load() != 2 * tasks && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        REQUIRE(done.load() == 2 * tasks);
+
+        std::vector<pot::coroutines::lazy_task<int>> lazy;
+        for (int i = 0; i < 64; ++i)
+            lazy.push_back([](int value) -> pot::coroutines::lazy_task<int> { co_return value * 2; }(i));
+        auto results = pot::coroutines::when_all_on(executor, lazy).get();
+        REQUIRE(results.size() == 64);
+        for (int i = 0; i < 64; ++i)
+            REQUIRE(results[i] == i * 2);
+
+        std::vector<pot::coroutines::lazy_task<void>> failing;
+        failing.push_back([]() -> pot::coroutines::lazy_task<void> { co_return; }());
+        failing.push_back([]() -> pot::coroutines::lazy_task<void>
+                          {
+                              throw std::runtime_error("bulk failure");
+                              co_return;
+                          }());
+        REQUIRE_THROWS_AS(pot::coroutines::when_all_on(executor, failing).get(), std::runtime_error);
+
+        // A stopped executor rejects the whole batch; when_all_on rethrows without running an input.
+        executor.shutdown();
+        bool ran = false;
+        std::vector<pot::coroutines::lazy_task<void>> rejected;
+        for (int i = 0; i < 4; ++i)
+            rejected.push_back([](bool &flag) -> pot::coroutines::lazy_task<void>
+                               {
+                                   flag = true;
+                                   co_return;
+                               }(ran));
+        REQUIRE_THROWS_AS(pot::coroutines::when_all_on(executor, rejected).get(), std::runtime_error);
+        REQUIRE_FALSE(ran);
+    };
+
+    pot::executors::thread_pool_executor_gq gq("bulk_gq", 4);
+    check_pool(gq);
+    pot::executors::thread_pool_executor_lq lq("bulk_lq", 4);
+    check_pool(lq);
+    pot::executors::thread_pool_executor_lfgq lfgq("bulk_lfgq", 4);
+    check_pool(lfgq);
+    pot::executors::thread_pool_executor_lflq lflq("bulk_lflq", 4);
+    check_pool(lflq);
+    pot::executors::thread_pool_executor_lfws lfws("bulk_lfws", 4);
+    check_pool(lfws);
+    pot::executors::thread_pool_executor_numa numa("bulk_numa", 4);
+    check_pool(numa);
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "pot/algorithms/filter.h"
+#include "pot/executors/thread_pool_executor.h"
+
+#include "simd_checks.h"
+
+TEST_CASE("Filter: stream compaction", "[filter]")
+{
+    using pot::simd::SIMDType;
+    pot::executors::thread_pool_executor_lfws pool("filter", 3);
+
+    for (size_t n : {size_t(0), size_t(1), size_t(7), size_t(33), size_t(1000), size_t(100003)})
+    {
+        std::vector<float> in(n);
+        std::vector<int32_t> ints(n);
+        std::mt19937 gen(static_cast<unsigned>(n));
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        for (size_t i = 0; i < n; ++i)
+        {
+            in[i] = dist(gen);
+            ints[i] = static_cast<int32_t>(i % 97) - 48;
+        }
+
+        std::vector<float> expected;
+        std::copy_if(in.begin(), in.end(), std::back_inserter(expected), [](float x) { return x > 0.25f; });
+
+        std::vector<float> out(n + 1, -7.0f);
+        const size_t count = pot::algorithms::filter(pool, in.data(), out.data(), n, [](float x) { return x > 0.25f; }).get(&pool);
+        REQUIRE(count == expected.size());
+        REQUIRE(std::equal(expected.begin(), expected.end(), out.begin()));
+        REQUIRE(out[count] == -7.0f);
+
+        simd_checks::filter_simd_matches_copy_if<SIMDType::SSE>(pool, in, ints);
+        simd_checks::filter_simd_matches_copy_if<SIMDType::Auto>(pool, in, ints);
+    }
+
+    SECTION("Span overloads check the output size")
+    {
+        std::vector<float> in(10, 1.0f), out(9);
+        REQUIRE_THROWS_AS(pot::algorithms::filter(pool, std::span<const float>(in), std::span<float>(out),
+                                                  [](float x) { return x > 0.0f; }),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS((pot::algorithms::filter_simd<float, SIMDType::SSE>(pool, std::span<const float>(in), std::span<float>(out),
+                                                                                [](auto v) { return v > decltype(v)(0.0f); })),
+                          std::invalid_argument);
+    }
+}
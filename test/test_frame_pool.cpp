@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "pot/coroutines/task.h"
+#include "pot/memory/coro_memory.h"
+#include "pot/memory/frame_pool.h"
+
+namespace
+{
+    class counting_resource final : public std::pmr::memory_resource
+    {
+      public:
+        std::atomic<size_t> allocations{0};
+        std::atomic<size_t> deallocations{0};
+
+      private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            allocations.fetch_add(1);
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            deallocations.fetch_add(1);
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    pot::coroutines::task<int> square(int x)
+    {
+        co_return x * x;
+    }
+} // namespace
+
+TEST_CASE("frame_pool_resource")
+{
+    counting_resource upstream;
+
+    SECTION("blocks are reused on the owning thread")
+    {
+        pot::memory::frame_pool_resource pool(&upstream);
+
+        void *first = pool.allocate(100);
+        pool.deallocate(first, 100);
+        void *second = pool.allocate(100);
+        REQUIRE(first == second);
+        pool.deallocate(second, 100);
+
+        // One slab serves many blocks of every size class.
+        std::vector<std::pair<void *, size_t>> blocks;
+        for (size_t size = 8; size < 900; size += 40)
+            blocks.emplace_back(pool.allocate(size), size);
+        for (auto [ptr, size] : blocks)
+        {
+            REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % alignof(std::max_align_t) == 0);
+            pool.deallocate(ptr, size);
+        }
+        REQUIRE(upstream.allocations.load() == 1);
+    }
+
+    SECTION("blocks freed on another thread come back to the owner")
+    {
+        pot::memory::frame_pool_resource pool(&upstream);
+
+        std::vector<void *> blocks;
+        for (int i = 0; i < 64; ++i)
+            blocks.push_back(pool.allocate(200));
+
+        std::thread([&] {
+            for (void *ptr : blocks)
+                pool.deallocate(ptr, 200);
+        }).join();
+
+        for (int i = 0; i < 64; ++i)
+        {
+            void *ptr = pool.allocate(200);
+            REQUIRE(std::find(blocks.begin(), blocks.end(), ptr) != blocks.end());
+        }
+    }
+
+    SECTION("large and over-aligned requests go upstream")
+    {
+        pot::memory::frame_pool_resource pool(&upstream);
+
+        void *large = pool.allocate(pot::memory::frame_pool_resource::max_block_size);
+        void *aligned = pool.allocate(64, 64);
+        REQUIRE(upstream.allocations.load() == 2);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+
+        pool.deallocate(large, pot::memory::frame_pool_resource::max_block_size);
+        pool.deallocate(aligned, 64, 64);
+        REQUIRE(upstream.deallocations.load() == 2);
+    }
+
+    SECTION("coroutine frames")
+    {
+        pot::memory::frame_pool_resource pool(&upstream);
+        pot::memory::set_memory_resource(&pool);
+
+        std::vector<pot::coroutines::task<int>> tasks;
+        for (int i = 0; i < 1000; ++i)
+            tasks.push_back(square(i));
+
+        // Destroy the frames on a foreign thread to exercise the remote path.
+        int64_t sum = 0;
+        std::thread([&] {
+            for (auto &task : tasks)
+                sum += task.get();
+            tasks.clear();
+        }).join();
+
+        for (int i = 0; i < 1000; ++i)
+            REQUIRE(square(i).get() == i * i);
+
+        pot::memory::reset_memory_resource();
+        REQUIRE(sum == 332'833'500);
+    }
+
+    REQUIRE(upstream.allocations.load() == upstream.deallocations.load());
+}
@@ -1,15 +1,25 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
 
+#include "pot/algorithms/dot.h"
+#include "pot/algorithms/filter.h"
 #include "pot/algorithms/parfor.h"
+#include "pot/algorithms/scan.h"
+#include "pot/algorithms/sort.h"
+#include "pot/executors/inline_executor.h"
 #include "pot/sandbox/thread_pool_executor.h"
+#include "pot/simd/dispatch.h"
 #include "pot/sync/async_lock.h"
 #include "pot/utils/time_it.h"
 
 #include <Eigen/Sparse>
 #include <cmath>
+#include <execution>
 #include <fmt/core.h>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <omp.h>
 #include <thread>
 #include <vector>
 
@@ -17,7 +27,10 @@ constexpr int MANDEL_WIDTH = 2000;
 constexpr int MANDEL_HEIGHT = 2000;
 constexpr int MANDEL_NUM_BINS = 64;
 
-int compute_mandelbrot(double c_re, double c_im, int max_iter)
+// Width of the simd_forced loops below: the widest this file is compiled for.
+constexpr pot::simd::SIMDType SIMD_WIDTH = pot::simd::details::widest_compiled();
+
+static int compute_mandelbrot(double c_re, double c_im, int max_iter)
 {
     double z_re = 0.0, z_im = 0.0;
     int iter = 0;
@@ -31,6 +44,43 @@ int compute_mandelbrot(double c_re, double c_im, int max_iter)
     return iter;
 }
 
+// compute_mandelbrot for a whole row, one pixel per lane. A lane stops counting once it escapes;
+// the loop ends when no lane is left.
+template <pot::simd::SIMDType W>
+void compute_mandelbrot_row_simd(double c_im, int max_iter, int *iters)
+{
+    using simd_t = pot::simd::simd_forced<double, W>;
+    constexpr size_t lanes = simd_t::lanes;
+    static_assert(MANDEL_WIDTH % lanes == 0);
+
+    const simd_t four(4.0), two(2.0), one(1.0), zero(0.0), ci(c_im);
+    for (size_t x = 0; x < MANDEL_WIDTH; x += lanes)
+    {
+        double re[lanes];
+        for (size_t k = 0; k < lanes; ++k)
+            re[k] = -2.0 + 3.0 * static_cast<double>(x + k) / MANDEL_WIDTH;
+        simd_t cr; cr.loadu(re);
+
+        simd_t zr = zero, zi = zero, count = zero;
+        auto alive = typename simd_t::mask(true);
+        for (int iter = 0; iter < max_iter; ++iter)
+        {
+            const simd_t zr2 = zr * zr, zi2 = zi * zi;
+            alive &= zr2 + zi2 <= four;
+            if (alive.none())
+                break;
+            count += select(alive, one, zero);
+            zi = two * zr * zi + ci;
+            zr = zr2 - zi2 + cr;
+        }
+
+        double out[lanes];
+        count.storeu(out);
+        for (size_t k = 0; k < lanes; ++k)
+            iters[x + k] = static_cast<int>(out[k]);
+    }
+}
+
 template <typename ExecutorType>
 void build_mandelbrot_pot_get(int64_t max_iter, std::shared_ptr<ExecutorType> executor)
 {
@@ -123,3 +173,665 @@ TEST_CASE("Compare get() vs blocking_get() on LQLF_Steal_Seq", "[benchmark]")
         }
     }
 }
+
+// Per-row histogram without locks: the cost of a row depends on how much of it lies inside the
+// set, so equal static chunks leave the threads that got the middle rows working alone.
+static int64_t mandelbrot_row(int64_t y, int64_t max_iter)
+{
+    const double c_im = -1.5 + 3.0 * y / MANDEL_HEIGHT;
+    int64_t total = 0;
+    for (int x = 0; x < MANDEL_WIDTH; ++x)
+        total += compute_mandelbrot(-2.0 + 3.0 * x / MANDEL_WIDTH, c_im, static_cast<int>(max_iter));
+    return total;
+}
+
+template <typename ExecutorType>
+void build_mandelbrot_pot_schedule(int64_t max_iter, std::shared_ptr<ExecutorType> executor,
+                                   pot::algorithms::schedule sched)
+{
+    std::vector<int64_t> rows(MANDEL_HEIGHT, 0);
+    pot::algorithms::parfor(*executor, (int64_t)0, (int64_t)MANDEL_HEIGHT, sched,
+                            [&](int64_t y) { rows[y] = mandelbrot_row(y, max_iter); })
+        .get(executor.get());
+}
+
+static void build_mandelbrot_omp_dynamic(int64_t max_iter)
+{
+    std::vector<int64_t> rows(MANDEL_HEIGHT, 0);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t y = 0; y < MANDEL_HEIGHT; ++y)
+        rows[y] = mandelbrot_row(y, max_iter);
+}
+
+static void build_mandelbrot_omp_guided(int64_t max_iter)
+{
+    std::vector<int64_t> rows(MANDEL_HEIGHT, 0);
+#pragma omp parallel for schedule(guided)
+    for (int64_t y = 0; y < MANDEL_HEIGHT; ++y)
+        rows[y] = mandelbrot_row(y, max_iter);
+}
+
+TEST_CASE("parfor schedules vs OpenMP on Mandelbrot rows", "[benchmark]")
+{
+    const int64_t thread_count = (int64_t)std::thread::hardware_concurrency();
+    const std::vector<int64_t> max_iters = {500, 2000, 8000};
+    const size_t test_runs = 5;
+
+    using pool_type = pot::executors::thread_pool_executor_lqlf_steal_seq;
+    auto executor = std::make_shared<pool_type>("Schedules", thread_count);
+    omp_set_num_threads(static_cast<int>(thread_count));
+
+    fmt::print("\n=== Mandelbrot rows: parfor schedules vs OpenMP ({} threads) ===\n", thread_count);
+    fmt::print("{:>8} | {:>10} {:>10} {:>10} {:>10} | {:>12} {:>12}\n", "MaxIter", "static", "dynamic",
+               "guided", "auto", "omp dynamic", "omp guided");
+    fmt::print("{:-<86}\n", "");
+
+    for (auto param : max_iters)
+    {
+        auto time_schedule = [&](pot::algorithms::schedule sched)
+        {
+            return pot::utils::time_it<std::chrono::duration<double>>(
+                       test_runs, []() {}, build_mandelbrot_pot_schedule<pool_type>, param, executor, sched)
+                .count();
+        };
+
+        const double t_static = time_schedule(pot::algorithms::schedule::static_chunks());
+        const double t_dynamic = time_schedule(pot::algorithms::schedule::dynamic(1));
+        const double t_guided = time_schedule(pot::algorithms::schedule::guided());
+        const double t_auto = time_schedule(pot::algorithms::schedule::automatic());
+        const double t_omp_dynamic =
+            pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {}, build_mandelbrot_omp_dynamic, param)
+                .count();
+        const double t_omp_guided =
+            pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {}, build_mandelbrot_omp_guided, param)
+                .count();
+
+        fmt::print("{:8} | {:10.5f} {:10.5f} {:10.5f} {:10.5f} | {:12.5f} {:12.5f}\n", param, t_static, t_dynamic,
+                   t_guided, t_auto, t_omp_dynamic, t_omp_guided);
+    }
+}
+
+TEST_CASE("scan vs std::inclusive_scan(par)", "[benchmark]")
+{
+    const int64_t thread_count = (int64_t)std::thread::hardware_concurrency();
+    const std::vector<size_t> sizes = {1 << 16, 1 << 20, 1 << 24};
+    const size_t test_runs = 10;
+
+    using pool_type = pot::executors::thread_pool_executor_lqlf_steal_seq;
+    auto executor = std::make_shared<pool_type>("Scan", thread_count);
+
+    fmt::print("\n=== Inclusive scan of float ({} threads) ===\n", thread_count);
+    fmt::print("{:>10} | {:>10} {:>10} | {:>10} {:>10}\n", "N", "std seq", "std par", "pot", "pot simd");
+    fmt::print("{:-<60}\n", "");
+
+    for (size_t n : sizes)
+    {
+        std::vector<float> in(n), out(n);
+        for (size_t i = 0; i < n; ++i)
+            in[i] = static_cast<float>(i % 7);
+
+        auto time = [&](auto &&scan)
+        { return pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {}, scan).count(); };
+
+        const double t_seq = time([&] { std::inclusive_scan(in.begin(), in.end(), out.begin()); });
+        const double t_par = time([&] { std::inclusive_scan(std::execution::par, in.begin(), in.end(), out.begin()); });
+        const double t_pot = time(
+            [&]
+            {
+                pot::algorithms::inclusive_scan(*executor, in.data(), out.data(), n, std::plus<>{}, 0.0f)
+                    .get(executor.get());
+            });
+        const double t_simd = time(
+            [&]
+            {
+                pot::algorithms::inclusive_scan_simd<float, pot::simd::SIMDType::Auto>(
+                    *executor, in.data(), out.data(), n, [](auto a, auto b) { return a + b; }, std::plus<>{}, 0.0f)
+                    .get(executor.get());
+            });
+
+        fmt::print("{:10} | {:10.5f} {:10.5f} | {:10.5f} {:10.5f}\n", n, t_seq, t_par, t_pot, t_simd);
+    }
+}
+
+TEST_CASE("sort and radix_sort vs std::sort", "[benchmark]")
+{
+    const int64_t thread_count = (int64_t)std::thread::hardware_concurrency();
+    const std::vector<size_t> sizes = {1 << 16, 1 << 20, 1 << 24};
+    const size_t test_runs = 5;
+
+    using pool_type = pot::executors::thread_pool_executor_lqlf_steal_seq;
+    auto executor = std::make_shared<pool_type>("Sort", thread_count);
+
+    fmt::print("\n=== Sorting random floats ({} threads) ===\n", thread_count);
+    fmt::print("{:>10} | {:>10} {:>10} | {:>10} {:>10}\n", "N", "std", "std par", "pot sort", "pot radix");
+    fmt::print("{:-<60}\n", "");
+
+    for (size_t n : sizes)
+    {
+        std::vector<float> source(n), data(n);
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> dist(-1e6f, 1e6f);
+        for (auto &x : source)
+            x = dist(rng);
+
+        // Every run starts from unsorted data: the clean-up callback restores it after each run.
+        auto time = [&](auto &&sort)
+        {
+            data = source;
+            return pot::utils::time_it<std::chrono::duration<double>>(
+                       test_runs, [&]() { data = source; }, sort)
+                .count();
+        };
+
+        const double t_std = time([&] { std::sort(data.begin(), data.end()); });
+        const double t_par = time([&] { std::sort(std::execution::par, data.begin(), data.end()); });
+        const double t_pot = time([&] { pot::algorithms::sort(*executor, data).get(executor.get()); });
+        const double t_radix = time([&] { pot::algorithms::radix_sort(*executor, data).get(executor.get()); });
+
+        fmt::print("{:10} | {:10.5f} {:10.5f} | {:10.5f} {:10.5f}\n", n, t_std, t_par, t_pot, t_radix);
+    }
+}
+
+TEST_CASE("reproducible dot_simd vs fast path", "[benchmark]")
+{
+    const int64_t thread_count = (int64_t)std::thread::hardware_concurrency();
+    const std::vector<size_t> sizes = {1 << 16, 1 << 20, 1 << 24};
+    const size_t test_runs = 10;
+
+    using pool_type = pot::executors::thread_pool_executor_lqlf_steal_seq;
+    auto executor = std::make_shared<pool_type>("Dot", thread_count);
+
+    fmt::print("\n=== dot_simd<float, Auto>: fast vs reproducible ({} threads) ===\n", thread_count);
+    fmt::print("{:>10} | {:>10} | {:>10} {:>10} {:>10}\n", "N", "fast", "naive", "pairwise", "kahan");
+    fmt::print("{:-<60}\n", "");
+
+    for (size_t n : sizes)
+    {
+        std::vector<float> a(n), b(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            a[i] = static_cast<float>(i % 97) * 0.01f;
+            b[i] = static_cast<float>(i % 89) * 0.02f;
+        }
+
+        auto time = [&](auto &&dot)
+        { return pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {}, dot).count(); };
+
+        auto reproducible = [&](pot::algorithms::summation method)
+        {
+            return time(
+                [&]
+                {
+                    pot::algorithms::dot_simd<float, pot::simd::SIMDType::Auto>(*executor, a.data(), b.data(), n,
+                                                                                {std::size_t(1) << 14, method})
+                        .get(executor.get());
+                });
+        };
+
+        const double t_fast = time(
+            [&]
+            {
+                pot::algorithms::dot_simd<float, pot::simd::SIMDType::Auto>(*executor, a.data(), b.data(), n)
+                    .get(executor.get());
+            });
+        const double t_naive = reproducible(pot::algorithms::summation::naive);
+        const double t_pairwise = reproducible(pot::algorithms::summation::pairwise);
+        const double t_kahan = reproducible(pot::algorithms::summation::kahan);
+
+        fmt::print("{:10} | {:10.5f} | {:10.5f} {:10.5f} {:10.5f}\n", n, t_fast, t_naive, t_pairwise, t_kahan);
+    }
+}
+
+TEST_CASE("mixed-precision dot_simd", "[benchmark]")
+{
+    const int64_t thread_count = (int64_t)std::thread::hardware_concurrency();
+    const std::vector<size_t> sizes = {1 << 16, 1 << 20, 1 << 24};
+    const size_t test_runs = 10;
+
+    using pool_type = pot::executors::thread_pool_executor_lqlf_steal_seq;
+    auto executor = std::make_shared<pool_type>("Dot", thread_count);
+
+    fmt::print("\n=== dot_simd<In, Acc, Auto> ({} threads) ===\n", thread_count);
+    fmt::print("{:>10} | {:>10} {:>10} {:>10} {:>10} {:>10}\n", "N", "f32", "f32->f64", "i8->i32", "bf16->f32",
+               "f16->f32");
+    fmt::print("{:-<70}\n", "");
+
+    for (size_t n : sizes)
+    {
+        std::vector<float> a(n), b(n);
+        std::vector<int8_t> a8(n), b8(n);
+        std::vector<pot::simd::bfloat16> abf(n), bbf(n);
+        std::vector<pot::simd::float16> ah(n), bh(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            a[i] = static_cast<float>(i % 97) * 0.01f;
+            b[i] = static_cast<float>(i % 89) * 0.02f;
+            a8[i] = static_cast<int8_t>(i % 97);
+            b8[i] = static_cast<int8_t>(-static_cast<int>(i % 89));
+            abf[i] = pot::simd::bfloat16(a[i]);
+            bbf[i] = pot::simd::bfloat16(b[i]);
+            ah[i] = pot::simd::float16(a[i]);
+            bh[i] = pot::simd::float16(b[i]);
+        }
+
+        auto time = [&]<typename In, typename Acc>(const std::vector<In> &x, const std::vector<In> &y)
+        {
+            return pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {},
+                [&]
+                {
+                    if constexpr (std::is_same_v<In, Acc>)
+                        pot::algorithms::dot_simd<In, pot::simd::SIMDType::Auto>(*executor, x.data(), y.data(), n)
+                            .get(executor.get());
+                    else
+                        pot::algorithms::dot_simd<In, Acc, pot::simd::SIMDType::Auto>(*executor, x.data(), y.data(), n)
+                            .get(executor.get());
+                }).count();
+        };
+
+        fmt::print("{:10} | {:10.5f} {:10.5f} {:10.5f} {:10.5f} {:10.5f}\n", n,
+                   time.operator()<float, float>(a, b), time.operator()<float, double>(a, b),
+                   time.operator()<int8_t, int32_t>(a8, b8),
+                   time.operator()<pot::simd::bfloat16, float>(abf, bbf),
+                   time.operator()<pot::simd::float16, float>(ah, bh));
+    }
+}
+
+TEST_CASE("strided and indexed dot_simd vs copy + dot_simd", "[benchmark]")
+{
+    const int64_t thread_count = (int64_t)std::thread::hardware_concurrency();
+    const size_t test_runs = 10;
+
+    using pool_type = pot::executors::thread_pool_executor_lqlf_steal_seq;
+    auto executor = std::make_shared<pool_type>("Dot", thread_count);
+
+    fmt::print("\n=== column dot of a row-major matrix ({} threads) ===\n", thread_count);
+    fmt::print("{:>10} {:>6} | {:>10} {:>10} {:>10}\n", "rows", "cols", "copy+dot", "strided", "strided_simd");
+    fmt::print("{:-<56}\n", "");
+
+    for (auto [rows, cols] : {std::pair<size_t, size_t>{1 << 20, 4}, {1 << 20, 16}, {1 << 18, 64}})
+    {
+        std::vector<float> m(rows * cols);
+        for (size_t i = 0; i < m.size(); ++i)
+            m[i] = static_cast<float>(i % 97) * 0.01f;
+        std::vector<float> column(rows);
+
+        auto time = [&](auto &&f)
+        { return pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {}, f).count(); };
+
+        const double t_copy = time(
+            [&]
+            {
+                for (size_t r = 0; r < rows; ++r)
+                    column[r] = m[r * cols + 1];
+                pot::algorithms::dot_simd<float, pot::simd::SIMDType::Auto>(*executor, column.data(), column.data(), rows)
+                    .get(executor.get());
+            });
+        const double t_strided = time(
+            [&]
+            {
+                pot::algorithms::dot_strided(*executor, m.data() + 1, cols, m.data() + 1, cols, rows).get(executor.get());
+            });
+        const double t_simd = time(
+            [&]
+            {
+                pot::algorithms::dot_strided_simd<float, pot::simd::SIMDType::Auto>(*executor, m.data() + 1, cols,
+                                                                                    m.data() + 1, cols, rows)
+                    .get(executor.get());
+            });
+
+        fmt::print("{:10} {:6} | {:10.5f} {:10.5f} {:10.5f}\n", rows, cols, t_copy, t_strided, t_simd);
+    }
+
+    fmt::print("\n=== sparse-dense dot, dense size 1M ({} threads) ===\n", thread_count);
+    fmt::print("{:>10} | {:>10} {:>10}\n", "nnz", "indexed", "indexed_simd");
+    fmt::print("{:-<36}\n", "");
+
+    std::vector<float> x(1 << 20);
+    for (size_t i = 0; i < x.size(); ++i)
+        x[i] = static_cast<float>(i % 89) * 0.02f;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(x.size() - 1));
+
+    for (size_t nnz : {size_t(1) << 14, size_t(1) << 18, size_t(1) << 20})
+    {
+        std::vector<float> values(nnz, 0.5f);
+        std::vector<uint32_t> idx(nnz);
+        for (auto &i : idx)
+            i = pick(rng);
+        std::sort(idx.begin(), idx.end());
+
+        auto time = [&](auto &&f)
+        { return pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {}, f).count(); };
+
+        const double t_scalar = time(
+            [&] { pot::algorithms::dot_indexed(*executor, values.data(), x.data(), idx.data(), nnz).get(executor.get()); });
+        const double t_simd = time(
+            [&]
+            {
+                pot::algorithms::dot_indexed_simd<float, pot::simd::SIMDType::Auto>(*executor, values.data(), x.data(),
+                                                                                    idx.data(), nnz)
+                    .get(executor.get());
+            });
+
+        fmt::print("{:10} | {:10.5f} {:10.5f}\n", nnz, t_scalar, t_simd);
+    }
+}
+
+TEST_CASE("short-vector dot_simd with masked tails", "[benchmark]")
+{
+    const size_t test_runs = 10;
+    const size_t calls = 10'000;
+
+    using simd_t = pot::simd::simd_forced<float, SIMD_WIDTH>;
+    constexpr size_t lanes = simd_t::lanes;
+
+    auto hsum = [](const simd_t &v) { return v.sum(); };
+
+    // The same SIMD loop with the two tail strategies, without the task and block machinery around it.
+    auto scalar_tail = [&](const float *a, const float *b, size_t n)
+    {
+        simd_t acc = simd_t::zeros();
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes)
+        {
+            simd_t va; va.loadu(a + i);
+            simd_t vb; vb.loadu(b + i);
+            acc += va * vb;
+        }
+        float sum = hsum(acc);
+        for (; i < n; ++i)
+            sum += a[i] * b[i];
+        return sum;
+    };
+    auto masked_tail = [&](const float *a, const float *b, size_t n)
+    {
+        simd_t acc = simd_t::zeros();
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes)
+        {
+            simd_t va; va.loadu(a + i);
+            simd_t vb; vb.loadu(b + i);
+            acc += va * vb;
+        }
+        if (i < n)
+        {
+            simd_t va; va.loadu(a + i, n - i);
+            simd_t vb; vb.loadu(b + i, n - i);
+            acc += va * vb;
+        }
+        return hsum(acc);
+    };
+
+    // Runs in the calling thread, so dot_simd adds only its task and block overhead.
+    pot::executors::inline_executor executor("Dot");
+
+    fmt::print("\n=== short-vector dot, ns per call ===\n");
+    fmt::print("{:>6} | {:>10} {:>11} {:>11} {:>10}\n", "n", "inner_prod", "scalar tail", "masked tail", "dot_simd");
+    fmt::print("{:-<56}\n", "");
+
+    for (size_t n : {32, 37, 63, 100, 131, 200})
+    {
+        std::vector<float> a(n), b(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            a[i] = static_cast<float>(i % 13) * 0.1f;
+            b[i] = static_cast<float>(i % 7) * 0.2f;
+        }
+
+        float sink = 0.0f;
+        auto time = [&](auto &&f)
+        {
+            const double seconds = pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {},
+                [&]
+                {
+                    for (size_t c = 0; c < calls; ++c)
+                        sink += f();
+                }).count();
+            return seconds * 1e9 / static_cast<double>(calls);
+        };
+
+        const double t_std = time([&] { return std::inner_product(a.begin(), a.end(), b.begin(), 0.0f); });
+        const double t_scalar = time([&] { return scalar_tail(a.data(), b.data(), n); });
+        const double t_masked = time([&] { return masked_tail(a.data(), b.data(), n); });
+        const double t_dot = time(
+            [&] { return pot::algorithms::dot_simd<float, pot::simd::SIMDType::Auto>(executor, a.data(), b.data(), n).get(); });
+
+        fmt::print("{:6} | {:10.1f} {:11.1f} {:11.1f} {:10.1f}{}\n", n, t_std, t_scalar, t_masked, t_dot, sink < 0.0f ? " " : "");
+    }
+}
+
+TEST_CASE("vectorized exp/log/sin/tanh/erf vs libm", "[benchmark]")
+{
+    const size_t test_runs = 10;
+    const size_t n = 1 << 16;
+
+    auto run = [&]<typename T>(const char *type_name)
+    {
+        using simd_t = pot::simd::simd_forced<T, SIMD_WIDTH>;
+        constexpr size_t lanes = pot::simd::details::simd_traits<T, SIMD_WIDTH>::scalar_count;
+
+        std::vector<T> in(n), out(n);
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> dist(0.01, 20.0);
+        for (auto &x : in)
+            x = static_cast<T>(dist(gen));
+
+        auto time = [&](auto &&f)
+        {
+            const double seconds = pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {}, f).count();
+            return seconds * 1e9 / static_cast<double>(n);
+        };
+        auto scalar = [&](auto f)
+        {
+            return time([&] { for (size_t i = 0; i < n; ++i) out[i] = f(in[i]); });
+        };
+        auto vector = [&](auto f)
+        {
+            return time(
+                [&]
+                {
+                    for (size_t i = 0; i < n; i += lanes)
+                    {
+                        simd_t v; v.loadu(in.data() + i);
+                        f(v).storeu(out.data() + i);
+                    }
+                });
+        };
+        auto row = [&](const char *name, double t_scalar, double t_vector)
+        {
+            fmt::print("{:>7} {:>7} | {:10.2f} {:10.2f} {:8.1f}x\n", name, type_name, t_scalar, t_vector, t_scalar / t_vector);
+        };
+
+        row("exp", scalar([](T x) { return std::exp(-x); }), vector([](simd_t v) { return (simd_t::zeros() - v).exp(); }));
+        row("log", scalar([](T x) { return std::log(x); }), vector([](simd_t v) { return v.log(); }));
+        row("sin", scalar([](T x) { return std::sin(x); }), vector([](simd_t v) { return v.sin(); }));
+        row("tanh", scalar([](T x) { return std::tanh(x); }), vector([](simd_t v) { return v.tanh(); }));
+        row("erf", scalar([](T x) { return std::erf(x); }), vector([](simd_t v) { return v.erf(); }));
+        row("sigmoid", scalar([](T x) { return T(1) / (T(1) + std::exp(-x)); }), vector([](simd_t v) { return v.sigmoid(); }));
+    };
+
+    fmt::print("\n=== transcendental functions, simd_forced vs libm, ns per element ===\n");
+    fmt::print("{:>7} {:>7} | {:>10} {:>10} {:>9}\n", "", "", "libm", "simd", "speedup");
+    fmt::print("{:-<49}\n", "");
+    run.template operator()<float>("float");
+    run.template operator()<double>("double");
+}
+
+TEST_CASE("dot_simd and FMA accumulators vs peak FLOP/s", "[benchmark]")
+{
+    using simd_t = pot::simd::simd_forced<float, SIMD_WIDTH>;
+    const size_t test_runs = 10;
+    const size_t chain_steps = 1 << 22;
+    const size_t n = 4096; // two arrays of 16 KiB stay in L1
+    const size_t calls = 10000;
+
+    float sink = 0.0f;
+    auto gflops = [&](double flops, auto &&f)
+    {
+        const double seconds = pot::utils::time_it<std::chrono::duration<double>>(test_runs, []() {}, f).count();
+        return flops / seconds * 1e-9;
+    };
+
+    // Register-only FMA chains: with N accumulators N FMAs are in flight at once.
+    auto chains = [&]<size_t N>()
+    {
+        const simd_t x(0.999999f), y(1e-7f);
+        return gflops(2.0 * simd_t::lanes * N * static_cast<double>(chain_steps),
+            [&]
+            {
+                pot::simd::accumulators<simd_t, N> acc;
+                for (size_t s = 0; s < chain_steps; ++s)
+                    acc.each([&](simd_t &sum, size_t) { sum = sum.fma(x, y); });
+                sink += acc.total().sum();
+            });
+    };
+
+    std::vector<float> a(n), b(n);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = dist(gen);
+        b[i] = dist(gen);
+    }
+    auto dot_one_chain = [&]
+    {
+        simd_t sum = simd_t::zeros();
+        for (size_t i = 0; i < n; i += simd_t::lanes)
+        {
+            simd_t x; x.loadu(a.data() + i);
+            simd_t y; y.loadu(b.data() + i);
+            sum = x.fma(y, sum);
+        }
+        return sum.sum();
+    };
+    auto dot_four_chains = [&]
+    {
+        pot::simd::accumulators<simd_t, 4> acc;
+        for (size_t i = 0; i < n; i += acc.stride)
+            acc.each(
+                [&](simd_t &sum, size_t k)
+                {
+                    simd_t x; x.loadu(a.data() + i + k * simd_t::lanes);
+                    simd_t y; y.loadu(b.data() + i + k * simd_t::lanes);
+                    sum = x.fma(y, sum);
+                });
+        return acc.total().sum();
+    };
+
+    pot::executors::inline_executor executor("Dot");
+    const double dot_flops = 2.0 * static_cast<double>(n) * static_cast<double>(calls);
+
+    const double peak = chains.template operator()<8>();
+    auto row = [&](const char *name, double rate)
+    {
+        fmt::print("{:<28} | {:8.1f} {:7.0f}%{}\n", name, rate, 100.0 * rate / peak, sink < 0.0f ? " " : "");
+    };
+
+    fmt::print("\n=== simd_forced float FMA throughput, GFLOP/s on one core ===\n");
+    fmt::print("{:<28} | {:>8} {:>8}\n", "", "GFLOP/s", "of peak");
+    fmt::print("{:-<47}\n", "");
+    row("8 register chains (peak)", peak);
+    row("4 register chains", chains.template operator()<4>());
+    row("1 register chain", chains.template operator()<1>());
+    row("dot, 1 accumulator", gflops(dot_flops, [&] { for (size_t c = 0; c < calls; ++c) sink += dot_one_chain(); }));
+    row("dot, 4 accumulators", gflops(dot_flops, [&] { for (size_t c = 0; c < calls; ++c) sink += dot_four_chains(); }));
+    row("dot_simd, inline_executor", gflops(dot_flops,
+        [&]
+        {
+            for (size_t c = 0; c < calls; ++c)
+                sink += pot::algorithms::dot_simd<float, pot::simd::SIMDType::Auto>(executor, a.data(), b.data(), n).get();
+        }));
+    row("std::inner_product", gflops(dot_flops,
+        [&] { for (size_t c = 0; c < calls; ++c) sink += std::inner_product(a.begin(), a.end(), b.begin(), 0.0f); }));
+}
+
+TEST_CASE("Mandelbrot escape loop: scalar vs simd_forced masks", "[benchmark]")
+{
+    const size_t test_runs = 3;
+    const int row_step = 8; // every 8th row of the image
+
+    fmt::print("\n=== Mandelbrot rows on one thread: scalar vs masked SIMD, ms ===\n");
+    fmt::print("{:>8} | {:>10} {:>10} {:>10} | {:>8}\n", "MaxIter", "scalar", "SSE", "Auto", "speedup");
+    fmt::print("{:-<58}\n", "");
+
+    for (int max_iter : {500, 2000})
+    {
+        std::vector<int> scalar(MANDEL_WIDTH), simd(MANDEL_WIDTH);
+        auto time = [&](auto &&row)
+        {
+            return pot::utils::time_it<std::chrono::duration<double, std::milli>>(test_runs, []() {},
+                [&]
+                {
+                    for (int y = 0; y < MANDEL_HEIGHT; y += row_step)
+                        row(-1.5 + 3.0 * y / MANDEL_HEIGHT);
+                }).count();
+        };
+
+        const double t_scalar = time([&](double c_im)
+        {
+            for (int x = 0; x < MANDEL_WIDTH; ++x)
+                scalar[static_cast<size_t>(x)] = compute_mandelbrot(-2.0 + 3.0 * x / MANDEL_WIDTH, c_im, max_iter);
+        });
+        const double t_sse = time([&](double c_im)
+        {
+            compute_mandelbrot_row_simd<pot::simd::SIMDType::SSE>(c_im, max_iter, simd.data());
+        });
+        const double t_auto = time([&](double c_im)
+        {
+            pot::simd::dispatch<pot::simd::SIMDType::Auto>([&]<pot::simd::SIMDType W>()
+            {
+                compute_mandelbrot_row_simd<W>(c_im, max_iter, simd.data());
+            });
+        });
+        REQUIRE(simd == scalar); // the last row of both runs
+
+        fmt::print("{:8} | {:10.1f} {:10.1f} {:10.1f} | {:7.1f}x\n", max_iter, t_scalar, t_sse, t_auto, t_scalar / t_auto);
+    }
+}
+
+TEST_CASE("filter_simd vs std::copy_if", "[benchmark]")
+{
+    const size_t test_runs = 10;
+    const size_t n = 1 << 22;
+
+    std::vector<float> in(n), out(n);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (auto &x : in)
+        x = dist(gen);
+
+    pot::executors::inline_executor executor("Filter");
+
+    fmt::print("\n=== filter of {} floats on one thread, ms ===\n", n);
+    fmt::print("{:>8} | {:>10} {:>10} {:>10} {:>10}\n", "kept", "copy_if", "filter", "simd SSE", "simd Auto");
+    fmt::print("{:-<56}\n", "");
+
+    for (float keep : {0.1f, 0.5f, 0.9f})
+    {
+        auto time = [&](auto &&f)
+        {
+            return pot::utils::time_it<std::chrono::duration<double, std::milli>>(test_runs, []() {}, f).count();
+        };
+        auto pred = [keep](float x) { return x < keep; };
+        auto simd_pred = [keep](auto v) { return v < decltype(v)(keep); };
+
+        size_t expected = 0;
+        const double t_copy_if = time([&] { expected = static_cast<size_t>(std::copy_if(in.begin(), in.end(), out.begin(), pred) - out.begin()); });
+        const double t_filter = time([&] { REQUIRE(pot::algorithms::filter(executor, in.data(), out.data(), n, pred).get() == expected); });
+        const double t_sse = time(
+            [&]
+            {
+                REQUIRE(pot::algorithms::filter_simd<float, pot::simd::SIMDType::SSE>(executor, in.data(), out.data(), n, simd_pred)
+                            .get() == expected);
+            });
+        const double t_auto = time(
+            [&]
+            {
+                REQUIRE(pot::algorithms::filter_simd<float, pot::simd::SIMDType::Auto>(executor, in.data(), out.data(), n, simd_pred)
+                            .get() == expected);
+            });
+
+        fmt::print("{:7.0f}% | {:10.2f} {:10.2f} {:10.2f} {:10.2f}\n", keep * 100.0f, t_copy_if, t_filter, t_sse, t_auto);
+    }
+}
@@ -1,9 +1,15 @@
+#include <array>
 #include <atomic>
+#include <cmath>
 #include <catch2/catch_all.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <mutex>
+#include <numeric>
+#include <set>
 #include <thread>
 
 #include "pot/algorithms/parfor.h"
+#include "pot/algorithms/parfor_nd.h"
 #include "pot/executors/thread_pool_executor.h"
 
 TEST_CASE("Parfor: Concurrency and Thread Distribution", "[parfor]")
@@ -172,3 +178,429 @@ TEST_CASE("Parfor: Edge Cases", "[parfor][edge]")
         REQUIRE(count == 5);
     }
 }
+
+TEST_CASE("Parfor: Work-stealing pool (lfws)", "[parfor][steal]")
+{
+    pot::executors::thread_pool_executor_lfws pool("lfws_pool", 4);
+
+    SECTION("Flat loop")
+    {
+        const int size = 10000;
+        std::vector<int> data(size, 0);
+
+        pot::algorithms::parfor(pool, 0, size, [&](int i) { data[i] = i * 2; }).get(&pool);
+
+        for (int i = 0; i < size; ++i)
+        {
+            REQUIRE(data[i] == i * 2);
+        }
+    }
+
+    SECTION("Nested parfor with run inside tasks")
+    {
+        std::atomic<int> total_ops{0};
+        const int outer_iters = 200;
+        const int inner_iters = 50;
+
+        pot::algorithms::parfor(pool, 0, outer_iters,
+                                [&](int) -> pot::coroutines::task<void>
+                                {
+                                    co_await pot::algorithms::parfor(
+                                        pool, 0, inner_iters, [&](int)
+                                        { total_ops.fetch_add(1, std::memory_order_relaxed); });
+                                    co_await pool.run(
+                                        [&] { total_ops.fetch_add(1, std::memory_order_relaxed); });
+                                })
+            .get(&pool);
+
+        REQUIRE(total_ops.load() == outer_iters * (inner_iters + 1));
+    }
+
+    SECTION("Work spawned by a worker is stolen by idle workers")
+    {
+        std::mutex mtx;
+        std::set<std::thread::id> thread_ids;
+
+        pool.run(
+                [&]() -> pot::coroutines::task<void>
+                {
+                    co_await pot::algorithms::parfor<1>(
+                        pool, 0, 64,
+                        [&](int)
+                        {
+                            std::this_thread::sleep_for(std::chrono::microseconds(200));
+                            std::lock_guard lock(mtx);
+                            thread_ids.insert(std::this_thread::get_id());
+                        });
+                })
+            .blocking_get();
+
+        REQUIRE(thread_ids.size() > 1);
+    }
+
+    SECTION("Shutdown runs the queued tasks")
+    {
+        pot::executors::thread_pool_executor_lfws draining("lfws_drain", 2);
+        std::atomic<int> done{0};
+        for (int i = 0; i < 500; ++i)
+        {
+            draining.run_detached([&done]
+                                  {
+                                      std::this_thread::sleep_for(std::chrono::microseconds(50));
+                                      done.fetch_add(1);
+                                  });
+        }
+        draining.shutdown();
+        REQUIRE(done.load() == 500);
+    }
+}
+
+TEST_CASE("Parfor: Scheduling policies", "[parfor][schedule]")
+{
+    pot::executors::thread_pool_executor_lfws pool("schedule_pool", 4);
+
+    const pot::algorithms::schedule schedules[] = {
+        pot::algorithms::schedule::static_chunks(), pot::algorithms::schedule::static_chunks(7),
+        pot::algorithms::schedule::dynamic(),       pot::algorithms::schedule::dynamic(3),
+        pot::algorithms::schedule::guided(),        pot::algorithms::schedule::guided(16),
+        pot::algorithms::schedule::automatic()};
+
+    SECTION("Every index runs exactly once")
+    {
+        for (const auto &sched : schedules)
+        {
+            for (int size : {1, 3, 100, 10007})
+            {
+                std::vector<std::atomic<int>> hits(size);
+                pot::algorithms::parfor(pool, 5, 5 + size, sched,
+                                        [&](int i) { hits[i - 5].fetch_add(1, std::memory_order_relaxed); })
+                    .get(&pool);
+
+                for (int i = 0; i < size; ++i)
+                    REQUIRE(hits[i].load() == 1);
+            }
+        }
+    }
+
+    SECTION("Imbalanced iterations")
+    {
+        // The last rows are far more expensive, like the inside of a Mandelbrot set.
+        const int size = 512;
+        std::vector<int64_t> results(size, 0);
+
+        for (const auto &sched : schedules)
+        {
+            pot::algorithms::parfor(pool, 0, size, sched,
+                                    [&](int i)
+                                    {
+                                        const int64_t work = i > size - 32 ? 20'000 : 10;
+                                        int64_t acc = 0;
+                                        for (int64_t k = 0; k < work; ++k)
+                                            acc += k % 7;
+                                        results[i] = acc;
+                                    })
+                .get(&pool);
+
+            for (int i = 0; i < size; ++i)
+                REQUIRE(results[i] > 0);
+            std::fill(results.begin(), results.end(), 0);
+        }
+    }
+
+    SECTION("Async body")
+    {
+        for (const auto &sched : schedules)
+        {
+            std::atomic<int> counter{0};
+            pot::algorithms::parfor(pool, 0, 64, sched,
+                                    [&](int) -> pot::coroutines::task<void>
+                                    {
+                                        co_await pool.run([&] { counter.fetch_add(1, std::memory_order_relaxed); });
+                                    })
+                .get(&pool);
+
+            REQUIRE(counter.load() == 64);
+        }
+    }
+
+    SECTION("Auto mode picks a schedule from the probe timings")
+    {
+        using kind = pot::algorithms::schedule::kind;
+        REQUIRE(pot::algorithms::details::choose_schedule({100, 110, 95, 105}) == kind::static_chunks);
+        REQUIRE(pot::algorithms::details::choose_schedule({100, 100, 100, 500}) == kind::guided);
+        REQUIRE(pot::algorithms::details::choose_schedule({10, 10, 10, 10, 10, 10, 10, 5000}) == kind::dynamic);
+        REQUIRE(pot::algorithms::details::choose_schedule({-1, 100}) == kind::static_chunks);
+    }
+}
+
+TEST_CASE("Parfor: Lazy binary splitting", "[parfor][split]")
+{
+    pot::executors::thread_pool_executor_lfws pool("split_pool", 4);
+
+    SECTION("Every index runs exactly once")
+    {
+        for (int64_t grain : {0, 1, 16})
+        {
+            for (int size : {1, 5, 1000, 10007})
+            {
+                std::vector<std::atomic<int>> hits(size);
+                pot::algorithms::parfor(pool, 0, size, pot::algorithms::schedule::lazy_split(grain),
+                                        [&](int i) { hits[i].fetch_add(1, std::memory_order_relaxed); })
+                    .get(&pool);
+
+                for (int i = 0; i < size; ++i)
+                    REQUIRE(hits[i].load() == 1);
+            }
+        }
+    }
+
+    SECTION("Nested loops compose")
+    {
+        std::atomic<int> total_ops{0};
+        const int outer_iters = 200;
+        const int inner_iters = 100;
+
+        pot::algorithms::parfor(pool, 0, outer_iters, pot::algorithms::schedule::lazy_split(1),
+                                [&](int) -> pot::coroutines::lazy_task<void>
+                                {
+                                    co_await pot::algorithms::parfor(
+                                        pool, 0, inner_iters, pot::algorithms::schedule::lazy_split(),
+                                        [&](int) { total_ops.fetch_add(1, std::memory_order_relaxed); });
+                                })
+            .get(&pool);
+
+        REQUIRE(total_ops.load() == outer_iters * inner_iters);
+    }
+
+    SECTION("Idle workers pick up split-off halves")
+    {
+        std::mutex mtx;
+        std::set<std::thread::id> thread_ids;
+
+        pool.run(
+                [&]() -> pot::coroutines::task<void>
+                {
+                    co_await pot::algorithms::parfor(pool, 0, 64, pot::algorithms::schedule::lazy_split(1),
+                                                     [&](int)
+                                                     {
+                                                         std::this_thread::sleep_for(std::chrono::microseconds(200));
+                                                         std::lock_guard lock(mtx);
+                                                         thread_ids.insert(std::this_thread::get_id());
+                                                     });
+                })
+            .blocking_get();
+
+        REQUIRE(thread_ids.size() > 1);
+    }
+
+    SECTION("Exceptions propagate after all halves finish")
+    {
+        std::atomic<int> ran{0};
+        REQUIRE_THROWS_AS(pot::algorithms::parfor(pool, 0, 1000, pot::algorithms::schedule::lazy_split(1),
+                                                  [&](int i)
+                                                  {
+                                                      ran.fetch_add(1, std::memory_order_relaxed);
+                                                      if (i == 500)
+                                                          throw std::runtime_error("split failure");
+                                                  })
+                              .get(&pool),
+                          std::runtime_error);
+        REQUIRE(ran.load() > 0);
+    }
+}
+
+TEST_CASE("Parfor: Tiled 2-D and 3-D loops", "[parfor][tiled]")
+{
+    pot::executors::thread_pool_executor_lfws pool("tiled_pool", 4);
+
+    const pot::algorithms::tile_order orders[] = {pot::algorithms::tile_order::row_major,
+                                                  pot::algorithms::tile_order::morton,
+                                                  pot::algorithms::tile_order::hilbert};
+
+    SECTION("Index body visits every cell once")
+    {
+        const int rows = 37;
+        const int cols = 53;
+        for (auto order : orders)
+        {
+            std::vector<std::atomic<int>> hits(rows * cols);
+            pot::algorithms::parfor_2d(pool, rows, cols, {8, 16, order},
+                                       [&](int i, int j) { hits[i * cols + j].fetch_add(1, std::memory_order_relaxed); })
+                .get(&pool);
+
+            for (auto &hit : hits)
+                REQUIRE(hit.load() == 1);
+        }
+    }
+
+    SECTION("Tile body covers the grid without overlap")
+    {
+        const int64_t ni = 9, nj = 10, nk = 11;
+        for (auto order : orders)
+        {
+            std::vector<std::atomic<int>> hits(ni * nj * nk);
+            std::atomic<int> tiles{0};
+            pot::algorithms::parfor_3d(pool, ni, nj, nk, {4, 4, 4, order},
+                                       [&](const pot::algorithms::tile_range_3d<int64_t> &t)
+                                       {
+                                           tiles.fetch_add(1, std::memory_order_relaxed);
+                                           REQUIRE(t.i_end - t.i_begin <= 4);
+                                           for (auto i = t.i_begin; i < t.i_end; ++i)
+                                               for (auto j = t.j_begin; j < t.j_end; ++j)
+                                                   for (auto k = t.k_begin; k < t.k_end; ++k)
+                                                       hits[(i * nj + j) * nk + k].fetch_add(1, std::memory_order_relaxed);
+                                       })
+                .get(&pool);
+
+            REQUIRE(tiles.load() == 3 * 3 * 3);
+            for (auto &hit : hits)
+                REQUIRE(hit.load() == 1);
+        }
+    }
+
+    SECTION("Async body")
+    {
+        std::atomic<int> counter{0};
+        pot::algorithms::parfor_2d(pool, 10, 10, {3, 3, pot::algorithms::tile_order::morton},
+                                   [&](int, int) -> pot::coroutines::task<void>
+                                   {
+                                       co_await pool.run([&] { counter.fetch_add(1, std::memory_order_relaxed); });
+                                   })
+            .get(&pool);
+
+        REQUIRE(counter.load() == 100);
+    }
+
+    SECTION("Empty grid and invalid tiles")
+    {
+        bool called = false;
+        pot::algorithms::parfor_2d(pool, 0, 10, {}, [&](int, int) { called = true; }).get(&pool);
+        REQUIRE_FALSE(called);
+
+        REQUIRE_THROWS_AS(pot::algorithms::parfor_2d(pool, 4, 4, {0, 4}, [](int, int) {}), std::invalid_argument);
+    }
+
+    SECTION("Tile orders")
+    {
+        using pot::algorithms::details::tile_sequence;
+
+        const auto morton = tile_sequence<2>({2, 2}, pot::algorithms::tile_order::morton);
+        REQUIRE(morton == std::vector<std::array<uint32_t, 2>>{{0, 0}, {0, 1}, {1, 0}, {1, 1}});
+
+        // Consecutive Hilbert tiles are always neighbours.
+        for (auto dims : {std::array<int64_t, 2>{8, 8}, std::array<int64_t, 2>{4, 16}})
+        {
+            const auto hilbert = tile_sequence<2>(dims, pot::algorithms::tile_order::hilbert);
+            REQUIRE(hilbert.size() == static_cast<size_t>(dims[0] * dims[1]));
+            if (dims[0] != dims[1])
+                continue;
+            for (size_t t = 1; t < hilbert.size(); ++t)
+            {
+                const int64_t di = std::abs(int64_t(hilbert[t][0]) - int64_t(hilbert[t - 1][0]));
+                const int64_t dj = std::abs(int64_t(hilbert[t][1]) - int64_t(hilbert[t - 1][1]));
+                REQUIRE(di + dj == 1);
+            }
+        }
+
+        const auto hilbert_3d = tile_sequence<3>({4, 4, 4}, pot::algorithms::tile_order::hilbert);
+        for (size_t t = 1; t < hilbert_3d.size(); ++t)
+        {
+            int64_t distance = 0;
+            for (size_t d = 0; d < 3; ++d)
+                distance += std::abs(int64_t(hilbert_3d[t][d]) - int64_t(hilbert_3d[t - 1][d]));
+            REQUIRE(distance == 1);
+        }
+    }
+}
+
+template <typename Range>
+concept parfor_range_accepts = requires(pot::executor &exec, Range &&range) {
+    pot::algorithms::parfor_range(exec, std::forward<Range>(range), std::declval<void (*)(std::span<int>)>());
+};
+
+TEST_CASE("Parfor: Block bodies", "[parfor][range]")
+{
+    pot::executors::thread_pool_executor_lfws pool("range_pool", 4);
+
+    SECTION("Blocks tile the range")
+    {
+        const pot::algorithms::schedule schedules[] = {
+            pot::algorithms::schedule::static_chunks(), pot::algorithms::schedule::static_chunks(100),
+            pot::algorithms::schedule::dynamic(),       pot::algorithms::schedule::guided(),
+            pot::algorithms::schedule::automatic(),     pot::algorithms::schedule::lazy_split(64)};
+
+        for (const auto &sched : schedules)
+        {
+            const int64_t from = -50, to = 9999;
+            std::vector<std::atomic<int>> hits(to - from);
+            std::atomic<int64_t> blocks{0};
+
+            pot::algorithms::parfor_range(pool, from, to, sched,
+                                          [&](int64_t b, int64_t e)
+                                          {
+                                              REQUIRE(b < e);
+                                              blocks.fetch_add(1, std::memory_order_relaxed);
+                                              for (int64_t i = b; i < e; ++i)
+                                                  hits[i - from].fetch_add(1, std::memory_order_relaxed);
+                                          })
+                .get(&pool);
+
+            for (auto &hit : hits)
+                REQUIRE(hit.load() == 1);
+            if (sched.chunk_size == 100)
+                REQUIRE(blocks.load() == (to - from + 99) / 100);
+        }
+    }
+
+    SECTION("Default overload hands out one block per thread")
+    {
+        std::atomic<int> blocks{0};
+        pot::algorithms::parfor_range(pool, 0, 4000, [&](int, int) { blocks.fetch_add(1); }).get(&pool);
+        REQUIRE(blocks.load() == 4);
+
+        pot::algorithms::parfor_range(pool, 7, 7, [&](int, int) { blocks.fetch_add(1); }).get(&pool);
+        REQUIRE(blocks.load() == 4);
+    }
+
+    SECTION("Span bodies")
+    {
+        std::vector<float> data(10'000);
+        std::iota(data.begin(), data.end(), 0.0f);
+
+        pot::algorithms::parfor_range(pool, data, pot::algorithms::schedule::dynamic(256),
+                                      [](std::span<float> block)
+                                      {
+                                          for (float &x : block)
+                                              x *= 2.0f;
+                                      })
+            .get(&pool);
+
+        for (size_t i = 0; i < data.size(); ++i)
+            REQUIRE(data[i] == 2.0f * static_cast<float>(i));
+
+        const std::vector<int> values(1000, 1);
+        std::atomic<int> sum{0};
+        pot::algorithms::parfor_range(pool, values,
+                                      [&](std::span<const int> block)
+                                      { sum.fetch_add(std::accumulate(block.begin(), block.end(), 0)); })
+            .get(&pool);
+        REQUIRE(sum.load() == 1000);
+
+        // The lazy task only keeps a span, so a temporary container must not bind.
+        STATIC_REQUIRE(parfor_range_accepts<std::vector<int> &>);
+        STATIC_REQUIRE(parfor_range_accepts<std::span<int>>);
+        STATIC_REQUIRE_FALSE(parfor_range_accepts<std::vector<int>>);
+    }
+
+    SECTION("Async block body")
+    {
+        std::atomic<int> total{0};
+        pot::algorithms::parfor_range(pool, 0, 100, pot::algorithms::schedule::dynamic(10),
+                                      [&](int b, int e) -> pot::coroutines::task<void>
+                                      {
+                                          co_await pool.run([&, b, e] { total.fetch_add(e - b); });
+                                      })
+            .get(&pool);
+        REQUIRE(total.load() == 100);
+    }
+}
@@ -0,0 +1,197 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "pot/algorithms/dot.h"
+#include "pot/algorithms/reduce.h"
+#include "pot/executors/thread_pool_executor.h"
+
+#include "simd_checks.h"
+
+TEST_CASE("Reduce: transform_reduce", "[reduce]")
+{
+    pot::executors::thread_pool_executor_lfws pool("reduce_pool", 4);
+
+    std::vector<int64_t> a(10'001), b(10'001);
+    std::iota(a.begin(), a.end(), int64_t{-5000});
+    std::iota(b.begin(), b.end(), int64_t{1});
+
+    SECTION("One and several ranges")
+    {
+        const int64_t squares = pot::algorithms::transform_reduce(pool, a, int64_t{0}, std::plus<>{},
+                                                                  [](int64_t x) { return x * x; })
+                                    .get(&pool);
+        REQUIRE(squares == std::transform_reduce(a.begin(), a.end(), int64_t{0}, std::plus<>{},
+                                                 [](int64_t x) { return x * x; }));
+
+        const int64_t dot = pot::algorithms::transform_reduce(pool, std::tie(a, b), int64_t{0}, std::plus<>{},
+                                                              [](int64_t x, int64_t y) { return x * y; })
+                                .get(&pool);
+        REQUIRE(dot == std::inner_product(a.begin(), a.end(), b.begin(), int64_t{0}));
+
+        const std::vector<int64_t> empty;
+        REQUIRE(pot::algorithms::transform_reduce(pool, empty, int64_t{7}, std::plus<>{}, [](int64_t x) { return x; })
+                    .get(&pool) == 7);
+
+        REQUIRE_THROWS_AS(pot::algorithms::transform_reduce(pool, std::tie(a, empty), int64_t{0}, std::plus<>{},
+                                                            [](int64_t x, int64_t y) { return x + y; }),
+                          std::invalid_argument);
+    }
+
+    SECTION("Non-arithmetic accumulators")
+    {
+        struct arg_max
+        {
+            int64_t value;
+            size_t index;
+        };
+
+        // Ties keep the lower index, which only works if blocks are combined in order.
+        const std::vector<int64_t> values(5000, 3);
+        const auto best = pot::algorithms::transform_reduce(
+                              pool, std::views::iota(size_t{0}, values.size()), arg_max{INT64_MIN, 0},
+                              [](arg_max lhs, arg_max rhs) { return rhs.value > lhs.value ? rhs : lhs; },
+                              [&](size_t i) { return arg_max{values[i], i}; })
+                              .get(&pool);
+        REQUIRE(best.value == 3);
+        REQUIRE(best.index == 0);
+
+        using histogram = std::array<int, 8>;
+        struct add_to_histogram
+        {
+            histogram operator()(histogram h, int bin) const
+            {
+                ++h[bin];
+                return h;
+            }
+            histogram operator()(histogram h, const histogram &other) const
+            {
+                for (size_t i = 0; i < h.size(); ++i)
+                    h[i] += other[i];
+                return h;
+            }
+        };
+
+        const auto hist = pot::algorithms::transform_reduce(pool, b, histogram{}, add_to_histogram{},
+                                                            [](int64_t x) { return static_cast<int>(x % 8); })
+                              .get(&pool);
+        REQUIRE(std::accumulate(hist.begin(), hist.end(), 0) == static_cast<int>(b.size()));
+        REQUIRE(hist[1] == 1251);
+
+        const std::string digits = pot::algorithms::transform_reduce(
+                                       pool, std::views::iota(0, 40), std::string{}, std::plus<>{},
+                                       [](int i) { return std::to_string(i % 10); })
+                                       .get(&pool);
+        REQUIRE(digits == "0123456789012345678901234567890123456789");
+    }
+
+    SECTION("elementwise_reduce uses padded partials")
+    {
+        const int64_t sum = pot::algorithms::elementwise_reduce(pool, a.data(), b.data(), a.size(), std::plus<int64_t>{},
+                                                                std::plus<int64_t>{}, int64_t{0})
+                                .get(&pool);
+        REQUIRE(sum == std::accumulate(a.begin(), a.end(), int64_t{0}) + std::accumulate(b.begin(), b.end(), int64_t{0}));
+    }
+}
+
+TEST_CASE("Reduce: reproducible SIMD reductions", "[reduce][reproducible]")
+{
+    using pot::simd::SIMDType;
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> a(300'007), b(a.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = dist(rng);
+        b[i] = dist(rng) * 1e3f;
+    }
+
+    pot::executors::thread_pool_executor_lfws pool1("repro_1", 1);
+    pot::executors::thread_pool_executor_lfws pool3("repro_3", 3);
+    pot::executors::thread_pool_executor_lfws pool4("repro_4", 4);
+
+    SECTION("Bit-identical across pools and SIMD widths")
+    {
+        for (auto method : {pot::algorithms::summation::naive, pot::algorithms::summation::pairwise,
+                            pot::algorithms::summation::kahan})
+        {
+            const pot::algorithms::reproducible mode{4000, method};
+
+            const float r1 = pot::algorithms::dot_simd<float, SIMDType::SSE>(pool1, a.data(), b.data(), a.size(), mode)
+                                 .get(&pool1);
+            const float r3 = pot::algorithms::dot_simd<float, SIMDType::SSE>(pool3, a.data(), b.data(), a.size(), mode)
+                                 .get(&pool3);
+            // Auto runs the widest kernel the library has for this CPU.
+            const float r4 = pot::algorithms::dot_simd<float, SIMDType::Auto>(pool4, std::span<const float>(a),
+                                                                              std::span<const float>(b), mode)
+                                 .get(&pool4);
+
+            REQUIRE(std::bit_cast<uint32_t>(r1) == std::bit_cast<uint32_t>(r3));
+            REQUIRE(std::bit_cast<uint32_t>(r1) == std::bit_cast<uint32_t>(r4));
+        }
+
+        REQUIRE(pot::algorithms::dot_simd<float, SIMDType::SSE>(pool4, a.data(), b.data(), 0, {}).get(&pool4) == 0.0f);
+        auto zero_block = [&]
+        {
+            return pot::algorithms::dot_simd<float, SIMDType::SSE>(pool4, a.data(), b.data(), 10,
+                                                                   pot::algorithms::reproducible{0})
+                .get(&pool4);
+        };
+        REQUIRE_THROWS_AS(zero_block(), std::invalid_argument);
+    }
+
+    SECTION("Compensated summation is more accurate")
+    {
+        simd_checks::compensated_summation<SIMDType::SSE>(pool4);
+    }
+
+    SECTION("Fast path and pointer overloads")
+    {
+        double expected = 0.0;
+        for (size_t i = 0; i < a.size(); ++i)
+            expected += static_cast<double>(a[i]) * b[i];
+
+        const float fast = pot::algorithms::dot_simd<float, SIMDType::SSE>(pool4, a.data(), b.data(), a.size()).get(&pool4);
+        const float scalar = pot::algorithms::dot(pool4, a, b).get(&pool4);
+        REQUIRE(std::abs(fast - expected) < 1.0);
+        REQUIRE(std::abs(scalar - expected) < 1.0);
+    }
+}
+
+TEST_CASE("Reduce: strided and indexed", "[reduce][gather]")
+{
+    using pot::simd::SIMDType;
+
+    pot::executors::thread_pool_executor_lfws pool("gather", 3);
+    std::mt19937 rng(20);
+
+    SECTION("Column norms of a row-major matrix")
+    {
+        simd_checks::column_dots<SIMDType::SSE, SIMDType::Auto>(pool, rng);
+    }
+
+    SECTION("Integer strides are exact")
+    {
+        simd_checks::integer_strides<SIMDType::SSE, SIMDType::Auto>(pool, rng);
+    }
+
+    SECTION("Sparse-dense dot products")
+    {
+        simd_checks::sparse_dots<SIMDType::SSE, SIMDType::Auto>(pool, rng);
+    }
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "pot/algorithms/scan.h"
+#include "pot/executors/thread_pool_executor.h"
+
+#include "simd_checks.h"
+
+TEST_CASE("Scan: inclusive and exclusive", "[scan]")
+{
+    pot::executors::thread_pool_executor_lfws pool("scan_pool", 4);
+
+    const size_t sizes[] = {0, 1, 7, 4095, 4096, 20'000, 100'003};
+
+    SECTION("Matches std::inclusive_scan / std::exclusive_scan")
+    {
+        for (size_t n : sizes)
+        {
+            std::vector<int64_t> in(n);
+            for (size_t i = 0; i < n; ++i)
+                in[i] = static_cast<int64_t>(i % 13) - 5;
+
+            std::vector<int64_t> expected(n), out(n);
+
+            std::inclusive_scan(in.begin(), in.end(), expected.begin());
+            const int64_t total =
+                pot::algorithms::inclusive_scan(pool, in.data(), out.data(), n, std::plus<>{}, int64_t{0}).get(&pool);
+            REQUIRE(out == expected);
+            REQUIRE(total == std::accumulate(in.begin(), in.end(), int64_t{0}));
+
+            std::exclusive_scan(in.begin(), in.end(), expected.begin(), int64_t{0});
+            REQUIRE(pot::algorithms::exclusive_scan(pool, in.data(), out.data(), n, std::plus<>{}, int64_t{0}).get(&pool) ==
+                    total);
+            REQUIRE(out == expected);
+        }
+    }
+
+    SECTION("Generic operation and in-place scan")
+    {
+        std::vector<int> data(50'000);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = static_cast<int>((i * 7919) % 100'000);
+
+        std::vector<int> expected(data.size());
+        std::inclusive_scan(data.begin(), data.end(), expected.begin(), [](int a, int b) { return std::max(a, b); });
+
+        auto max_op = [](int a, int b) { return std::max(a, b); };
+        pot::algorithms::inclusive_scan(pool, std::span<const int>(data), std::span<int>(data), max_op,
+                                        std::numeric_limits<int>::min())
+            .get(&pool);
+        REQUIRE(data == expected);
+
+        std::vector<int> shorter(10);
+        REQUIRE_THROWS_AS(pot::algorithms::exclusive_scan(pool, std::span<const int>(data), std::span<int>(shorter),
+                                                          std::plus<>{}, 0),
+                          std::invalid_argument);
+    }
+
+    SECTION("SIMD blocks")
+    {
+        simd_checks::scan_simd_blocks<pot::simd::SIMDType::SSE, pot::simd::SIMDType::Auto>(pool, sizes);
+    }
+}
@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include "pot/algorithms/dot.h"
+#include "pot/algorithms/reduce.h"
+#include "pot/algorithms/scan.h"
+#include "pot/algorithms/sort.h"
+#include "pot/executors/thread_pool_executor.h"
+#include "pot/simd/dispatch.h"
+#include "pot/simd/simd_auto.h"
+
+#include "simd_checks.h"
+
+TEST_CASE("SIMD: runtime width dispatch", "[simd][dispatch]")
+{
+    using pot::simd::SIMDType;
+
+    SECTION("Width selection")
+    {
+        REQUIRE(pot::simd::parse_simd_type("SSE") == SIMDType::SSE);
+        REQUIRE(pot::simd::parse_simd_type("avx") == SIMDType::AVX);
+        REQUIRE(pot::simd::parse_simd_type("Avx512") == SIMDType::AVX512);
+        REQUIRE_FALSE(pot::simd::parse_simd_type("neon").has_value());
+
+        pot::simd::cpu_features sse_host;
+        sse_host.sse41 = true;
+        pot::simd::cpu_features avx2_host = sse_host;
+        avx2_host.avx2 = avx2_host.fma = avx2_host.f16c = true;
+        pot::simd::cpu_features avx512_host = avx2_host;
+        avx512_host.avx512f = avx512_host.avx512bw = avx512_host.avx512vl = true;
+
+        // Never wider than the host.
+        REQUIRE(pot::simd::select_simd_type(sse_host, avx512_host) == SIMDType::SSE);
+        REQUIRE(pot::simd::select_simd_type(avx2_host, avx512_host) == SIMDType::AVX);
+        REQUIRE(pot::simd::select_simd_type(avx512_host, avx512_host) == SIMDType::AVX512);
+        // Never wider than the build.
+        REQUIRE(pot::simd::select_simd_type(avx512_host, avx2_host) == SIMDType::AVX);
+        REQUIRE(pot::simd::select_simd_type(avx512_host, pot::simd::cpu_features{}) == SIMDType::SSE);
+        // Kernels built with VNNI must not run on a host without it.
+        pot::simd::cpu_features vnni_build = avx512_host;
+        vnni_build.avx512vnni = true;
+        REQUIRE(pot::simd::select_simd_type(avx512_host, vnni_build) == SIMDType::AVX);
+        // POT_SIMD-style limit.
+        REQUIRE(pot::simd::select_simd_type(avx512_host, avx512_host, SIMDType::SSE) == SIMDType::SSE);
+        REQUIRE(pot::simd::select_simd_type(avx512_host, avx512_host, SIMDType::AVX) == SIMDType::AVX);
+
+        const auto active = pot::simd::active_simd_type();
+        REQUIRE(pot::simd::cpu_features::system().covers(pot::simd::cpu_features{}));
+        REQUIRE(active == pot::simd::select_simd_type(pot::simd::cpu_features::system(),
+                                                      pot::simd::kernel_features(),
+                                                      pot::simd::simd_type_override()));
+        // The library builds every width, whatever flags this file is compiled with.
+        REQUIRE(pot::simd::kernel_features().avx512f);
+    }
+
+    SECTION("Auto matches the selected width")
+    {
+        pot::executors::thread_pool_executor_lfws pool("dispatch", 3);
+        std::vector<float> a(10'007), b(a.size());
+        std::vector<int8_t> q(a.size());
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            a[i] = static_cast<float>(i % 13) * 0.25f;
+            b[i] = static_cast<float>(i % 7) - 3.0f;
+            q[i] = static_cast<int8_t>(i % 255 - 127);
+        }
+
+        const auto expected = [&]<SIMDType W>()
+        {
+            return std::tuple{
+                pot::algorithms::dot_simd<float, W>(pool, a.data(), b.data(), a.size()).get(&pool),
+                pot::algorithms::dot_simd<float, W>(pool, a.data(), b.data(), a.size(), {}).get(&pool),
+                pot::algorithms::dot_simd<int8_t, int32_t, W>(pool, q.data(), q.data(), q.size()).get(&pool)};
+        };
+        // Auto runs the library kernels, which may be wider than the widths compiled into this file.
+        // Every product and partial sum here is exact, so all widths agree.
+        const auto selected = pot::simd::dispatch<SIMDType::Auto>(expected);
+        const auto automatic = std::tuple{
+            pot::algorithms::dot_simd<float, SIMDType::Auto>(pool, a.data(), b.data(), a.size()).get(&pool),
+            pot::algorithms::dot_simd<float, SIMDType::Auto>(pool, a.data(), b.data(), a.size(), {}).get(&pool),
+            pot::algorithms::dot_simd<int8_t, int32_t, SIMDType::Auto>(pool, q.data(), q.data(), q.size()).get(&pool)};
+        REQUIRE(automatic == selected);
+
+        std::vector<float> scanned(a.size()), reference(a.size());
+        pot::algorithms::inclusive_scan_simd<float, SIMDType::Auto>(
+            pool, a.data(), scanned.data(), a.size(), [](auto x, auto y) { return x + y; }, std::plus<float>{}, 0.0f)
+            .get(&pool);
+        std::inclusive_scan(a.begin(), a.end(), reference.begin());
+        for (size_t i = 0; i < a.size(); i += 997)
+            REQUIRE(std::abs(scanned[i] - reference[i]) <= 1e-3f * std::max(1.0f, reference[i]));
+
+        std::vector<float> sorted = b;
+        pot::algorithms::sort(pool, sorted.begin(), sorted.end()).get(&pool);
+        REQUIRE(std::is_sorted(sorted.begin(), sorted.end()));
+    }
+}
+
+TEST_CASE("SIMD: masked tails", "[simd][tail]")
+{
+    using pot::simd::SIMDType;
+
+    SECTION("Partial loads and stores touch only the first lanes")
+    {
+        simd_checks::partial_loads<SIMDType::SSE>();
+    }
+
+    SECTION("Short vectors")
+    {
+        pot::executors::thread_pool_executor_lfws pool("tail", 3);
+
+        for (size_t n = 1; n <= 200; ++n)
+        {
+            const float sse = simd_checks::short_vectors<SIMDType::SSE>(pool, n);
+            REQUIRE(simd_checks::short_vectors<SIMDType::Auto>(pool, n) == sse);
+        }
+    }
+}
+
+TEST_CASE("SIMD: transcendental functions", "[simd][math]")
+{
+    simd_checks::transcendentals<pot::simd::SIMDType::SSE>();
+}
+
+TEST_CASE("SIMD: fused multiply-add and horizontal reductions", "[simd][fma]")
+{
+    using pot::simd::SIMDType;
+
+    SECTION("fma, fms and fnma")
+    {
+        simd_checks::fused_ops<SIMDType::SSE>();
+    }
+
+    SECTION("Horizontal sum, min and max")
+    {
+        simd_checks::horizontal_reductions<SIMDType::SSE>();
+    }
+}
+
+TEST_CASE("SIMD: comparison masks, select and compress", "[simd][mask]")
+{
+    using pot::simd::SIMDType;
+
+    SECTION("Lane masks match scalar comparisons")
+    {
+        simd_checks::comparison_masks<SIMDType::SSE>();
+    }
+
+    SECTION("simd_auto masks")
+    {
+        using simd_t = pot::simd::simd_auto<int, 6>;
+        const simd_t a(0, 1, 2, 3, 4, 5), b(3);
+        const auto ge = a >= b;
+        REQUIRE(ge.movemask() == 0b111000);
+        REQUIRE((ge & simd_t::mask::first(4)).popcount() == 1);
+        REQUIRE((~ge).movemask() == 0b000111);
+
+        int out[6] = {};
+        REQUIRE(a.compress_store(out, ge) == 3);
+        REQUIRE((out[0] == 3 && out[1] == 4 && out[2] == 5));
+        REQUIRE(select(ge, a, b).sum() == 3 + 3 + 3 + 3 + 4 + 5);
+    }
+}
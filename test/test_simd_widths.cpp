@@ -0,0 +1,139 @@
+// The checks of simd_checks.h at the widest width this file is compiled for: one executable per
+// width, see test/CMakeLists.txt.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "pot/algorithms/dot.h"
+#include "pot/executors/thread_pool_executor.h"
+#include "pot/simd/dispatch.h"
+#include "pot/simd/float16.h"
+
+#include "simd_checks.h"
+
+namespace
+{
+using pot::simd::SIMDType;
+
+constexpr SIMDType W = pot::simd::details::widest_compiled();
+static_assert(W != SIMDType::SSE, "build this file with the flags of a wider SIMD width");
+} // namespace
+
+// Read by simd_width_guard.cpp before any static initialization of this file runs.
+extern const pot::simd::cpu_features required_cpu_features = pot::simd::details::compiled_features();
+
+TEST_CASE("SIMD width: scan", "[width][scan]")
+{
+    pot::executors::thread_pool_executor_lfws pool("scan_pool", 4);
+    const size_t sizes[] = {0, 1, 7, 4095, 4096, 20'000, 100'003};
+    simd_checks::scan_simd_blocks<W>(pool, sizes);
+}
+
+TEST_CASE("SIMD width: reproducible reductions", "[width][reduce][reproducible]")
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> a(300'007), b(a.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = dist(rng);
+        b[i] = dist(rng) * 1e3f;
+    }
+
+    pot::executors::thread_pool_executor_lfws pool3("repro_3", 3);
+    pot::executors::thread_pool_executor_lfws pool4("repro_4", 4);
+
+    SECTION("Bit-identical to SSE")
+    {
+        for (auto method : {pot::algorithms::summation::naive, pot::algorithms::summation::pairwise,
+                            pot::algorithms::summation::kahan})
+        {
+            const pot::algorithms::reproducible mode{4000, method};
+            const float wide = pot::algorithms::dot_simd<float, W>(pool3, a.data(), b.data(), a.size(), mode).get(&pool3);
+            const float sse = pot::algorithms::dot_simd<float, SIMDType::SSE>(pool4, std::span<const float>(a),
+                                                                              std::span<const float>(b), mode)
+                                  .get(&pool4);
+            REQUIRE(std::bit_cast<uint32_t>(wide) == std::bit_cast<uint32_t>(sse));
+        }
+        REQUIRE(pot::algorithms::dot_simd<float, W>(pool4, a.data(), b.data(), 0, {}).get(&pool4) == 0.0f);
+    }
+
+    SECTION("Compensated summation is more accurate")
+    {
+        simd_checks::compensated_summation<W>(pool4);
+    }
+}
+
+TEST_CASE("SIMD width: strided and indexed", "[width][reduce][gather]")
+{
+    pot::executors::thread_pool_executor_lfws pool("gather", 3);
+    std::mt19937 rng(20);
+
+    simd_checks::column_dots<W>(pool, rng);
+    simd_checks::integer_strides<W>(pool, rng);
+    simd_checks::sparse_dots<W>(pool, rng);
+}
+
+TEST_CASE("SIMD width: mixed-precision and widening dot", "[width][dot][widen]")
+{
+    pot::executors::thread_pool_executor_lfws pool("widen", 3);
+    std::mt19937 rng(19);
+
+    simd_checks::float_to_double<W>(pool, rng);
+    simd_checks::integer_widening<int8_t, W>(pool, rng);
+    simd_checks::integer_widening<uint8_t, W>(pool, rng);
+    simd_checks::integer_widening<int16_t, W>(pool, rng);
+    simd_checks::widening_extremes<W>(pool);
+    simd_checks::widening_biased_sum<W>();
+    simd_checks::half_float_widening<pot::simd::bfloat16, W>(pool, rng, 0.05f);
+    simd_checks::half_float_widening<pot::simd::float16, W>(pool, rng, 0.05f);
+}
+
+TEST_CASE("SIMD width: masked tails", "[width][simd][tail]")
+{
+    simd_checks::partial_loads<W>();
+
+    pot::executors::thread_pool_executor_lfws pool("tail", 3);
+    for (size_t n = 1; n <= 200; ++n)
+        REQUIRE(simd_checks::short_vectors<W>(pool, n) == simd_checks::short_vectors<SIMDType::SSE>(pool, n));
+}
+
+TEST_CASE("SIMD width: transcendental functions", "[width][simd][math]")
+{
+    simd_checks::transcendentals<W>();
+}
+
+TEST_CASE("SIMD width: fused multiply-add and horizontal reductions", "[width][simd][fma]")
+{
+    simd_checks::fused_ops<W>();
+    simd_checks::horizontal_reductions<W>();
+}
+
+TEST_CASE("SIMD width: comparison masks, select and compress", "[width][simd][mask]")
+{
+    simd_checks::comparison_masks<W>();
+}
+
+TEST_CASE("SIMD width: filter", "[width][filter]")
+{
+    pot::executors::thread_pool_executor_lfws pool("filter", 3);
+
+    for (size_t n : {size_t(0), size_t(1), size_t(7), size_t(33), size_t(1000), size_t(100003)})
+    {
+        std::vector<float> in(n);
+        std::vector<int32_t> ints(n);
+        std::mt19937 gen(static_cast<unsigned>(n));
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        for (size_t i = 0; i < n; ++i)
+        {
+            in[i] = dist(gen);
+            ints[i] = static_cast<int32_t>(i % 97) - 48;
+        }
+        simd_checks::filter_simd_matches_copy_if<W>(pool, in, ints);
+    }
+}
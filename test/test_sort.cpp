@@ -0,0 +1,175 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "pot/algorithms/sort.h"
+#include "pot/executors/thread_pool_executor.h"
+
+template <typename Range>
+concept sort_accepts = requires(pot::executor &exec, Range &&range) {
+    pot::algorithms::sort(exec, std::forward<Range>(range));
+};
+
+TEST_CASE("Sort: parallel merge sort", "[sort]")
+{
+    pot::executors::thread_pool_executor_lfws pool("sort_pool", 4);
+    std::mt19937_64 rng(42);
+
+    const size_t sizes[] = {0, 1, 2, 63, 64, 65, 1000, 40'000, 200'003};
+
+    SECTION("Network keys")
+    {
+        for (size_t n : sizes)
+        {
+            std::uniform_int_distribution<int32_t> dist(-1000, 1000);
+
+            std::vector<int32_t> ints(n);
+            for (auto &x : ints)
+                x = dist(rng);
+            std::vector<float> floats(ints.begin(), ints.end());
+            std::vector<double> doubles(n);
+            for (auto &x : doubles)
+                x = std::uniform_real_distribution<double>(-1.0, 1.0)(rng);
+
+            auto expected_ints = ints;
+            auto expected_floats = floats;
+            auto expected_doubles = doubles;
+            std::sort(expected_ints.begin(), expected_ints.end());
+            std::sort(expected_floats.begin(), expected_floats.end());
+            std::sort(expected_doubles.begin(), expected_doubles.end());
+
+            pot::algorithms::sort(pool, ints).get(&pool);
+            pot::algorithms::sort(pool, floats.begin(), floats.end()).get(&pool);
+            pot::algorithms::sort(pool, doubles, std::less<double>{}).get(&pool);
+
+            REQUIRE(ints == expected_ints);
+            REQUIRE(floats == expected_floats);
+            REQUIRE(doubles == expected_doubles);
+        }
+    }
+
+    SECTION("Custom comparator and non-arithmetic values")
+    {
+        for (size_t n : sizes)
+        {
+            std::vector<int64_t> values(n);
+            for (auto &x : values)
+                x = static_cast<int64_t>(rng() % 5000);
+            auto expected = values;
+            std::sort(expected.begin(), expected.end(), std::greater<>{});
+            pot::algorithms::sort(pool, values, std::greater<>{}).get(&pool);
+            REQUIRE(values == expected);
+        }
+
+        // Moved-from strings are empty, so merge slices that still compared elements of the
+        // source after another slice had moved them wrote out of place. Repeat to catch it.
+        for (int round = 0; round < 8; ++round)
+        {
+            std::vector<std::string> words(30'000);
+            for (auto &w : words)
+                w = std::to_string(rng() % 100'000);
+            auto expected = words;
+            std::sort(expected.begin(), expected.end());
+            pot::algorithms::sort(pool, words).get(&pool);
+            REQUIRE(words == expected);
+        }
+    }
+
+    SECTION("Temporary ranges are rejected")
+    {
+        STATIC_REQUIRE(sort_accepts<std::vector<int> &>);
+        STATIC_REQUIRE(sort_accepts<std::span<int>>);
+        STATIC_REQUIRE_FALSE(sort_accepts<std::vector<int>>);
+    }
+}
+
+TEST_CASE("Sort: radix sort", "[sort][radix]")
+{
+    pot::executors::thread_pool_executor_lfws pool("radix_pool", 4);
+    std::mt19937_64 rng(7);
+
+    const size_t sizes[] = {0, 1, 100, 40'000, 200'003};
+
+    auto check = [&]<typename K>(std::vector<K> keys)
+    {
+        auto expected = keys;
+        std::sort(expected.begin(), expected.end());
+        pot::algorithms::radix_sort(pool, keys).get(&pool);
+        REQUIRE(keys == expected);
+    };
+
+    SECTION("Key types")
+    {
+        for (size_t n : sizes)
+        {
+            std::vector<uint64_t> bits(n);
+            for (auto &x : bits)
+                x = rng();
+
+            check(std::vector<uint32_t>(bits.begin(), bits.end()));
+            check(std::vector<uint64_t>(bits));
+
+            std::vector<int32_t> i32(n);
+            std::vector<int64_t> i64(n);
+            std::vector<float> f32(n);
+            std::vector<double> f64(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                i32[i] = static_cast<int32_t>(bits[i] % 2001) - 1000;
+                i64[i] = static_cast<int64_t>(bits[i]);
+                f32[i] = static_cast<float>(i32[i]) * 0.25f;
+                f64[i] = static_cast<double>(i64[i]) * 1e-9;
+            }
+            check(i32);
+            check(i64);
+            check(f32);
+            check(f64);
+        }
+
+        std::vector<float> specials = {0.0f, -0.0f, 1.0f, -1.0f, std::numeric_limits<float>::infinity(),
+                                       -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::min(),
+                                       -std::numeric_limits<float>::max()};
+        pot::algorithms::radix_sort(pool, specials).get(&pool);
+        REQUIRE(std::is_sorted(specials.begin(), specials.end()));
+        REQUIRE(std::signbit(specials[3]));
+        REQUIRE_FALSE(std::signbit(specials[4]));
+    }
+
+    SECTION("Key-value pairs are stable")
+    {
+        const size_t n = 100'000;
+        std::vector<uint32_t> keys(n);
+        std::vector<size_t> order(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            keys[i] = static_cast<uint32_t>(rng() % 64) << 20;
+            order[i] = i;
+        }
+
+        std::vector<std::pair<uint32_t, size_t>> expected(n);
+        for (size_t i = 0; i < n; ++i)
+            expected[i] = {keys[i], i};
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+
+        pot::algorithms::radix_sort(pool, keys, order).get(&pool);
+        for (size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(keys[i] == expected[i].first);
+            REQUIRE(order[i] == expected[i].second);
+        }
+
+        std::vector<size_t> shorter(3);
+        REQUIRE_THROWS_AS(pot::algorithms::radix_sort(pool, keys, shorter), std::invalid_argument);
+    }
+}
@@ -3,6 +3,8 @@
 
 #include "pot/coroutines/task.h"
 
+#include <memory_resource>
+
 pot::coroutines::lazy_task<int> fibonacci_lazy(int i)
 {
     if (i == 0)
@@ -442,3 +444,56 @@ TEST_CASE("task test")
         REQUIRE(result == 90);
     }
 }
+
+namespace
+{
+    class frame_size_resource final : public std::pmr::memory_resource
+    {
+      public:
+        std::size_t last_size = 0;
+
+      private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            last_size = bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    pot::coroutines::task<int> trivial_task()
+    {
+        co_return 1;
+    }
+} // namespace
+
+TEST_CASE("task frame size")
+{
+    using promise_type = pot::coroutines::task<int>::promise_type;
+
+    // run_count and the executor pointer, nothing else.
+    STATIC_REQUIRE(sizeof(pot::coroutines::details::task_meta) <= 2 * sizeof(void *));
+    // ready flag, awaiter, variant<monostate, int, exception_ptr> and meta.
+    STATIC_REQUIRE(sizeof(promise_type) <= 6 * sizeof(void *));
+
+    frame_size_resource resource;
+    pot::memory::set_memory_resource(&resource);
+    {
+        auto task = trivial_task();
+        REQUIRE(task.get() == 1);
+    }
+    pot::memory::reset_memory_resource();
+
+    // resume/destroy pointers and the suspend index come on top of the promise.
+    REQUIRE(resource.last_size > sizeof(promise_type));
+    REQUIRE(resource.last_size <= sizeof(promise_type) + 6 * sizeof(void *));
+}
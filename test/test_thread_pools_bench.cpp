@@ -2,17 +2,22 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "pot/algorithms/parfor.h"
+#include "pot/memory/frame_pool.h"
 #include "pot/sandbox/thread_pool_executor.h"
 #include "pot/sync/async_lock.h"
 #include "pot/utils/time_it.h"
 
 #include <Eigen/Sparse>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <fmt/core.h>
+#include <fstream>
 #include <latch>
 #include <memory>
 #include <thread>
+#include <unistd.h>
 #include <vector>
 
 template <typename ExecutorType>
@@ -57,6 +62,74 @@ void run_high_contention_microtasks(int64_t total_tasks, std::shared_ptr<Executo
 		state->completion.wait();
 }
 
+template <typename ExecutorType> void spawn_trivial_tasks(int64_t total_tasks, std::shared_ptr<ExecutorType> executor)
+{
+	std::vector<pot::coroutines::task<int64_t>> tasks;
+	tasks.reserve(total_tasks);
+	for (int64_t i = 0; i < total_tasks; ++i)
+		tasks.push_back(executor->run([i]() { return i; }));
+
+	int64_t sum = 0;
+	for (auto &task : tasks)
+		sum += task.get(&*executor);
+
+	if (sum != total_tasks * (total_tasks - 1) / 2)
+		throw std::runtime_error("spawn_trivial_tasks: lost a task");
+}
+
+size_t resident_bytes()
+{
+	std::ifstream statm("/proc/self/statm");
+	size_t total_pages = 0, resident_pages = 0;
+	statm >> total_pages >> resident_pages;
+	return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+template <typename ExecutorType> void churn_frames(int64_t total_frames, std::shared_ptr<ExecutorType> executor)
+{
+	// One frame per chunk plus one per iteration; chunk frames die on the submitting thread.
+	pot::algorithms::parfor<16>(*executor, (int64_t)0, total_frames,
+								[](int64_t) -> pot::coroutines::task<void> { co_return; })
+		.get(&*executor);
+}
+
+struct latency_stats
+{
+	double median_us;
+	double p99_us;
+};
+
+template <typename ExecutorType>
+latency_stats ping_pong_latency(ExecutorType &executor, size_t rounds, std::chrono::microseconds gap)
+{
+	using clock = std::chrono::steady_clock;
+
+	std::vector<double> samples;
+	samples.reserve(rounds);
+	std::atomic<clock::rep> ran_at{0};
+
+	for (size_t i = 0; i < rounds; ++i)
+	{
+		// Leave the pool idle for a while so every sample goes through the worker's idle path.
+		std::this_thread::sleep_for(gap);
+
+		ran_at.store(0, std::memory_order_relaxed);
+		const auto submitted = clock::now();
+		executor.run_detached([&ran_at]
+							  { ran_at.store(clock::now().time_since_epoch().count(), std::memory_order_release); });
+
+		clock::rep ran = 0;
+		while ((ran = ran_at.load(std::memory_order_acquire)) == 0)
+			std::this_thread::yield();
+
+		samples.push_back(
+			std::chrono::duration<double, std::micro>(clock::duration(ran) - submitted.time_since_epoch()).count());
+	}
+
+	std::sort(samples.begin(), samples.end());
+	return {samples[samples.size() / 2], samples[samples.size() * 99 / 100]};
+}
+
 constexpr int MANDEL_WIDTH = 2000;
 constexpr int MANDEL_HEIGHT = 2000;
 constexpr int MANDEL_NUM_BINS = 64;
@@ -98,6 +171,8 @@ template <typename ExecutorType> void build_mandelbrot_pot(int64_t max_iter, std
 								}
 							})
 		.get();
+
+	pot::memory::reset_memory_resource();
 }
 
 std::tuple<double, double, double> calculation(const int64_t row_idx)
@@ -134,6 +209,8 @@ template <typename ExecutorType> void buildA_pot(int64_t n, std::shared_ptr<Exec
 									A.coeffRef(i, i + 1) = vr;
 							})
 		.get();
+
+	pot::memory::reset_memory_resource();
 }
 
 #define INIT_EXECUTORS(THREADS)                                                                                        \
@@ -234,4 +311,108 @@ TEST_CASE("Comprehensive ExecutorType Thread Pool Benchmarks", "[benchmark]")
 			}
 		}
 	}
+
+	SECTION("4. Spawn rate")
+	{
+		const std::vector<int64_t> task_counts = {100'000, 1'000'000};
+		const size_t test_runs = 5;
+
+		fmt::print("\n=== S6: Trivial task<int64_t> spawn + get ===\n");
+		fmt::print("{:>8} {:>10} | {:>8} {:>8} {:>8} {:>8} {:>8} {:>8} {:>8} {:>8} {:>8}\n", "Threads", "Tasks", "GQ",
+				   "LQ", "LQ_Seq", "LQ_Neigh", "GS", "LS", "GS_Hot", "LS_Hot", "GPQ");
+		fmt::print("{:-<110}\n", "");
+
+		for (auto thread_count : thread_counts)
+		{
+			INIT_EXECUTORS(thread_count)
+			for (auto param : task_counts)
+			{
+				RUN_BENCHMARK_SUITE(spawn_trivial_tasks, param)
+			}
+		}
+	}
+
+	SECTION("5. Frame allocator")
+	{
+		const int64_t total_frames = 1'000'000;
+		const size_t test_runs = 5;
+
+		fmt::print("\n=== S7: Coroutine frame allocator ===\n");
+		fmt::print("{:>8} {:>6} {:>12} | {:>12} {:>10}\n", "Threads", "Pool", "Resource", "Mframes/s", "RSS +MiB");
+		fmt::print("{:-<56}\n", "");
+
+		auto measure = [&](auto executor, const char *pool_name, const char *resource_name,
+						   std::pmr::memory_resource *resource)
+		{
+			using ExecutorType = typename decltype(executor)::element_type;
+
+			pot::memory::set_memory_resource(resource);
+			const size_t rss_before = resident_bytes();
+			auto elapsed = pot::utils::time_it<std::chrono::duration<double>>(
+				test_runs, []() {}, churn_frames<ExecutorType>, total_frames, executor);
+			const size_t rss_after = resident_bytes();
+			pot::memory::reset_memory_resource();
+
+			// parfor<16> allocates a chunk frame per 16 iterations on top of one frame per iteration.
+			const double frames = static_cast<double>(total_frames) * 17.0 / 16.0;
+			fmt::print("{:8} {:>6} {:>12} | {:12.3f} {:10.2f}\n", executor->thread_count(), pool_name, resource_name,
+					   frames / elapsed.count() / 1e6,
+					   (static_cast<double>(rss_after) - static_cast<double>(rss_before)) / (1024.0 * 1024.0));
+		};
+
+		for (auto thread_count : thread_counts)
+		{
+			auto exec_gq = std::make_shared<pot::executors::thread_pool_executor_gq>("GQ", thread_count);
+			auto exec_lflq = std::make_shared<pot::executors::thread_pool_executor_lflq>("LFLQ", thread_count);
+
+			{
+				measure(exec_gq, "GQ", "new_delete", std::pmr::new_delete_resource());
+				pot::memory::frame_pool_resource frame_pool;
+				measure(exec_gq, "GQ", "frame_pool", &frame_pool);
+			}
+			{
+				measure(exec_lflq, "LFLQ", "new_delete", std::pmr::new_delete_resource());
+				pot::memory::frame_pool_resource frame_pool;
+				measure(exec_lflq, "LFLQ", "frame_pool", &frame_pool);
+			}
+		}
+	}
+	SECTION("6. Ping-pong latency")
+	{
+		const size_t rounds = 2'000;
+		const std::vector<std::chrono::microseconds> gaps = {std::chrono::microseconds(0),
+															 std::chrono::microseconds(50),
+															 std::chrono::microseconds(1'000)};
+		const std::vector<std::pair<const char *, pot::idle_policy>> policies = {
+			{"park", pot::idle_policy::park()},
+			{"yield", pot::idle_policy::yield_then_park()},
+			{"spin", pot::idle_policy::spin_then_park()},
+		};
+
+		fmt::print("\n=== S8: Submit-to-run latency of an idle pool ===\n");
+		fmt::print("{:>8} {:>6} {:>8} {:>8} | {:>10} {:>10}\n", "Threads", "Pool", "Policy", "Gap us", "p50 us",
+				   "p99 us");
+		fmt::print("{:-<58}\n", "");
+
+		auto measure = [&](auto executor, const char *pool_name, const char *policy_name)
+		{
+			for (auto gap : gaps)
+			{
+				auto stats = ping_pong_latency(*executor, rounds, gap);
+				fmt::print("{:8} {:>6} {:>8} {:8} | {:10.2f} {:10.2f}\n", executor->thread_count(), pool_name,
+						   policy_name, gap.count(), stats.median_us, stats.p99_us);
+			}
+		};
+
+		for (auto thread_count : thread_counts)
+		{
+			for (const auto &[policy_name, policy] : policies)
+			{
+				measure(std::make_shared<pot::executors::thread_pool_executor_gq>("GQ", thread_count, policy), "GQ",
+						policy_name);
+				measure(std::make_shared<pot::executors::thread_pool_executor_lflq>("LFLQ", thread_count, policy),
+						"LFLQ", policy_name);
+			}
+		}
+	}
 }